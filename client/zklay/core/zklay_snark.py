@@ -52,6 +52,7 @@ class snark :
         self.__libsnark.getLastFunctionMsg.restype = ctypes.c_char_p 
         self.__libsnark.serializeProof.restype = ctypes.c_char_p 
         self.__libsnark.serializeVerifyKey.restype = ctypes.c_char_p
+        self.__libsnark.serializePrimaryInputs.restype = ctypes.c_char_p
 
     def _createCircuitArguments(self):
         args = [self.client_ctx.depth, self.client_ctx.hash]
@@ -113,6 +114,19 @@ class snark :
         except Exception as e:
             print(e)
 
+    @print_wrapper(0)
+    def proof_batch(self, context_id : int, inputs : List[Dict[str, Any]]) -> List[str] :
+        """
+        run proof for each primary input set in inputs, in one call
+        """
+        proofs = ctypes.c_char_p()
+        rtn = self.__libsnark.runProofBatch(context_id, s2c(json.dumps(inputs)), ctypes.byref(proofs))
+        msg = self.__libsnark.getLastFunctionMsg(context_id).decode('utf-8')
+        print ("RunProofBatch : %d , %s" % (rtn , msg) )
+        if rtn != 0 or not proofs.value :
+            return []
+        return [json.dumps(proof) for proof in json.loads(proofs.value.decode('utf-8'))]
+
     @print_wrapper(0)
     def verify(self, context_id : int) :
         """
@@ -122,6 +136,36 @@ class snark :
         msg = self.__libsnark.getLastFunctionMsg(context_id).decode('utf-8')
         print ("RunVerify : %d , %s" % (rtn , msg) )
 
+    def create_verifier(self, context_id : int, vk_file_name : Optional[str] = None) :
+        """
+        keep the processed verification key in the context for the following verify calls
+        """
+        rtn = self.__libsnark.createVerifier(context_id, s2c(vk_file_name) if vk_file_name else None)
+        msg = self.__libsnark.getLastFunctionMsg(context_id).decode('utf-8')
+        print ("CreateVerifier : %d , %s" % (rtn , msg) )
+
+    def verify_with_inputs(self, context_id : int, primary_inputs : List[str]) -> bool :
+        """
+        run verify against the given primary inputs (see GetPrimaryInputs), with no circuit evaluation
+        """
+        rtn = self.__libsnark.runVerifyWithInputs(context_id, s2c(json.dumps(primary_inputs)))
+        msg = self.__libsnark.getLastFunctionMsg(context_id).decode('utf-8')
+        print ("RunVerifyWithInputs : %d , %s" % (rtn , msg) )
+        return rtn == 0
+
+    def verify_batch(self, context_id : int, inputs : List[Dict[str, Any]], proofs : List[str]) -> List[bool] :
+        """
+        run verify for each (primary input set, proof) pair, in one call
+        """
+        results = (ctypes.c_int * len(proofs))()
+        proofs_json = "[" + ",".join(proofs) + "]"
+        rtn = self.__libsnark.runVerifyBatch(context_id, s2c(json.dumps(inputs)), s2c(proofs_json), results)
+        msg = self.__libsnark.getLastFunctionMsg(context_id).decode('utf-8')
+        print ("RunVerifyBatch : %d , %s" % (rtn , msg) )
+        if rtn == 1 :
+            return [False] * len(proofs)
+        return [bool(r) for r in results]
+
     def finalize(self, context_id : int) :
         """
         Finalize :: it means "memory free"
@@ -135,12 +179,20 @@ class snark :
         self.__libsnark.serializeFormat(c_id,ZKLAY_SERIAL)
         return c_id
 
+    def get_verifier_context_id(self) -> int :
+        c_id = self.__libsnark.createVerifierContext(PROOF_SYSTEM_GG, 1)
+        self.__libsnark.serializeFormat(c_id,ZKLAY_SERIAL)
+        return c_id
+
     def GetVerificationKey(self, context_id : int) -> str :
         return self.__libsnark.serializeVerifyKey(context_id).decode('utf-8')
 
     def GetProof(self, context_id : int) -> str :
         return self.__libsnark.serializeProof(context_id).decode('utf-8')
 
+    def GetPrimaryInputs(self, context_id : int) -> List[str] :
+        return json.loads(self.__libsnark.serializePrimaryInputs(context_id).decode('utf-8'))
+
 
 class VerificationKey :
     def __init__(
@@ -65,6 +65,19 @@ extern "C" {
                              const char * inputs_text_path , 
                              const char * cs_file_path );
     
+    /**
+     * Initialize a verifier context : no circuit is constructed or evaluated.
+     *
+     * The context reads a verify key and proofs, and verifies with {@link #runVerifyWithInputs}
+     * and {@link #runVerifyBatchWithInputs}. \n
+     * The functions that build, set up, evaluate or prove the circuit fail on it.
+     *
+     * @return -2   : invalid \b proof_system \n
+     *         -3   : invalid \b ec_selection \n
+     *         >=1  : success \n
+     */
+    int createVerifierContext( int proof_system , int ec_selection );
+
     /**
      * Construct the embedded circuit
      * 
@@ -96,6 +109,60 @@ extern "C" {
             int context_id , 
             const char * arg_key , 
             const char * arg_value  );
+
+    /**
+     * Make the following {@link #buildCircuit} calls run the r1cs optimizer over the constraint system.
+     *
+     * The pass substitutes the linear constraints away, and drops trivial and duplicate constraints
+     * and unused variables. It changes the constraint system, so the constraint system files, the
+     * evaluation programs and the keys of an optimized circuit do not fit the unoptimized one.
+     *
+     * @param enable - 1 to optimize, 0 to keep the constraint system as built (default)
+     *
+     * @return 0 : \b success \n
+     *        -1 : invalid \b context_id \n 
+     *         1 : a verifier context \n 
+     */
+    int setConstraintSystemOptimizer( int context_id , int enable );
+
+    /**
+     * Make the following {@link #buildCircuit} calls reuse a gadget allocated again over the same
+     * inputs and arguments, with its output wires, instead of building it twice.
+     *
+     * It changes the constraint system of the circuits that repeat a gadget, so the constraint
+     * system files, the evaluation programs and the keys of a circuit built with it do not fit the
+     * circuit built without it. Turning it on or off for a circuit therefore means running the
+     * setup again and using the new proving and verification keys; proofs made with the old keys
+     * do not verify against the new ones.
+     *
+     * @param enable - 1 to reuse the gadgets, 0 to build every gadget allocation (default)
+     *
+     * @return 0 : \b success \n
+     *        -1 : invalid \b context_id \n 
+     *         1 : a verifier context \n 
+     */
+    int setGadgetMemoization( int context_id , int enable );
+
+    /**
+     * Make the following {@link #buildCircuit} calls multiply a constant elliptic curve base point
+     * (e.g. the fixed generator of ZKlay) with multiples of the base computed outside the circuit,
+     * one per window of 2 secret bits, instead of the generic double-and-add ladder.
+     *
+     * It changes the constraint system of the circuits with a constant base point, so the constraint
+     * system files, the evaluation programs and the keys of a circuit built with it do not fit the
+     * circuit built without it.
+     *
+     * The option is off by default, and only a base point made of constant wires takes the precomputed
+     * windows. The RealEstate circuits pass their G_PKE bases as input or prover witness wires, so they
+     * build the same circuit with or without it and gain nothing from it.
+     *
+     * @param enable - 1 for the precomputed windows, 0 for the generic ladder (default)
+     *
+     * @return 0 : \b success \n
+     *        -1 : invalid \b context_id \n 
+     *         1 : a verifier context \n 
+     */
+    int setFixedBaseScalarMul( int context_id , int enable );
     /** @} */
 
     
@@ -113,6 +180,115 @@ extern "C" {
     int runSetup( int context_id );
     int runProof( int context_id );
     int runVerify( int context_id );
+
+    /**
+     * Prove a batch of primary input sets for the same circuit.
+     *
+     * Each item is applied as with {@link #updatePrimaryInputFromJson} and proven as with {@link #runProof}.
+     * The proving key and the per-circuit prover state are shared by the whole batch, and
+     * the witness of the next item is generated while the current one is proven. \n
+     * After the call, the context holds the inputs and the proof of the last item. \n
+     * An item with an array index out of range, or whose evaluation fails, stops the batch,
+     * with an error message naming its index.
+     *
+     * @param inputs_json_array - a JSON array of primary input objects
+     *
+     * @param proofs_json_array - set to a JSON array of the serialized proofs, in the order of the inputs
+     *                            (see {@link #serializeFormat}). Valid until the next call on the same context.
+     */
+    int runProofBatch( int context_id , const char* inputs_json_array , const char** proofs_json_array );
+
+    /**
+     * Verify a batch of proofs for the same circuit.
+     *
+     * Item i of \b proofs_json_array is verified against item i of \b inputs_json_array, as with
+     * {@link #updatePrimaryInputFromJson} and {@link #runVerify}. The proofs are combined with random
+     * scalars and checked with a single pairing product; if that check fails, the batch is split to
+     * find the invalid proofs. Uses the processed verify key of {@link #createVerifier} if there is one.
+     * After the call, the context holds the inputs of the last item; its proof is left unchanged. \n
+     * An item with an array index out of range, whose evaluation fails, or whose proof is malformed
+     * stops the batch, with an error message naming its index.
+     *
+     * @param inputs_json_array - a JSON array of primary input objects
+     *
+     * @param proofs_json_array - a JSON array of serialized proofs (see {@link #runProofBatch})
+     *
+     * @param results - set to 1 (valid) or 0 (invalid) for each proof. May be NULL, or else must hold one int per proof.
+     *
+     * @return 0 : all proofs are valid \n
+     *        -1 : invalid \b context_id , or at least one proof is invalid \n
+     *         1 : error occurred , get the error description with {@link #getLastFunctionMsg}
+     */
+    int runVerifyBatch( int context_id , const char* inputs_json_array , const char* proofs_json_array , int* results );
+
+    /**
+     * Verify a batch of proofs against the given primary inputs, without evaluating the circuit.
+     *
+     * As {@link #runVerifyBatch}, with item i of \b primary_inputs_json_array given as to {@link #runVerifyWithInputs}.
+     * Use it on a context of {@link #createVerifierContext}, or any context with a verify key.
+     *
+     * @param primary_inputs_json_array - a JSON array of JSON arrays of primary input values as hexadecimal strings
+     *
+     * @param proofs_json_array - a JSON array of serialized proofs (see {@link #runProofBatch})
+     *
+     * @param results - set to 1 (valid) or 0 (invalid) for each proof. May be NULL, or else must hold one int per proof.
+     *
+     * @return 0 : all proofs are valid \n
+     *        -1 : invalid \b context_id , or at least one proof is invalid \n
+     *         1 : error occurred , get the error description with {@link #getLastFunctionMsg}
+     */
+    int runVerifyBatchWithInputs( int context_id , const char* primary_inputs_json_array , const char* proofs_json_array , int* results );
+
+    /**
+     * Verify the loaded proof against the given primary inputs, without evaluating the circuit.
+     *
+     * Use it on a context of {@link #createVerifierContext}, or any context with a verify key and a proof.
+     * Uses the processed verify key of {@link #createVerifier} if there is one.
+     *
+     * @param primary_inputs_json - a JSON array of the primary input values as hexadecimal strings,
+     *                              in the order of the constraint system (see {@link #serializePrimaryInputs})
+     *
+     * @return 0 : the proof is valid \n
+     *        -1 : invalid \b context_id , or the proof is invalid \n
+     *         1 : error occurred , get the error description with {@link #getLastFunctionMsg}
+     */
+    int runVerifyWithInputs( int context_id , const char* primary_inputs_json );
+
+    /**
+     * Keep a processed verify key in the context for repeated verification.
+     *
+     * The pairing e(alpha, beta) and the G2 precomputations of the verify key are computed once,
+     * and each following {@link #runVerify} only does the per-proof work. \n
+     * The processed key is dropped by {@link #readVK}, {@link #deSerializeVerifyKey} and {@link #runSetup}. \n
+     * Fails when the file can not be read, or when no verify key was read or generated before.
+     *
+     * @param vk_file_name - verify key file to read first (as with {@link #readVK}), or NULL to use the loaded verify key
+     */
+    int createVerifier( int context_id , const char* vk_file_name );
+
+    /**
+     * Keep precomputed multiples of the proof key bases in the context (R1CS_GG only).
+     *
+     * The multi-exponentiations of {@link #runProof} then use the tables and skip most doublings.
+     * The tables are built at once if the context has a proof key, and rebuilt whenever the proof key
+     * changes. {@link #writePKBinary} stores them, and {@link #readPKBinary} loads them when they fit
+     * in the budget, instead of building them again.
+     *
+     * @param memory_mb - memory budget of the tables in MB, 0 to drop them
+     */
+    int setPKTableMemory( int context_id , int memory_mb );
+
+    /**
+     * Make the following {@link #runSetup} calls publish the H query of the proof key in the
+     * Lagrange basis of a coset of the QAP domain (R1CS_GG only).
+     *
+     * {@link #runProof} then uses the evaluations of H on the coset as they are, and skips one FFT
+     * of the QAP domain size per proof. The proof key has one more H query point and carries the
+     * basis in its files, so that a key and a prover of different bases are never mixed.
+     *
+     * @param enable - 1 for the coset Lagrange basis, 0 for the monomial basis (default)
+     */
+    int setCosetHQuery( int context_id , int enable );
     /** @} */
 
 
@@ -135,11 +311,14 @@ extern "C" {
      * @param array_index - index of a primary input array to update
      * 
      * @param input_json_string - a JSON object, with keys as primary input names and values as BigInteger in a hexadecimal format.
+     *                            Keys that are not primary inputs of the circuit are skipped.
      * 
      * @return  0 : \b success \n 
      *         -1 : invalid \b context_id \n 
      *          1 : invalid \b input_name \n 
-     *          1 : \b array_index out-of-range
+     *          1 : \b array_index out-of-range \n
+     *          1 : no circuit to update (a verifier context, or the circuit is not built),
+     *              get the error description with {@link #getLastFunctionMsg}
      * @{
      */
     int updatePrimaryInput(int context_id , const char* input_name , int value );
@@ -175,12 +354,32 @@ extern "C" {
     int writeCircuitToFile(int context_id , const char* file_name);
     int writeInputsToFile(int context_id , const char* file_name);
 
+    /**
+     * Write / read a binary snapshot of the witness evaluation program : opcodes, wire ids, constants
+     * and the primary input labels. Read it on a context created with a constraint system file, after
+     * the circuit arguments and before {@link #buildCircuit} : the circuit generator is then not run,
+     * and the primary inputs are updated by their labels as usual. \n
+     * Write fails for a circuit with a prover hint that has no native routine.
+     * Read returns 2 when the file is not a snapshot of this circuit (name and arguments).
+     */
+    int writeEvaluationProgram(int context_id , const char* file_name);
+    int readEvaluationProgram(int context_id , const char* file_name);
+
     int writeVK(int context_id , const char* file_name);
     int readVK(int context_id , const char* file_name);
     
     int writePK(int context_id , const char* file_name);
     int readPK(int context_id , const char* file_name);
     
+    /**
+     * Write / read the proof key (R1CS_GG only) in a binary, page aligned file of affine points.
+     * Reading maps the file and copies the points with no parsing or point decompression.
+     * The checksum is a keccak256 of the data, optional on both sides.
+     * Read returns 2 on a checksum mismatch.
+     */
+    int writePKBinary(int context_id , const char* file_name , int use_checksum );
+    int readPKBinary(int context_id , const char* file_name , int verify_checksum );
+    
     int writeProof(int context_id , const char* file_name);
     int readProof(int context_id , const char* file_name);
     
@@ -194,6 +393,11 @@ extern "C" {
     const char* serializeProof(int context_id );
     int deSerializeProof(int context_id , const char* json_string);
 
+    /**
+     * The primary inputs of the last evaluation (e.g. of {@link #runProof}), as the JSON array read by {@link #runVerifyWithInputs}.
+     */
+    const char* serializePrimaryInputs(int context_id );
+
 
     
     int serializeFormat( int context_id , int format ) ;
@@ -119,6 +119,53 @@ namespace libsnark {
     }
     
 
+    // called with createCircuitContext_mtx held
+    int add_context( const string & circuit_name , 
+                     int proof_system ,
+                     int ec_selection ,
+                     create_circuit_ftn_t create_circuit_ftn ,
+                     const string & arith_text_path , 
+                     const string & inputs_text_path , 
+                     const string & cs_file_path )
+    {
+        Context_base * context = NULL ; 
+
+        int new_id = last_context_id + 1 ;
+        while ( context_list.find(new_id) != context_list.end() ){ new_id ++ ; }        
+        last_context_id = new_id ;
+        
+        if ( ec_selection == EC_ALT_BN128 ){
+            
+            context = new Context< libff::Fr<libff::alt_bn128_pp > ,  libff::alt_bn128_pp , libff::alt_bn128_pp >(
+                                last_context_id , 
+                                circuit_name , 
+                                proof_system , 
+                                config_list[ec_selection],
+                                create_circuit_ftn ,
+                                arith_text_path , 
+                                inputs_text_path ,
+                                cs_file_path );
+        
+        }else if ( ec_selection == EC_BLS12_381 ){
+        
+            context = new Context< libff::Fr<libff::bls12_381_pp > ,  libff::bls12_381_pp , libff::bls12_381_pp >(
+                            last_context_id , 
+                            circuit_name , 
+                            proof_system , 
+                            config_list[ec_selection],
+                            create_circuit_ftn ,
+                            arith_text_path , 
+                            inputs_text_path ,
+                            cs_file_path );
+        
+        }
+        
+        context_list[last_context_id] = context ;
+
+        return last_context_id ;
+    }
+
+
     int createCircuitContext(const char * __circuit_name , 
                              int proof_system ,
                              int ec_selection ,
@@ -128,7 +175,6 @@ namespace libsnark {
     { 
         
         create_circuit_ftn_t create_circuit_ftn = NULL ;
-        Context_base * context = NULL ; 
         int error_code = 0 ;
         
         if ( ! __circuit_name ){ return -1 ; }
@@ -169,41 +215,47 @@ namespace libsnark {
 
         
 
-        int new_id = last_context_id + 1 ;
-        while ( context_list.find(new_id) != context_list.end() ){ new_id ++ ; }        
-        last_context_id = new_id ;
-        
-        if ( ec_selection == EC_ALT_BN128 ){
-            
-            context = new Context< libff::Fr<libff::alt_bn128_pp > ,  libff::alt_bn128_pp , libff::alt_bn128_pp >(
-                                last_context_id , 
-                                circuit_name , 
-                                proof_system , 
-                                config_list[ec_selection],
-                                create_circuit_ftn ,
-                                arith_text_path , 
-                                inputs_text_path ,
-                                cs_file_path );
-        
-        }else if ( ec_selection == EC_BLS12_381 ){
-        
-            context = new Context< libff::Fr<libff::bls12_381_pp > ,  libff::bls12_381_pp , libff::bls12_381_pp >(
-                            last_context_id , 
-                            circuit_name , 
-                            proof_system , 
-                            config_list[ec_selection],
-                            create_circuit_ftn ,
-                            arith_text_path , 
-                            inputs_text_path ,
-                            cs_file_path );
+        const int context_id = add_context( circuit_name , 
+                                            proof_system , 
+                                            ec_selection , 
+                                            create_circuit_ftn , 
+                                            arith_text_path , 
+                                            inputs_text_path , 
+                                            cs_file_path );
+
+        createCircuitContext_mtx.unlock() ;
         
+        return context_id ;
+    }
+
+
+    int createVerifierContext( int proof_system , int ec_selection ){
+
+        createCircuitContext_mtx.lock() ;
+
+        libsnark::init_globals();
+
+        int error_code = 0 ;
+
+        if ( !(proof_system == R1CS_GG || proof_system == R1CS_ROM_SE) ){ 
+            error_code = -2 ;
         }
-        
-        context_list[last_context_id] = context ;
+
+        if ( (error_code == 0) && (config_list.find(ec_selection) == config_list.end()) ){ 
+            error_code = -3 ;
+        }
+
+        if ( error_code != 0 ){
+            createCircuitContext_mtx.unlock() ;
+            return error_code ;
+        }
+
+        // no circuit constructor : the context only reads keys and proofs, and verifies
+        const int context_id = add_context( "Verifier" , proof_system , ec_selection , NULL , "" , "" , "" );
 
         createCircuitContext_mtx.unlock() ;
-        
-        return last_context_id ;
+
+        return context_id ;
     }
 }
 
@@ -229,6 +281,10 @@ extern "C" {
                                         cs_file_path );
     }
 
+    int createVerifierContext( int proof_system , int ec_selection ){
+        return libsnark::createVerifierContext( proof_system , ec_selection );
+    }
+
     int buildCircuit (int context_id ){
         auto ItC = context_list.find(context_id) ;
         if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
@@ -245,6 +301,24 @@ extern "C" {
         return ItC->second->assign_circuit_argument(arg_key , arg_value ) ;
     }
 
+    int setConstraintSystemOptimizer (int context_id , int enable ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->set_cs_optimizer( enable == 1 ) ;
+    }
+
+    int setGadgetMemoization (int context_id , int enable ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->set_gadget_memoization( enable == 1 ) ;
+    }
+
+    int setFixedBaseScalarMul (int context_id , int enable ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->set_fixed_base_scalar_mul( enable == 1 ) ;
+    }
+
     int runSetup (int context_id ){
         auto ItC = context_list.find(context_id) ;
         if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
@@ -257,12 +331,54 @@ extern "C" {
         return ItC->second->run_proof() ;
     }
 
+    int runProofBatch (int context_id , const char* inputs_json_array , const char** proofs_json_array ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->run_proof_batch( inputs_json_array , proofs_json_array ) ;
+    }
+
     int runVerify (int context_id  ) {
         auto ItC = context_list.find(context_id) ;
         if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
         return ItC->second->run_verify() ;
     }
 
+    int runVerifyBatch (int context_id , const char* inputs_json_array , const char* proofs_json_array , int* results ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->run_verify_batch(inputs_json_array , proofs_json_array , results) ;
+    }
+
+    int runVerifyBatchWithInputs (int context_id , const char* primary_inputs_json_array , const char* proofs_json_array , int* results ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->run_verify_batch_with_inputs(primary_inputs_json_array , proofs_json_array , results) ;
+    }
+
+    int runVerifyWithInputs (int context_id , const char* primary_inputs_json ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->run_verify_with_inputs(primary_inputs_json) ;
+    }
+
+    int createVerifier (int context_id , const char* vk_file_name ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->create_verifier(vk_file_name) ;
+    }
+
+    int setPKTableMemory (int context_id , int memory_mb ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->set_pk_table_memory( ( memory_mb > 0 ) ? ( (size_t)memory_mb << 20 ) : 0 ) ;
+    }
+
+    int setCosetHQuery (int context_id , int enable ) {
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->set_coset_H_query( enable == 1 ) ;
+    }
+
     int writeConstraintSystem(int context_id , const char* file_name , int use_compression , const char* checksum_prefix ){
         auto ItC = context_list.find(context_id) ;
         if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
@@ -287,6 +403,18 @@ extern "C" {
         return ItC->second->write_inputs_to_file(file_name) ;
     }
 
+    int writeEvaluationProgram(int context_id , const char* file_name){
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->write_evaluation_program(file_name) ;
+    }
+
+    int readEvaluationProgram(int context_id , const char* file_name){
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->read_evaluation_program(file_name) ;
+    }
+
 
     int updatePrimaryInput(int context_id , const char* input_name , int value ){
         auto ItC = context_list.find(context_id) ;
@@ -355,6 +483,18 @@ extern "C" {
         return ItC->second->read_pk(file_name) ;
     }
 
+    int writePKBinary(int context_id , const char* file_name , int use_checksum ){
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->write_pk_binary(file_name , ( use_checksum == 1 ) ) ;
+    }
+
+    int readPKBinary(int context_id , const char* file_name , int verify_checksum ){
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
+        return ItC->second->read_pk_binary(file_name , ( verify_checksum == 1 ) ) ;
+    }
+
     int writeProof(int context_id , const char* file_name){
         auto ItC = context_list.find(context_id) ;
         if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
@@ -403,6 +543,12 @@ extern "C" {
         return ItC->second->de_serialize_proof_object(json_string) ;
     }
 
+    const char* serializePrimaryInputs(int context_id ){
+        auto ItC = context_list.find(context_id) ;
+        if( ItC == context_list.end()){ ContextIdErr ; return NULL ; }
+        return ItC->second->serialize_primary_inputs() ;
+    }
+
     int serializeFormat(int context_id ,  int format ) {
         auto ItC = context_list.find(context_id) ;
         if( ItC == context_list.end()){ ContextIdErr ; return -1 ; }
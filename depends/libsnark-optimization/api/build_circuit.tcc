@@ -6,6 +6,13 @@ namespace libsnark {
     template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
     int Context<FieldT,ppT_GG,ppT_ROM_SE>::build_circuit(){
         
+        release_prepared_prover();
+
+        if ( is_verifier_context() ){
+            strncpy (last_function_msg , "Error : a verifier context has no circuit to build" , last_function_msg_size ); 
+            return 1 ;
+        }
+
         if ( create_circuit_ftn && !cs_file_path.size() ){
         
             return build_circuit_with_generator();
@@ -42,7 +49,7 @@ namespace libsnark {
         profile.enter_block("Build Circuit" );
 
         profile.enter_block("Create Embedded Circuit" ); 
-        generator = create_circuit_ftn ( circuit_arguments , config ) ; 
+        generator = create_circuit_ftn ( circuit_arguments , circuit_config() ) ; 
         profile.leave_block("Create Embedded Circuit" ); 
 
         if (! generator ){
@@ -52,34 +59,25 @@ namespace libsnark {
             return 1 ;
         }
         
-        pb = gadgetlib2::Protoboard<FieldT>::create( this , gadgetlib2::R1P); 
-
         LOGD("create circuit reader \n");
         embedded_generator_reader = new EmbeddedGeneratorCircuitReader<FieldT>( 
                                         generator, 
-                                        pb , 
+                                        cs , 
                                         & wire_variable_map , 
                                         & wire_variable_map_count , 
                                         & zero_variables_idx , 
                                         & zero_variables_count ,
                                         profile , this );
-        
-        LOGD("get constraint system \n");
-        profile.enter_block("Get ConstraintSystem from Gadgetlib2" ); 
-        get_constraint_system_from_gadgetlib2_2<FieldT> (* pb, cs , false , profile , this ) ; 
-        profile.leave_block("Get ConstraintSystem from Gadgetlib2" ); 
 
-        
-        profile.leave_block("Build Circuit" );
+        evaluation_program = new EvaluationProgram<FieldT>( generator , profile );
             
-        
         full_assignment_size =  getLastVariableIndex() ;
         cs.primary_input_size = embedded_generator_reader->getNumInputs() + embedded_generator_reader->getNumOutputs();
         cs.auxiliary_input_size = full_assignment_size - cs.num_inputs();
+
+        optimize_cs( profile );
         
-        #ifndef DEBUG
-        pb->clear_constraintSystem();
-        #endif 
+        profile.leave_block("Build Circuit" );
 
         LOGD("Evaluate Inputs Done : Full Assignments:%u ,  Primary Inputs:%zu , Auxiliary Inputs:%zu \n", 
                 full_assignment_size , cs.primary_input_size , cs.auxiliary_input_size ) ;
@@ -109,15 +107,23 @@ namespace libsnark {
 
         profile.enter_block("Build Circuit" );
 
-        profile.enter_block("Create Embedded Circuit" ); 
-        generator = create_circuit_ftn ( circuit_arguments , config ) ; 
-        profile.leave_block("Create Embedded Circuit" ); 
+        // an evaluation program read with read_evaluation_program stands in for the generator
+        if ( evaluation_program ){
 
-        if (! generator ){
-            LOGD("BuildCircuit  : Error\n" );
-            print_profile_logs("Build Circuit" , profile );
-            strncpy (last_function_msg , "Error : could not build circuit" , last_function_msg_size ); 
-            return 1 ;
+            LOGD("Evaluation Program     : restored , the circuit generator is not run\n" );
+
+        }else{
+
+            profile.enter_block("Create Embedded Circuit" ); 
+            generator = create_circuit_ftn ( circuit_arguments , circuit_config() ) ; 
+            profile.leave_block("Create Embedded Circuit" ); 
+
+            if (! generator ){
+                LOGD("BuildCircuit  : Error\n" );
+                print_profile_logs("Build Circuit" , profile );
+                strncpy (last_function_msg , "Error : could not build circuit" , last_function_msg_size ); 
+                return 1 ;
+            }
         }
         
         
@@ -126,6 +132,17 @@ namespace libsnark {
             return 1 ;
         }
 
+        if ( ! evaluation_program ){
+            evaluation_program = new EvaluationProgram<FieldT>( generator , profile );
+        }
+
+        for ( uint32_t ix = 0 ; ix < wire_variable_map_count ; ix++ ){
+            if ( wire_variable_map[ix].wire_idx >= evaluation_program->values().size() ){
+                strncpy (last_function_msg , "Error : the constraint system file does not match the evaluation program" , last_function_msg_size ); 
+                return 1 ;
+            }
+        }
+
         
         profile.leave_block("Build Circuit" );
             
@@ -170,10 +187,18 @@ namespace libsnark {
         // extract primary and auxiliary input
         primary_input.clear() ; 
         auxiliary_input.clear() ;
-        const r1cs_variable_assignment<FieldT> full_assignment =
+        r1cs_variable_assignment<FieldT> full_assignment =
             get_variable_assignment_from_gadgetlib2_2<FieldT>(* pb , getLastVariableIndex() );
         cs.primary_input_size = arith_file_reader->getNumInputs() + arith_file_reader->getNumOutputs() ;
         cs.auxiliary_input_size = full_assignment.size() - cs.num_inputs();
+        
+        const std::vector<uint32_t> variable_map = optimize_cs( profile ) ;
+        if ( variable_map.size() ){
+            r1cs_variable_assignment<FieldT> projected ;
+            r1cs_optimizer<FieldT>::project( variable_map , full_assignment , projected );
+            full_assignment.swap( projected );
+        }
+
         primary_input = r1cs_primary_input<FieldT> ( full_assignment.begin(), full_assignment.begin() + cs.num_inputs() );
         auxiliary_input = r1cs_auxiliary_input<FieldT> ( full_assignment.begin() + cs.num_inputs(), full_assignment.end() );
         LOGD("primary_input_size:%zu , auxiliary_input_size:%zu\n", cs.primary_input_size, cs.auxiliary_input_size);
@@ -191,4 +216,65 @@ namespace libsnark {
         return 0 ;
     }
 
-}
\ No newline at end of file
+
+
+    /**
+     * Runs the r1cs_optimizer over the constraint system just built , and moves the wire to variable
+     * map , the zero variables and the reader to the new variable numbering. Returns the variable
+     * map of the optimizer , or an empty one when the pass is disabled.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    std::vector<uint32_t> Context<FieldT,ppT_GG,ppT_ROM_SE>::optimize_cs( libff::profiling & profile ){
+
+        if ( ! optimize_constraint_system ){
+            return std::vector<uint32_t>() ;
+        }
+
+        profile.enter_block("Optimize Constraint System" );
+
+        const size_t num_constraints = cs.num_constraints() ;
+        const size_t num_variables = cs.num_variables() ;
+
+        r1cs_optimizer<FieldT> optimizer ;
+        for ( uint32_t ix = 0 ; ix < zero_variables_count ; ix++ ){
+            optimizer.keep( zero_variables_idx[ix] );
+        }
+        if ( embedded_generator_reader ){
+            embedded_generator_reader->keepVariables( optimizer );
+        }
+
+        const std::vector<uint32_t> variable_map = optimizer.optimize( cs );
+
+        // the map stays sorted by wire
+        uint32_t count = 0 ;
+        for ( uint32_t ix = 0 ; ix < wire_variable_map_count ; ix++ ){
+            const uint32_t variable = variable_map[ wire_variable_map[ix].variable_idx ] ;
+            if ( variable != r1cs_optimizer<FieldT>::removed ){
+                wire_variable_map[count].wire_idx = wire_variable_map[ix].wire_idx ;
+                wire_variable_map[count].variable_idx = variable ;
+                count++ ;
+            }
+        }
+        wire_variable_map_count = count ;
+
+        for ( uint32_t ix = 0 ; ix < zero_variables_count ; ix++ ){
+            zero_variables_idx[ix] = variable_map[ zero_variables_idx[ix] ] ;
+        }
+
+        if ( embedded_generator_reader ){
+            embedded_generator_reader->remapVariables( variable_map );
+        }
+
+        full_assignment_size = cs.num_variables() ;
+
+        LOGD("Optimize Constraint System : Constraints %zu -> %zu , Variables %zu -> %zu \n" ,
+             num_constraints , cs.num_constraints() , num_variables , cs.num_variables() );
+        LOGD("    substituted:%zu , trivial:%zu , duplicates:%zu , unused:%zu \n" ,
+             optimizer.num_substituted , optimizer.num_trivial , optimizer.num_duplicates , optimizer.num_unused );
+
+        profile.leave_block("Optimize Constraint System" );
+
+        return variable_map ;
+    }
+
+}
@@ -9,6 +9,7 @@
 
 #include <libsnark/jsnark_interface/ArithFileCircuitReader.hpp>
 #include <libsnark/jsnark_interface/EmbeddedGeneratorCircuitReader.hpp>
+#include <libsnark/jsnark_interface/EvaluationProgram.hpp>
 
 #include <libsnark/zk_proof_systems/ppzksnark/r1cs_gg_ppzksnark/r1cs_gg_ppzksnark.hpp>
 #include <libsnark/zk_proof_systems/ppzksnark/r1cs_rom_se_ppzksnark/r1cs_rom_se_ppzksnark.hpp>
@@ -36,12 +37,15 @@ namespace libsnark {
         int serialization_format ;
         std::string serialization_buffer ;
         string proof_json_str ;
+        string proofs_json_str ;
+        string primary_inputs_json_str ;
         string vk_json_str ;
 
         ProtoboardPtr<FieldT> pb ;
         r1cs_constraint_system<FieldT> cs ;
         ArithFileCircuitReader<FieldT> * arith_file_reader ;
         EmbeddedGeneratorCircuitReader<FieldT> * embedded_generator_reader ;
+        EvaluationProgram<FieldT> * evaluation_program ;
 
         wire2VariableMap_t* wire_variable_map ;
         uint32_t wire_variable_map_count ;
@@ -53,20 +57,62 @@ namespace libsnark {
         r1cs_primary_input<FieldT> primary_input ;
         r1cs_auxiliary_input<FieldT> auxiliary_input ;
 
+        // why the last evaluate_inputs failed
+        std::string evaluation_error ;
+
         r1cs_keypair * keypair_ROM_SE ;
         r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE> * proof_ROM_SE ;
         
         r1cs_gg_ppzksnark_keypair<ppT_GG> keypair_GG ;
         r1cs_gg_ppzksnark_proof<ppT_GG> proof_GG ;
+        r1cs_gg_ppzksnark_prepared_prover<ppT_GG> * prepared_prover_GG ;
+
+        // fixed-base tables of the proving key, built when the budget is not 0 (bytes)
+        size_t pk_table_memory_budget ;
+        r1cs_gg_ppzksnark_proving_key_tables<ppT_GG> * pk_tables_GG ;
+
+        // basis of the H query of the proving keys made by run_setup
+        r1cs_gg_ppzksnark_H_query_basis setup_H_query_basis ;
+
+        r1cs_gg_ppzksnark_processed_verification_key<ppT_GG> * processed_vk_GG ;
+        r1cs_rom_se_ppzksnark_processed_verification_key<ppT_ROM_SE> * processed_vk_ROM_SE ;
         
         int build_circuit_with_generator();
         int build_circuit_with_arith();
         int build_circuit_with_cs();
 
+        std::vector<uint32_t> optimize_cs( libff::profiling & profile );
+
         int evaluate_inputs( libff::profiling & profile , bool IgnoreFailedAssertion = false );
     
         int read_cs( libff::profiling & profile );
 
+        std::string evaluation_program_tag() const ;
+
+        int prepare_prover( libff::profiling & profile );
+        void release_prepared_prover();
+
+        void prepare_pk_tables( libff::profiling & profile );
+        void release_pk_tables();
+
+        void release_verifier();
+
+        bool read_statement( JsonTree::Node & json_array , 
+                             r1cs_primary_input<FieldT> & statement , 
+                             size_t & invalid_index );
+
+        template<typename ProofTy , typename ppTy >
+        bool read_batch_proofs( JsonTree::Node & proofs_root , std::vector< ProofTy > & proofs );
+
+        int verify_batch( const std::vector< r1cs_primary_input<FieldT> > & primary_inputs ,
+                          JsonTree::Node & proofs_root , 
+                          int* results ,
+                          libff::profiling & profile );
+
+        int prove( const r1cs_primary_input<FieldT> & primary ,
+                   const r1cs_auxiliary_input<FieldT> & auxiliary ,
+                   libff::profiling & profile );
+
     public:
         
         Context(int id, 
@@ -83,7 +129,14 @@ namespace libsnark {
         int build_circuit();
         int run_setup(  );
         int run_proof(  );
+        int run_proof_batch( const char* inputs_json_array , const char** proofs_json_array );
         int run_verify(  );
+        int run_verify_batch( const char* inputs_json_array , const char* proofs_json_array , int* results );
+        int run_verify_batch_with_inputs( const char* primary_inputs_json_array , const char* proofs_json_array , int* results );
+        int run_verify_with_inputs( const char* primary_inputs_json );
+        int create_verifier( const char* vk_file_name );
+        int set_pk_table_memory( size_t memory_budget );
+        int set_coset_H_query( bool enable );
 
         int write_cs( const char* file_name, 
                       bool use_compression , 
@@ -94,11 +147,17 @@ namespace libsnark {
         int write_circuit_to_file( const char* file_name);
         int write_inputs_to_file( const char* file_name);
 
+        int write_evaluation_program( const char* file_name);
+        int read_evaluation_program( const char* file_name);
+
         int write_vk( const char* file_name);
         int read_vk( const char* file_name);
         
         int write_pk( const char* file_name);
         int read_pk( const char* file_name);
+
+        int write_pk_binary( const char* file_name , bool use_checksum );
+        int read_pk_binary( const char* file_name , bool verify_checksum );
         
         int write_proof( const char* file_name);
         int read_proof( const char* file_name);
@@ -111,6 +170,7 @@ namespace libsnark {
 
         const char* serialize_proof_object();
         int de_serialize_proof_object(const char* json_string);
+        const char* serialize_primary_inputs();
         int get_set_serialize_format(int format );
         
     };
@@ -125,6 +185,7 @@ namespace libsnark {
 
 #include <jsnark_interface/ArithFileCircuitReader.tcc>
 #include <jsnark_interface/EmbeddedGeneratorCircuitReader.tcc>
+#include <jsnark_interface/EvaluationProgram.tcc>
 
 #include "context.tcc"
 #include "build_circuit.tcc"
@@ -138,4 +199,5 @@ namespace libsnark {
 
 #include "read_write_cs.tcc"
 #include "read_write.tcc"
+#include "read_write_pk_binary.tcc"
 #include "serialize.tcc"
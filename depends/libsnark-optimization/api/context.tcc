@@ -31,8 +31,15 @@ namespace libsnark {
         zero_variables_count = 0 ;
         arith_file_reader = NULL ;
         embedded_generator_reader  = NULL ;
+        evaluation_program = NULL ;
         keypair_ROM_SE = NULL ;
         proof_ROM_SE = NULL ; 
+        prepared_prover_GG = NULL ;
+        pk_table_memory_budget = 0 ;
+        pk_tables_GG = NULL ;
+        setup_H_query_basis = r1cs_gg_ppzksnark_H_query_monomial ;
+        processed_vk_GG = NULL ;
+        processed_vk_ROM_SE = NULL ;
         inputs_evaluated = false ;
         serialization_format = serializeFormatCRV ;
 
@@ -45,11 +52,15 @@ namespace libsnark {
         auxiliary_input.clear() ;
         if ( arith_file_reader ){ try{ delete arith_file_reader ; }catch(exception e){} }
         if ( embedded_generator_reader ){ try{ delete embedded_generator_reader ; }catch(exception e){} }
+        if ( evaluation_program ){ try{ delete evaluation_program ; }catch( const std::exception &e ){} }
         if ( generator ){ generator->finalize(); try{ delete generator ; }catch(exception e){} }
         if ( wire_variable_map ) { free (wire_variable_map) ; }
         if ( zero_variables_idx ) { free (zero_variables_idx) ; }
         if (keypair_ROM_SE ){ try{ delete keypair_ROM_SE ; }catch(exception e){} }
         if (proof_ROM_SE){ try{ delete proof_ROM_SE ; }catch(exception e){} }
+        release_prepared_prover();
+        release_pk_tables();
+        release_verifier();
     }
 
 }
\ No newline at end of file
@@ -39,6 +39,11 @@ namespace libsnark {
           arith_text_path ( __arith_text_path ) ,
           inputs_text_path ( __inputs_text_path ) ,
           cs_file_path ( __cs_file_path ),
+          generator ( NULL ) ,
+          evaluation_inputs ( NULL ) ,
+          optimize_constraint_system ( __config.optimizeConstraintSystem ) ,
+          memoize_gadgets ( __config.memoizeGadgets ) ,
+          fixed_base_scalar_mul ( __config.fixedBaseScalarMul ) ,
           next_free_gadgetlib2_variable_index ( 0 ) 
     {
         if ( create_circuit_ftn && ! cs_file_path.size() ){
@@ -56,6 +61,58 @@ namespace libsnark {
         return 0;
     }
 
+    int Context_base::set_cs_optimizer( bool enable ){
+
+        clear_last_errmsg();
+
+        if ( is_verifier_context() ){
+            strncpy (last_function_msg , "no circuit to optimize in a verifier context" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        optimize_constraint_system = enable ;
+
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+
+    int Context_base::set_gadget_memoization( bool enable ){
+
+        clear_last_errmsg();
+
+        if ( is_verifier_context() ){
+            strncpy (last_function_msg , "no circuit to build in a verifier context" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        memoize_gadgets = enable ;
+
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+
+    int Context_base::set_fixed_base_scalar_mul( bool enable ){
+
+        clear_last_errmsg();
+
+        if ( is_verifier_context() ){
+            strncpy (last_function_msg , "no circuit to build in a verifier context" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        fixed_base_scalar_mul = enable ;
+
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+
+    Config Context_base::circuit_config() const {
+        Config circuit_config = config ;
+        circuit_config.memoizeGadgets = memoize_gadgets ;
+        circuit_config.fixedBaseScalarMul = fixed_base_scalar_mul ;
+        return circuit_config ;
+    }
+
 
     VarIndex_t Context_base::getNextVariableIndex() {
         return next_free_gadgetlib2_variable_index ++ ;
@@ -10,9 +10,12 @@
 #include <Config.hpp>
 #include <CircuitGenerator.hpp>
 #include <libff/common/profiling.hpp>
+#include <libsnark/jsnark_interface/EvaluationInputs.hpp>
 
 typedef unsigned long VarIndex_t;
 
+namespace JsonTree { class Node ; }
+
 namespace libsnark {
 
     typedef std::map<std::string , std::string> CircuitArguments ;
@@ -34,8 +37,23 @@ namespace libsnark {
         CircuitArguments circuit_arguments ;
         CircuitGenerator * generator ;
 
+        // the primary inputs , when the evaluation program was restored from a file in place of the generator
+        EvaluationInputs * evaluation_inputs ;
+
         bool inputs_evaluated ;
 
+        // run the r1cs_optimizer pass when the circuit is built
+        bool optimize_constraint_system ;
+
+        // reuse the gadgets allocated again over the same inputs when the circuit is built
+        bool memoize_gadgets ;
+
+        // multiply constant elliptic curve base points with precomputed windows when the circuit is built
+        bool fixed_base_scalar_mul ;
+
+        // the config handed to the circuit generator , with the options set on the context
+        Config circuit_config() const ;
+
         static const int last_function_msg_size = 8192 ;
         char last_function_msg [last_function_msg_size] ;
         
@@ -43,6 +61,13 @@ namespace libsnark {
 
         void clear_last_errmsg();
 
+        // a context of createVerifierContext : there is no circuit to build , evaluate or prove
+        bool is_verifier_context() const { return ! create_circuit_ftn && ! arith_text_path.size() ; }
+
+        int check_primary_inputs();
+        int assign_primary_input( const char* input_name , const char * value_str );
+        int assign_primary_input_array( const char* input_name , int array_index, const char * value_str );
+
     public:
  
         Context_base(int id, 
@@ -57,11 +82,21 @@ namespace libsnark {
         virtual ~Context_base() {}
 
         int assign_circuit_argument(const char * arg_key , const char * arg_value );
+        int set_cs_optimizer( bool enable );
+        int set_gadget_memoization( bool enable );
+        int set_fixed_base_scalar_mul( bool enable );
 
         virtual int build_circuit() = 0 ;
         virtual int run_setup(  ) = 0 ;
         virtual int run_proof(  ) = 0 ;
+        virtual int run_proof_batch( const char* inputs_json_array , const char** proofs_json_array ) = 0 ;
         virtual int run_verify(  ) = 0 ;
+        virtual int run_verify_batch( const char* inputs_json_array , const char* proofs_json_array , int* results ) = 0 ;
+        virtual int run_verify_batch_with_inputs( const char* primary_inputs_json_array , const char* proofs_json_array , int* results ) = 0 ;
+        virtual int run_verify_with_inputs( const char* primary_inputs_json ) = 0 ;
+        virtual int create_verifier( const char* vk_file_name ) = 0 ;
+        virtual int set_pk_table_memory( size_t memory_budget ) = 0 ;
+        virtual int set_coset_H_query( bool enable ) = 0 ;
 
         virtual int write_cs( const char* file_name, 
                       bool use_compression , 
@@ -72,11 +107,17 @@ namespace libsnark {
         virtual int write_circuit_to_file( const char* file_name) = 0 ;
         virtual int write_inputs_to_file( const char* file_name) = 0 ;
 
+        virtual int write_evaluation_program( const char* file_name) = 0 ;
+        virtual int read_evaluation_program( const char* file_name) = 0 ;
+
         virtual int write_vk( const char* file_name) = 0 ;
         virtual int read_vk( const char* file_name) = 0 ;
         
         virtual int write_pk( const char* file_name) = 0 ;
         virtual int read_pk( const char* file_name) = 0 ;
+
+        virtual int write_pk_binary( const char* file_name , bool use_checksum ) = 0 ;
+        virtual int read_pk_binary( const char* file_name , bool verify_checksum ) = 0 ;
         
         virtual int write_proof( const char* file_name) = 0 ;
         virtual int read_proof( const char* file_name) = 0 ;
@@ -89,6 +130,7 @@ namespace libsnark {
 
         virtual const char* serialize_proof_object() = 0 ;
         virtual int de_serialize_proof_object(const char* json_string) = 0 ;
+        virtual const char* serialize_primary_inputs() = 0 ;
         virtual int get_set_serialize_format(int format ) = 0 ;
 
 
@@ -99,6 +141,7 @@ namespace libsnark {
         int reset_primary_input_array( const char* input_name , int value );
         int reset_primary_input_array_strValue( const char* input_name , const char * value_str );
         int update_primary_input_from_json(const char* json_str ) ;
+        int update_primary_input_from_json( JsonTree::Node & json_node ) ;
 
         const char* get_last_function_msg();
         
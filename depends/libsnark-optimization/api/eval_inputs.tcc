@@ -12,13 +12,32 @@ namespace libsnark {
 
         profile.enter_block("Generate Auxiliary Inputs" );
         
-        generator->ignore_failed_assertion = IgnoreFailedAssertion ;
+        if ( generator ){
+            generator->ignore_failed_assertion = IgnoreFailedAssertion ;
+        }else{
+            evaluation_program->setIgnoreFailedAssertion( IgnoreFailedAssertion );
+        }
         
-        profile.enter_block("generator->evalCircuit()" );
-        generator->evalCircuit();
-        profile.leave_block("generator->evalCircuit()" );
+        profile.enter_block("evaluation_program->evaluate()" );
+        try {
+            evaluation_program->evaluate( profile );
+        } catch ( const std::exception &e ) {
+            // e.g. an input value the circuit cannot take ; the previous assignment is no longer valid.
+            // The reason goes to evaluation_error , not last_function_msg , as this may run on a witness thread
+            profile.leave_block("evaluation_program->evaluate()" );
+            profile.leave_block("Generate Auxiliary Inputs" );
+            full_assignment.clear() ;
+            primary_input.clear() ;
+            auxiliary_input.clear() ;
+            evaluation_error = e.what() ;
+            return 1 ;
+        }
+        profile.leave_block("evaluation_program->evaluate()" );
         
-        full_assignment.clear();
+        // after an incremental evaluation, only the variables of the changed wires are written again
+        const bool update_only = evaluation_program->isIncremental() && full_assignment.size() == full_assignment_size ;
+
+        if ( ! update_only ) { full_assignment.clear(); }
         primary_input.clear() ; 
         auxiliary_input.clear() ;
 
@@ -27,11 +46,26 @@ namespace libsnark {
 
             profile.enter_block("convert assignments" );
             
-            full_assignment.resize( full_assignment_size , FieldT::zero() );
+            if ( update_only ){
+
+                // the map is sorted by wire
+                wire2VariableMap_t* map_end = wire_variable_map + wire_variable_map_count ;
+                for ( wireID_t wire_idx : evaluation_program->changedWires() ){
+                    const wire2VariableMap_t* w_v_map = std::lower_bound( wire_variable_map , map_end , wire_idx ,
+                        []( const wire2VariableMap_t & m , wireID_t w ){ return static_cast<wireID_t>( m.wire_idx ) < w ; } );
+                    if ( w_v_map != map_end && static_cast<wireID_t>( w_v_map->wire_idx ) == wire_idx ){
+                        full_assignment[ w_v_map->variable_idx ] = evaluation_program->value( wire_idx ) ;
+                    }
+                }
+
+            }else{
+
+                full_assignment.resize( full_assignment_size , FieldT::zero() );
             
-            for( size_t ix = 0 ; ix < wire_variable_map_count ; ix ++ ){
-                const wire2VariableMap_t w_v_map = wire_variable_map[ix] ;
-                full_assignment[ w_v_map.variable_idx ] = convert2FieldT<FieldT>( generator->getCircuitEvaluator()->getAssignment( w_v_map.wire_idx ) ) ;
+                for( size_t ix = 0 ; ix < wire_variable_map_count ; ix ++ ){
+                    const wire2VariableMap_t w_v_map = wire_variable_map[ix] ;
+                    full_assignment[ w_v_map.variable_idx ] = evaluation_program->value( w_v_map.wire_idx ) ;
+                }
             }
 
             profile.leave_block("convert assignments" );
@@ -44,23 +78,21 @@ namespace libsnark {
 
         
             profile.enter_block("reader_2->evaluate_inputs()" );
-            embedded_generator_reader->evaluateInputs( profile );
+            if ( update_only ){
+                embedded_generator_reader->updateInputs( evaluation_program->values() , evaluation_program->changedWires() , full_assignment , profile );
+            }else{
+                full_assignment.resize( full_assignment_size , FieldT::zero() );
+                embedded_generator_reader->evaluateInputs( evaluation_program->values() , full_assignment , profile );
+            }
             profile.leave_block("reader_2->evaluate_inputs()" );
 
 
-            // extract primary and auxiliary input
-            
-            const r1cs_variable_assignment<FieldT> full_assignment =
-                get_variable_assignment_from_gadgetlib2_2(* pb , getLastVariableIndex() );
-            
-            cs.primary_input_size = embedded_generator_reader->getNumInputs() + embedded_generator_reader->getNumOutputs();
-            cs.auxiliary_input_size = full_assignment.size() - cs.num_inputs();
+            // extract primary and auxiliary input ; the sizes of cs were set when building or reading it , and
+            // are not written here , as this may run while another thread proves with cs
             
             primary_input = r1cs_primary_input<FieldT> ( full_assignment.begin(), full_assignment.begin() + cs.num_inputs() );
             auxiliary_input = r1cs_auxiliary_input<FieldT> ( full_assignment.begin() + cs.num_inputs(), full_assignment.end() );
 
-            pb->clear_value_mapping();    
-
             LOGD("Evaluate Inputs Done : Full Assignments:%zu ,  Primary Inputs:%zu , Auxiliary Inputs:%zu \n", 
                  full_assignment.size() , cs.primary_input_size, cs.auxiliary_input_size ) ;
 
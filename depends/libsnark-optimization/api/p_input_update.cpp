@@ -1,6 +1,8 @@
 
 
 
+#include <cstring>
+
 #include "context_base.hpp" 
 #include <json_tree.hpp>
 
@@ -14,8 +16,10 @@ namespace libsnark {
     int Context_base::update_primary_input(const char* input_name , int value ){
         
         clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
         
-        int ret_val = generator->update_primary_input( input_name, value);
+        int ret_val = generator ? generator->update_primary_input( input_name, value)
+                                : evaluation_inputs->update_primary_input( input_name, value);
         
         if(ret_val == 0 ){ inputs_evaluated = false ; }
 
@@ -26,20 +30,19 @@ namespace libsnark {
     int Context_base::update_primary_input_strValue(const char* input_name , const char * value_str ){
         
         clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
 
-        int ret_val = generator->update_primary_input( input_name, value_str );
-        
-        if(ret_val == 0 ){ inputs_evaluated = false ; }
-
-        return ret_val ;
+        return assign_primary_input( input_name, value_str );
     }
 
 
     int Context_base::update_primary_input_array(const char* input_name , int array_index, int value ){
         
         clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
 
-        int ret_val = generator->update_primary_input_array( input_name , array_index, value );
+        int ret_val = generator ? generator->update_primary_input_array( input_name , array_index, value )
+                                : evaluation_inputs->update_primary_input_array( input_name , array_index, value );
         
         if(ret_val == 0 ){ inputs_evaluated = false ; }
 
@@ -50,8 +53,19 @@ namespace libsnark {
     int Context_base::update_primary_input_array_strValue(const char* input_name , int array_index, const char * value_str ){
         
         clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
+
+        return assign_primary_input_array( input_name , array_index, value_str );
+    }
+
+
+    int Context_base::reset_primary_input_array(const char* input_name , int value ){
+        
+        clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
 
-        int ret_val = generator->update_primary_input_array( input_name , array_index, value_str );
+        int ret_val = generator ? generator->reset_primary_input_array( input_name , value )
+                                : evaluation_inputs->reset_primary_input_array( input_name , value );
         
         if(ret_val == 0 ){ inputs_evaluated = false ; }
 
@@ -59,11 +73,13 @@ namespace libsnark {
     }
 
 
-    int Context_base::reset_primary_input_array(const char* input_name , int value ){
+    int Context_base::reset_primary_input_array_strValue(const char* input_name , const char * value_str ){
         
         clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
 
-        int ret_val = generator->reset_primary_input_array( input_name , value );
+        int ret_val = generator ? generator->reset_primary_input_array( input_name, value_str )
+                                : evaluation_inputs->reset_primary_input_array( input_name, value_str );
         
         if(ret_val == 0 ){ inputs_evaluated = false ; }
 
@@ -71,26 +87,77 @@ namespace libsnark {
     }
 
 
-    int Context_base::reset_primary_input_array_strValue(const char* input_name , const char * value_str ){
+    //
+    // the primary inputs are held by the generator , or by the inputs of a restored evaluation program.
+    // With neither , 1 and the reason in last_function_msg
+    //
+    int Context_base::check_primary_inputs(){
+
+        if ( generator || evaluation_inputs ){ return 0 ; }
+
+        if ( is_verifier_context() ){
+            strncpy (last_function_msg , "no circuit in a verifier context : use runVerifyWithInputs" , last_function_msg_size ); 
+        }else if ( ! create_circuit_ftn ){
+            strncpy (last_function_msg , "Error : the primary inputs of an arith file circuit are read from its inputs file" , last_function_msg_size ); 
+        }else{
+            strncpy (last_function_msg , "Error : the circuit is not built" , last_function_msg_size ); 
+        }
+
+        return 1 ;
+    }
+
+
+    //
+    // as update_primary_input_strValue / update_primary_input_array_strValue , without touching
+    // last_function_msg : run_proof_batch calls them from its witness thread while a proof runs
+    //
+    int Context_base::assign_primary_input(const char* input_name , const char * value_str ){
+
+        if ( ! generator && ! evaluation_inputs ){ return 1 ; }
+
+        int ret_val = generator ? generator->update_primary_input( input_name, value_str )
+                                : evaluation_inputs->update_primary_input( input_name, value_str );
         
-        clear_last_errmsg();
+        if(ret_val == 0 ){ inputs_evaluated = false ; }
+
+        return ret_val ;
+    }
+
 
-        int ret_val = generator->reset_primary_input_array( input_name, value_str );
+    int Context_base::assign_primary_input_array(const char* input_name , int array_index, const char * value_str ){
+
+        if ( ! generator && ! evaluation_inputs ){ return 1 ; }
+
+        int ret_val = generator ? generator->update_primary_input_array( input_name , array_index, value_str )
+                                : evaluation_inputs->update_primary_input_array( input_name , array_index, value_str );
         
         if(ret_val == 0 ){ inputs_evaluated = false ; }
 
         return ret_val ;
     }
 
+
     int Context_base::update_primary_input_from_json(const char* json_str ) {
         
+        clear_last_errmsg();
+        if ( check_primary_inputs() != 0 ){ return 1 ; }
+
         JsonTree::Root json_root(json_str) ;
 
+        return update_primary_input_from_json( json_root ) ;
+    }
+
+    int Context_base::update_primary_input_from_json( JsonTree::Node & json_root ) {
+
         LOGD("\nUpdate primary inputs from json : \n" ); 
         // LOGD("----------------------------------------------------------------------\n");
         // LOGD("%s\n" , json_root.get_json().c_str() ) ; 
         // LOGD("----------------------------------------------------------------------\n\n");
 
+        if ( ! generator && ! evaluation_inputs ){ return 1 ; }
+
+        // a name the circuit does not have is skipped , as the objects may carry other fields ;
+        // an array index out of range stops the update and is returned
 
         for ( size_t iNode = 0 ; iNode < json_root.size() ; iNode++  ){
             
@@ -98,19 +165,22 @@ namespace libsnark {
 
             if( N.is_string() ){
                 
-                update_primary_input_strValue( N.get_key().c_str() , N.get_string_c() );
+                const int ret_val = assign_primary_input( N.get_key().c_str() , N.get_string_c() );
+                if ( ret_val > 1 ){ return ret_val ; }
             
             }else if ( N.is_array() ){
             
                 for ( size_t ix = 0 ; ix < N.size() ; ix++ ){
-                    update_primary_input_array_strValue( N.get_key().c_str() , (int)ix , N[ix].get_string_c() );
+                    const int ret_val = assign_primary_input_array( N.get_key().c_str() , (int)ix , N[ix].get_string_c() );
+                    if ( ret_val > 1 ){ return ret_val ; }
                 }
             
             }else if (N.is_object()){
                 
                 for ( size_t ix = 0 ; ix < N.size() ; ix++ ){
                     int array_index = std::atoi( N[ix].get_key().c_str() );
-                    update_primary_input_array_strValue( N.get_key().c_str() , array_index , N[ix].get_string_c() );
+                    const int ret_val = assign_primary_input_array( N.get_key().c_str() , array_index , N[ix].get_string_c() );
+                    if ( ret_val > 1 ){ return ret_val ; }
                 }
 
             }
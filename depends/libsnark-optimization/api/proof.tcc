@@ -1,5 +1,13 @@
 
 
+#include <functional>
+#include <thread>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <json_tree.hpp>
 #include <logging.hpp>
 
 namespace libsnark {
@@ -7,23 +15,202 @@ namespace libsnark {
     template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
     int Context<FieldT,ppT_GG,ppT_ROM_SE>::run_proof ( ) {
         
-        const bool test_serialization = false;
-        
         LOGD("\n\n" );
         LOGD("Run Proof     :\n" );
         LOGD("Context_ID    : %d\n", id );
 
+        if ( is_verifier_context() ) {
+            strncpy (last_function_msg , "no circuit to prove in a verifier context" , last_function_msg_size ); 
+            return 1 ;
+        }
+
         libff::profiling profile ;
         
-        evaluate_inputs( profile ); 
+        if ( evaluate_inputs( profile ) != 0 ) {
+            snprintf (last_function_msg , last_function_msg_size , "evaluation of the inputs failed : %s" , evaluation_error.c_str() ); 
+            return 1 ;
+        }
 
-        r1cs_example<FieldT> example(cs, primary_input, auxiliary_input);
-        
         profile.enter_block("Proof" ); 
 
+        if ( prove( primary_input , auxiliary_input , profile ) != 0 ) {
+            profile.leave_block("Proof" ); 
+            return 1 ;
+        }
+
+        profile.leave_block("Proof" ); 
+        
+        LOGD("Run Proof     : Done\n" );
+
+        print_profile_logs("Run Proof" , profile );
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0;
+    }
+
+
+    /*
+     * Prove every item of a JSON array of primary input objects (each in the format
+     * of updatePrimaryInputFromJson) with the same keys and prepared prover. When the
+     * circuit is evaluated with the generator, the witness of item i+1 is generated
+     * on its own thread while item i is being proven.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::run_proof_batch ( const char* inputs_json_array , const char** proofs_json_array ) {
+
+        LOGD("\n\n" );
+        LOGD("Run Proof Batch :\n" );
+        LOGD("Context_ID      : %d\n", id );
+
+        clear_last_errmsg();
+
+        proofs_json_str = "[]" ;
+        if ( proofs_json_array ) { *proofs_json_array = proofs_json_str.c_str() ; }
+
+        if ( is_verifier_context() ) {
+            strncpy (last_function_msg , "no circuit to prove in a verifier context" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        if ( ! inputs_json_array ) {
+            strncpy (last_function_msg , "no inputs json array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        JsonTree::Root json_root( inputs_json_array ) ;
+        
+        if ( ! json_root.is_array() ) {
+            strncpy (last_function_msg , "inputs json is not an array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        const size_t batch_size = json_root.size() ;
+
+        LOGD("Batch Size      : %zu\n", batch_size );
+
+        libff::profiling profile ;
+        
+        profile.enter_block("Proof Batch" ); 
+
+        if ( proof_system == R1CS_GG && ! prepared_prover_GG ) { prepare_prover( profile ); }
+
+        // the generator is only touched by the witness generation, which writes the context's witness
+        // buffers and never cs , making it safe to overlap with a proof of the swapped-out item buffers
+        const bool overlap_witness_generation = ( evaluate_with == Generator ) ;
+
+        r1cs_primary_input<FieldT> item_primary_input ;
+        r1cs_auxiliary_input<FieldT> item_auxiliary_input ;
+
+        // the witness of an item, into primary_input / auxiliary_input. It may run on its own thread , so
+        // an error is kept in witness_error rather than in last_function_msg , and nothing is thrown
+        int witness_retval = 0 ;
+        std::string witness_error ;
+        auto generate_witness = [ this , &json_root , &witness_retval , &witness_error ]( size_t item , libff::profiling & witness_profile ) {
+            try {
+                witness_retval = update_primary_input_from_json( json_root[item] );
+                if ( witness_retval != 0 ) {
+                    witness_error = "primary input array index out of range" ;
+                    return ;
+                }
+                inputs_evaluated = false ;
+                witness_retval = evaluate_inputs( witness_profile );
+                if ( witness_retval != 0 ) { witness_error = "evaluation of the inputs failed : " + evaluation_error ; }
+            } catch ( const std::exception & e ) {
+                witness_retval = 1 ;
+                witness_error = e.what() ;
+            } catch ( ... ) {
+                witness_retval = 1 ;
+                witness_error = "could not evaluate the inputs" ;
+            }
+        };
+
+        auto witness_failed = [ this , &witness_retval , &witness_error , &profile ]( size_t item ) {
+            snprintf (last_function_msg , last_function_msg_size , "input item #%zu : %s" , item , witness_error.c_str() ); 
+            profile.leave_block("Proof Batch" ); 
+            return witness_retval ;
+        };
+
+        std::string proofs = "[" ;
+        
+        if ( batch_size > 0 ) {
+            generate_witness( 0 , profile );
+            if ( witness_retval != 0 ) { return witness_failed( 0 ); }
+        }
+
+        for ( size_t ix = 0 ; ix < batch_size ; ix++ ){
+
+            // generate_witness writes the next witness into primary_input / auxiliary_input
+            item_primary_input.swap( primary_input );
+            item_auxiliary_input.swap( auxiliary_input );
+
+            libff::profiling witness_profile ;
+
+            std::thread witness_thread ;
+            if ( ix + 1 < batch_size && overlap_witness_generation ) {
+                witness_thread = std::thread( generate_witness , ix + 1 , std::ref( witness_profile ) );
+            }
+
+#ifdef MULTICORE
+            // leave the witness thread a core
+            const int num_threads = omp_get_max_threads();
+            if ( witness_thread.joinable() && num_threads > 1 ) { omp_set_num_threads( num_threads - 1 ); }
+#endif
+
+            const int prove_retval = prove( item_primary_input , item_auxiliary_input , profile );
+
+#ifdef MULTICORE
+            omp_set_num_threads( num_threads );
+#endif
+
+            if ( witness_thread.joinable() ) {
+                witness_thread.join();
+            } else if ( ix + 1 < batch_size && prove_retval == 0 ) {
+                generate_witness( ix + 1 , witness_profile );
+            }
+
+            if ( prove_retval != 0 ) {
+                profile.leave_block("Proof Batch" ); 
+                return 1 ;
+            }
+
+            if ( ix + 1 < batch_size && witness_retval != 0 ) { return witness_failed( ix + 1 ); }
+
+            if ( ix > 0 ) { proofs += "," ; }
+            proofs += serialize_proof_object() ;
+        }
+
+        proofs += "]" ;
+
+        // keep the last item as the current witness, as after runProof
+        if ( batch_size > 0 ) {
+            primary_input.swap( item_primary_input );
+            auxiliary_input.swap( item_auxiliary_input );
+        }
+
+        profile.leave_block("Proof Batch" ); 
+
+        proofs_json_str = proofs ;
+        if ( proofs_json_array ) { *proofs_json_array = proofs_json_str.c_str() ; }
+        
+        LOGD("Run Proof Batch : Done\n" );
+
+        print_profile_logs("Run Proof Batch" , profile );
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::prove ( const r1cs_primary_input<FieldT> & primary ,
+                                                   const r1cs_auxiliary_input<FieldT> & auxiliary ,
+                                                   libff::profiling & profile ) {
+        
+        const bool test_serialization = false;
+
         switch(proof_system){
             
             case R1CS_ROM_SE :
+            {
+                r1cs_example<FieldT> example(cs, primary, auxiliary);
 
                 if ( proof_ROM_SE ) { try { delete proof_ROM_SE ; } catch( exception e){} }
                 
@@ -34,29 +221,139 @@ namespace libsnark {
                             & proof_ROM_SE ,
                             profile );
                 break ;
+            }
             
             case R1CS_GG :
             default :
 
-                libsnark::run_r1cs_gg_ppzksnark<ppT_GG>(
-                            example, 
-                            test_serialization, 
+                if ( ! prepared_prover_GG ) { prepare_prover( profile ); }
+
+                if ( libsnark::run_r1cs_gg_ppzksnark<ppT_GG>(
+                            * prepared_prover_GG , 
+                            primary , 
+                            auxiliary , 
                             keypair_GG , 
                             proof_GG ,
-                            profile);
+                            profile) != 0 ) {
+                    strncpy (last_function_msg , "proof key does not match the circuit or its H query basis" , last_function_msg_size ); 
+                    return 1 ;
+                }
                 break;
         }
 
-        profile.leave_block("Proof" ); 
-        
-        LOGD("Run Proof     : Done\n" );
+        return 0 ;
+    }
 
-        print_profile_logs("Run Proof" , profile );
+
+    /*
+     * Build the per-circuit state of the GG prover (swapped constraint system, QAP domain
+     * and its tables) so that run_proof only does per-witness work. Called after setup
+     * and after loading a proving key; run_proof falls back to it if neither happened.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::prepare_prover ( libff::profiling & profile ) {
+
+        release_prepared_prover();
+
+        // nothing to prepare until the circuit is built
+        if ( proof_system != R1CS_GG || cs.num_constraints() == 0 ) { return 0 ; }
+
+        profile.enter_block("Prepare prover" ); 
+        prepared_prover_GG = new r1cs_gg_ppzksnark_prepared_prover<ppT_GG>( cs , profile );
+        profile.leave_block("Prepare prover" ); 
+
+        prepare_pk_tables( profile );
+
+        return 0 ;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    void Context<FieldT,ppT_GG,ppT_ROM_SE>::release_prepared_prover () {
+        if ( prepared_prover_GG ) { try { delete prepared_prover_GG ; } catch( const std::exception &e ){} }
+        prepared_prover_GG = NULL ;
+    }
+
+
+    /*
+     * Build the fixed-base tables of the proving key within the memory budget, unless they
+     * exist (built before, or read with the proving key), and hand them to the prepared prover.
+     * They only depend on the proving key : whoever replaces it releases them first.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    void Context<FieldT,ppT_GG,ppT_ROM_SE>::prepare_pk_tables ( libff::profiling & profile ) {
+
+        if ( proof_system != R1CS_GG || pk_table_memory_budget == 0 ) { return ; }
+
+        if ( ! pk_tables_GG ) {
+#ifdef MULTICORE
+            const size_t num_threads = omp_get_max_threads();
+#else
+            const size_t num_threads = 1 ;
+#endif
+            profile.enter_block("Prepare proving key tables" ); 
+            pk_tables_GG = new r1cs_gg_ppzksnark_proving_key_tables<ppT_GG>( keypair_GG.pk , pk_table_memory_budget , num_threads , profile );
+            profile.leave_block("Prepare proving key tables" ); 
+        }
+
+        if ( prepared_prover_GG ) { prepared_prover_GG->tables = pk_tables_GG ; }
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    void Context<FieldT,ppT_GG,ppT_ROM_SE>::release_pk_tables () {
+        if ( prepared_prover_GG ) { prepared_prover_GG->tables = NULL ; }
+        if ( pk_tables_GG ) { try { delete pk_tables_GG ; } catch( const std::exception &e ){} }
+        pk_tables_GG = NULL ;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::set_pk_table_memory ( size_t memory_budget ) {
+
+        LOGD("\n\n" );
+        LOGD("Set PK Table Memory :\n" );
+        LOGD("Context_ID          : %d\n", id );
+        LOGD("Memory Budget       : %zu\n", memory_budget );
+
+        clear_last_errmsg();
+
+        if ( proof_system != R1CS_GG ) {
+            strncpy (last_function_msg , "proving key tables are only supported for R1CS_GG" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        pk_table_memory_budget = memory_budget ;
+        release_pk_tables();
+
+        libff::profiling profile ;
+        prepare_pk_tables( profile );
+
+        print_profile_logs("Set PK Table Memory" , profile );
         strncpy (last_function_msg , "success" , last_function_msg_size ); 
-        return 0;
+        return 0 ;
     }
-    
-}
 
 
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::set_coset_H_query ( bool enable ) {
+
+        LOGD("\n\n" );
+        LOGD("Set Coset H Query :\n" );
+        LOGD("Context_ID        : %d\n", id );
+        LOGD("Enable            : %d\n", enable );
+
+        clear_last_errmsg();
+
+        if ( proof_system != R1CS_GG ) {
+            strncpy (last_function_msg , "coset H query is only supported for R1CS_GG" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        setup_H_query_basis = enable ? r1cs_gg_ppzksnark_H_query_coset_lagrange : r1cs_gg_ppzksnark_H_query_monomial ;
 
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+    
+}
@@ -35,25 +35,54 @@ namespace libsnark {
         LOGD("  ");
         std::ifstream crs_vk_infile(file_name, ios::in);
 
+        if ( ! crs_vk_infile.good() ){
+            snprintf (last_function_msg , last_function_msg_size , "Error : could not open verify key file [%s]" , file_name ); 
+            return 1 ;
+        }
+
+        release_verifier();
+
+        // the key is read aside , so that a file that does not hold one leaves the loaded key as it was
+        bool read_failed = false ;
+
         if(proof_system == R1CS_ROM_SE ) {
                         
-            if ( keypair_ROM_SE ) { try { delete keypair_ROM_SE ; } catch( exception e){} }
-            keypair_ROM_SE = new r1cs_rom_se_ppzksnark_keypair<ppT_ROM_SE>();
-            keypair_ROM_SE->read_vk(crs_vk_infile);
-            LOGD("\n");
-            keypair_ROM_SE->print_vk_size();
+            r1cs_rom_se_ppzksnark_keypair<ppT_ROM_SE> * read_keypair = new r1cs_rom_se_ppzksnark_keypair<ppT_ROM_SE>();
+            try { read_keypair->read_vk(crs_vk_infile); } catch( std::exception & e ){ read_failed = true ; }
+            read_failed = read_failed || crs_vk_infile.fail() ;
+
+            if ( read_failed ){
+                delete read_keypair ;
+            }else{
+                if ( keypair_ROM_SE ) { try { delete keypair_ROM_SE ; } catch( const std::exception &e ){} }
+                keypair_ROM_SE = read_keypair ;
+                LOGD("\n");
+                read_keypair->print_vk_size();
+            }
             
         }else if (proof_system == R1CS_GG ) { 
             
-            keypair_GG.read_vk(crs_vk_infile);
-            LOGD("\n");
-            keypair_GG.print_vk_size();
+            r1cs_gg_ppzksnark_keypair<ppT_GG> read_keypair ;
+            try { read_keypair.read_vk(crs_vk_infile); } catch( std::exception & e ){ read_failed = true ; }
+            read_failed = read_failed || crs_vk_infile.fail() ;
+
+            if ( ! read_failed ){
+                keypair_GG.vk = std::move( read_keypair.vk );
+                LOGD("\n");
+                keypair_GG.print_vk_size();
+            }
             
         }
 
         crs_vk_infile.close();
         LOGD("End of Reading Verify Key from file\n");
+
+        if ( read_failed ){
+            snprintf (last_function_msg , last_function_msg_size , "Error : the file [%s] does not hold a verify key" , file_name ); 
+            return 1 ;
+        }
     
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
         return 0 ;
     }
 
@@ -96,6 +125,10 @@ namespace libsnark {
             keypair_GG.read_pk(crs_pk_infile);
             LOGD("\n");
             keypair_GG.print_pk_size();
+
+            libff::profiling profile ;
+            release_pk_tables();
+            prepare_prover( profile );
             
         }
         
@@ -155,6 +188,11 @@ namespace libsnark {
         LOGD("Write Circuit to file\n");
         LOGD(" Circuit File : [%s]\n" , file_name);
         
+        if ( ! generator ){
+            strncpy (last_function_msg , "Error : no circuit generator , the circuit was restored from an evaluation program" , last_function_msg_size ); 
+            return 1 ;
+        }
+
         std::ofstream outfile( file_name , ios::trunc | ios::out);
         generator->printCircuit(outfile);
         outfile.close();
@@ -170,6 +208,11 @@ namespace libsnark {
         LOGD("Write Inputs to file\n");
         LOGD(" Inputs File : [%s]\n" , file_name);
         
+        if ( ! generator ){
+            strncpy (last_function_msg , "Error : no circuit generator , the circuit was restored from an evaluation program" , last_function_msg_size ); 
+            return 1 ;
+        }
+
         generator->ignore_failed_assertion = false  ;
         generator->evalCircuit();
         std::ofstream outfile(file_name, ios::trunc | ios::out);
@@ -180,6 +223,88 @@ namespace libsnark {
         return 0 ;
     }
 
+
+    /**
+     * The circuit name and arguments : a snapshot of the evaluation program is only valid for the
+     * circuit built with the same ones.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE > 
+    std::string Context<FieldT,ppT_GG,ppT_ROM_SE>::evaluation_program_tag() const {
+        std::string tag = circuit_name ;
+        for ( auto Itr : circuit_arguments ){
+            tag += "\n" + Itr.first + "=" + Itr.second ;
+        }
+        return tag ;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE > 
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::write_evaluation_program(const char* file_name){
+
+        LOGD("Write Evaluation Program to file\n");
+        LOGD(" Program File : [%s]\n" , file_name);
+
+        if ( ! evaluation_program ){
+            strncpy (last_function_msg , "Error : no evaluation program , build the circuit first" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        std::ofstream outfile( file_name , ios::trunc | ios::out | ios::binary );
+        const bool saved = outfile.good() && evaluation_program->save( outfile , evaluation_program_tag() ) ;
+        outfile.close();
+
+        if ( ! saved ){
+            strncpy (last_function_msg , "Error : could not write the evaluation program ( a prover hint without a native routine ? )" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+
+
+    /**
+     * Loads a snapshot of the evaluation program , for build_circuit_with_cs to use in place of the
+     * circuit generator. The circuit arguments must be assigned before.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE > 
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::read_evaluation_program(const char* file_name){
+
+        LOGD("Read Evaluation Program from file\n");
+        LOGD(" Program File : [%s]\n" , file_name);
+
+        if ( ! cs_file_path.size() ){
+            strncpy (last_function_msg , "Error : an evaluation program is only used with a constraint system file" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        if ( generator || evaluation_program ){
+            strncpy (last_function_msg , "Error : the circuit is already built" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        std::ifstream infile( file_name , ios::in | ios::binary );
+        if ( ! infile.good() ){
+            snprintf (last_function_msg , last_function_msg_size , "Error : could not open evaluation program file [%s]" , file_name ); 
+            return 1 ;
+        }
+
+        libff::profiling profile ;
+        evaluation_program = EvaluationProgram<FieldT>::load( infile , evaluation_program_tag() , profile );
+        infile.close();
+
+        if ( ! evaluation_program ){
+            strncpy (last_function_msg , "Error : the file does not hold an evaluation program of this circuit" , last_function_msg_size ); 
+            return 2 ;
+        }
+
+        evaluation_inputs = evaluation_program->inputs() ;
+
+        print_profile_logs("Read Evaluation Program" , profile );
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+
 }
 
  
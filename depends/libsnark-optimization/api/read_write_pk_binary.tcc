@@ -0,0 +1,559 @@
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include "json_tree.hpp"
+#include <Keccak256.hpp>
+#include <misc.hpp>
+
+#include <logging.hpp>
+
+
+/*
+ *  Binary proving key file (R1CS_GG only)
+ *
+ *  [ 0 , 4096 )    : file info, a null terminated json object (format, version, curve,
+ *                    point sizes, query sizes, H_query basis, section offsets and the
+ *                    optional checksum). A missing H_query basis is the monomial basis.
+ *  [ 4096 , ... )  : sections, each one starting at a page boundary
+ *                      - alpha_g1, beta_g1, delta_g1, beta_g2, delta_g2
+ *                      - A_query
+ *                      - B_query indices (uint64) , G2 values , G1 values
+ *                      - H_query
+ *                      - L_query
+ *                      - optionally, the levels of the proving key tables of A_query,
+ *                        B_query G2 values, B_query G1 values, H_query and L_query
+ *                        (see setPKTableMemory), level after level
+ *
+ *  Points are stored in affine coordinates, as the raw Montgomery limbs of x then y,
+ *  and the point at infinity as all zero bytes (never a point of the curves in use).
+ *  Loading a section is a plain copy of the limbs, with no parsing and no square roots,
+ *  and leaves the points with Z = 1, i.e. ready for mixed additions. The table levels
+ *  are copied as they are, as the tables keep the same affine coordinates in memory.
+ */
+
+namespace libsnark {
+
+    const size_t pk_binary_page_size = 4096 ;
+    const char * const pk_binary_format = "R1CS_GG Proving Key" ;
+    const uint64_t pk_binary_version = 1 ;
+
+    // points converted to affine at a time when writing
+    const size_t pk_binary_write_chunk = 1 << 16 ;
+
+
+    template<typename T>
+    size_t affine_point_size() {
+        return 2 * sizeof( decltype(T::X) ) ;
+    }
+
+
+    inline void write_padding_to_page( std::ostream &out ){
+        static const char zeros[pk_binary_page_size] = { 0 } ;
+        const uint64_t pos = static_cast<uint64_t>( out.tellp() ) ;
+        const uint64_t padding = ( pk_binary_page_size - ( pos % pk_binary_page_size ) ) % pk_binary_page_size ;
+        out.write( zeros , padding ) ;
+    }
+
+
+    template<typename T>
+    void write_affine_points( std::ostream &out , typename std::vector<T>::const_iterator begin , typename std::vector<T>::const_iterator end ){
+
+        const size_t coord_size = sizeof( decltype(T::X) ) ;
+        const std::vector<char> zero_point( 2 * coord_size , 0 ) ;
+
+        while ( begin != end ){
+
+            const size_t n = std::min<size_t>( end - begin , pk_binary_write_chunk ) ;
+            std::vector<T> chunk( begin , begin + n ) ;
+            libff::batch_to_special<T>( chunk ) ;
+
+            for ( const T & p : chunk ){
+                if ( p.is_zero() ){
+                    out.write( zero_point.data() , zero_point.size() ) ;
+                }else{
+                    out.write( (const char*) & p.X , coord_size ) ;
+                    out.write( (const char*) & p.Y , coord_size ) ;
+                }
+            }
+
+            begin += n ;
+        }
+    }
+
+
+    template<typename T>
+    void read_affine_points( const char * data , size_t count , std::vector<T> & points ){
+
+        typedef decltype(T::X) coord_t ;
+        const size_t coord_size = sizeof( coord_t ) ;
+        const coord_t one = coord_t::one() ;
+        const T zero = T::zero() ;
+
+        points.resize( count ) ;
+
+#ifdef MULTICORE
+        #pragma omp parallel for
+#endif
+        for ( size_t i = 0 ; i < count ; i++ ){
+
+            const char * p = data + i * 2 * coord_size ;
+
+            bool is_zero = true ;
+            for ( size_t b = 0 ; b < 2 * coord_size && is_zero ; b++ ){ is_zero = ( p[b] == 0 ) ; }
+
+            if ( is_zero ){
+                points[i] = zero ;
+            }else{
+                coord_t X , Y ;
+                memcpy( (char*) & X , p , coord_size ) ;
+                memcpy( (char*) & Y , p + coord_size , coord_size ) ;
+                points[i] = T( X , Y , one ) ;
+            }
+        }
+    }
+
+
+    template<typename T>
+    void write_table_section( std::ostream &out , JsonTree::Node &file_meta , const std::string &name , const libff::multi_exp_base_table<T> &table ){
+        file_meta[name + " Table Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        file_meta[name + " Table Window"] << static_cast<uint64_t>( table.window ) ;
+        file_meta[name + " Table Levels"] << static_cast<uint64_t>( table.num_levels ) ;
+        // the coordinates are already affine , and zero for the point at infinity
+        out.write( (const char*) table.coords.data() , table.coords.size() * sizeof( table.coords[0] ) ) ;
+        write_padding_to_page( out ) ;
+    }
+
+
+    // a + b and a * b , UINT64_MAX when they do not fit in 64 bits
+    inline uint64_t pk_binary_saturating_add( uint64_t a , uint64_t b ){
+        return ( a > UINT64_MAX - b ) ? UINT64_MAX : a + b ;
+    }
+
+    inline uint64_t pk_binary_saturating_mul( uint64_t a , uint64_t b ){
+        return ( b > 0 && a > UINT64_MAX / b ) ? UINT64_MAX : a * b ;
+    }
+
+
+    // the number of points of a table section , 0 if the file has none , UINT64_MAX if it does not fit in 64 bits
+    inline uint64_t table_section_points( JsonTree::Node &file_meta , const std::string &name , uint64_t num_bases ){
+        return pk_binary_saturating_mul( num_bases , file_meta[name + " Table Levels"].get_uint() ) ;
+    }
+
+
+    // whether the window and levels of a table section are those of a table of the given stride for scalars of num_bits bits
+    template<typename T>
+    bool table_section_valid( JsonTree::Node &file_meta , const std::string &name , uint64_t stride , size_t num_bits ){
+        const uint64_t window = file_meta[name + " Table Window"].get_uint() ;
+        if ( window < 2 || window > libff::multi_exp_table_max_window ){ return false ; }
+        return file_meta[name + " Table Levels"].get_uint() == libff::multi_exp_base_table<T>::levels( window , stride , num_bits ) ;
+    }
+
+
+    // whether the indices of a sparse query are increasing and below its domain size
+    inline bool pk_binary_indices_valid( const uint64_t * indices , uint64_t count , uint64_t domain_size ){
+        for ( uint64_t i = 0 ; i < count ; i++ ){
+            if ( indices[i] >= domain_size || ( i > 0 && indices[i] <= indices[i-1] ) ){ return false ; }
+        }
+        return true ;
+    }
+
+
+    // whether count items of item_size bytes at offset lie within the file , written so that nothing overflows
+    inline bool pk_binary_section_fits( uint64_t file_size , uint64_t offset , uint64_t count , uint64_t item_size ){
+        if ( item_size > 0 && count > file_size / item_size ){ return false ; }
+        const uint64_t size = count * item_size ;
+        return ! ( size > file_size || offset > file_size - size ) ;
+    }
+
+
+    // a section checked by table_section_valid and pk_binary_section_fits
+    template<typename T>
+    void read_table_section( const char * data , JsonTree::Node &file_meta , const std::string &name ,
+                             uint64_t num_bases , uint64_t stride , libff::multi_exp_base_table<T> &table ){
+        table.window = file_meta[name + " Table Window"].get_uint() ;
+        table.stride = stride ;
+        table.num_bases = num_bases ;
+        table.num_levels = file_meta[name + " Table Levels"].get_uint() ;
+        table.coords.resize( 2 * num_bases * table.num_levels ) ;
+        memcpy( (char*) table.coords.data() , data + file_meta[name + " Table Offset"].get_uint() , table.coords.size() * sizeof( table.coords[0] ) ) ;
+    }
+
+
+    inline std::string pk_binary_checksum( const uint8_t * data , uint64_t data_size ){
+        std::vector<uint8_t> hash_bytes = Hashes::keccak256( (uint8_t*) data , static_cast<size_t>(data_size) ) ;
+        return MISC::byteArrayToHexString( hash_bytes ) ;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::write_pk_binary( const char* file_name , bool use_checksum ){
+
+        typedef libff::G1<ppT_GG> G1 ;
+        typedef libff::G2<ppT_GG> G2 ;
+
+        LOGD("Write Proof Key to binary file\n");
+        LOGD("  File : [%s]\n" , file_name );
+
+        if ( proof_system != R1CS_GG ){
+            strncpy (last_function_msg , "binary proof key files are only supported for R1CS_GG" , last_function_msg_size );
+            return 1 ;
+        }
+
+        const r1cs_gg_ppzksnark_proving_key<ppT_GG> & pk = keypair_GG.pk ;
+        const knowledge_commitment_vector<G2, G1> & B_query = pk.B_query ;
+
+        std::vector<G1> B_query_g1 ;
+        std::vector<G2> B_query_g2 ;
+        B_query_g1.reserve( B_query.values.size() );
+        B_query_g2.reserve( B_query.values.size() );
+        for ( const knowledge_commitment<G2, G1> & v : B_query.values ){
+            B_query_g2.emplace_back( v.g );
+            B_query_g1.emplace_back( v.h );
+        }
+
+        const std::vector<uint64_t> B_query_indices( B_query.indices.begin() , B_query.indices.end() ) ;
+
+        const std::vector<G1> fixed_g1 = { pk.alpha_g1 , pk.beta_g1 , pk.delta_g1 } ;
+        const std::vector<G2> fixed_g2 = { pk.beta_g2 , pk.delta_g2 } ;
+
+        JsonTree::Root file_meta ;
+        char file_meta_buff[pk_binary_page_size] = { 0 } ;
+
+        std::ofstream out ( file_name  , ios::trunc | ios::out | ios::binary );
+        if ( ! out.good() ){
+            snprintf(last_function_msg , last_function_msg_size , "Could not open pk file " );
+            return 1 ;
+        }
+
+        // file info, written last
+        out.write( file_meta_buff , pk_binary_page_size ) ;
+
+        file_meta["Fixed Points Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        write_affine_points<G1>( out , fixed_g1.begin() , fixed_g1.end() ) ;
+        write_affine_points<G2>( out , fixed_g2.begin() , fixed_g2.end() ) ;
+        write_padding_to_page( out ) ;
+
+        file_meta["A Query Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        write_affine_points<G1>( out , pk.A_query.begin() , pk.A_query.end() ) ;
+        write_padding_to_page( out ) ;
+
+        file_meta["B Query Indices Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        out.write( (const char*) B_query_indices.data() , B_query_indices.size() * sizeof(uint64_t) ) ;
+        write_padding_to_page( out ) ;
+
+        file_meta["B Query G2 Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        write_affine_points<G2>( out , B_query_g2.begin() , B_query_g2.end() ) ;
+        write_padding_to_page( out ) ;
+
+        file_meta["B Query G1 Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        write_affine_points<G1>( out , B_query_g1.begin() , B_query_g1.end() ) ;
+        write_padding_to_page( out ) ;
+
+        file_meta["H Query Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        write_affine_points<G1>( out , pk.H_query.begin() , pk.H_query.end() ) ;
+        write_padding_to_page( out ) ;
+
+        file_meta["L Query Offset"] << static_cast<uint64_t>( out.tellp() ) ;
+        write_affine_points<G1>( out , pk.L_query.begin() , pk.L_query.end() ) ;
+        write_padding_to_page( out ) ;
+
+        if ( pk_tables_GG && ! pk_tables_GG->empty() ){
+            file_meta["Tables Stride"] << static_cast<uint64_t>( pk_tables_GG->A_query.stride ) ;
+            write_table_section<G1>( out , file_meta , "A Query" , pk_tables_GG->A_query ) ;
+            write_table_section<G2>( out , file_meta , "B Query G2" , pk_tables_GG->B_query_g2 ) ;
+            write_table_section<G1>( out , file_meta , "B Query G1" , pk_tables_GG->B_query_g1 ) ;
+            write_table_section<G1>( out , file_meta , "H Query" , pk_tables_GG->H_query ) ;
+            write_table_section<G1>( out , file_meta , "L Query" , pk_tables_GG->L_query ) ;
+        }
+
+        // the stream state is sticky , so a single check covers every write above
+        const uint64_t file_size = static_cast<uint64_t>( out.tellp() ) ;
+        out.flush() ;
+        const bool write_ok = out.good() ;
+        out.close() ;
+
+        if ( ! write_ok || out.fail() ){
+            std::remove( file_name ) ;
+            snprintf(last_function_msg , last_function_msg_size , "Could not write pk file " );
+            return 1 ;
+        }
+
+        // checksum of everything after the file info
+        std::string checksum = "" ;
+        if ( use_checksum ){
+
+            int fd = open( file_name , O_RDONLY ) ;
+            void * mapped = ( fd >= 0 ) ? mmap( NULL , file_size , PROT_READ , MAP_PRIVATE , fd , 0 ) : MAP_FAILED ;
+            if ( fd >= 0 ) { close( fd ) ; }
+
+            if ( mapped == MAP_FAILED ){
+                snprintf(last_function_msg , last_function_msg_size , "Could not map pk file to compute its checksum " );
+                return 1 ;
+            }
+
+            checksum = pk_binary_checksum( (const uint8_t*) mapped + pk_binary_page_size , file_size - pk_binary_page_size ) ;
+            munmap( mapped , file_size ) ;
+        }
+
+        file_meta["Binary Format"]          << pk_binary_format ;
+        file_meta["Version"]                << static_cast<uint64_t>( pk_binary_version ) ;
+        file_meta["Curve"]                  << static_cast<int64_t>( config.EC_Selection ) ;
+        file_meta["G1 Point Size"]          << static_cast<uint64_t>( affine_point_size<G1>() ) ;
+        file_meta["G2 Point Size"]          << static_cast<uint64_t>( affine_point_size<G2>() ) ;
+        file_meta["A Query Size"]           << static_cast<uint64_t>( pk.A_query.size() ) ;
+        file_meta["B Query Size"]           << static_cast<uint64_t>( B_query.indices.size() ) ;
+        file_meta["B Query Domain Size"]    << static_cast<uint64_t>( B_query.domain_size_ ) ;
+        file_meta["H Query Size"]           << static_cast<uint64_t>( pk.H_query.size() ) ;
+        file_meta["H Query Basis"]          << static_cast<uint64_t>( pk.H_query_basis ) ;
+        file_meta["L Query Size"]           << static_cast<uint64_t>( pk.L_query.size() ) ;
+        file_meta["File Size"]              << file_size ;
+        file_meta["Checksum"]               << checksum ;
+
+        // the file info and its null terminator must fit in the first page
+        std::string file_meta_json_str = file_meta.get_json();
+        if ( file_meta_json_str.size() >= pk_binary_page_size ){
+            std::remove( file_name ) ;
+            snprintf(last_function_msg , last_function_msg_size , "pk file info does not fit in a page (%zu bytes)" , file_meta_json_str.size() );
+            return 1 ;
+        }
+        memcpy( file_meta_buff , file_meta_json_str.c_str() , file_meta_json_str.size() + 1 ) ;
+
+        {
+            std::fstream meta_out ( file_name , ios::in | ios::out | ios::binary );
+            meta_out.seekp( 0 , ios::beg ) ;
+            meta_out.write( file_meta_buff , pk_binary_page_size ) ;
+            meta_out.flush() ;
+            const bool meta_ok = meta_out.good() ;
+            meta_out.close() ;
+
+            if ( ! meta_ok || meta_out.fail() ){
+                std::remove( file_name ) ;
+                snprintf(last_function_msg , last_function_msg_size , "Could not write pk file info " );
+                return 1 ;
+            }
+        }
+
+        // the file info alone may fill a log line
+        LOGD("---- File Info ----\n");
+        LOGD("%s" , file_meta_buff );
+        LOGD("\n-------------------\n");
+        LOGD("End of Writing Proof Key to binary file\n");
+
+        strncpy (last_function_msg , "success" , last_function_msg_size );
+        return 0 ;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::read_pk_binary( const char* file_name , bool verify_checksum ){
+
+        typedef libff::G1<ppT_GG> G1 ;
+        typedef libff::G2<ppT_GG> G2 ;
+
+        LOGD("Read Proof Key from binary file\n");
+        LOGD("  File : [%s]\n" , file_name );
+
+        if ( proof_system != R1CS_GG ){
+            strncpy (last_function_msg , "binary proof key files are only supported for R1CS_GG" , last_function_msg_size );
+            return 1 ;
+        }
+
+        int fd = open( file_name , O_RDONLY ) ;
+        if ( fd < 0 ){
+            snprintf(last_function_msg , last_function_msg_size , "Could not open pk file " );
+            return 1 ;
+        }
+
+        struct stat file_stat ;
+        if ( fstat( fd , &file_stat ) != 0 || static_cast<uint64_t>( file_stat.st_size ) < pk_binary_page_size ){
+            close( fd ) ;
+            snprintf(last_function_msg , last_function_msg_size , "Invalid pk file size " );
+            return 1 ;
+        }
+
+        const uint64_t file_size = static_cast<uint64_t>( file_stat.st_size ) ;
+        void * mapped = mmap( NULL , file_size , PROT_READ , MAP_PRIVATE , fd , 0 ) ;
+        close( fd ) ;
+
+        if ( mapped == MAP_FAILED ){
+            snprintf(last_function_msg , last_function_msg_size , "Could not map pk file " );
+            return 1 ;
+        }
+
+        const char * data = (const char*) mapped ;
+
+        std::string file_meta_str( data , strnlen( data , pk_binary_page_size ) ) ;
+        LOGD("---- File Info ----\n");
+        LOGD("%s" , file_meta_str.c_str() );
+        LOGD("\n-------------------\n");
+        JsonTree::Root file_meta( file_meta_str ) ;
+
+        const uint64_t A_size           = file_meta["A Query Size"].get_uint() ;
+        const uint64_t B_size           = file_meta["B Query Size"].get_uint() ;
+        const uint64_t H_size           = file_meta["H Query Size"].get_uint() ;
+        const uint64_t H_basis          = file_meta["H Query Basis"].get_uint() ;
+        const uint64_t L_size           = file_meta["L Query Size"].get_uint() ;
+        const uint64_t fixed_offset     = file_meta["Fixed Points Offset"].get_uint() ;
+        const uint64_t A_offset         = file_meta["A Query Offset"].get_uint() ;
+        const uint64_t B_indices_offset = file_meta["B Query Indices Offset"].get_uint() ;
+        const uint64_t B_g2_offset      = file_meta["B Query G2 Offset"].get_uint() ;
+        const uint64_t B_g1_offset      = file_meta["B Query G1 Offset"].get_uint() ;
+        const uint64_t H_offset         = file_meta["H Query Offset"].get_uint() ;
+        const uint64_t L_offset         = file_meta["L Query Offset"].get_uint() ;
+        const size_t G1_size = affine_point_size<G1>() ;
+        const size_t G2_size = affine_point_size<G2>() ;
+        const size_t num_bits = libff::Fr<ppT_GG>::size_in_bits() ;
+
+        // the tables are read when the file has them and they fit in the memory budget
+        const uint64_t tables_stride = file_meta["Tables Stride"].get_uint() ;
+        const uint64_t A_table_points     = table_section_points( file_meta , "A Query" , A_size ) ;
+        const uint64_t B_g2_table_points  = table_section_points( file_meta , "B Query G2" , B_size ) ;
+        const uint64_t B_g1_table_points  = table_section_points( file_meta , "B Query G1" , B_size ) ;
+        const uint64_t H_table_points     = table_section_points( file_meta , "H Query" , H_size ) ;
+        const uint64_t L_table_points     = table_section_points( file_meta , "L Query" , L_size ) ;
+        uint64_t tables_memory = 0 ;
+        for ( const uint64_t G1_points : { A_table_points , B_g1_table_points , H_table_points , L_table_points } ){
+            tables_memory = pk_binary_saturating_add( tables_memory , pk_binary_saturating_mul( G1_points , G1_size ) ) ;
+        }
+        tables_memory = pk_binary_saturating_add( tables_memory , pk_binary_saturating_mul( B_g2_table_points , G2_size ) ) ;
+        const bool read_tables = ( tables_stride > 0 && pk_table_memory_budget > 0 && tables_memory <= pk_table_memory_budget ) ;
+
+        int retval = 0 ;
+
+        if ( file_meta["Binary Format"].get_string() != pk_binary_format ||
+             file_meta["Version"].get_uint() != pk_binary_version ){
+
+            snprintf(last_function_msg , last_function_msg_size , "Invalid Binary Format Desc or Version" );
+            retval = 1 ;
+
+        }else if ( file_meta["Curve"].get_int() != config.EC_Selection ||
+                   file_meta["G1 Point Size"].get_uint() != G1_size ||
+                   file_meta["G2 Point Size"].get_uint() != G2_size ){
+
+            snprintf(last_function_msg , last_function_msg_size , "pk file was written for another curve" );
+            retval = 1 ;
+
+        }else if ( H_basis != r1cs_gg_ppzksnark_H_query_monomial &&
+                   H_basis != r1cs_gg_ppzksnark_H_query_coset_lagrange ){
+
+            snprintf(last_function_msg , last_function_msg_size , "Unknown H Query Basis [%lu]" , (unsigned long) H_basis );
+            retval = 1 ;
+
+        }else if ( file_size < file_meta["File Size"].get_uint() ||
+                   file_meta["File Size"].get_uint() < pk_binary_page_size ||
+                   ! pk_binary_section_fits( file_size , fixed_offset , 1 , 3 * G1_size + 2 * G2_size ) ||
+                   ! pk_binary_section_fits( file_size , A_offset , A_size , G1_size ) ||
+                   ! pk_binary_section_fits( file_size , B_indices_offset , B_size , sizeof(uint64_t) ) ||
+                   ! pk_binary_section_fits( file_size , B_g2_offset , B_size , G2_size ) ||
+                   ! pk_binary_section_fits( file_size , B_g1_offset , B_size , G1_size ) ||
+                   ! pk_binary_section_fits( file_size , H_offset , H_size , G1_size ) ||
+                   ! pk_binary_section_fits( file_size , L_offset , L_size , G1_size ) ||
+                   ( read_tables &&
+                     ( ! pk_binary_section_fits( file_size , file_meta["A Query Table Offset"].get_uint() , A_table_points , G1_size ) ||
+                       ! pk_binary_section_fits( file_size , file_meta["B Query G2 Table Offset"].get_uint() , B_g2_table_points , G2_size ) ||
+                       ! pk_binary_section_fits( file_size , file_meta["B Query G1 Table Offset"].get_uint() , B_g1_table_points , G1_size ) ||
+                       ! pk_binary_section_fits( file_size , file_meta["H Query Table Offset"].get_uint() , H_table_points , G1_size ) ||
+                       ! pk_binary_section_fits( file_size , file_meta["L Query Table Offset"].get_uint() , L_table_points , G1_size ) ) ) ){
+
+            snprintf(last_function_msg , last_function_msg_size , "pk file is truncated" );
+            retval = 1 ;
+
+        }else if ( ! pk_binary_indices_valid( (const uint64_t*) ( data + B_indices_offset ) , B_size , file_meta["B Query Domain Size"].get_uint() ) ){
+
+            snprintf(last_function_msg , last_function_msg_size , "Invalid B Query indices" );
+            retval = 1 ;
+
+        }else if ( read_tables &&
+                   ( tables_stride > r1cs_gg_ppzksnark_proving_key_tables<ppT_GG>::max_stride ||
+                     ! table_section_valid<G1>( file_meta , "A Query" , tables_stride , num_bits ) ||
+                     ! table_section_valid<G2>( file_meta , "B Query G2" , tables_stride , num_bits ) ||
+                     ! table_section_valid<G1>( file_meta , "B Query G1" , tables_stride , num_bits ) ||
+                     ! table_section_valid<G1>( file_meta , "H Query" , tables_stride , num_bits ) ||
+                     ! table_section_valid<G1>( file_meta , "L Query" , tables_stride , num_bits ) ) ){
+
+            snprintf(last_function_msg , last_function_msg_size , "Invalid proving key tables" );
+            retval = 1 ;
+
+        }else if ( verify_checksum && file_meta["Checksum"].get_string().size() ){
+
+            const uint64_t data_size = file_meta["File Size"].get_uint() - pk_binary_page_size ;
+            const std::string checksum = pk_binary_checksum( (const uint8_t*) data + pk_binary_page_size , data_size ) ;
+
+            if ( checksum != file_meta["Checksum"].get_string() ){
+                snprintf(last_function_msg ,
+                         last_function_msg_size ,
+                         "Invalid Checksum, in file info : [%s] , computed : [%s]",
+                         file_meta["Checksum"].get_string().c_str() ,
+                         checksum.c_str() );
+                retval = 2 ;
+            }
+        }
+
+        if ( retval == 0 ){
+
+            r1cs_gg_ppzksnark_proving_key<ppT_GG> & pk = keypair_GG.pk ;
+
+            std::vector<G1> fixed_g1 ;
+            std::vector<G2> fixed_g2 ;
+            read_affine_points<G1>( data + fixed_offset , 3 , fixed_g1 ) ;
+            read_affine_points<G2>( data + fixed_offset + 3 * G1_size , 2 , fixed_g2 ) ;
+            pk.alpha_g1 = fixed_g1[0] ;
+            pk.beta_g1  = fixed_g1[1] ;
+            pk.delta_g1 = fixed_g1[2] ;
+            pk.beta_g2  = fixed_g2[0] ;
+            pk.delta_g2 = fixed_g2[1] ;
+
+            read_affine_points<G1>( data + A_offset , A_size , pk.A_query ) ;
+            read_affine_points<G1>( data + H_offset , H_size , pk.H_query ) ;
+            pk.H_query_basis = static_cast<r1cs_gg_ppzksnark_H_query_basis>( H_basis ) ;
+            read_affine_points<G1>( data + L_offset , L_size , pk.L_query ) ;
+
+            std::vector<G2> B_query_g2 ;
+            std::vector<G1> B_query_g1 ;
+            read_affine_points<G2>( data + B_g2_offset , B_size , B_query_g2 ) ;
+            read_affine_points<G1>( data + B_g1_offset , B_size , B_query_g1 ) ;
+
+            const uint64_t * B_query_indices = (const uint64_t*) ( data + B_indices_offset ) ;
+
+            pk.B_query.domain_size_ = file_meta["B Query Domain Size"].get_uint() ;
+            pk.B_query.indices.assign( B_query_indices , B_query_indices + B_size ) ;
+            pk.B_query.values.clear() ;
+            pk.B_query.values.reserve( B_size ) ;
+            for ( size_t i = 0 ; i < B_size ; i++ ){
+                pk.B_query.values.emplace_back( B_query_g2[i] , B_query_g1[i] ) ;
+            }
+
+            keypair_GG.print_pk_size();
+
+            release_pk_tables();
+            if ( read_tables ){
+                pk_tables_GG = new r1cs_gg_ppzksnark_proving_key_tables<ppT_GG>() ;
+                read_table_section<G1>( data , file_meta , "A Query" , A_size , tables_stride , pk_tables_GG->A_query ) ;
+                read_table_section<G2>( data , file_meta , "B Query G2" , B_size , tables_stride , pk_tables_GG->B_query_g2 ) ;
+                read_table_section<G1>( data , file_meta , "B Query G1" , B_size , tables_stride , pk_tables_GG->B_query_g1 ) ;
+                read_table_section<G1>( data , file_meta , "H Query" , H_size , tables_stride , pk_tables_GG->H_query ) ;
+                read_table_section<G1>( data , file_meta , "L Query" , L_size , tables_stride , pk_tables_GG->L_query ) ;
+                LOGD("Read proving key tables : %zu bytes\n" , pk_tables_GG->size_in_bytes() );
+            }
+
+            libff::profiling profile ;
+            prepare_prover( profile );
+
+            strncpy (last_function_msg , "success" , last_function_msg_size );
+        }
+
+        munmap( mapped , file_size ) ;
+
+        LOGD("End of Reading Proof Key from binary file : %s \n" , ( (retval==0) ? "Success" : "Failed" ) );
+        return retval ;
+    }
+
+}
@@ -126,6 +126,27 @@ namespace libsnark {
     }
 
 
+    // whether node is a string that hex_to_Fq_bytes_inverse can read : the hex digits of exactly as
+    // many bytes as Fq_bytes_to_hex_inverse writes for an Fq_Ty , after "0x" with hex_suffix
+    template<typename Fq_Ty>
+    bool is_Fq_bytes_hex( const JsonTree::Node & node , bool hex_suffix = false ){
+
+        if ( ! node.is_string() ) { return false ; }
+
+        Fq_Ty zero = Fq_Ty::zero() ;
+        const string & hex_string = node.get_string() ;
+        if ( hex_string.size() != Fq_bytes_to_hex_inverse( zero , hex_suffix ).size() ) { return false ; }
+
+        const size_t offset = (hex_suffix) ? 2 : 0 ;
+        if ( hex_suffix && hex_string.compare( 0 , 2 , "0x" ) != 0 && hex_string.compare( 0 , 2 , "0X" ) != 0 ) { return false ; }
+
+        for ( size_t i = offset ; i < hex_string.size() ; i++ ){
+            if ( ! isxdigit( (unsigned char) hex_string[i] ) ) { return false ; }
+        }
+        return true ;
+    }
+
+
 
 
     template<typename ppTy>
@@ -251,6 +272,12 @@ namespace libsnark {
             }
 
             json_root["B_query Domain Size"] << (uint64_t)pk.B_query.domain_size_;
+
+            // keys in the monomial basis have no H_query Basis, as the ones serialized before it
+            if (pk.H_query_basis != r1cs_gg_ppzksnark_H_query_monomial)
+            {
+                json_root["H_query Basis"] << static_cast<uint64_t>(pk.H_query_basis);
+            }
         } else if (serialization_format == serializeFormatZKlay ){
 
             g1_affine_to_json_array_inverse<ppTy>( json_root["Alpha_G1"] , pk.alpha_g1, true ) ;
@@ -297,6 +324,11 @@ namespace libsnark {
             }
 
             json_root["B_query Domain Size"] << (uint64_t)pk.B_query.domain_size_;
+
+            if (pk.H_query_basis != r1cs_gg_ppzksnark_H_query_monomial)
+            {
+                json_root["H_query Basis"] << static_cast<uint64_t>(pk.H_query_basis);
+            }
         }
         json_string_out = json_root.get_json() ;
         return 0 ;        
@@ -414,6 +446,15 @@ namespace libsnark {
             pk.B_query.domain_size_ = json_root["B_query Domain Size"].get_uint();
         }
 
+        // a missing H_query Basis is the monomial basis
+        const uint64_t H_query_basis = json_root["H_query Basis"].get_uint();
+        if (H_query_basis != r1cs_gg_ppzksnark_H_query_monomial &&
+            H_query_basis != r1cs_gg_ppzksnark_H_query_coset_lagrange)
+        {
+            return 1;
+        }
+        pk.H_query_basis = static_cast<r1cs_gg_ppzksnark_H_query_basis>(H_query_basis);
+
         return 0;
     }
 
@@ -617,11 +658,59 @@ namespace libsnark {
         return 0 ;
     }
     
+    // whether the proof json has the layout serialize_proof writes , with a coordinate in every place
+    template<typename ppTy>
+    bool is_proof_json( JsonTree::Root & json_root , int serialization_format ){
+
+        typedef typename libff::G1<ppTy>::base_field G1_coord_t ;
+        typedef decltype( libff::G2<ppTy>::twist_field::c0 ) G2_coord_t ;
+
+        if ( ! json_root.is_object() ) { return false ; }
+
+        if (serialization_format == serializeFormatCRV || serialization_format == serializeFormatDefault ){
+
+            JsonTree::Node & crv = json_root["CRVProof"] ;
+            if ( ! crv.is_array() || crv.size() != 8 ) { return false ; }
+
+            // g_A , g_B and g_C : 2 , 4 and 2 coordinates
+            for ( size_t i = 0 ; i < 8 ; i++ ){
+                const bool g1_coord = ( i < 2 || i >= 6 ) ;
+                if ( g1_coord ? ! is_Fq_bytes_hex<G1_coord_t>( crv[i] ) : ! is_Fq_bytes_hex<G2_coord_t>( crv[i] ) ) { return false ; }
+            }
+
+        }else if(serialization_format == serializeFormatZKlay ){
+
+            JsonTree::Node & a = json_root["a"] ;
+            JsonTree::Node & b = json_root["b"] ;
+            JsonTree::Node & c = json_root["c"] ;
+
+            if ( ! a.is_array() || a.size() != 2 || ! c.is_array() || c.size() != 2 ||
+                 ! b.is_array() || b.size() != 2 ) { return false ; }
+
+            for ( size_t i = 0 ; i < 2 ; i++ ){
+                if ( ! is_Fq_bytes_hex<G1_coord_t>( a[i] , true ) || ! is_Fq_bytes_hex<G1_coord_t>( c[i] , true ) ) { return false ; }
+                if ( ! b[i].is_array() || b[i].size() != 2 ||
+                     ! is_Fq_bytes_hex<G2_coord_t>( b[i][0] , true ) || ! is_Fq_bytes_hex<G2_coord_t>( b[i][1] , true ) ) { return false ; }
+            }
+
+        }else{
+            return false ;
+        }
+
+        return true ;
+    }
+
+    /*
+     * Reads a proof written by serialize_proof. Returns 1 , with the proof left as it was , if the
+     * json does not have that layout. Whether the points are on the curve is left to the verifier.
+     */
     template<typename ProofTy, typename ppTy>
     int de_serialize_proof(ProofTy & proof , string & proof_json_str , int serialization_format ){
 
         JsonTree::Root json_root(proof_json_str) ;
 
+        if ( ! is_proof_json<ppTy>( json_root , serialization_format ) ) { return 1 ; }
+
         if (serialization_format == serializeFormatCRV || serialization_format == serializeFormatDefault ){
             
             json_array_to_g1_affine_inverse<ppTy>(json_root["CRVProof"] , 0 , proof.g_A ) ;
@@ -664,7 +753,13 @@ namespace libsnark {
             // r1cs_rom_se_ppzksnark_keypair<libff::default_ec_pp> * kp = (r1cs_rom_se_ppzksnark_keypair<libff::default_ec_pp>*) keypair_ROM_SE ;
             // de_serialize_vk<r1cs_rom_se_ppzksnark_verification_key<libff::default_ec_pp> , libff::default_ec_pp > (kp->vk , vk_json_str , serialization_format);
         }else if ( proof_system == R1CS_GG ) {
-            de_serialize_pk<r1cs_gg_ppzksnark_proving_key<ppT_GG> , ppT_GG >( keypair_GG.pk , serialization_buffer , serialization_format );
+            if ( de_serialize_pk<r1cs_gg_ppzksnark_proving_key<ppT_GG> , ppT_GG >( keypair_GG.pk , serialization_buffer , serialization_format ) != 0 ) {
+                strncpy (last_function_msg , "Unknown H_query Basis" , last_function_msg_size ); 
+                return 1 ;
+            }
+            libff::profiling profile ;
+            release_pk_tables();
+            prepare_prover( profile );
         }
         return 0 ;
     }
@@ -684,6 +779,7 @@ namespace libsnark {
     template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE > 
     int Context<FieldT,ppT_GG,ppT_ROM_SE>::de_serialize_vk_object(const char* json_string){
         vk_json_str.assign(json_string);
+        release_verifier();
         if ( proof_system == R1CS_ROM_SE ) {
             // r1cs_rom_se_ppzksnark_keypair<libff::default_ec_pp> * kp = (r1cs_rom_se_ppzksnark_keypair<libff::default_ec_pp>*) keypair_ROM_SE ;
             // de_serialize_vk<r1cs_rom_se_ppzksnark_verification_key<libff::default_ec_pp> , libff::default_ec_pp > (kp->vk , vk_json_str , serialization_format);
@@ -708,15 +804,61 @@ namespace libsnark {
     int Context<FieldT,ppT_GG,ppT_ROM_SE>::de_serialize_proof_object(const char* json_string) { 
         proof_json_str.assign( json_string ) ;   
         if ( proof_system == R1CS_ROM_SE ) {
+            r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE> proof ;
+            if ( de_serialize_proof<r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE>, ppT_ROM_SE>(proof, proof_json_str, serialization_format) != 0 ) {
+                strncpy (last_function_msg , "malformed proof json" , last_function_msg_size ); 
+                return 1 ;
+            }
             if ( proof_ROM_SE ) { try { delete proof_ROM_SE ; } catch( exception e){} }
-            proof_ROM_SE = new r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE>();  
-            de_serialize_proof<r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE>, ppT_ROM_SE>(*proof_ROM_SE, proof_json_str, serialization_format);
+            proof_ROM_SE = new r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE>( proof );  
         }else if ( proof_system == R1CS_GG ) {
-            de_serialize_proof<r1cs_gg_ppzksnark_proof<ppT_GG> , ppT_GG >(proof_GG, proof_json_str, serialization_format) ;
+            if ( de_serialize_proof<r1cs_gg_ppzksnark_proof<ppT_GG> , ppT_GG >(proof_GG, proof_json_str, serialization_format) != 0 ) {
+                strncpy (last_function_msg , "malformed proof json" , last_function_msg_size ); 
+                return 1 ;
+            }
         }
         return 0 ;
     }
 
+    /*
+     * Reads every proof of a batch into proofs , without touching the proof of the context. On a
+     * malformed item , sets the error message with its index and returns false.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    template <typename ProofTy , typename ppTy >
+    bool Context<FieldT,ppT_GG,ppT_ROM_SE>::read_batch_proofs ( JsonTree::Node & proofs_root , std::vector< ProofTy > & proofs ) {
+
+        proofs.resize( proofs_root.size() ) ;
+
+        for ( size_t ix = 0 ; ix < proofs_root.size() ; ix++ ){
+            string item_json_str = proofs_root[ix].get_json( true ) ;
+            if ( de_serialize_proof<ProofTy , ppTy>( proofs[ix] , item_json_str , serialization_format ) != 0 ) {
+                snprintf (last_function_msg , last_function_msg_size , "proof item #%zu : malformed proof json" , ix ); 
+                return false ;
+            }
+        }
+
+        return true ;
+    }
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE > 
+    const char* Context<FieldT,ppT_GG,ppT_ROM_SE>::serialize_primary_inputs(){
+        // the statement of the last evaluation, in r1cs order, as hexadecimal strings
+        primary_inputs_json_str = "[" ;
+        mpz_t value ;
+        mpz_init( value );
+        for ( size_t ix = 0 ; ix < primary_input.size() ; ix++ ){
+            primary_input[ix].as_bigint().to_mpz( value );
+            char * value_str = mpz_get_str( NULL , 16 , value );
+            if ( ix > 0 ) { primary_inputs_json_str += "," ; }
+            primary_inputs_json_str += "\"" + string( value_str ) + "\"" ;
+            free( value_str );
+        }
+        mpz_clear( value );
+        primary_inputs_json_str += "]" ;
+        return primary_inputs_json_str.c_str() ;
+    }
+
     template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE > 
     int Context<FieldT,ppT_GG,ppT_ROM_SE>::get_set_serialize_format(int format ){
         if (format > 0 ) serialization_format = format ;
@@ -12,12 +12,19 @@ namespace libsnark {
         LOGD("Run Setup     : \n" );
         LOGD("Context_ID    : %d\n", id );
 
+        if ( is_verifier_context() ) {
+            strncpy (last_function_msg , "no circuit to set up in a verifier context" , last_function_msg_size ); 
+            return 1 ;
+        }
+
         libff::profiling profile ;
         
         primary_input = r1cs_primary_input<FieldT> ( cs.num_inputs() , FieldT::zero() );
         auxiliary_input = r1cs_auxiliary_input<FieldT> ( full_assignment_size - cs.num_inputs() , FieldT::zero());
 
         profile.enter_block("Setup"); 
+
+        release_verifier();
         
         if ( proof_system == R1CS_ROM_SE ){
 
@@ -36,10 +43,13 @@ namespace libsnark {
         }else if ( proof_system == R1CS_GG ){
             
             libsnark::run_r1cs_gg_ppzksnark_setup<ppT_GG>(
-                        cs , keypair_GG , profile );
+                        cs , keypair_GG , profile , setup_H_query_basis );
 
             keypair_GG.print_pk_size();
             keypair_GG.print_vk_size();
+
+            release_pk_tables();
+            prepare_prover( profile );
             
         }
         
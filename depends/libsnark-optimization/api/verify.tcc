@@ -1,6 +1,7 @@
 
 
 
+#include <json_tree.hpp>
 #include <logging.hpp>
 
 namespace libsnark {
@@ -15,9 +16,17 @@ namespace libsnark {
         LOGD("Run Verify    :\n" );
         LOGD("Context_ID    : %d\n", id );
 
+        if ( is_verifier_context() ) {
+            strncpy (last_function_msg , "no circuit in a verifier context : use runVerifyWithInputs" , last_function_msg_size ); 
+            return 1 ;
+        }
+
         libff::profiling profile ;
         
-        evaluate_inputs( profile , true ); 
+        if ( evaluate_inputs( profile , true ) != 0 ) {
+            snprintf (last_function_msg , last_function_msg_size , "evaluation of the inputs failed : %s" , evaluation_error.c_str() ); 
+            return 1 ;
+        }
 
         r1cs_example<FieldT> example(cs, primary_input, auxiliary_input);
         
@@ -28,6 +37,13 @@ namespace libsnark {
         switch(proof_system){
             
             case R1CS_ROM_SE :
+                if ( processed_vk_ROM_SE ) {
+                    successBit = 
+                        libsnark::run_r1cs_rom_se_ppzksnark_verify<ppT_ROM_SE>(
+                                * processed_vk_ROM_SE , 
+                                primary_input , 
+                                * proof_ROM_SE , profile ); 
+                }else
                 successBit = 
                     libsnark::run_r1cs_rom_se_ppzksnark_verify<ppT_ROM_SE>(
                             example, 
@@ -44,6 +60,14 @@ namespace libsnark {
             
             case R1CS_GG :
             default :
+                if ( processed_vk_GG ) {
+                    successBit = 
+                        libsnark::run_r1cs_gg_ppzksnark_verify<ppT_GG>(
+                                * processed_vk_GG , 
+                                primary_input , 
+                                proof_GG ,
+                                profile); 
+                }else
                 successBit = 
                     libsnark::run_r1cs_gg_ppzksnark_verify<ppT_GG>(
                             example, 
@@ -68,4 +92,407 @@ namespace libsnark {
         return (successBit) ? 0 : -1 ;
     }
 
- }
\ No newline at end of file
+ 
+
+
+    /*
+     * Verify the loaded proof against a statement given directly, as a JSON array of the
+     * primary input values in hexadecimal (see serialize_primary_inputs). The circuit is
+     * neither built nor evaluated, so this also works on a verifier context.
+     * Uses the processed verify key of create_verifier if there is one.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::run_verify_with_inputs ( const char* primary_inputs_json ) {
+
+        LOGD("\n\n" );
+        LOGD("Run Verify With Inputs :\n" );
+        LOGD("Context_ID             : %d\n", id );
+
+        clear_last_errmsg();
+
+        if ( ! primary_inputs_json ) {
+            strncpy (last_function_msg , "no primary inputs json array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        JsonTree::Root json_root( primary_inputs_json ) ;
+
+        if ( ! json_root.is_array() ) {
+            strncpy (last_function_msg , "primary inputs json is not an array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        if ( proof_system == R1CS_ROM_SE && ( ! keypair_ROM_SE || ! proof_ROM_SE ) ) {
+            strncpy (last_function_msg , "verify key or proof is not loaded" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        r1cs_primary_input<FieldT> statement ;
+        size_t invalid_index = 0 ;
+
+        if ( ! read_statement( json_root , statement , invalid_index ) ) {
+            snprintf (last_function_msg , last_function_msg_size , "invalid primary input #%zu" , invalid_index ); 
+            return 1 ;
+        }
+
+        LOGD("Primary Inputs         : %zu\n", statement.size() );
+
+        libff::profiling profile ;
+
+        profile.enter_block("Verify" );
+
+        bool successBit = false ;
+
+        switch(proof_system){
+
+            case R1CS_ROM_SE :
+                if ( processed_vk_ROM_SE ) {
+                    successBit = libsnark::run_r1cs_rom_se_ppzksnark_verify<ppT_ROM_SE>( * processed_vk_ROM_SE , statement , * proof_ROM_SE , profile );
+                } else {
+                    const r1cs_rom_se_ppzksnark_processed_verification_key<ppT_ROM_SE> pvk = 
+                        r1cs_rom_se_ppzksnark_verifier_process_vk<ppT_ROM_SE>( ((r1cs_rom_se_ppzksnark_keypair<ppT_ROM_SE> *) keypair_ROM_SE )->vk , profile );
+                    successBit = libsnark::run_r1cs_rom_se_ppzksnark_verify<ppT_ROM_SE>( pvk , statement , * proof_ROM_SE , profile );
+                }
+                break ;
+
+            case R1CS_GG :
+            default :
+                if ( processed_vk_GG ) {
+                    successBit = libsnark::run_r1cs_gg_ppzksnark_verify<ppT_GG>( * processed_vk_GG , statement , proof_GG , profile );
+                } else {
+                    const r1cs_gg_ppzksnark_processed_verification_key<ppT_GG> pvk = 
+                        r1cs_gg_ppzksnark_verifier_process_vk<ppT_GG>( keypair_GG.vk , profile );
+                    successBit = libsnark::run_r1cs_gg_ppzksnark_verify<ppT_GG>( pvk , statement , proof_GG , profile );
+                }
+                break ;
+        }
+
+        profile.leave_block("Verify" ); 
+
+        LOGD("Run Verify With Inputs : successBit = %d [ %s ] \n" , successBit , (successBit) ? "Success" : "Failed" );
+
+        print_profile_logs("Run Verify With Inputs" , profile );
+
+        if ( successBit ) {
+            strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        } else {
+            strncpy (last_function_msg , "the proof does not verify against the primary inputs" , last_function_msg_size ); 
+        }
+
+        return (successBit) ? 0 : -1 ;
+    }
+
+
+    /*
+     * The statement of a JSON array of primary input values in hexadecimal (see serialize_primary_inputs).
+     * Returns false , with the index of the value in invalid_index , when a value is not a field element.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    bool Context<FieldT,ppT_GG,ppT_ROM_SE>::read_statement ( JsonTree::Node & json_array , 
+                                                             r1cs_primary_input<FieldT> & statement , 
+                                                             size_t & invalid_index ) {
+
+        statement.resize( json_array.size() ) ;
+
+        mpz_t value , modulus ;
+        mpz_init( value );
+        mpz_init( modulus );
+        FieldT::field_char().to_mpz( modulus );
+
+        bool valid = true ;
+
+        for ( size_t ix = 0 ; ix < json_array.size() && valid ; ix++ ){
+
+            const char * value_str = ( json_array[ix].is_string() ) ? json_array[ix].get_string_c() : NULL ;
+            if ( value_str && ( ! strncmp( value_str , "0x" , 2 ) || ! strncmp( value_str , "0X" , 2 ) ) ) { value_str += 2 ; }
+
+            if ( ! value_str || mpz_set_str( value , value_str , 16 ) != 0 || mpz_sgn( value ) < 0 || mpz_cmp( value , modulus ) >= 0 ) {
+                invalid_index = ix ;
+                valid = false ;
+            } else {
+                statement[ix] = FieldT( libff::bigint<FieldT::num_limbs>( value ) );
+            }
+        }
+
+        mpz_clear( value );
+        mpz_clear( modulus );
+
+        return valid ;
+    }
+
+
+    /*
+     * Verify every proof of a JSON array of serialized proofs against the matching item
+     * of a JSON array of primary input objects, with one combined pairing check (see
+     * r1cs_gg_ppzksnark_online_batch_verifier_strong_IC). Each item is evaluated with the
+     * circuit : a verifier context has none , and uses run_verify_batch_with_inputs.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::run_verify_batch ( const char* inputs_json_array , const char* proofs_json_array , int* results ) {
+
+        LOGD("\n\n" );
+        LOGD("Run Verify Batch :\n" );
+        LOGD("Context_ID       : %d\n", id );
+
+        clear_last_errmsg();
+
+        if ( is_verifier_context() ) {
+            strncpy (last_function_msg , "no circuit in a verifier context : use runVerifyBatchWithInputs" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        if ( ! inputs_json_array || ! proofs_json_array ) {
+            strncpy (last_function_msg , "no inputs or proofs json array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        JsonTree::Root inputs_root( inputs_json_array ) ;
+        JsonTree::Root proofs_root( proofs_json_array ) ;
+
+        if ( ! inputs_root.is_array() || ! proofs_root.is_array() ) {
+            strncpy (last_function_msg , "inputs or proofs json is not an array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        if ( inputs_root.size() != proofs_root.size() ) {
+            snprintf (last_function_msg , last_function_msg_size , "inputs and proofs array sizes differ (%zu , %zu)" , inputs_root.size() , proofs_root.size() ); 
+            return 1 ;
+        }
+
+        libff::profiling profile ;
+
+        profile.enter_block("Verify Batch" );
+
+        std::vector< r1cs_primary_input<FieldT> > primary_inputs ( inputs_root.size() ) ;
+
+        for ( size_t ix = 0 ; ix < inputs_root.size() ; ix++ ){
+
+            if ( update_primary_input_from_json( inputs_root[ix] ) != 0 ) {
+                profile.leave_block("Verify Batch" );
+                snprintf (last_function_msg , last_function_msg_size , "input item #%zu : primary input array index out of range" , ix ); 
+                return 1 ;
+            }
+
+            inputs_evaluated = false ;
+            if ( evaluate_inputs( profile , true ) != 0 ) {
+                profile.leave_block("Verify Batch" );
+                snprintf (last_function_msg , last_function_msg_size , "input item #%zu : evaluation of the inputs failed : %s" , ix , evaluation_error.c_str() ); 
+                return 1 ;
+            }
+            primary_inputs[ix] = primary_input ;
+        }
+
+        const int retval = verify_batch( primary_inputs , proofs_root , results , profile );
+
+        profile.leave_block("Verify Batch" );
+
+        print_profile_logs("Run Verify Batch" , profile );
+
+        return retval ;
+    }
+
+
+    /*
+     * As run_verify_batch , with the statements given directly : a JSON array of JSON arrays of
+     * primary input values in hexadecimal (see run_verify_with_inputs). The circuit is neither
+     * built nor evaluated , so this also works on a verifier context.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::run_verify_batch_with_inputs ( const char* primary_inputs_json_array , const char* proofs_json_array , int* results ) {
+
+        LOGD("\n\n" );
+        LOGD("Run Verify Batch With Inputs :\n" );
+        LOGD("Context_ID                   : %d\n", id );
+
+        clear_last_errmsg();
+
+        if ( ! primary_inputs_json_array || ! proofs_json_array ) {
+            strncpy (last_function_msg , "no primary inputs or proofs json array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        JsonTree::Root inputs_root( primary_inputs_json_array ) ;
+        JsonTree::Root proofs_root( proofs_json_array ) ;
+
+        if ( ! inputs_root.is_array() || ! proofs_root.is_array() ) {
+            strncpy (last_function_msg , "primary inputs or proofs json is not an array" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        std::vector< r1cs_primary_input<FieldT> > primary_inputs ( inputs_root.size() ) ;
+
+        for ( size_t ix = 0 ; ix < inputs_root.size() ; ix++ ){
+
+            size_t invalid_index = 0 ;
+
+            if ( ! inputs_root[ix].is_array() ) {
+                snprintf (last_function_msg , last_function_msg_size , "input item #%zu is not an array" , ix ); 
+                return 1 ;
+            }
+
+            if ( ! read_statement( inputs_root[ix] , primary_inputs[ix] , invalid_index ) ) {
+                snprintf (last_function_msg , last_function_msg_size , "input item #%zu : invalid primary input #%zu" , ix , invalid_index ); 
+                return 1 ;
+            }
+        }
+
+        libff::profiling profile ;
+
+        profile.enter_block("Verify Batch" );
+
+        const int retval = verify_batch( primary_inputs , proofs_root , results , profile );
+
+        profile.leave_block("Verify Batch" );
+
+        print_profile_logs("Run Verify Batch With Inputs" , profile );
+
+        return retval ;
+    }
+
+
+    /*
+     * The combined check of run_verify_batch and run_verify_batch_with_inputs. Uses the processed
+     * verify key of create_verifier if there is one.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::verify_batch ( const std::vector< r1cs_primary_input<FieldT> > & primary_inputs ,
+                                                          JsonTree::Node & proofs_root , 
+                                                          int* results ,
+                                                          libff::profiling & profile ) {
+
+        if ( primary_inputs.size() != proofs_root.size() ) {
+            snprintf (last_function_msg , last_function_msg_size , "inputs and proofs array sizes differ (%zu , %zu)" , primary_inputs.size() , proofs_root.size() ); 
+            return 1 ;
+        }
+
+        if ( proof_system == R1CS_ROM_SE && ! keypair_ROM_SE ) {
+            strncpy (last_function_msg , "verify key is not loaded" , last_function_msg_size ); 
+            return 1 ;
+        }
+
+        const size_t batch_size = proofs_root.size() ;
+
+        LOGD("Batch Size       : %zu\n", batch_size );
+
+        std::vector< bool > valid ;
+        bool successBit = false ;
+
+        switch(proof_system){
+
+            case R1CS_ROM_SE : {
+
+                std::vector< r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE> > proofs ( batch_size ) ;
+                if ( ! read_batch_proofs<r1cs_rom_se_ppzksnark_proof<ppT_ROM_SE> , ppT_ROM_SE>( proofs_root , proofs ) ) { return 1 ; }
+
+                if ( processed_vk_ROM_SE ) {
+                    successBit = r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC<ppT_ROM_SE>( * processed_vk_ROM_SE , primary_inputs , proofs , valid , profile );
+                } else {
+                    const r1cs_rom_se_ppzksnark_processed_verification_key<ppT_ROM_SE> pvk = 
+                        r1cs_rom_se_ppzksnark_verifier_process_vk<ppT_ROM_SE>( ((r1cs_rom_se_ppzksnark_keypair<ppT_ROM_SE> *) keypair_ROM_SE )->vk , profile );
+                    successBit = r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC<ppT_ROM_SE>( pvk , primary_inputs , proofs , valid , profile );
+                }
+
+                break ;
+            }
+
+            case R1CS_GG :
+            default : {
+
+                std::vector< r1cs_gg_ppzksnark_proof<ppT_GG> > proofs ( batch_size ) ;
+                if ( ! read_batch_proofs<r1cs_gg_ppzksnark_proof<ppT_GG> , ppT_GG>( proofs_root , proofs ) ) { return 1 ; }
+
+                if ( processed_vk_GG ) {
+                    successBit = r1cs_gg_ppzksnark_online_batch_verifier_strong_IC<ppT_GG>( * processed_vk_GG , primary_inputs , proofs , valid , profile );
+                } else {
+                    const r1cs_gg_ppzksnark_processed_verification_key<ppT_GG> pvk = 
+                        r1cs_gg_ppzksnark_verifier_process_vk<ppT_GG>( keypair_GG.vk , profile );
+                    successBit = r1cs_gg_ppzksnark_online_batch_verifier_strong_IC<ppT_GG>( pvk , primary_inputs , proofs , valid , profile );
+                }
+
+                break ;
+            }
+        }
+
+        if ( results ) {
+            for ( size_t ix = 0 ; ix < batch_size ; ix++ ){ results[ix] = valid[ix] ? 1 : 0 ; }
+        }
+
+        const size_t num_valid = std::count( valid.begin() , valid.end() , true ) ;
+
+        LOGD("Run Verify Batch : %zu of %zu proofs valid\n" , num_valid , batch_size );
+
+        if ( successBit ) {
+            strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        } else {
+            snprintf (last_function_msg , last_function_msg_size , "%zu of %zu proofs failed to verify" , batch_size - num_valid , batch_size ); 
+        }
+
+        return (successBit) ? 0 : -1 ;
+    }
+
+
+    /*
+     * Process the verify key once (the pairing e(alpha, beta) and the G2 precomputations)
+     * and keep it in the context, so that run_verify only does per-proof work.
+     * Reading, de-serializing or generating a new verify key drops the cached one.
+     */
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    int Context<FieldT,ppT_GG,ppT_ROM_SE>::create_verifier ( const char* vk_file_name ) {
+
+        LOGD("\n\n" );
+        LOGD("Create Verifier :\n" );
+        LOGD("Context_ID      : %d\n", id );
+
+        libff::profiling profile ;
+
+        if ( vk_file_name ) {
+            const int read_retval = read_vk( vk_file_name );
+            if ( read_retval != 0 ) { return read_retval ; }
+        }
+
+        release_verifier();
+
+        profile.enter_block("Create Verifier" );
+
+        if ( proof_system == R1CS_ROM_SE ) {
+            
+            if ( ! keypair_ROM_SE ) {
+                profile.leave_block("Create Verifier" );
+                strncpy (last_function_msg , "verify key is not loaded" , last_function_msg_size ); 
+                return 1 ;
+            }
+
+            processed_vk_ROM_SE = new r1cs_rom_se_ppzksnark_processed_verification_key<ppT_ROM_SE>(
+                r1cs_rom_se_ppzksnark_verifier_process_vk<ppT_ROM_SE>(
+                    ((r1cs_rom_se_ppzksnark_keypair<ppT_ROM_SE> *) keypair_ROM_SE )->vk , profile ));
+
+        }else if ( proof_system == R1CS_GG ) {
+
+            // alpha_g1 is never zero in a key made by the generator , only in a default constructed one
+            if ( keypair_GG.vk.alpha_g1.is_zero() ) {
+                profile.leave_block("Create Verifier" );
+                strncpy (last_function_msg , "verify key is not loaded" , last_function_msg_size ); 
+                return 1 ;
+            }
+            
+            processed_vk_GG = new r1cs_gg_ppzksnark_processed_verification_key<ppT_GG>(
+                r1cs_gg_ppzksnark_verifier_process_vk<ppT_GG>( keypair_GG.vk , profile ));
+        }
+
+        profile.leave_block("Create Verifier" );
+
+        print_profile_logs("Create Verifier" , profile );
+        strncpy (last_function_msg , "success" , last_function_msg_size ); 
+        return 0 ;
+    }
+
+
+    template <typename FieldT , typename ppT_GG , typename ppT_ROM_SE >
+    void Context<FieldT,ppT_GG,ppT_ROM_SE>::release_verifier () {
+        if ( processed_vk_GG ) { try { delete processed_vk_GG ; } catch( const std::exception &e ){} }
+        if ( processed_vk_ROM_SE ) { try { delete processed_vk_ROM_SE ; } catch( const std::exception &e ){} }
+        processed_vk_GG = NULL ;
+        processed_vk_ROM_SE = NULL ;
+    }
+
+}
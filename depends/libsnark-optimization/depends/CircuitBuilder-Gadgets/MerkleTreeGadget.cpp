@@ -17,26 +17,113 @@
 namespace CircuitBuilder {
     namespace Gadgets {
 
+        /**
+         * Builds the tree level by level : [0,1,2,3] [4:0||1, 5:2||3] [6:4||5].
+         * The output holds every level, padding included, with the root last ; its size is
+         * known up front, so each level is written in place.
+         * The hashes of a level are independent, and their native witness routines ( MiMC7 , Poseidon )
+         * run as one batch ; SHA256 hashes have none, and are evaluated gate by gate.
+         * With QUEUE_ORDER, a "level" is every pair of nodes already there : [0,1,2] [3:0||1] [4:2||3].
+         */
         void MerkleTreeGadget::buildCircuit() {
-            // const int leafWireLength = leafWires.size();
-            unsigned long long int ptr = 0;
 
-            Wires treeNodes = leafWires;
-            HashGadget *hashGadget;
+            if (leafWires.size() == 0) {
+                throw invalid_argument("MerkleTreeGadget needs at least one leaf.");
+            }
+
+            outWires = Wires(numNodes(leafWires.size(), padding));
 
-            // [0,1,2,3] [4:0||1, 5:2||3] [6:4||5]
-            while (ptr+1 < treeNodes.size()) {
-                WirePtr leftNode = treeNodes[ptr];
-                WirePtr rightNode = treeNodes[ptr + 1];
+            size_t levelBegin = 0;
+            size_t levelSize = leafWires.size();
+            size_t pos = 0;
+
+            for (size_t i = 0; i < levelSize; i++) {
+                outWires[pos++] = leafWires[i];
+            }
 
-                vector <WirePtr> hashInput = {leftNode, rightNode};
-                hashGadget = allocate<HashGadget>(generator, hashInput);
+            if (padding == QUEUE_ORDER) {
+                size_t next = 0;
+                while (pos - next > 1) {
+                    const size_t parents = (pos - next) / 2;
+                    const size_t queuePosition = generator->getEvaluationQueue().size();
 
-                treeNodes = Util::concat(treeNodes ,hashGadget->getOutputWires());
-                ptr += 2;
+                    for (size_t i = 0; i < parents; i++) {
+                        vector<WirePtr> hashInput = {outWires[next + 2 * i], outWires[next + 2 * i + 1]};
+                        HashGadget *hashGadget = allocate<HashGadget>(generator, hashInput);
+                        outWires[pos + i] = hashGadget->getOutputWires()[0];
+                    }
+
+                    batchNativeWitness(queuePosition);
+
+                    next += 2 * parents;
+                    pos += parents;
+                }
+                return;
+            }
+
+            for (size_t level = 0; levelSize > 1; level++) {
+
+                bool promote = false;
+                if (levelSize % 2 == 1) {
+                    if (padding == PAD_WITH_ZERO) {
+                        outWires[pos++] = zeroRoot(level);
+                        levelSize++;
+                    } else if (padding == DUPLICATE_LAST) {
+                        outWires[pos] = outWires[pos - 1];
+                        pos++;
+                        levelSize++;
+                    } else {
+                        promote = true;
+                    }
+                }
+
+                const size_t parents = levelSize / 2;
+                const size_t queuePosition = generator->getEvaluationQueue().size();
+
+                for (size_t i = 0; i < parents; i++) {
+                    vector<WirePtr> hashInput = {outWires[levelBegin + 2 * i], outWires[levelBegin + 2 * i + 1]};
+                    HashGadget *hashGadget = allocate<HashGadget>(generator, hashInput);
+                    outWires[pos + i] = hashGadget->getOutputWires()[0];
+                }
+
+                batchNativeWitness(queuePosition);
+
+                const size_t nextBegin = pos;
+                pos += parents;
+                if (promote) {
+                    outWires[pos++] = outWires[levelBegin + levelSize - 1];
+                }
+
+                levelBegin = nextBegin;
+                levelSize = pos - nextBegin;
+            }
+        }
+
+
+        WirePtr MerkleTreeGadget::zeroRoot(size_t level) {
+            if (zeroRoots.empty()) {
+                zeroRoots.push_back(generator->zeroWire);
+            }
+            while (zeroRoots.size() <= level) {
+                vector<WirePtr> hashInput = {zeroRoots.back(), zeroRoots.back()};
+                HashGadget *hashGadget = allocate<HashGadget>(generator, hashInput);
+                zeroRoots.push_back(hashGadget->getOutputWires()[0]);
             }
+            return zeroRoots[level];
+        }
+
 
-            outWires = treeNodes;
+        size_t MerkleTreeGadget::numNodes(size_t numLeaves, PaddingPolicy padding) {
+            if (padding == QUEUE_ORDER) {
+                return numLeaves > 0 ? 2 * numLeaves - 1 : 0;
+            }
+            size_t total = 0;
+            size_t levelSize = numLeaves;
+            while (levelSize > 1) {
+                total += (levelSize % 2 == 1 && padding != PROMOTE_LAST) ? levelSize + 1 : levelSize;
+                levelSize = (levelSize + 1) / 2;
+            }
+            return total + levelSize;
         }
 
 
@@ -45,7 +132,7 @@ namespace CircuitBuilder {
                          Wires &_leafWires,
                          int _height,
                          string desc)
-                : Gadget(generator, desc), outWires(1) {
+                : Gadget(generator, desc), outWires(1), padding(QUEUE_ORDER) {
             leafWires = _leafWires;
             height = _height;
             if (leafWires.size() != static_cast<size_t>(height) ) {
@@ -58,7 +145,18 @@ namespace CircuitBuilder {
         MerkleTreeGadget(CircuitGenerator *generator,
                          Wires &_leafWires,
                          string desc)
-                : Gadget(generator, desc), outWires(1) {
+                : Gadget(generator, desc), outWires(1), padding(QUEUE_ORDER) {
+            leafWires = _leafWires;
+            height = (leafWires.size());
+            buildCircuit();
+        }
+
+        MerkleTreeGadget::
+        MerkleTreeGadget(CircuitGenerator *generator,
+                         Wires &_leafWires,
+                         PaddingPolicy _padding,
+                         string desc)
+                : Gadget(generator, desc), outWires(1), padding(_padding) {
             leafWires = _leafWires;
             height = (leafWires.size());
             buildCircuit();
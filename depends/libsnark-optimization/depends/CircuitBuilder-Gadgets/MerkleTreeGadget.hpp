@@ -18,14 +18,41 @@ namespace CircuitBuilder {
 
         class MerkleTreeGadget : public CircuitBuilder::Gadget {
 
+        public:
+
+            /**
+             * How a level with an odd number of nodes is completed.
+             *
+             * PAD_WITH_ZERO    the missing sibling is the root of an all-zero subtree, i.e. the
+             *                  leaves are padded with zeros up to the next power of two
+             * DUPLICATE_LAST   the last node is hashed with itself
+             * PROMOTE_LAST     the last node moves up to the next level unchanged
+             * QUEUE_ORDER      no level is completed : each node is hashed with the next one
+             *                  produced, as in a queue, e.g. H(2, H(0,1)) for three leaves.
+             *                  This is the tree of the constructors without a policy.
+             *
+             * All of them give the same tree for a power of two leaves.
+             */
+            enum PaddingPolicy {
+                PAD_WITH_ZERO = 0,
+                DUPLICATE_LAST = 1,
+                PROMOTE_LAST = 2,
+                QUEUE_ORDER = 3
+            };
+
         private:
 
             Wires outWires;
             Wires leafWires;
 
             int height;
+            PaddingPolicy padding;
+
+            // zeroRoots[l] is the root of an all-zero subtree of height l
+            vector<WirePtr> zeroRoots;
 
             void buildCircuit();
+            WirePtr zeroRoot(size_t level);
 
         public:
 
@@ -46,6 +73,21 @@ namespace CircuitBuilder {
              */
             MerkleTreeGadget(CircuitGenerator *generator, Wires &leafWires, string desc = "");
 
+            /**
+             * Any number of leaves ; odd levels are completed according to the padding policy.
+             * @param generator
+             * @param leafWires     Array of leafNode
+             * @param padding       Padding policy
+             * @param desc
+             */
+            MerkleTreeGadget(CircuitGenerator *generator, Wires &leafWires, PaddingPolicy padding, string desc = "");
+
+            /**
+             * Number of nodes in the tree built over numLeaves leaves, levels included,
+             * i.e. the size of getOutputWires().
+             */
+            static size_t numNodes(size_t numLeaves, PaddingPolicy padding);
+
             Wires &getOutputWires();
             WirePtr &getRootNode();
 
@@ -81,9 +81,15 @@ namespace Gadgets {
          * constants cheaper in our setting, so they are not counted)
          */
 
-        baseTable = preprocess(basePoint); 
-        
-        AffinePoint output = mul(basePoint, secretBits, baseTable);
+        AffinePoint output = AffinePoint(NULL, NULL);
+
+        if (generator->config.fixedBaseScalarMul && 
+            basePoint.x->instanceof_ConstantWire() && basePoint.y->instanceof_ConstantWire()) {
+            output = fixedBaseMul(secretBits);
+        } else {
+            baseTable = preprocess(basePoint); 
+            output = mul(basePoint, secretBits, baseTable);
+        }
          
         outputPublicValue[0] = output.x;
         outputPublicValue[1] = output.y;
@@ -105,11 +111,15 @@ namespace Gadgets {
 
 
 
-    class Evaluator : public Instruction  {
+    // native_ec_y_coordinate , params : COEFF_A as words ; inputs : x ; outputs : y
+    class Evaluator : public NativeWitnessInstruction  {
         ECGroupGeneratorGadget* parent ;
     public:
         Evaluator(CircuitGenerator * generator , ECGroupGeneratorGadget* __parent) 
-            : Instruction(generator) , parent(__parent) 
+            : NativeWitnessInstruction( generator , native_ec_y_coordinate , generator->getEvaluationQueue().size() ,
+                                        Wires( __parent->basePoint.x ) , { __parent->basePoint.y } ,
+                                        NativeWitnessInstruction::words( __parent->COEFF_A ) , NULL ) ,
+              parent(__parent) 
         {}
 
         void evaluate(CircuitEvaluator & evaluator) {
@@ -176,6 +186,127 @@ namespace Gadgets {
         return result;
     }
 
+
+    AffinePoint ECGroupGeneratorGadget::fixedBaseMul(Wires & secretBits) {
+
+        /**
+         * Window i selects (k_i + 1) * 2^(w*i) * Base, where k_i is the value of its
+         * bits, so no window selects the point at infinity. As in mul(), the
+         * accumulator starts at 2^SECRET_BITWIDTH * Base (folded into the first
+         * window) to keep the incomplete addition formulas away from doublings.
+         * The sum of the offsets is subtracted at the end.
+         */
+        BigInteger baseX = ((ConstantWire*) basePoint.x)->getConstant();
+        BigInteger baseY = ((ConstantWire*) basePoint.y)->getConstant();
+        BigIntegerAffinePoint windowBase = BigIntegerAffinePoint(baseX, baseY);
+
+        BigIntegerAffinePoint offset = windowBase;
+        for (size_t j = 0; j < secretBits.size(); j++) {
+            offset = doubleConstantPoint(offset);
+        }
+
+        BigIntegerAffinePoint correction = offset;
+
+        // the table of the next window, of width bits, after which windowBase and correction move on past it
+        auto windowTable = [&](size_t width) {
+            vector<BigIntegerAffinePoint> table ((size_t) 1 << width);
+            table[0] = windowBase;
+            for (size_t k = 1; k < table.size(); k++) {
+                table[k] = (k == 1) ? doubleConstantPoint(windowBase) : addConstantPoints(table[k - 1], windowBase);
+            }
+
+            correction = addConstantPoints(correction, windowBase);
+            for (size_t j = 0; j < width; j++) {
+                windowBase = doubleConstantPoint(windowBase);
+            }
+            return table;
+        };
+
+        size_t width = min((size_t) FIXED_BASE_WINDOW, secretBits.size());
+        vector<BigIntegerAffinePoint> table = windowTable(width);
+        for (size_t k = 0; k < table.size(); k++) {
+            table[k] = addConstantPoints(table[k], offset);
+        }
+        AffinePoint result = lookup(secretBits, 0, width, table);
+
+        for (size_t i = width; i < secretBits.size(); i += FIXED_BASE_WINDOW) {
+            width = min((size_t) FIXED_BASE_WINDOW, secretBits.size() - i);
+            table = windowTable(width);
+            result = addAffinePoints(result, lookup(secretBits, i, width, table));
+        }
+
+        AffinePoint correctionPoint = AffinePoint(generator->createConstantWire(correction.x), 
+                                                  generator->createConstantWire(correction.y));
+        return subAffinePoints(result, correctionPoint);
+    }
+
+
+    AffinePoint 
+    ECGroupGeneratorGadget::lookup(Wires & secretBits, 
+                                   size_t offset, size_t width, 
+                                   vector<BigIntegerAffinePoint> & table)
+    {
+        const BigInteger & FIELD_PRIME = generator->config.FIELD_PRIME;
+
+        // coefficients of the multilinear polynomials in the window bits that
+        // interpolate the x and y coordinates of the table
+        vector<BigInteger> coeffX (table.size());
+        vector<BigInteger> coeffY (table.size());
+        for (size_t k = 0; k < table.size(); k++) {
+            coeffX[k] = table[k].x;
+            coeffY[k] = table[k].y;
+        }
+        for (size_t j = 0; j < width; j++) {
+            for (size_t k = 0; k < table.size(); k++) {
+                if (k & ((size_t) 1 << j)) {
+                    coeffX[k] = coeffX[k].subtract(coeffX[k ^ ((size_t) 1 << j)]).mod(FIELD_PRIME);
+                    coeffY[k] = coeffY[k].subtract(coeffY[k ^ ((size_t) 1 << j)]).mod(FIELD_PRIME);
+                }
+            }
+        }
+
+        // monomials[k] is the product of the bits set in k
+        vector<WirePtr> monomials (table.size(), NULL);
+        WirePtr x = generator->createConstantWire(coeffX[0]);
+        WirePtr y = generator->createConstantWire(coeffY[0]);
+
+        for (size_t k = 1; k < table.size(); k++) {
+            size_t j = 0;
+            while (!(k & ((size_t) 1 << j))) {
+                j++;
+            }
+            size_t rest = k ^ ((size_t) 1 << j);
+            WirePtr bit = secretBits.get(offset + j);
+            monomials[k] = (rest == 0) ? bit : monomials[rest]->mul(bit);
+            x = x->add(monomials[k]->mul(coeffX[k]));
+            y = y->add(monomials[k]->mul(coeffY[k]));
+        }
+
+        return AffinePoint(x, y);
+    }
+
+
+    BigIntegerAffinePoint ECGroupGeneratorGadget::doubleConstantPoint(const BigIntegerAffinePoint & p) {
+        const BigInteger & FIELD_PRIME = generator->config.FIELD_PRIME;
+        BigInteger tmpx = p.x.multiply(p.x).multiply(3l).add(p.x.multiply(COEFF_A).multiply(2l)).add(1l).mod(FIELD_PRIME);
+        BigInteger l1 = tmpx.multiply(p.y.multiply(2l).mod(FIELD_PRIME).modInverse(FIELD_PRIME)).mod(FIELD_PRIME);
+        BigInteger l2 = l1.multiply(l1).mod(FIELD_PRIME);
+        BigInteger newX = l2.subtract(COEFF_A).subtract(p.x).subtract(p.x).mod(FIELD_PRIME);
+        BigInteger newY = p.x.multiply(3l).add(COEFF_A).subtract(l2).multiply(l1).subtract(p.y).mod(FIELD_PRIME);
+        return BigIntegerAffinePoint(newX, newY);
+    }
+
+
+    BigIntegerAffinePoint ECGroupGeneratorGadget::addConstantPoints(const BigIntegerAffinePoint & p1, const BigIntegerAffinePoint & p2) {
+        const BigInteger & FIELD_PRIME = generator->config.FIELD_PRIME;
+        BigInteger diffY = p1.y.subtract(p2.y).mod(FIELD_PRIME);
+        BigInteger diffX = p1.x.subtract(p2.x).mod(FIELD_PRIME);
+        BigInteger q = diffY.multiply(diffX.modInverse(FIELD_PRIME)).mod(FIELD_PRIME);
+        BigInteger newX = q.multiply(q).subtract(COEFF_A).subtract(p1.x).subtract(p2.x).mod(FIELD_PRIME);
+        BigInteger newY = p1.x.subtract(newX).multiply(q).subtract(p1.y).mod(FIELD_PRIME);
+        return BigIntegerAffinePoint(newX, newY);
+    }
+
     
     AffinePoint ECGroupGeneratorGadget::doubleAffinePoint(AffinePoint p) {
         WirePtr x_2 = p.x->mul(p.x);
@@ -37,6 +37,7 @@
 #include <Gadget.hpp>
 #include <CircuitGenerator.hpp>
 #include <AffinePoint.hpp>
+#include <BigIntegerAffinePoint.hpp>
 
 
 namespace CircuitBuilder {
@@ -55,6 +56,12 @@ namespace Gadgets {
         // See the constructor
         static const int SECRET_BITWIDTH = 254; 
 
+        // number of secret bits selecting one precomputed multiple when the
+        // base point is constant and Config::fixedBaseScalarMul is set. A window
+        // of w bits costs 2^w-w-1 gates for the lookup and one point addition,
+        // so 2 bits per window is the cheapest.
+        static const int FIXED_BASE_WINDOW = 2; 
+
         // parameterization in
         // https://eprint.iacr.org/2015/1093.pdf
         static BigInteger Global_COEFF_A ; 
@@ -114,6 +121,18 @@ namespace Gadgets {
          */
         AffinePoint mul(AffinePoint p, Wires & secretBits, vector<AffinePoint> & precomputedTable) ;
 
+        /**
+         * Performs scalar multiplication by a constant base point. The multiples of
+         * the base used by every window of FIXED_BASE_WINDOW secret bits are computed
+         * outside the circuit, so the circuit only selects one of them per window
+         * and adds it to the accumulated point.
+         */
+        AffinePoint fixedBaseMul(Wires & secretBits) ;
+        AffinePoint lookup(Wires & secretBits, size_t offset, size_t width, vector<BigIntegerAffinePoint> & table) ;
+
+        BigIntegerAffinePoint doubleConstantPoint(const BigIntegerAffinePoint & p) ;
+        BigIntegerAffinePoint addConstantPoints(const BigIntegerAffinePoint & p1, const BigIntegerAffinePoint & p2) ;
+
         AffinePoint doubleAffinePoint(AffinePoint p) ;
         AffinePoint addAffinePoints(AffinePoint p1, AffinePoint p2) ;
         AffinePoint subAffinePoints(AffinePoint p1, AffinePoint p2) ;
@@ -118,11 +118,15 @@ namespace Gadgets {
 
     
 
-    class Evaluator_1 : public Instruction  {
+    // native_ec_y_coordinate , params : COEFF_A as words ; inputs : x ; outputs : y
+    class Evaluator_1 : public NativeWitnessInstruction  {
         ECGroupOperationGadget* parent ;
     public:
         Evaluator_1(CircuitGenerator * generator , ECGroupOperationGadget* __parent) 
-        : Instruction(generator) , parent(__parent) {}
+        : NativeWitnessInstruction( generator , native_ec_y_coordinate , generator->getEvaluationQueue().size() ,
+                                    Wires( __parent->basePoint.x ) , { __parent->basePoint.y } ,
+                                    NativeWitnessInstruction::words( __parent->COEFF_A ) , NULL ) ,
+          parent(__parent) {}
 
         void evaluate(CircuitEvaluator &evaluator) {
             BigInteger x = evaluator.getWireValue(parent->basePoint.x);
@@ -130,11 +134,14 @@ namespace Gadgets {
         }
     } ;
 
-    class Evaluator_2 : public Instruction  {
+    class Evaluator_2 : public NativeWitnessInstruction  {
         ECGroupOperationGadget* parent ;
     public:
         Evaluator_2(CircuitGenerator * generator , ECGroupOperationGadget* __parent) 
-        : Instruction(generator) , parent(__parent) {}
+        : NativeWitnessInstruction( generator , native_ec_y_coordinate , generator->getEvaluationQueue().size() ,
+                                    Wires( __parent->hPoint.x ) , { __parent->hPoint.y } ,
+                                    NativeWitnessInstruction::words( __parent->COEFF_A ) , NULL ) ,
+          parent(__parent) {}
 
         void evaluate(CircuitEvaluator &evaluator) {
             BigInteger x = evaluator.getWireValue(parent->hPoint.x);
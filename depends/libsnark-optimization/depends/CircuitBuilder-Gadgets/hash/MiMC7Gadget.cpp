@@ -25,7 +25,7 @@ namespace Gadgets {
 					string desc ) 
 		: Gadget(generator , desc) , outWires(1)
 	{
-		outWires[0] = Encrypt(inputLeft, inputRight)->add(inputLeft)->add(inputRight);
+		outWires[0] = hash(inputLeft, inputRight);
 	}
 
 
@@ -38,12 +38,12 @@ namespace Gadgets {
 		
 		if( inputs.size() == 1){
          
-            outWires[0] = Encrypt(inputs[0], inputs[0])->add(inputs[0])->add(inputs[0]);
+            outWires[0] = hash(inputs[0], inputs[0]);
         
         }else{
             WirePtr output = inputs[0];
             for(size_t i=1; i<inputs.size() ; i++) {
-            	WirePtr mimc7 = Encrypt(output, inputs[i])->add(output)->add(inputs[i]);
+            	WirePtr mimc7 = hash(output, inputs[i]);
                 output = mimc7;
             }
             outWires[0] = output ;
@@ -51,14 +51,39 @@ namespace Gadgets {
 	}
 
 
+	/**
+	 * Encrypt(left, right) + left + right. The wires of the rounds are recorded, in order,
+	 * for a native witness routine (native_mimc7) that computes them in one shot.
+	 */
+	WirePtr MiMC7Gadget::hash(WirePtr left, WirePtr right){
+
+		beginNativeWitness();
+		nativeOutputs.clear();
+
+		WirePtr output = Encrypt(left, right)->add(left);
+		nativeOutputs.push_back(output);
+		output = output->add(right);
+		nativeOutputs.push_back(output);
+
+		specifyNativeWitness(native_mimc7, Wires(left, right), nativeOutputs, { (uint32_t) numRounds }, &roundConstants);
+
+		return output;
+	}
+
+
 	WirePtr MiMC7Gadget::MiMC_round(WirePtr message, WirePtr key, const BigInteger & rc){
         
-        WirePtr xored = message->add(key)->add(rc); // mod prime automatically
+        WirePtr xored = message->add(key);
+        nativeOutputs.push_back(xored);
+        xored = xored->add(rc); // mod prime automatically
+        nativeOutputs.push_back(xored);
         
         WirePtr tmp = xored;
         for (int i=0; i<2; i++) {
             tmp = tmp->mul(tmp);
+            nativeOutputs.push_back(tmp);
             xored = xored->mul(tmp);
+            nativeOutputs.push_back(xored);
         }
         return xored;
     }
@@ -75,7 +100,10 @@ namespace Gadgets {
             result = MiMC_round(result, key, roundConstants[i]);
         }
 
-        return result->add(key);
+        result = result->add(key);
+        nativeOutputs.push_back(result);
+
+        return result;
     }
 
 
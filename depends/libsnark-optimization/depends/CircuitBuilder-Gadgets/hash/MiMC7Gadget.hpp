@@ -17,6 +17,7 @@ namespace Gadgets {
 	private:
 
 		Wires outWires;
+		vector<WirePtr> nativeOutputs;
 
 		/**
 	     * MiMC specialized for Fr in ALT-BN128, in which the exponent is 7 and 91
@@ -26,6 +27,7 @@ namespace Gadgets {
     	static const int numRounds = 91;
     	static vector<BigInteger> roundConstants;
 
+		WirePtr hash(WirePtr left, WirePtr right);
 		WirePtr MiMC_round(WirePtr message, WirePtr key, const BigInteger & rc);
 		WirePtr Encrypt(WirePtr message, WirePtr ek) ;
 		static BigInteger _keccak256( vector<uint8_t> & inputs ) ;
@@ -34,7 +34,12 @@ namespace Gadgets {
         state = { generator->zeroWire };
         state = Util::concat(state, inputs);
 
+        beginNativeWitness();
+        Wires initialState = state;
+
         buildCircuit();
+
+        specifyNativeWitness(native_poseidon, initialState, nativeOutputs, { (uint32_t) t, (uint32_t) nRoundsF, (uint32_t) nRoundsP, (uint32_t) c.size(), (uint32_t) s.size() }, &nativeConstants[t-2]);
     }
 
     void PoseidonGadget::buildCircuit()
@@ -53,14 +58,21 @@ namespace Gadgets {
         for (int i = 0; i < nRoundsP; i++) {
             state[0] = exp5(state[0]);
             state[0] = state[0]->add(c[(NUM_ROUNDS_F / 2 + 1) * t + i]);
+            nativeOutputs.push_back(state[0]);
 
             WirePtr newState0 = generator->zeroWire;
             for (int j = 0; j < t; j++) {
-                newState0 = newState0->add(state[j]->mul(s[(t * 2 - 1) * i + j]));
+                WirePtr term = state[j]->mul(s[(t * 2 - 1) * i + j]);
+                nativeOutputs.push_back(term);
+                newState0 = newState0->add(term);
+                nativeOutputs.push_back(newState0);
             }
 
             for (int k = 1; k < t; k++) {
-                state[k] = state[k]->add(state[0]->mul(s[(t * 2 - 1) * i + t + k - 1]));
+                WirePtr term = state[0]->mul(s[(t * 2 - 1) * i + t + k - 1]);
+                nativeOutputs.push_back(term);
+                state[k] = state[k]->add(term);
+                nativeOutputs.push_back(state[k]);
             }
             state[0] = newState0 ;
         }
@@ -81,8 +93,12 @@ namespace Gadgets {
     {
         WirePtr a2 = a->mul(a);
         WirePtr a4 = a2->mul(a2);
+        WirePtr a5 = a4->mul(a);
 
-        return a4->mul(a);
+        nativeOutputs.push_back(a2);
+        nativeOutputs.push_back(a4);
+        nativeOutputs.push_back(a5);
+        return a5;
     }
 
     void PoseidonGadget::exp5state()
@@ -98,6 +114,7 @@ namespace Gadgets {
         for (int i = 0; i < t; i++)
         {
             state[i] = state[i]->add(c[r + i]);
+            nativeOutputs.push_back(state[i]);
         }
     }
 
@@ -109,7 +126,10 @@ namespace Gadgets {
             newState[i] = generator->zeroWire;
             for (int j = 0; j < t; j++)
             {
-                newState[i] = newState[i]->add(state[j]->mul(_m[j][i]));
+                WirePtr term = state[j]->mul(_m[j][i]);
+                nativeOutputs.push_back(term);
+                newState[i] = newState[i]->add(term);
+                nativeOutputs.push_back(newState[i]);
             }
         }
         state = newState;
@@ -127,6 +147,7 @@ namespace Gadgets {
     vector<vector<vector<BigInteger>>> PoseidonGadget::P;
     vector<vector<BigInteger>> PoseidonGadget::C;
     vector<vector<BigInteger>> PoseidonGadget::S;
+    vector<vector<BigInteger>> PoseidonGadget::nativeConstants;
 
     void PoseidonGadget::load_opt_constants()
     {   
@@ -194,6 +215,16 @@ namespace Gadgets {
         
         load_opt_constants() ;
 
+        // the constants of the native witness routine, per state size : C, S, then M and P row by row
+        nativeConstants = vector<vector<BigInteger>>(C.size());
+        for (size_t i = 0; i < C.size(); i++) {
+            vector<BigInteger> & constants = nativeConstants[i];
+            constants.insert(constants.end(), C[i].begin(), C[i].end());
+            constants.insert(constants.end(), S[i].begin(), S[i].end());
+            for (auto & row : M[i]) { constants.insert(constants.end(), row.begin(), row.end()); }
+            for (auto & row : P[i]) { constants.insert(constants.end(), row.begin(), row.end()); }
+        }
+
         return;
     }
 
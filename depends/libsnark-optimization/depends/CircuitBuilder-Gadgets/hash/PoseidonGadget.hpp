@@ -24,6 +24,7 @@ namespace Gadgets {
                 static vector<vector<vector<BigInteger>>> P ;
                 static vector<vector<BigInteger>> C ;
                 static vector<vector<BigInteger>> S ;
+                static vector<vector<BigInteger>> nativeConstants ;
 
                 int t ;
                 int nRoundsP ;
@@ -34,6 +35,7 @@ namespace Gadgets {
                 vector<vector<BigInteger>> p ;
                 Wires outWires ;
                 Wires state ;
+                vector<WirePtr> nativeOutputs ;
 
                 WirePtr exp5(WirePtr a) ;
                 void exp5state() ;
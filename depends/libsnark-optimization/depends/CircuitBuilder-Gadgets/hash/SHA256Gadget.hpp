@@ -12,6 +12,11 @@
 namespace CircuitBuilder {
 namespace Gadgets {
 
+	/**
+	 * Unlike MiMC7Gadget and PoseidonGadget, this gadget registers no native witness routine :
+	 * its witness is bit level, and the rotations, xors and packs share wires through the
+	 * operation cache, so the evaluation program runs its BasicOps one by one.
+	 */
 	class SHA256Gadget : public Gadget {
 
 	private:
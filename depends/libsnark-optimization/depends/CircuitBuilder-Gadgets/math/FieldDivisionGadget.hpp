@@ -25,11 +25,15 @@ namespace Gadgets {
 
 
 
-		class Evaluator : public Instruction  {
+		// native_field_division , inputs : a , b ; outputs : c
+		class Evaluator : public NativeWitnessInstruction  {
 	        FieldDivisionGadget* parent ;
 	    public:
 	        Evaluator(CircuitGenerator * generator , FieldDivisionGadget* __parent) 
-	        	: Instruction(generator) , parent(__parent) {}
+	        	: NativeWitnessInstruction( generator , native_field_division , generator->getEvaluationQueue().size() ,
+	        								Wires( __parent->a , __parent->b ) , { __parent->c } ,
+	        								vector<uint32_t>() , NULL ) ,
+	        	  parent(__parent) {}
 
     		void evaluate(CircuitEvaluator & evaluator) {
 				BigInteger aValue = evaluator.getWireValue(parent->a);
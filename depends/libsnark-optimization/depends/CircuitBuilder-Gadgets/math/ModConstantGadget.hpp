@@ -35,12 +35,16 @@ namespace Gadgets {
         friend class Evaluator ;
 
 
-		class Evaluator : public Instruction  {
+		// native_mod_constant , params : c as words ; inputs : ab ; outputs : r , q
+		class Evaluator : public NativeWitnessInstruction  {
 	        ModConstantGadget* parent ;
 	        WirePtr ab ;
 	    public:
 	        Evaluator(CircuitGenerator * generator , ModConstantGadget* __parent , WirePtr __ab ) 
-	        	: Instruction(generator) , parent(__parent), ab(__ab) {}
+	        	: NativeWitnessInstruction( generator , native_mod_constant , generator->getEvaluationQueue().size() ,
+	        								Wires( __ab ) , { __parent->r , __parent->q } ,
+	        								NativeWitnessInstruction::words( __parent->c ) , NULL ) ,
+	        	  parent(__parent), ab(__ab) {}
 
 	        void evaluate(CircuitEvaluator & evaluator) {
 				BigInteger mulValue = evaluator.getWireValue(ab);
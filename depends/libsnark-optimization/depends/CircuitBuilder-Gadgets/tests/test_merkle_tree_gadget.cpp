@@ -0,0 +1,195 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <global.hpp>
+#include <BigInteger.hpp>
+#include <Wire.hpp>
+#include <WireArray.hpp>
+#include <CircuitGenerator.hpp>
+#include <CircuitEvaluator.hpp>
+
+#include <MerkleTreeGadget.hpp>
+#include <hash/HashGadget.hpp>
+#include <hash/MiMC7Gadget.hpp>
+#include <hash/PoseidonGadget.hpp>
+
+using namespace CircuitBuilder;
+using namespace CircuitBuilder::Gadgets;
+
+typedef MerkleTreeGadget::PaddingPolicy PaddingPolicy;
+
+static const std::vector<PaddingPolicy> policies = {
+    MerkleTreeGadget::PAD_WITH_ZERO,
+    MerkleTreeGadget::DUPLICATE_LAST,
+    MerkleTreeGadget::PROMOTE_LAST,
+    MerkleTreeGadget::QUEUE_ORDER
+};
+
+/*
+  The trees over numLeaves input leaves with every padding policy, and with the constructors
+  without a policy, next to the roots they should have, hashed pair by pair.
+*/
+class MerkleCircuit : public CircuitGenerator {
+
+    int numLeaves;
+    WiresPtr leaves;
+
+    WirePtr hash(WirePtr left, WirePtr right)
+    {
+        vector<WirePtr> hashInput = {left, right};
+        return allocate<HashGadget>(this, hashInput)->getOutputWires()[0];
+    }
+
+    /* the root each policy should give , hashed pair by pair */
+    WirePtr expectedRoot(PaddingPolicy padding)
+    {
+        Wires &l = *leaves;
+
+        if (numLeaves == 4)
+        {
+            return hash(hash(l[0], l[1]), hash(l[2], l[3]));
+        }
+
+        if (numLeaves == 3)
+        {
+            switch (padding)
+            {
+                case MerkleTreeGadget::PAD_WITH_ZERO:  return hash(hash(l[0], l[1]), hash(l[2], zeroWire));
+                case MerkleTreeGadget::DUPLICATE_LAST: return hash(hash(l[0], l[1]), hash(l[2], l[2]));
+                case MerkleTreeGadget::PROMOTE_LAST:   return hash(hash(l[0], l[1]), l[2]);
+                default:                               return hash(l[2], hash(l[0], l[1]));
+            }
+        }
+
+        /* five leaves */
+        WirePtr h01 = hash(l[0], l[1]);
+        WirePtr h23 = hash(l[2], l[3]);
+        switch (padding)
+        {
+            case MerkleTreeGadget::PAD_WITH_ZERO:
+                return hash(hash(h01, h23), hash(hash(l[4], zeroWire), hash(zeroWire, zeroWire)));
+            case MerkleTreeGadget::DUPLICATE_LAST:
+            {
+                WirePtr h44 = hash(l[4], l[4]);
+                return hash(hash(h01, h23), hash(h44, h44));
+            }
+            case MerkleTreeGadget::PROMOTE_LAST:
+                return hash(hash(h01, h23), l[4]);
+            default:
+                return hash(h23, hash(l[4], h01));
+        }
+    }
+
+protected:
+
+    void buildCircuit()
+    {
+        leaves = createInputWireArray(numLeaves, "leaves");
+
+        for (PaddingPolicy padding : policies)
+        {
+            MerkleTreeGadget *tree = allocate<MerkleTreeGadget>(this, *leaves, padding);
+            assert(tree->getOutputWires().size() == MerkleTreeGadget::numNodes(numLeaves, padding));
+            roots.push_back(std::make_pair(tree->getRootNode(), expectedRoot(padding)));
+        }
+
+        /* the constructors without a policy pair the nodes in queue order */
+        MerkleTreeGadget *tree = allocate<MerkleTreeGadget>(this, *leaves);
+        assert(tree->getOutputWires().size() == (size_t) 2 * numLeaves - 1);
+        roots.push_back(std::make_pair(tree->getRootNode(), expectedRoot(MerkleTreeGadget::QUEUE_ORDER)));
+
+        tree = allocate<MerkleTreeGadget>(this, *leaves, numLeaves);
+        roots.push_back(std::make_pair(tree->getRootNode(), expectedRoot(MerkleTreeGadget::QUEUE_ORDER)));
+    }
+
+public:
+
+    std::vector<std::pair<WirePtr, WirePtr> > roots;
+
+    MerkleCircuit(int __numLeaves, Config &config)
+        : CircuitGenerator("MerkleCircuit", config), numLeaves(__numLeaves), leaves(NULL) {}
+
+    void assignInputs(CircuitEvaluator &evaluator) { assign_inputs(evaluator); }
+
+    void finalize()
+    {
+        if (leaves) { delete leaves; }
+        CircuitGenerator::finalize();
+    }
+};
+
+Config merkle_circuit_config(const string &hashType)
+{
+    Config config;
+    config.FIELD_PRIME = BigInteger("21888242871839275222246405745257275088548364400416034343698204186575808495617", 10);
+    config.LOG2_FIELD_PRIME = config.FIELD_PRIME.size_in_base(2);
+    config.outputVerbose = false;
+    config.debugVerbose = false;
+    config.hashType = hashType;
+    return config;
+}
+
+void test_merkle_tree_roots(const int numLeaves, const string &hashType)
+{
+    Config config = merkle_circuit_config(hashType);
+    MerkleCircuit *generator = new MerkleCircuit(numLeaves, config);
+    generator->generateCircuit();
+
+    for (int i = 0; i < numLeaves; ++i)
+    {
+        generator->update_primary_input_array("leaves", i, 7 * i + 3);
+    }
+    generator->evalCircuit();
+    CircuitEvaluator *evaluator = generator->getCircuitEvaluator();
+
+    std::vector<BigInteger> values;
+    for (auto &root : generator->roots)
+    {
+        const BigInteger value = evaluator->getWireValue(root.first);
+        assert(value.equals(evaluator->getWireValue(root.second)));
+        values.push_back(value);
+    }
+
+    /* a power of two leaves gives one tree , whatever the policy */
+    if ((numLeaves & (numLeaves - 1)) == 0)
+    {
+        for (auto &value : values)
+        {
+            assert(value.equals(values[0]));
+        }
+    }
+
+    printf("* Merkle tree roots over %d leaves with %s , every padding policy\n", numLeaves, hashType.c_str());
+
+    generator->finalize();
+    delete generator;
+}
+
+int main(void)
+{
+    MiMC7Gadget::init_static_members();
+    PoseidonGadget::init_static_members();
+
+    assert(MerkleTreeGadget::numNodes(3, MerkleTreeGadget::QUEUE_ORDER) == 5);
+    assert(MerkleTreeGadget::numNodes(3, MerkleTreeGadget::PAD_WITH_ZERO) == 7);
+    assert(MerkleTreeGadget::numNodes(3, MerkleTreeGadget::PROMOTE_LAST) == 6);
+    assert(MerkleTreeGadget::numNodes(1, MerkleTreeGadget::PAD_WITH_ZERO) == 1);
+
+    for (const string hashType : { "MiMC7", "Poseidon" })
+    {
+        test_merkle_tree_roots(4, hashType);
+        test_merkle_tree_roots(3, hashType);
+        test_merkle_tree_roots(5, hashType);
+    }
+
+    return 0;
+}
@@ -18,12 +18,18 @@ namespace CircuitBuilder {
 		BigInteger CURVE_ORDER ;
 		BigInteger SUBGROUP_ORDER ;
 		string hashType;
+		bool memoizeGadgets ;
+		bool optimizeConstraintSystem ;
+		bool fixedBaseScalarMul ;
 
 		Config() : FIELD_PRIME(0l) , CURVE_ORDER(0l) {
 			
 			hexOutputEnabled = true ;
 			outputVerbose = true ;
 			debugVerbose = true ;
+			memoizeGadgets = false ;
+			optimizeConstraintSystem = false ;
+			fixedBaseScalarMul = false ;
 
 			evaluationQueue_size = 0 ;
 			inWires_size = 0 ;
@@ -31,6 +31,24 @@ namespace CircuitBuilder {
 		valueAssignment = vector<BigInteger>(circuitGenerator->getNumWires() , BigInteger(0l) );
 		valueAssignmentFlag = vector<bool>(circuitGenerator->getNumWires() , false );
 		valueAssignment[circuitGenerator->oneWire->getWireId()] = BigInteger::ONE() ;
+		assignmentLog = NULL ;
+	}
+
+
+	void CircuitEvaluator::reset(){
+		for ( auto & v : valueAssignment ){ v.assign( 0l ) ; }
+		std::fill( valueAssignmentFlag.begin() , valueAssignmentFlag.end() , false );
+		valueExternalFlag.clear() ;
+		externalValue = nullptr ;
+		assignmentLog = NULL ;
+		valueAssignment[circuitGenerator->oneWire->getWireId()] = BigInteger::ONE() ;
+	}
+
+
+	void CircuitEvaluator::assigned( wireID_t wireID ){
+		valueAssignmentFlag[wireID] = true ;
+		if ( valueExternalFlag.size() ){ valueExternalFlag[wireID] = false ; }
+		if ( assignmentLog ){ assignmentLog->push_back(wireID) ; }
 	}
 
 
@@ -39,7 +57,7 @@ namespace CircuitBuilder {
 			throw invalid_argument("Only positive values that are less than the modulus are allowed for this method.");
 		}
 		valueAssignment[wire->getWireId()] = v;
-		valueAssignmentFlag[wire->getWireId()] = true ;
+		assigned(wire->getWireId()) ;
 		return ;
 	}
 
@@ -49,7 +67,7 @@ namespace CircuitBuilder {
 			throw invalid_argument("Only positive values that are less than the modulus are allowed for this method.");
 		}
 		valueAssignment[wire->getWireId()] = BigInteger( v );
-		valueAssignmentFlag[wire->getWireId()] = true ;
+		assigned(wire->getWireId()) ;
 		return ;
 	}
 
@@ -59,7 +77,7 @@ namespace CircuitBuilder {
 			throw invalid_argument("Only positive values that are less than the modulus are allowed for this method.");
 		}
 		valueAssignment[wire.getWireId()] = v;
-		valueAssignmentFlag[wire.getWireId()] = true ;
+		assigned(wire.getWireId()) ;
 		return ;
 	}
 
@@ -69,7 +87,7 @@ namespace CircuitBuilder {
 			throw invalid_argument("Only positive values that are less than the modulus are allowed for this method.");
 		}
 		valueAssignment[wire.getWireId()] = BigInteger( v );
-		valueAssignmentFlag[wire.getWireId()] = true ;
+		assigned(wire.getWireId()) ;
 		return ;
 	}
 
@@ -110,7 +128,7 @@ namespace CircuitBuilder {
 			
 		if ( getAsignFlag(w->getWireId()) ){
 
-			return valueAssignment[w->getWireId()];
+			return getAssignment(w->getWireId());
 
 		}else{
 
@@ -120,7 +138,7 @@ namespace CircuitBuilder {
 			if (bits != NULL) {
 				BigInteger sum = BigInteger::ZERO() ;
 				for (size_t i = 0; i < bits->size(); i++) {
-					sum.__add(valueAssignment[bits->get(i)->getWireId()].shiftLeft(i));
+					sum.__add(getAssignment(bits->get(i)->getWireId()).shiftLeft(i));
 				}
 				ret_val = sum;
 			}
@@ -154,6 +172,16 @@ namespace CircuitBuilder {
 		}
 
 		 
+		checkAssignments();
+		
+		LOGD("Circuit Evaluation Done for < %s >\n\n" , circuitGenerator->getName().c_str() );
+
+		return ;
+	}
+
+
+	void CircuitEvaluator::checkAssignments() {
+		
 		// check that each wire has been assigned a value
 		wireID_t cc = (wireID_t) valueAssignment.size() ;
 		for ( wireID_t i = 0; i < cc ; i++) {
@@ -161,10 +189,21 @@ namespace CircuitBuilder {
 				throw  runtime_error(string( "Wire# " + to_string(i) + "is without value" ));
 			}
 		}
-		
-		LOGD("Circuit Evaluation Done for < %s >\n\n" , circuitGenerator->getName().c_str() );
+	}
 
-		return ;
+
+	/**
+	 * Hands the given wires over to an external evaluation (see EvaluationProgram).
+	 * They count as assigned, and the BigInteger value is fetched from the reader the
+	 * first time an instruction asks for it.
+	 */
+	void CircuitEvaluator::bindExternalValues( std::function<void( wireID_t , BigInteger & )> reader , const vector<wireID_t> & wires ) {
+		externalValue = reader ;
+		valueExternalFlag.assign( valueAssignment.size() , false );
+		for ( wireID_t wireID : wires ){
+			valueExternalFlag[wireID] = true ;
+			valueAssignmentFlag[wireID] = true ;
+		}
 	}
 
 
@@ -185,7 +224,7 @@ namespace CircuitBuilder {
 					 (wl->getType() == LabelType::nizkinput)) 
 				{
 					int id = wl->getWire()->getWireId();
-					printWriter << id << " " << valueAssignment[id].toString(16) << endline  ;
+					printWriter << id << " " << getAssignment(id).toString(16) << endline  ;
 				}
 			}
 		}
@@ -194,6 +233,10 @@ namespace CircuitBuilder {
 	}
 
 	const BigInteger & CircuitEvaluator::getAssignment(wireID_t wireID) const {
+		if ( valueExternalFlag.size() && valueExternalFlag[wireID] ){
+			externalValue( wireID , valueAssignment[wireID] );
+			valueExternalFlag[wireID] = false ;
+		}
 		return valueAssignment[wireID] ;
 	}
 
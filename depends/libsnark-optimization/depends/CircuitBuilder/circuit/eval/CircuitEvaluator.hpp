@@ -12,9 +12,17 @@ namespace CircuitBuilder {
 	private : 
 	
 		CircuitGenerator *circuitGenerator;
-		vector<BigInteger> valueAssignment;
+		mutable vector<BigInteger> valueAssignment;
 		vector<bool> valueAssignmentFlag;
 
+		// wires whose value is held outside the evaluator, fetched on first read
+		mutable vector<bool> valueExternalFlag;
+		std::function<void( wireID_t , BigInteger & )> externalValue ;
+
+		vector<wireID_t> * assignmentLog ;
+
+		void assigned( wireID_t wireID ) ;
+
 		friend class CircuitGenerator ;
 	 		
 	public : 
@@ -22,6 +30,8 @@ namespace CircuitBuilder {
 		CircuitEvaluator(CircuitGenerator *circuitGenerator);  
 		~CircuitEvaluator(){ valueAssignment.clear() ; }
 
+		void reset() ;
+
 		void setWireValue(WirePtr w, const BigInteger &v) ;
 		void setWireValue(WirePtr w, long v) ;
 		void setWireValue(Wire &w, const BigInteger &v) ;
@@ -41,6 +51,12 @@ namespace CircuitBuilder {
 
 		void evaluate() ;
 
+		void checkAssignments() ;
+
+		void bindExternalValues( std::function<void( wireID_t , BigInteger & )> reader , const vector<wireID_t> & wires ) ;
+
+		void recordAssignments( vector<wireID_t> * log ) { assignmentLog = log ; }
+
 		void printInputs( std::ostream & printWriter , string endline = "\n") ;
 
 		const BigInteger & getAssignment( wireID_t wireID ) const ;
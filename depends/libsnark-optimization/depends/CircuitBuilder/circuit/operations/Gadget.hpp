@@ -3,6 +3,7 @@
 
 #include <global.hpp>
 #include <CircuitGenerator.hpp>
+#include <NativeWitnessInstruction.hpp>
 
 
 namespace CircuitBuilder { 
@@ -14,10 +15,66 @@ namespace CircuitBuilder {
 		CircuitGenerator *generator;
 		string description;
 
+		// where the gadget started, for a native witness routine
+		size_t nativeWitnessPosition ;
+		wireID_t nativeWitnessFirstWire ;
+
+		void beginNativeWitness() {
+			nativeWitnessPosition = generator->getEvaluationQueue().size() ;
+			nativeWitnessFirstWire = generator->getNumWires() ;
+		}
+
+		/**
+		 * Registers one native routine computing the wires added since beginNativeWitness().
+		 * The outputs are listed in the order the routine computes them ; the ones the gadget
+		 * did not create (cached operations) are left to the instructions that did.
+		 */
+		void specifyNativeWitness( NativeWitnessType type ,
+								   const Wires & inputs ,
+								   const vector<WirePtr> & outputs ,
+								   const vector<uint32_t> & params ,
+								   const vector<BigInteger> * constants ) {
+
+			vector<WirePtr> created( outputs );
+			for ( WirePtr & w : created ){
+				if ( w->getWireId() < nativeWitnessFirstWire ){ w = NULL ; }
+			}
+
+			NativeWitnessInstruction * instruction = 
+				new NativeWitnessInstruction( generator , type , nativeWitnessPosition , inputs , created , params , constants );
+			add_allocation( generator , instruction );
+			generator->specifyProverWitnessComputation( instruction );
+		}
+
+		/**
+		 * Runs the native routines registered since the given queue position ( by the gadgets
+		 * allocated in between ) as one native_batch instruction , when they are all alike.
+		 * The routines must not read each other's outputs.
+		 */
+		void batchNativeWitness( size_t queuePosition ) {
+
+			EvaluationQueue & queue = generator->getEvaluationQueue() ;
+			vector<NativeWitnessInstruction*> members ;
+
+			for ( size_t i = queuePosition ; i < queue.size() ; i++ ){
+				InstructionPtr e = queue.at( i ) ;
+				if ( e->instanceof_NativeWitnessInstruction() ){
+					members.push_back( (NativeWitnessInstruction*) e );
+				}
+			}
+
+			NativeWitnessInstruction * instruction = NativeWitnessInstruction::batch( generator , members );
+			if ( instruction ){
+				add_allocation( generator , instruction );
+				generator->specifyProverWitnessComputation( instruction );
+			}
+		}
+
 	public :
 
 		Gadget(CircuitGenerator * __generator , string desc = "") 
-			: generator(__generator) , description (desc) 
+			: generator(__generator) , description (desc) ,
+			  nativeWitnessPosition(0) , nativeWitnessFirstWire(0)
 		{
 			class_id = class_id | Object::Gadget_Mask ;
 		}
@@ -0,0 +1,140 @@
+
+#pragma once
+
+
+#include <global.hpp>
+#include <Instruction.hpp>
+#include <Wire.hpp>
+#include <WireArray.hpp>
+
+
+namespace CircuitBuilder {
+
+	enum NativeWitnessType {
+		native_mimc7 = 1 ,
+		native_poseidon = 2 ,
+		native_batch = 3 ,
+		native_field_division = 4 ,
+		native_mod_constant = 5 ,
+		native_ec_y_coordinate = 6
+	} ;
+
+
+	/**
+	 * A native witness routine registered by a gadget (see Gadget::specifyNativeWitness).
+	 *
+	 * The gadget still adds its BasicOps, so the constraints and the gate by gate evaluation
+	 * in the CircuitEvaluator are unchanged. The instruction only describes the computation
+	 * to a witness generator that can run it in one shot : the routine type, its parameters,
+	 * the input wires, and every wire the routine fills, in the order it computes them.
+	 * Wires created before the gadget (cached operations) are reported as NULL.
+	 *
+	 * A prover hint ( a witness computed outside of the circuit ) is a subclass that overrides
+	 * evaluate() , and is registered with specifyProverWitnessComputation at its own position.
+	 */
+	class NativeWitnessInstruction : public Instruction {
+
+	private :
+
+		NativeWitnessType type ;
+		size_t queuePosition ;
+		Wires inputs ;
+		vector<WirePtr> outputs ;
+		vector<uint32_t> params ;
+		const vector<BigInteger> * constants ;
+		bool batched ;
+
+	public :
+
+		NativeWitnessInstruction(CircuitGenerator * generator ,
+								 NativeWitnessType __type ,
+								 size_t __queuePosition ,
+								 const Wires & __inputs ,
+								 const vector<WirePtr> & __outputs ,
+								 const vector<uint32_t> & __params ,
+								 const vector<BigInteger> * __constants )
+			: Instruction(generator) ,
+			  type(__type) , queuePosition(__queuePosition) ,
+			  inputs(__inputs) , outputs(__outputs) , params(__params) , constants(__constants) ,
+			  batched(false)
+		{
+			class_id = class_id | Object::NativeWitnessInstruction_Mask ;
+		}
+
+		void evaluate(CircuitEvaluator &evaluator) {
+			UNUSEDPARAM(evaluator)
+			// nothing to do : the BasicOps of the gadget compute the same wires.
+		}
+
+		NativeWitnessType getType() const { return type ; }
+
+		// the position, in the evaluation queue, of the first instruction added by the gadget
+		size_t getQueuePosition() const { return queuePosition ; }
+
+		const Wires & getInputs() const { return inputs ; }
+
+		const vector<WirePtr> & getOutputs() const { return outputs ; }
+
+		const vector<uint32_t> & getParams() const { return params ; }
+
+		// shared by every instance of the gadget
+		const vector<BigInteger> & getConstants() const {
+			static const vector<BigInteger> none ;
+			return constants ? *constants : none ;
+		}
+
+		// the routine runs as part of a native_batch instruction
+		bool isBatched() const { return batched ; }
+
+		/**
+		 * A number too large for a field element, as a params run : the word count , then
+		 * the 32 bit words , least significant first.
+		 */
+		static vector<uint32_t> words( const BigInteger & x ){
+			size_t count = 0 ;
+			vector<uint32_t> w( 1 + ( mpz_sizeinbase( x.get_mpz() , 2 ) + 31 ) / 32 , 0 );
+			mpz_export( w.data() + 1 , &count , -1 , sizeof(uint32_t) , 0 , 0 , x.get_mpz() );
+			w[0] = (uint32_t) count ;
+			w.resize( 1 + count );
+			return w ;
+		}
+
+		/**
+		 * Merges routines of the same type , params and constants into one native_batch
+		 * instruction placed at the first member's position. Returns NULL , and leaves the
+		 * routines alone , when they differ or there are fewer than two.
+		 */
+		static NativeWitnessInstruction * batch( CircuitGenerator * generator , const vector<NativeWitnessInstruction*> & members ){
+
+			if ( members.size() < 2 ){ return NULL ; }
+
+			const NativeWitnessInstruction * first = members[0] ;
+			for ( const NativeWitnessInstruction * m : members ){
+				if ( m->type != first->type || m->type == native_batch || m->batched ||
+					 m->params != first->params || m->constants != first->constants ||
+					 m->inputs.size() != first->inputs.size() || m->outputs.size() != first->outputs.size() )
+				{
+					return NULL ;
+				}
+			}
+
+			vector<uint32_t> batchParams = { (uint32_t) first->type , (uint32_t) members.size() } ;
+			batchParams.insert( batchParams.end() , first->params.begin() , first->params.end() );
+
+			vector<WirePtr> batchInputs ;
+			vector<WirePtr> batchOutputs ;
+			batchInputs.reserve( members.size() * first->inputs.size() );
+			batchOutputs.reserve( members.size() * first->outputs.size() );
+
+			for ( NativeWitnessInstruction * m : members ){
+				for ( size_t i = 0 ; i < m->inputs.size() ; i++ ){ batchInputs.push_back( m->inputs[i] ); }
+				batchOutputs.insert( batchOutputs.end() , m->outputs.begin() , m->outputs.end() );
+				m->batched = true ;
+			}
+
+			return new NativeWitnessInstruction( generator , native_batch , first->queuePosition ,
+												 Wires( batchInputs ) , batchOutputs , batchParams , first->constants );
+		}
+
+	};
+}
@@ -167,11 +167,11 @@ namespace CircuitBuilder {
     
     hashCode_t BasicOp::hashCode() const {
 
-        hashCode_t h ;
-        h = std::hash<std::string>()(getOpcode());
+        // the opcode ( which holds the constants of the operation ) and the input wires , in order
+        hashCode_t h = std::hash<std::string>()(getOpcode());
         
         for(WirePtr in : inputs.asArray() ){
-            h += (hashCode_t)in->hashCode();
+            h = h * 1000003 + (hashCode_t)in->hashCode();
         }
         
         return h;
@@ -0,0 +1,61 @@
+
+
+#pragma once
+
+#include <global.hpp>
+
+
+namespace CircuitBuilder {
+
+    class Object ;
+
+    /**
+     * Bump-pointer storage for the wires , operations and gadgets of a circuit generator.
+     * Each allocation is preceded by a slot holding the object built in it , so release()
+     * destroys the objects in creation order and frees the blocks at once.
+     * Blocks double in size , up to maxBlockSize.
+     */
+    class Arena {
+
+    private :
+
+        struct Slot {
+            Object * object ;
+            size_t size ;
+        };
+
+        struct Block {
+            char * base ;
+            size_t size ;
+            size_t used ;
+        };
+
+        vector<Block> blocks ;
+        size_t nextBlockSize ;
+        size_t numObjects ;
+
+        Arena( const Arena & ) ;
+        Arena & operator=( const Arena & ) ;
+
+    public :
+
+        static const size_t firstBlockSize = 64 * 1024 ;
+        static const size_t maxBlockSize = 64 * 1024 * 1024 ;
+
+        Arena() ;
+        ~Arena() ;
+
+        // memory for an object of the given size , handed over with adopt() once it is built
+        void * allocate( size_t size ) ;
+        void adopt( Object * object ) ;
+
+        // destroys an object of the arena before the release , its memory is kept
+        void destroy( Object * object ) ;
+
+        void release() ;
+
+        size_t size() const { return numObjects ; }
+        size_t bytes() const ;
+    };
+
+}
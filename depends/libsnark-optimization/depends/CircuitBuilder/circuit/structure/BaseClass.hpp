@@ -3,6 +3,9 @@
 #pragma once 
 
 #include <global.hpp>
+#include <new>
+#include <typeinfo>
+#include <type_traits>
 
 namespace CircuitBuilder {
 
@@ -42,6 +45,7 @@ namespace CircuitBuilder {
         AddClassType(WireLabelInstruction,27)
         AddClassType(WireArray,28)
         AddClassType(Gadget,29)
+        AddClassType(NativeWitnessInstruction,30)
 
     public :
         
@@ -65,39 +69,111 @@ namespace CircuitBuilder {
 
     void add_allocation( CircuitGenerator*  , Object* );
 
+    //
+    // allocate<T> builds the object in the arena of the generator ,
+    // which destroys it when the generator is finalized.
+    //
+    void * arena_allocate( CircuitGenerator * , size_t size );
+    void arena_adopt( CircuitGenerator * , Object * );
+
+
+    /**
+     * Identifies a gadget by its type, the ids of its input wires and its
+     * configuration arguments. Strings are descriptions and are not part of the key.
+     * An input wire that is not packed yet has no id : such a key is not reusable.
+     */
+    class GadgetKey {
+    
+    private :
+        string key ;
+        bool reusable ;
+    
+    public :
+        GadgetKey( const char * type_name ) : key( type_name ) , reusable( true ) { key.push_back('\0'); }
+
+        void add( WirePtr w );
+        void add( const Wires & ws );
+        void add( const BigInteger & x );
+        void add( bool x );
+        void add( int x );
+        void add( long x );
+        void add( unsigned int x );
+        void add( unsigned long x );
+        void add( const string & ){}
+        void add( const char * ){}
+
+        const string & str() const { return key ; }
+        bool is_reusable() const { return reusable ; }
+    };
+
+    inline void gadget_key_append( GadgetKey & ){}
+
+    template<typename Arg , typename... Args>
+    void gadget_key_append( GadgetKey & key , const Arg & arg , const Args & ... args ){
+        key.add( arg );
+        gadget_key_append( key , args... );
+    }
+
+    Gadget * find_gadget( CircuitGenerator * , const GadgetKey & );
+    void remember_gadget( CircuitGenerator * , const GadgetKey & , Gadget * );
+
+
+    template<class T , bool is_gadget = std::is_base_of<Gadget , T>::value >
+    struct Allocator {
+        template<typename... Args>
+        static T* make( CircuitGenerator * generator , Args & ... args ){
+            T* new_allocation = new ( arena_allocate( generator , sizeof(T) ) ) T(generator , args... );
+            arena_adopt( generator , new_allocation );
+            return new_allocation ;
+        }
+    };
+
+    //
+    // Gadgets are hash-consed : allocating the same gadget type over the same
+    // inputs again returns the existing instance and its output wires.
+    //
+    template<class T >
+    struct Allocator<T , true> {
+        template<typename... Args>
+        static T* make( CircuitGenerator * generator , Args & ... args ){
+            GadgetKey key( typeid(T).name() );
+            gadget_key_append( key , args... );
+
+            Gadget * cached = find_gadget( generator , key );
+            if ( cached ){
+                return static_cast<T*>( cached );
+            }
+
+            T* new_allocation = new ( arena_allocate( generator , sizeof(T) ) ) T(generator , args... );
+            arena_adopt( generator , new_allocation );
+            remember_gadget( generator , key , new_allocation );
+            return new_allocation ;
+        }
+    };
+
     template<class T >
     T* allocate ( CircuitGenerator* generator ){
-        T* new_allocation = new T(generator );
-        add_allocation( generator , new_allocation );
-        return new_allocation ;
+        return Allocator<T>::make( generator );
     }
 
     template<class T , typename Arg1 >
     T* allocate ( CircuitGenerator * generator , Arg1 arg1  ){
-        T* new_allocation = new T(generator , arg1 );
-        add_allocation( generator , new_allocation );
-        return new_allocation ;
+        return Allocator<T>::make( generator , arg1 );
     }
 
     template<class T , typename Arg1 , typename Arg2 >
     T* allocate ( CircuitGenerator * generator , Arg1 arg1 , Arg2 arg2 ){
-        T* new_allocation = new T(generator , arg1 , arg2 );
-        add_allocation( generator , new_allocation );
-        return new_allocation ;
+        return Allocator<T>::make( generator , arg1 , arg2 );
     }
 
     template<class T , typename Arg1 , typename Arg2 , typename Arg3 >
     T* allocate ( CircuitGenerator * generator , Arg1 arg1 , Arg2 arg2 , Arg3 arg3 ){
-        T* new_allocation = new T(generator , arg1 , arg2 , arg3 );
-        add_allocation( generator , new_allocation );
-        return new_allocation ;
+        return Allocator<T>::make( generator , arg1 , arg2 , arg3 );
     }
 
     template<class T , typename Arg1 , typename Arg2 , typename Arg3 , typename Arg4>
     T* allocate ( CircuitGenerator * generator , Arg1 arg1 , Arg2 arg2 , Arg3 arg3 , Arg4 arg4  ){
-        T* new_allocation = new T(generator , arg1 , arg2 , arg3 , arg4 );
-        add_allocation( generator , new_allocation );
-        return new_allocation ;
+        return Allocator<T>::make( generator , arg1 , arg2 , arg3 , arg4 );
     }
 
     template<class T ,  
@@ -109,9 +185,7 @@ namespace CircuitBuilder {
                   Arg3 arg3 , Arg4 arg4 , 
                   Arg5 arg5 )
     {
-        T* new_allocation = new T(generator , arg1 , arg2 , arg3 , arg4 , arg5 );
-        add_allocation( generator , new_allocation );
-        return new_allocation ;
+        return Allocator<T>::make( generator , arg1 , arg2 , arg3 , arg4 , arg5 );
     }
 
 }
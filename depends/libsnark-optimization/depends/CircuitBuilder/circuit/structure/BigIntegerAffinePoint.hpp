@@ -30,5 +30,11 @@ namespace CircuitBuilder {
             x = p.x;
             y = p.y;
         }
+
+        BigIntegerAffinePoint & operator=(const BigIntegerAffinePoint &p) {
+            x = p.x;
+            y = p.y;
+            return *this;
+        }
     };
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <BaseClass.hpp>
 #include <utilities.hpp>
 #include <WireArray.hpp>
+#include <Arena.hpp>
 
 
 typedef std::map<std::string , std::string> CircuitArguments ;
@@ -20,20 +21,32 @@ namespace CircuitBuilder {
     
     private:
         vector<InstructionPtr> base_insertion_order ;
-        std::map<hashCode_t , vector<size_t> > base_hash_map ;
+
+        //
+        // open addressing ( linear probing ) table of the basic operations in the queue ,
+        // by hashCode. A slot holds the queue index plus one , zero when empty.
+        //
+        struct HashSlot {
+            hashCode_t hash ;
+            size_t index ;
+        };
+        vector<HashSlot> base_hash_table ;
+        size_t base_hash_count ;
+
+        void grow_hash_table();
 
     public :
         size_t put_order ;
-        size_t vector_alloc_size ;
 
         EvaluationQueue( size_t estimated_queue_size = 1 );
         
         InstructionPtr find_Instruction_by_Inputs ( InstructionPtr instr );
         size_t size(){ return put_order ; }
         size_t length(){ return put_order ; }
+        InstructionPtr at( size_t index ) const { return base_insertion_order[index] ; }
         void put(InstructionPtr instr  );
         
-        void clear_quick_search_map(){ base_hash_map.clear() ; }        
+        void clear_quick_search_map(){ vector<HashSlot>().swap(base_hash_table) ; base_hash_count = 0 ; }        
 
         class const_iterator {
         private:
@@ -182,6 +195,8 @@ namespace CircuitBuilder {
 
             void evalCircuit() ;
 
+            CircuitEvaluator* prepareCircuitEvaluator( vector<wireID_t> * assignmentLog = NULL ) ;
+
             void prepFiles() ;
 
             void pFiles();
@@ -210,6 +225,10 @@ namespace CircuitBuilder {
             int reset_primary_input_array(const char* input_name , int value );
             int reset_primary_input_array(const char* input_name , const char* value_str );
 
+            // the labels the primary inputs are updated with , and the wires they set
+            const std::map<string , std::pair<WirePtr , BigInteger>> & get_primary_inputs() const { return primary_inputs ; }
+            const std::map<string , std::pair<WiresPtr , std::vector<BigInteger>>> & get_primary_array_inputs() const { return primary_array_inputs ; }
+
 
 
         private :
@@ -223,18 +242,27 @@ namespace CircuitBuilder {
 
 
         private :
-            map<BasicOp*, BasicOp*> AllocatedOperators ;
-            map<WirePtr , WirePtr> AllocatedWires ;
-            map<WireLabelInstruction*, WireLabelInstruction*> AllocatedWireLabelInstructions ;
-            map<WireArray* , WireArray*> AllocatedWireArrays ;
-            map<Gadget* , Gadget* > AllocatedGadgets ;
+            Arena arena ;
+            vector<Object*> heapAllocations ;
             vector<BasicOp*> toDeallocate;
 
+            map<string , Gadget* > memoizedGadgets ;
+            size_t reusedGadgets ;
+
             void clean_deallocated();
 
         public:
+            // objects created with new , deleted when the generator is finalized
             void add_allocation( Object* new_allocation );
 
+            Arena & getArena() { return arena ; }
+
+            //
+            // gadgets built so far, keyed by type , input wires and configuration
+            //
+            Gadget * find_gadget( const GadgetKey & key );
+            void remember_gadget( const GadgetKey & key , Gadget * gadget );
+
             //
             // deallocate operator and its output wires
             //
@@ -11,41 +11,146 @@
 namespace CircuitBuilder {
 
 
+	static const size_t arena_alignment = 16 ;
+
+	static inline size_t arena_round( size_t size ){
+		return ( size + arena_alignment - 1 ) & ~( arena_alignment - 1 ) ;
+	}
+
+
+	Arena::Arena() : nextBlockSize( firstBlockSize ) , numObjects(0) {}
+
+	Arena::~Arena(){ release(); }
+
+	void * Arena::allocate( size_t size ){
+
+		const size_t needed = arena_round( sizeof(Slot) ) + arena_round( size ) ;
+
+		if ( blocks.empty() || blocks.back().size - blocks.back().used < needed ){
+			
+			const size_t block_size = std::max( nextBlockSize , needed ) ;
+			char * base = (char*) malloc( block_size ) ;
+			if ( ! base ){ throw std::bad_alloc() ; }
+			
+			blocks.push_back( Block{ base , block_size , 0 } ) ;
+			nextBlockSize = std::min( nextBlockSize * 2 , maxBlockSize ) ;
+		}
+
+		Block & block = blocks.back() ;
+		Slot * slot = (Slot*) ( block.base + block.used ) ;
+		slot->object = NULL ;
+		slot->size = arena_round( size ) ;
+		block.used += needed ;
+
+		return ( (char*) slot ) + arena_round( sizeof(Slot) ) ;
+	}
+
+	void Arena::adopt( Object * object ){
+		Slot * slot = (Slot*) ( (char*) dynamic_cast<void*>(object) - arena_round( sizeof(Slot) ) ) ;
+		slot->object = object ;
+		numObjects++ ;
+	}
+
+	void Arena::destroy( Object * object ){
+		Slot * slot = (Slot*) ( (char*) dynamic_cast<void*>(object) - arena_round( sizeof(Slot) ) ) ;
+		if ( slot->object ){
+			slot->object = NULL ;
+			object->~Object() ;
+			numObjects-- ;
+		}
+	}
+
+	void Arena::release(){
+
+		for ( Block & block : blocks ){
+			size_t offset = 0 ;
+			while ( offset < block.used ){
+				Slot * slot = (Slot*) ( block.base + offset ) ;
+				if ( slot->object ){ slot->object->~Object() ; }
+				offset += arena_round( sizeof(Slot) ) + slot->size ;
+			}
+			free( block.base ) ;
+		}
+
+		blocks.clear() ;
+		nextBlockSize = firstBlockSize ;
+		numObjects = 0 ;
+	}
+
+	size_t Arena::bytes() const {
+		size_t total = 0 ;
+		for ( const Block & block : blocks ){ total += block.size ; }
+		return total ;
+	}
+
+
+	void * arena_allocate( CircuitGenerator * generator , size_t size ){
+		return generator->getArena().allocate( size ) ;
+	}
+
+	void arena_adopt( CircuitGenerator * generator , Object * allocation ){
+		generator->getArena().adopt( allocation ) ;
+	}
+
+
 	void add_allocation( CircuitGenerator * generator , Object * allocation ){
 		generator->add_allocation(allocation);
 	}
 
 	void CircuitGenerator::add_allocation(Object * allocation){
-
-        if(allocation->instanceof_Wire()){
-           
-            WirePtr w = (WirePtr)allocation ;
-            AllocatedWires[w] = w ;
-        
-        }else if ( allocation->instanceof_BasicOp() ){
-        
-            BasicOp* op = (BasicOp*)allocation ;
-            AllocatedOperators[op] = op ;
-        
-        }else if ( allocation->instanceof_WireLabelInstruction() ){
-
-            WireLabelInstructionPtr wl = (WireLabelInstructionPtr)allocation ;
-            AllocatedWireLabelInstructions[wl] = wl ;
-        
-        } else if ( allocation->instanceof_Gadget() ) {
-            
-            Gadget* g = (Gadget*) allocation ;
-            AllocatedGadgets[g] = g ;
-        
-        } else if ( allocation->instanceof_WireArray() ){
-        
-            WireArray* warray = ( WireArray*) allocation ;
-            AllocatedWireArrays[warray] = warray ;
-        
-        }
-	
+		heapAllocations.push_back( allocation ) ;
     }
 
+	void GadgetKey::add( WirePtr w ){
+		wireID_t id = w ? w->getWireId() : -1 ;
+		if ( w && id < 0 ){ reusable = false ; }
+		key.append( (const char*) &id , sizeof(id) );
+	}
+
+	void GadgetKey::add( const Wires & ws ){
+		add( (unsigned long) ws.size() );
+		for ( size_t i = 0 ; i < ws.size() ; i++ ){
+			add( ws.get(i) );
+		}
+	}
+
+	void GadgetKey::add( const BigInteger & x ){
+		key.append( x.toString(16) );
+		key.push_back( '\0' );
+	}
+
+	void GadgetKey::add( bool x ){ key.push_back( x ? 1 : 0 ); }
+	void GadgetKey::add( int x ){ add( (long) x ); }
+	void GadgetKey::add( long x ){ key.append( (const char*) &x , sizeof(x) ); }
+	void GadgetKey::add( unsigned int x ){ add( (unsigned long) x ); }
+	void GadgetKey::add( unsigned long x ){ key.append( (const char*) &x , sizeof(x) ); }
+
+
+	Gadget * find_gadget( CircuitGenerator * generator , const GadgetKey & key ){
+		return generator->find_gadget(key);
+	}
+
+	void remember_gadget( CircuitGenerator * generator , const GadgetKey & key , Gadget * gadget ){
+		generator->remember_gadget(key , gadget);
+	}
+
+	Gadget * CircuitGenerator::find_gadget( const GadgetKey & key ){
+		
+		if ( ! config.memoizeGadgets || ! key.is_reusable() ){ return NULL ; }
+
+		auto node = memoizedGadgets.find(key.str());
+		if ( node == memoizedGadgets.end() ){ return NULL ; }
+
+		reusedGadgets++ ;
+		return node->second ;
+	}
+
+	void CircuitGenerator::remember_gadget( const GadgetKey & key , Gadget * gadget ){
+		if ( config.memoizeGadgets && key.is_reusable() ){
+			memoizedGadgets[key.str()] = gadget ;
+		}
+	}
+
 	void CircuitGenerator::deallocate( BasicOp * op ){
         toDeallocate.push_back(op);
 		return ;
@@ -56,19 +161,19 @@ namespace CircuitBuilder {
         const size_t cleaned_op = toDeallocate.size();
         size_t cleaned_w = 0 ;
 
+        // the operators and their output wires are destroyed , their arena memory is
+        // released with the rest of the generator
         for ( BasicOp* op : toDeallocate ){
             
             { 
                 const Wires & ws = op->getOutputs();
                 for ( WirePtr w : ws ){
-                    AllocatedWires.erase(w);
-                    delete w ;
+                    arena.destroy(w);
                     cleaned_w++ ;
                 }
             }
 
-            AllocatedOperators.erase(op);
-            delete op ;
+            arena.destroy(op);
         }
 
         LOGD( "Deallocate %lu Operators , %lu Wires \n" , cleaned_op , cleaned_w );
@@ -93,38 +198,15 @@ namespace CircuitBuilder {
         primary_array_inputs.clear();
 
 
-        LOGD( "Deallocate %lu Operators , %lu Wires \n" , AllocatedOperators.size() , AllocatedWires.size());
-
-        for( auto Itr : AllocatedWires ){
-            WirePtr w = Itr.second ;
-			delete w ;
-		}
-
-		for( auto Itr : AllocatedOperators ){
-            BasicOp* op = Itr.second ;
-			delete op ;
-		}
-
-        for ( auto Itr : AllocatedWireLabelInstructions){
-            WireLabelInstructionPtr wl = Itr.second;
-            delete wl ;
-        }
-
-        for ( auto Itr : AllocatedGadgets ){
-            Gadget* g = Itr.second ;
-            delete g ;
-        }
+        LOGD( "Deallocate %lu Objects , %lu Bytes \n" , arena.size() + heapAllocations.size() , arena.bytes() );
 
-        for ( auto Itr : AllocatedWireArrays ){
-            WireArray* warray = Itr.second;
-            delete warray ;
+        for ( Object* allocation : heapAllocations ){
+            delete allocation ;
         }
+        heapAllocations.clear() ;
 
-        AllocatedOperators.clear() ;
-        AllocatedWires.clear() ;
-        AllocatedWireLabelInstructions.clear();
-        AllocatedWireArrays.clear() ;
-        AllocatedGadgets.clear() ;
+        arena.release() ;
+        memoizedGadgets.clear() ;
 	}
      
 }
\ No newline at end of file
@@ -34,7 +34,8 @@ namespace CircuitBuilder {
 		  	zeroWire(NULL), 
 		  	oneWire(NULL), 
 		  	currentWireId(0),
-		  	ignore_failed_assertion(false)
+		  	ignore_failed_assertion(false),
+		  	reusedGadgets(0)
 	{}
 
 
@@ -51,6 +52,7 @@ namespace CircuitBuilder {
 		LOGD("    Input Wires     : %lu \n", inWires.size());
 		LOGD("    Output Wires    : %lu \n", outWires.size());
 		LOGD("    Witness Wires   : %lu \n", proverWitnessWires.size());
+		LOGD("    Reused Gadgets  : %lu \n", reusedGadgets);
 		// LOGD("    EvaluationQueue : %lu\n" , evaluationQueue.size() );
 		LOGD("    List of primary inputs to assign : \n");
 		
@@ -70,20 +72,21 @@ namespace CircuitBuilder {
 
 		clean_deallocated();
 		evaluationQueue.clear_quick_search_map() ;
+		memoizedGadgets.clear() ;
 
 	}
 
 
 	void CircuitGenerator::initCircuitConstruction() {
 
-		op_desc_list.get_allocator().allocate( 100000 ) ;
+		op_desc_list.reserve( 100000 ) ;
 		op_desc_list.push_back( "" );
 		last_desc_id = 0 ;
 
 		// pre-allocate following vector memories
-		inWires.get_allocator().allocate( config.inWires_size ) ;
-		outWires.get_allocator().allocate( config.outWires_size ) ;
-		proverWitnessWires.get_allocator().allocate( config.proverWitnessWires_size ) ;
+		inWires.reserve( config.inWires_size ) ;
+		outWires.reserve( config.outWires_size ) ;
+		proverWitnessWires.reserve( config.proverWitnessWires_size ) ;
 
 		evaluationQueue = EvaluationQueue ( config.evaluationQueue_size ) ;
 
@@ -439,17 +442,33 @@ namespace CircuitBuilder {
 	}
 
 	void CircuitGenerator::evalCircuit() { 
+		prepareCircuitEvaluator()->evaluate();
+	}
+
+
+	/**
+	 * Returns the circuit evaluator with only the constant and input wires assigned. 
+	 * The evaluator (and its BigInteger buffers) is reused between evaluations.
+	 * If a log is given, the ids of the assigned wires are appended to it.
+	 */
+	CircuitEvaluator* CircuitGenerator::prepareCircuitEvaluator( vector<wireID_t> * assignmentLog ) { 
 		
-		if (circuitEvaluator){ 
-			circuitEvaluator->clear();
-			delete circuitEvaluator ;
+		if (circuitEvaluator && circuitEvaluator->size() == (size_t) getNumWires() ){ 
+			circuitEvaluator->reset();
+		}else{
+			if (circuitEvaluator){ 
+				circuitEvaluator->clear();
+				delete circuitEvaluator ;
+			}
+			circuitEvaluator = new CircuitEvaluator(this);
 		}
 
-		circuitEvaluator = new CircuitEvaluator(this);
+		circuitEvaluator->recordAssignments( assignmentLog );
 		circuitEvaluator->setWireValue( oneWire , oneWire->getConstant() );
 		circuitEvaluator->setWireValue( zeroWire , zeroWire->getConstant() );
 		assignInputs(*circuitEvaluator);
-		circuitEvaluator->evaluate();
+		
+		return circuitEvaluator ;
 	}
 
 
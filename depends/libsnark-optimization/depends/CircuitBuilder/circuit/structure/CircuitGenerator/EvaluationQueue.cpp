@@ -13,30 +13,57 @@ namespace CircuitBuilder {
 
 
 
+	// spreads the hash codes , which are often small sums of wire ids , over the table
+	static inline size_t hash_slot( hashCode_t hs , size_t mask ){
+		return (size_t) ( ( (uint64_t) hs * 0x9E3779B97F4A7C15ULL ) >> 32 ) & mask ;
+	}
+
+
 	EvaluationQueue::EvaluationQueue( size_t estimated_queue_size ){
 		put_order = 0 ;
-		vector_alloc_size = estimated_queue_size + 1000 ;
-		base_insertion_order = vector<InstructionPtr>(vector_alloc_size);
+		base_hash_count = 0 ;
+		base_insertion_order.reserve( estimated_queue_size + 1000 ) ;
+	}
+
+
+	void EvaluationQueue::grow_hash_table(){
+		
+		const size_t capacity = base_hash_table.size() ? base_hash_table.size() * 2 : 4096 ;
+		const size_t mask = capacity - 1 ;
+		
+		vector<HashSlot> table( capacity , HashSlot{ 0 , 0 } ) ;
+
+		for ( const HashSlot & slot : base_hash_table ){
+			if ( ! slot.index ){ continue ; }
+			size_t pos = hash_slot( slot.hash , mask ) ;
+			while ( table[pos].index ){ pos = ( pos + 1 ) & mask ; }
+			table[pos] = slot ;
+		}
+
+		base_hash_table.swap( table ) ;
 	}
 
  
 	void EvaluationQueue::put(InstructionPtr instr  ){
 		
-		if ( put_order >= vector_alloc_size ){
-			vector_alloc_size += 1000 ;
-			base_insertion_order.resize(vector_alloc_size) ;
-		}
+		// the vector grows geometrically
+		base_insertion_order.push_back( instr ) ;
 
-		base_insertion_order[put_order] = instr  ;
+		// only basic operations are looked up
+		if ( instr->instanceof_BasicOp() ){
 
-		hashCode_t hs = instr ->hashCode() ;
+			// load factor up to 0.7
+			if ( ( base_hash_count + 1 ) * 10 > base_hash_table.size() * 7 ){
+				grow_hash_table() ;
+			}
 
-		auto node = base_hash_map.find(hs) ; 
-		
-		if( node == base_hash_map.end() ){
-			base_hash_map[hs] = vector<size_t>(1 , put_order ) ;
-		}else{
-			node->second.push_back(put_order) ;
+			const hashCode_t hs = instr->hashCode() ;
+			const size_t mask = base_hash_table.size() - 1 ;
+			size_t pos = hash_slot( hs , mask ) ;
+			while ( base_hash_table[pos].index ){ pos = ( pos + 1 ) & mask ; }
+			
+			base_hash_table[pos] = HashSlot{ hs , put_order + 1 } ;
+			base_hash_count++ ;
 		}
 
 		put_order++ ; 
@@ -45,22 +72,21 @@ namespace CircuitBuilder {
 
 	InstructionPtr EvaluationQueue::find_Instruction_by_Inputs ( InstructionPtr instr ){
 		
-		hashCode_t hs = instr->hashCode() ;
-
-		auto node = base_hash_map.find(hs) ; 
-
-		if( node == base_hash_map.end() ){
+		if ( ! instr->instanceof_BasicOp() || base_hash_table.empty() ){
 			return NULL ;
 		}
+
+		const hashCode_t hs = instr->hashCode() ;
+		const size_t mask = base_hash_table.size() - 1 ;
 			
 		// compare instructions
-		for ( size_t index : node->second ){
+		for ( size_t pos = hash_slot( hs , mask ) ; base_hash_table[pos].index ; pos = ( pos + 1 ) & mask ){
 			
-			InstructionPtr i_instr = base_insertion_order[index] ;
-
-			if ( ! (instr->instanceof_BasicOp() && i_instr->instanceof_BasicOp()) ) {
+			if ( base_hash_table[pos].hash != hs ){
 				continue ;
 			}
+
+			InstructionPtr i_instr = base_insertion_order[ base_hash_table[pos].index - 1 ] ;
 				
 			BasicOp * instr_op = (BasicOp*) instr ;
 			BasicOp * i_instr_op = (BasicOp*) i_instr ;
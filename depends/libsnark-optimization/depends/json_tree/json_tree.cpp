@@ -432,6 +432,7 @@ namespace JsonTree {
                 
                 current_parent = 0 ;
                 parent_chain[current_parent] = root ;
+                root->as_array() ;
 
             }else{
                 
@@ -18,6 +18,8 @@ std::vector<size_t> alt_bn128_G1::wnaf_window_table;
 std::vector<size_t> alt_bn128_G1::fixed_base_exp_window_table;
 alt_bn128_G1 alt_bn128_G1::G1_zero = {};
 alt_bn128_G1 alt_bn128_G1::G1_one = {};
+alt_bn128_Fq alt_bn128_G1::glv_beta;
+glv_decomposition<alt_bn128_G1::scalar_field::num_limbs> alt_bn128_G1::glv;
 bool alt_bn128_G1::initialized = false;
 
 alt_bn128_G1::alt_bn128_G1()
@@ -326,6 +328,11 @@ alt_bn128_G1 alt_bn128_G1::mixed_add(const alt_bn128_G1 &other) const
     return alt_bn128_G1(X3, Y3, Z3);
 }
 
+alt_bn128_G1 alt_bn128_G1::endomorphism() const
+{
+    return alt_bn128_G1(glv_beta * this->X, this->Y, this->Z);
+}
+
 alt_bn128_G1 alt_bn128_G1::dbl() const
 {
 #ifdef PROFILE_OP_COUNTS
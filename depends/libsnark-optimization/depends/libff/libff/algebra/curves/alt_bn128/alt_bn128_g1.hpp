@@ -11,6 +11,7 @@
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/algebra/scalar_multiplication/glv.hpp>
 
 namespace libff {
 
@@ -33,6 +34,10 @@ public:
     typedef alt_bn128_Fq base_field;
     typedef alt_bn128_Fr scalar_field;
 
+    // the endomorphism (X, Y, Z) -> (beta X, Y, Z) , and the decomposition of scalars for it (see glv.hpp)
+    static alt_bn128_Fq glv_beta;
+    static glv_decomposition<scalar_field::num_limbs> glv;
+
     alt_bn128_Fq X, Y, Z;
 
     // using Jacobian coordinates
@@ -58,6 +63,7 @@ public:
     alt_bn128_G1 add(const alt_bn128_G1 &other) const;
     alt_bn128_G1 mixed_add(const alt_bn128_G1 &other) const;
     alt_bn128_G1 dbl() const;
+    alt_bn128_G1 endomorphism() const;
 
     bool is_well_formed() const;
 
@@ -18,6 +18,8 @@ std::vector<size_t> alt_bn128_G2::wnaf_window_table;
 std::vector<size_t> alt_bn128_G2::fixed_base_exp_window_table;
 alt_bn128_G2 alt_bn128_G2::G2_zero = {};
 alt_bn128_G2 alt_bn128_G2::G2_one = {};
+alt_bn128_Fq alt_bn128_G2::glv_beta;
+glv_decomposition<alt_bn128_G2::scalar_field::num_limbs> alt_bn128_G2::glv;
 bool alt_bn128_G2::initialized = false;
 
 alt_bn128_G2::alt_bn128_G2()
@@ -336,6 +338,11 @@ alt_bn128_G2 alt_bn128_G2::mixed_add(const alt_bn128_G2 &other) const
     return alt_bn128_G2(X3, Y3, Z3);
 }
 
+alt_bn128_G2 alt_bn128_G2::endomorphism() const
+{
+    return alt_bn128_G2(glv_beta * this->X, this->Y, this->Z);
+}
+
 alt_bn128_G2 alt_bn128_G2::dbl() const
 {
 #ifdef PROFILE_OP_COUNTS
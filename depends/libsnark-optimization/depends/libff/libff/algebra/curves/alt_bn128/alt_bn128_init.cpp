@@ -150,6 +150,10 @@ void init_alt_bn128_params()
                                     alt_bn128_Fq::one());
     alt_bn128_G1::initialized = true;
 
+    // endomorphism (x, y) -> (beta x, y) for a cube root of unity beta , acting as lambda on the prime order subgroup
+    alt_bn128_G1::glv_beta = alt_bn128_Fq("2203960485148121921418603742825762020974279258880205651966");
+    alt_bn128_G1::glv.init(bigint<alt_bn128_r_limbs>("4407920970296243842393367215006156084916469457145843978461"), alt_bn128_modulus_r);
+
     alt_bn128_G1::wnaf_window_table.resize(0);
     alt_bn128_G1::wnaf_window_table.push_back(11);
     alt_bn128_G1::wnaf_window_table.push_back(24);
@@ -215,6 +219,10 @@ void init_alt_bn128_params()
                                     alt_bn128_Fq2::one());
     alt_bn128_G2::initialized = true;
 
+    // endomorphism (x, y) -> (beta x, y) for a cube root of unity beta , acting as lambda on the prime order subgroup
+    alt_bn128_G2::glv_beta = alt_bn128_Fq("2203960485148121921418603742825762020974279258880205651966");
+    alt_bn128_G2::glv.init(bigint<alt_bn128_r_limbs>("21888242871839275217838484774961031246154997185409878258781734729429964517155"), alt_bn128_modulus_r);
+
     alt_bn128_G2::wnaf_window_table.resize(0);
     alt_bn128_G2::wnaf_window_table.push_back(5);
     alt_bn128_G2::wnaf_window_table.push_back(15);
@@ -13,6 +13,8 @@ std::vector<size_t> bls12_381_G1::wnaf_window_table;
 std::vector<size_t> bls12_381_G1::fixed_base_exp_window_table;
 bls12_381_G1 bls12_381_G1::G1_zero;
 bls12_381_G1 bls12_381_G1::G1_one;
+bls12_381_Fq bls12_381_G1::glv_beta;
+glv_decomposition<bls12_381_G1::scalar_field::num_limbs> bls12_381_G1::glv;
 bigint<bls12_381_G1::h_limbs> bls12_381_G1::h;
 
 bls12_381_G1::bls12_381_G1()
@@ -271,6 +273,11 @@ bls12_381_G1 bls12_381_G1::mixed_add(const bls12_381_G1 &other) const
     return bls12_381_G1(X3, Y3, Z3);
 }
 
+bls12_381_G1 bls12_381_G1::endomorphism() const
+{
+    return bls12_381_G1(glv_beta * this->X, this->Y, this->Z);
+}
+
 bls12_381_G1 bls12_381_G1::dbl() const
 {
 #ifdef PROFILE_OP_COUNTS
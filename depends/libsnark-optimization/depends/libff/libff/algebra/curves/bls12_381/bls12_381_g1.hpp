@@ -11,6 +11,7 @@
 
 #include <libff/algebra/curves/bls12_381/bls12_381_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/algebra/scalar_multiplication/glv.hpp>
 
 namespace libff {
 
@@ -36,6 +37,10 @@ public:
     typedef bls12_381_Fq base_field;
     typedef bls12_381_Fr scalar_field;
 
+    // the endomorphism (X, Y, Z) -> (beta X, Y, Z) , and the decomposition of scalars for it (see glv.hpp)
+    static bls12_381_Fq glv_beta;
+    static glv_decomposition<scalar_field::num_limbs> glv;
+
     bls12_381_Fq X, Y, Z;
 
     // using Jacobian coordinates
@@ -61,6 +66,7 @@ public:
     bls12_381_G1 add(const bls12_381_G1 &other) const;
     bls12_381_G1 mixed_add(const bls12_381_G1 &other) const;
     bls12_381_G1 dbl() const;
+    bls12_381_G1 endomorphism() const;
     bls12_381_G1 mul_by_cofactor() const;
 
     bool is_well_formed() const;
@@ -13,6 +13,8 @@ std::vector<size_t> bls12_381_G2::wnaf_window_table;
 std::vector<size_t> bls12_381_G2::fixed_base_exp_window_table;
 bls12_381_G2 bls12_381_G2::G2_zero;
 bls12_381_G2 bls12_381_G2::G2_one;
+bls12_381_Fq bls12_381_G2::glv_beta;
+glv_decomposition<bls12_381_G2::scalar_field::num_limbs> bls12_381_G2::glv;
 bigint<bls12_381_G2::h_limbs> bls12_381_G2::h;
 
 bls12_381_G2::bls12_381_G2()
@@ -281,6 +283,11 @@ bls12_381_G2 bls12_381_G2::mixed_add(const bls12_381_G2 &other) const
     return bls12_381_G2(X3, Y3, Z3);
 }
 
+bls12_381_G2 bls12_381_G2::endomorphism() const
+{
+    return bls12_381_G2(glv_beta * this->X, this->Y, this->Z);
+}
+
 bls12_381_G2 bls12_381_G2::dbl() const
 {
 #ifdef PROFILE_OP_COUNTS
@@ -11,6 +11,7 @@
 
 #include <libff/algebra/curves/bls12_381/bls12_381_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/algebra/scalar_multiplication/glv.hpp>
 
 namespace libff {
 
@@ -37,6 +38,10 @@ public:
     typedef bls12_381_Fq2 twist_field;
     typedef bls12_381_Fr scalar_field;
 
+    // the endomorphism (X, Y, Z) -> (beta X, Y, Z) , and the decomposition of scalars for it (see glv.hpp)
+    static bls12_381_Fq glv_beta;
+    static glv_decomposition<scalar_field::num_limbs> glv;
+
     bls12_381_Fq2 X, Y, Z;
 
     // using Jacobian coordinates
@@ -64,6 +69,7 @@ public:
     bls12_381_G2 add(const bls12_381_G2 &other) const;
     bls12_381_G2 mixed_add(const bls12_381_G2 &other) const;
     bls12_381_G2 dbl() const;
+    bls12_381_G2 endomorphism() const;
     bls12_381_G2 mul_by_q() const;
     bls12_381_G2 mul_by_cofactor() const;
 
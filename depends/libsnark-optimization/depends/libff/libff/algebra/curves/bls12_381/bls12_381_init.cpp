@@ -45,6 +45,10 @@ void init_bls12_381_params()
     // Cofactor
     bls12_381_G1::h = bigint<bls12_381_G1::h_limbs>("76329603384216526031706109802092473003");
 
+    // endomorphism (x, y) -> (beta x, y) for a cube root of unity beta , acting as lambda on the prime order subgroup
+    bls12_381_G1::glv_beta = bls12_381_Fq("793479390729215512621379701633421447060886740281060493010456487427281649075476305620758731620350");
+    bls12_381_G1::glv.init(bigint<bls12_381_r_limbs>("52435875175126190479447740508185965837461563690374988244538805122978187051009"), bls12_381_modulus_r);
+
 
     // TODO: wNAF window table
     bls12_381_G1::wnaf_window_table.resize(0);
@@ -115,6 +119,10 @@ void init_bls12_381_params()
     // Cofactor
     bls12_381_G2::h = bigint<bls12_381_G2::h_limbs>("305502333931268344200999753193121504214466019254188142667664032982267604182971884026507427359259977847832272839041616661285803823378372096355777062779109");
 
+    // endomorphism (x, y) -> (beta x, y) for a cube root of unity beta , acting as lambda on the prime order subgroup
+    bls12_381_G2::glv_beta = bls12_381_Fq("793479390729215512621379701633421447060886740281060493010456487427281649075476305620758731620350");
+    bls12_381_G2::glv.init(bigint<bls12_381_r_limbs>("228988810152649578064853576960394133503"), bls12_381_modulus_r);
+
 
     // TODO: wNAF window table
     bls12_381_G2::wnaf_window_table.resize(0);
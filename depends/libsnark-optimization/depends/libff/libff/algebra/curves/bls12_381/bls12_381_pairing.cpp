@@ -415,6 +415,59 @@ bls12_381_Fq12 bls12_381_ate_double_miller_loop(const bls12_381_ate_G1_precomp &
     return f;
 }
 
+/*
+ * Miller loop of a product of pairings prod_j e(P_j, Q_j), sharing the squarings
+ * of the accumulator between all pairs (as in the double Miller loop).
+ */
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+                                    const std::vector<bls12_381_ate_G2_precomp> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+
+    bls12_381_Fq12 f = bls12_381_Fq12::one();
+
+    bool found_one = false;
+    size_t idx = 0;
+
+    const bigint<bls12_381_Fq::num_limbs> &loop_count = bls12_381_ate_loop_count;
+    for (long i = loop_count.max_bits(); i >= 0; --i)
+    {
+        const bool bit = loop_count.test_bit(i);
+        if (!found_one)
+        {
+            /* this skips the MSB itself */
+            found_one |= bit;
+            continue;
+        }
+
+        f = f.squared();
+
+        for (size_t j = 0; j < prec_P.size(); ++j)
+        {
+            const bls12_381_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+            f = f.mul_by_045(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+        }
+        ++idx;
+
+        if (bit)
+        {
+            for (size_t j = 0; j < prec_P.size(); ++j)
+            {
+                const bls12_381_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+                f = f.mul_by_045(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+            }
+            ++idx;
+        }
+    }
+
+    if (bls12_381_ate_is_loop_count_neg)
+    {
+    	f = f.inverse();
+    }
+
+    return f;
+}
+
 bls12_381_Fq12 bls12_381_ate_pairing(const bls12_381_G1& P, const bls12_381_G2 &Q)
 {
     //enter_block("Call to bls12_381_ate_pairing");
@@ -460,6 +513,12 @@ bls12_381_Fq12 bls12_381_double_miller_loop(const bls12_381_G1_precomp &prec_P1,
     return bls12_381_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bls12_381_Fq12 bls12_381_multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                                const std::vector<bls12_381_G2_precomp> &prec_Q)
+{
+    return bls12_381_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1& P,
                       const bls12_381_G2 &Q)
 {
@@ -57,6 +57,8 @@ bls12_381_Fq12 bls12_381_ate_double_miller_loop(const bls12_381_ate_G1_precomp &
                                      const bls12_381_ate_G2_precomp &prec_Q1,
                                      const bls12_381_ate_G1_precomp &prec_P2,
                                      const bls12_381_ate_G2_precomp &prec_Q2);
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+                                    const std::vector<bls12_381_ate_G2_precomp> &prec_Q);
 
 bls12_381_Fq12 bls12_381_ate_pairing(const bls12_381_G1& P,
                           const bls12_381_G2 &Q);
@@ -80,6 +82,9 @@ bls12_381_Fq12 bls12_381_double_miller_loop(const bls12_381_G1_precomp &prec_P1,
                                  const bls12_381_G1_precomp &prec_P2,
                                  const bls12_381_G2_precomp &prec_Q2);
 
+bls12_381_Fq12 bls12_381_multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                                const std::vector<bls12_381_G2_precomp> &prec_Q);
+
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1& P,
                       const bls12_381_G2 &Q);
 
@@ -39,6 +39,8 @@ public:
                                              const bls12_381_G2_precomp &prec_Q1,
                                              const bls12_381_G1_precomp &prec_P2,
                                              const bls12_381_G2_precomp &prec_Q2);
+    static bls12_381_Fq12 multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                                            const std::vector<bls12_381_G2_precomp> &prec_Q);
     static bls12_381_Fq12 pairing(const bls12_381_G1 &P,
                                   const bls12_381_G2 &Q);
     static bls12_381_Fq12 reduced_pairing(const bls12_381_G1 &P,
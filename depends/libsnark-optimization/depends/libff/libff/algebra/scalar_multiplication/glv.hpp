@@ -0,0 +1,129 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for scalar multiplication with an endomorphism,
+ after Gallant, Lambert and Vanstone [GLV01].
+
+ On a curve y^2 = x^3 + b over a field with a cube root of unity beta, the map
+ phi(x, y) = (beta x, y) acts on the subgroup of prime order r as the
+ multiplication by a cube root of unity lambda modulo r. A scalar k is split
+ into k = k1 + k2 lambda (mod r), with k1 and k2 of about half the bits of r,
+ and k P = k1 P + k2 phi(P) needs half the doublings. The same map works on
+ the twist, so G1 and G2 of alt_bn128 and bls12_381 both have one.
+
+ [GLV01] = Gallant, Lambert, Vanstone,
+           "Faster point multiplication on elliptic curves with efficient endomorphisms",
+           CRYPTO 2001
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef GLV_HPP_
+#define GLV_HPP_
+
+#include <cstddef>
+#include <type_traits>
+
+#include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/algebra/fields/bigint.hpp>
+
+namespace libff {
+
+/**
+ * The decomposition k = k1 + k2 lambda (mod r) of [GLV01], by rounding against a short
+ * basis of the lattice { (a, b) : a + b lambda = 0 (mod r) }. The rounding uses constants
+ * precomputed by init(), so a decomposition costs a few multiplications of n limbs.
+ */
+template<mp_size_t n>
+class glv_decomposition {
+public:
+    bigint<n> lambda;
+    /* bound on the bits of k1 and k2 */
+    size_t num_bits;
+
+    glv_decomposition() : num_bits(0) {}
+
+    void init(const bigint<n> &lambda, const bigint<n> &modulus);
+
+    /* k = k1 + k2 lambda (mod r), with k1 and k2 as magnitudes and signs */
+    void decompose(const bigint<n> &k,
+                   bigint<n> &k1, bool &k1_negative,
+                   bigint<n> &k2, bool &k2_negative) const;
+
+private:
+    /* the basis (a1, b1), (a2, b2), as two's complements modulo 2^(n GMP_NUMB_BITS) */
+    bigint<n> a1, b1, a2, b2;
+    /* round(2^(n GMP_NUMB_BITS) b2 / det) and round(-2^(n GMP_NUMB_BITS) b1 / det), as magnitudes and signs */
+    bigint<n> g1, g2;
+    bool g1_negative, g2_negative;
+};
+
+/**
+ * The endomorphism of a group T, if T has one : T::glv is its decomposition, and
+ * P.endomorphism() = T::glv.lambda * P for P in the subgroup of prime order.
+ * num_bits() is the bound on the bits of the decomposed scalars, 0 for a group without one.
+ */
+template<typename T, typename = void>
+struct glv_endomorphism {
+    static size_t num_bits() { return 0; }
+
+    template<mp_size_t n>
+    static void decompose(const bigint<n> &k,
+                          bigint<n> &k1, bool &k1_negative,
+                          bigint<n> &k2, bool &k2_negative)
+    {
+        k1 = k;
+        k1_negative = false;
+        k2.clear();
+        k2_negative = false;
+    }
+
+    static T apply(const T &P) { return P; }
+};
+
+template<typename T>
+struct glv_endomorphism<T, decltype((void) T::glv, void())> {
+    static size_t num_bits() { return T::glv.num_bits; }
+
+    template<mp_size_t n>
+    static void decompose(const bigint<n> &k,
+                          bigint<n> &k1, bool &k1_negative,
+                          bigint<n> &k2, bool &k2_negative)
+    {
+        T::glv.decompose(k, k1, k1_negative, k2, k2_negative);
+    }
+
+    static T apply(const T &P) { return P.endomorphism(); }
+};
+
+/**
+ * The bits of the scalars a table of multiples of a base must cover, for scalars of
+ * scalar_size bits : the bound of the decomposition when it is smaller.
+ */
+template<typename T>
+size_t glv_scalar_size(const size_t scalar_size);
+
+/**
+ * scalar * base by interleaved wNAF over the two halves of the decomposition.
+ * The base must be in the subgroup of prime order.
+ */
+template<typename T, mp_size_t n>
+T glv_scalar_mul(const T &base, const bigint<n> &scalar);
+
+/**
+ * scalar * base for an element of a prime field : with glv_scalar_mul when FieldT is the
+ * scalar field of T, and with scalar_mul otherwise. As for glv_scalar_mul, the base must be
+ * in the subgroup of prime order, so operator*(FieldT, T) keeps to scalar_mul, and callers
+ * that know their base, like the setup and the prover of a ppzksnark, call this instead.
+ */
+template<typename T, typename FieldT>
+T field_scalar_mul(const T &base, const FieldT &scalar);
+
+} // libff
+
+#include <libff/algebra/scalar_multiplication/glv.tcc>
+
+#endif // GLV_HPP_
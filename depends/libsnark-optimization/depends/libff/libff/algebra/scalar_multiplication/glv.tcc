@@ -0,0 +1,265 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for scalar multiplication with an endomorphism.
+
+ See glv.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef GLV_TCC_
+#define GLV_TCC_
+
+#include <algorithm>
+#include <vector>
+
+#include <gmp.h>
+
+#include <libff/algebra/scalar_multiplication/wnaf.hpp>
+
+namespace libff {
+
+template<mp_size_t n>
+void glv_decomposition<n>::init(const bigint<n> &lambda, const bigint<n> &modulus)
+{
+    this->lambda = lambda;
+
+    const size_t word_bits = n * GMP_NUMB_BITS;
+    mpz_t r, root, r0, r1, r2, t0, t1, t2, q, tmp, det, num;
+    mpz_inits(r, root, r0, r1, r2, t0, t1, t2, q, tmp, det, num, NULL);
+
+    /*
+      extended Euclid on (r, lambda) : each remainder r_i = s_i r + t_i lambda gives the
+      lattice vector (r_i, -t_i). The short basis is taken around the first remainder
+      below sqrt(r), as in [GLV01, Section 4].
+    */
+    modulus.to_mpz(r);
+    lambda.to_mpz(r1);
+    mpz_set(r0, r);
+    mpz_set_ui(t0, 0);
+    mpz_set_ui(t1, 1);
+    mpz_sqrt(root, r);
+
+    while (mpz_cmp(r1, root) >= 0)
+    {
+        mpz_fdiv_qr(q, r2, r0, r1);
+        mpz_mul(tmp, q, t1);
+        mpz_sub(t2, t0, tmp);
+        mpz_swap(r0, r1);
+        mpz_swap(r1, r2);
+        mpz_swap(t0, t1);
+        mpz_swap(t1, t2);
+    }
+
+    /* (r0, t0) and (r1, t1) are the last remainder above sqrt(r) and the first below, (r2, t2) the next one */
+    mpz_fdiv_qr(q, r2, r0, r1);
+    mpz_mul(tmp, q, t1);
+    mpz_sub(t2, t0, tmp);
+
+    mpz_t va1, vb1, va2, vb2, norm0, norm2;
+    mpz_inits(va1, vb1, va2, vb2, norm0, norm2, NULL);
+
+    mpz_set(va1, r1);
+    mpz_neg(vb1, t1);
+
+    mpz_mul(norm0, r0, r0);
+    mpz_addmul(norm0, t0, t0);
+    mpz_mul(norm2, r2, r2);
+    mpz_addmul(norm2, t2, t2);
+    if (mpz_cmp(norm0, norm2) <= 0)
+    {
+        mpz_set(va2, r0);
+        mpz_neg(vb2, t0);
+    }
+    else
+    {
+        mpz_set(va2, r2);
+        mpz_neg(vb2, t2);
+    }
+
+    /* det = a1 b2 - a2 b1 = +-r */
+    mpz_mul(det, va1, vb2);
+    mpz_submul(det, va2, vb1);
+
+    const auto rounded_quotient = [&](bigint<n> &g, bool &g_negative, const mpz_t b)
+    {
+        mpz_mul_2exp(num, b, word_bits);
+        g_negative = (mpz_sgn(num) * mpz_sgn(det) < 0);
+        mpz_abs(num, num);
+        mpz_abs(tmp, det);
+        mpz_fdiv_q_2exp(q, tmp, 1);
+        mpz_add(num, num, q);
+        mpz_fdiv_q(q, num, tmp);
+        g = bigint<n>(q);
+    };
+
+    rounded_quotient(g1, g1_negative, vb2);
+    mpz_neg(tmp, vb1);
+    rounded_quotient(g2, g2_negative, tmp);
+
+    const auto twos_complement = [&](bigint<n> &x, const mpz_t v)
+    {
+        mpz_fdiv_r_2exp(tmp, v, word_bits);
+        x = bigint<n>(tmp);
+    };
+
+    twos_complement(a1, va1);
+    twos_complement(b1, vb1);
+    twos_complement(a2, va2);
+    twos_complement(b2, vb2);
+
+    /* the rounding errors are below 1, so |k1| < |a1| + |a2| and |k2| < |b1| + |b2| */
+    mpz_abs(tmp, va1);
+    mpz_abs(q, va2);
+    mpz_add(num, tmp, q);
+    mpz_abs(tmp, vb1);
+    mpz_abs(q, vb2);
+    mpz_add(tmp, tmp, q);
+    num_bits = std::max(mpz_sizeinbase(num, 2), mpz_sizeinbase(tmp, 2));
+
+    mpz_clears(va1, vb1, va2, vb2, norm0, norm2, NULL);
+    mpz_clears(r, root, r0, r1, r2, t0, t1, t2, q, tmp, det, num, NULL);
+}
+
+template<mp_size_t n>
+void glv_decomposition<n>::decompose(const bigint<n> &k,
+                                     bigint<n> &k1, bool &k1_negative,
+                                     bigint<n> &k2, bool &k2_negative) const
+{
+    mp_limb_t product[2*n];
+    bigint<n> c1, c2;
+
+    /* c = round(k g / 2^(n GMP_NUMB_BITS)) , with the sign of g */
+    const auto rounded_product = [&](bigint<n> &c, const bigint<n> &g, const bool g_negative)
+    {
+        mpn_mul_n(product, k.data, g.data, n);
+        mpn_copyi(c.data, product + n, n);
+        if (product[n-1] >> (GMP_NUMB_BITS - 1))
+        {
+            mpn_add_1(c.data, c.data, n, 1);
+        }
+        if (g_negative)
+        {
+            mpn_neg(c.data, c.data, n);
+        }
+    };
+
+    rounded_product(c1, g1, g1_negative);
+    rounded_product(c2, g2, g2_negative);
+
+    /* k1 = k - c1 a1 - c2 a2 and k2 = - c1 b1 - c2 b2 , modulo 2^(n GMP_NUMB_BITS) */
+    mpn_mul_n(product, c1.data, a1.data, n);
+    mpn_sub_n(k1.data, k.data, product, n);
+    mpn_mul_n(product, c2.data, a2.data, n);
+    mpn_sub_n(k1.data, k1.data, product, n);
+
+    mpn_mul_n(product, c1.data, b1.data, n);
+    mpn_neg(k2.data, product, n);
+    mpn_mul_n(product, c2.data, b2.data, n);
+    mpn_sub_n(k2.data, k2.data, product, n);
+
+    k1_negative = (k1.data[n-1] >> (GMP_NUMB_BITS - 1));
+    if (k1_negative)
+    {
+        mpn_neg(k1.data, k1.data, n);
+    }
+
+    k2_negative = (k2.data[n-1] >> (GMP_NUMB_BITS - 1));
+    if (k2_negative)
+    {
+        mpn_neg(k2.data, k2.data, n);
+    }
+}
+
+template<typename T>
+size_t glv_scalar_size(const size_t scalar_size)
+{
+    const size_t glv_bits = glv_endomorphism<T>::num_bits();
+    return (glv_bits > 0 && glv_bits < scalar_size) ? glv_bits : scalar_size;
+}
+
+template<typename T, mp_size_t n>
+T glv_scalar_mul(const T &base, const bigint<n> &scalar)
+{
+    bigint<n> k1, k2;
+    bool k1_negative, k2_negative;
+    glv_endomorphism<T>::decompose(scalar, k1, k1_negative, k2, k2_negative);
+
+    /* the window of opt_window_wnaf_exp for the bits of the halves */
+    const size_t scalar_bits = std::max(k1.num_bits(), k2.num_bits());
+    size_t window = 1;
+    for (long i = T::wnaf_window_table.size() - 1; i >= 0; --i)
+    {
+        if (scalar_bits >= T::wnaf_window_table[i])
+        {
+            window = i+1;
+            break;
+        }
+    }
+
+    const std::vector<long> naf1 = find_wnaf(window, k1);
+    const std::vector<long> naf2 = find_wnaf(window, k2);
+
+    /* odd multiples of the base, and their images by the endomorphism, with the signs of the halves */
+    const size_t table_size = 1ul << (window-1);
+    std::vector<T> table1(table_size), table2(table_size);
+    T tmp = base;
+    const T dbl = base.dbl();
+    for (size_t i = 0; i < table_size; ++i)
+    {
+        table1[i] = (k1_negative ? -tmp : tmp);
+        const T image = glv_endomorphism<T>::apply(tmp);
+        table2[i] = (k2_negative ? -image : image);
+        tmp = tmp + dbl;
+    }
+
+    T res = T::zero();
+    bool found_nonzero = false;
+    for (long i = scalar_bits; i >= 0; --i)
+    {
+        if (found_nonzero)
+        {
+            res = res.dbl();
+        }
+
+        if (naf1[i] != 0)
+        {
+            found_nonzero = true;
+            res = (naf1[i] > 0 ? res + table1[naf1[i]/2] : res - table1[(-naf1[i])/2]);
+        }
+
+        if (naf2[i] != 0)
+        {
+            found_nonzero = true;
+            res = (naf2[i] > 0 ? res + table2[naf2[i]/2] : res - table2[(-naf2[i])/2]);
+        }
+    }
+
+    return res;
+}
+
+template<typename T, typename FieldT>
+T field_scalar_mul(const T &base, const FieldT &scalar, std::true_type)
+{
+    return glv_scalar_mul<T, FieldT::num_limbs>(base, scalar.as_bigint());
+}
+
+template<typename T, typename FieldT>
+T field_scalar_mul(const T &base, const FieldT &scalar, std::false_type)
+{
+    return scalar_mul<T, FieldT::num_limbs>(base, scalar.as_bigint());
+}
+
+template<typename T, typename FieldT>
+T field_scalar_mul(const T &base, const FieldT &scalar)
+{
+    return field_scalar_mul<T, FieldT>(base, scalar, std::is_same<FieldT, typename T::scalar_field>());
+}
+
+} // libff
+
+#endif // GLV_TCC_
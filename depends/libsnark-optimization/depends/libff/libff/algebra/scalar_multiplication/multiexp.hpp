@@ -45,7 +45,25 @@ enum multi_exp_method {
   * Requires that T implements .dbl() (and, if USE_MIXED_ADDITION is defined,
   * .to_special(), .mixed_add(), and batch_to_special()).
   */
- multi_exp_method_BDLO12
+ multi_exp_method_BDLO12,
+ /**
+  * A variant of multi_exp_method_BDLO12 with
+  * - signed-digit windows (digits in [-2^{c-1}, 2^{c-1}]), which halves the
+  *   number of buckets,
+  * - buckets kept in affine coordinates and accumulated in batches, where
+  *   the inversions of one batch are shared by Montgomery's trick,
+  * - bucket storage allocated once per call (i.e., once per thread, see
+  *   multi_exp) and reused by every window, and
+  * - a window size c chosen from a cost model of the instance size
+  *   (see get_multi_exp_signed_window_size), and
+  * - for a group with an endomorphism, full-size scalars split into two
+  *   halves (see glv.hpp), which halves the number of windows.
+  * Requires that T uses Jacobian coordinates exposed as .X, .Y, .Z , and
+  * implements .dbl() and .mixed_add(). The affine doublings of the batches
+  * use the slope 3x^2/(2y), which holds only for a curve y^2 = x^3 + b (a = 0),
+  * as are alt_bn128 and bls12_381.
+  */
+ multi_exp_method_BDLO12_signed
 };
 
 /**
@@ -67,7 +85,7 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
  * A variant of multi_exp that takes advantage of the method mixed_add (instead
  * of the operator '+').
  * Assumes input is in special form, and includes special pre-processing for
- * scalars equal to 0 or 1.
+ * scalars equal to 0 or 1, and for small scalars (see multi_exp_terms).
  */
 template<typename T, typename FieldT, multi_exp_method Method>
 T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_start,
@@ -76,6 +94,132 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
                                 typename std::vector<FieldT>::const_iterator scalar_end,
                                 const size_t chunks);
 
+/**
+ * The terms of a multi_exp_with_mixed_addition, classified by scalar:
+ * - a zero scalar is skipped;
+ * - a base with scalar 1 (or -1, negated) is only added to the sum;
+ * - a scalar of at most small_scalar_bits bits (or its negation, with the
+ *   base negated) goes to a multi_exp of its own, which needs only a few
+ *   windows;
+ * - the others go to a multi_exp over full-size scalars.
+ * Witness vectors hold mostly booleans and short integers, so that the
+ * full-size multi_exp is often a small part of the input.
+ */
+template<typename T, typename FieldT>
+class multi_exp_terms {
+public:
+    static const size_t small_scalar_bits = 64;
+
+    std::vector<T> ones;
+    std::vector<T> small_bases;
+    std::vector<FieldT> small_scalars;
+    std::vector<T> dense_bases;
+    std::vector<FieldT> dense_scalars;
+    size_t num_skip;
+
+    multi_exp_terms() : num_skip(0) {}
+
+    void add(const T &base, const FieldT &scalar);
+
+    /* the sum of the terms, with the given method for the multi_exps */
+    template<multi_exp_method Method>
+    T sum(const size_t chunks) const;
+};
+
+/**
+ * The sum of the bases, which are in special form. With multi_exp_method_BDLO12_signed
+ * (bases with Jacobian coordinates), the sum is a tree of affine additions, each level
+ * sharing one field inversion; otherwise a sequence of mixed additions. As for
+ * multi_exp_method_BDLO12_signed, the affine doublings assume a curve with a = 0.
+ */
+template<typename T, multi_exp_method Method>
+T multi_exp_sum_bases(const std::vector<T> &bases);
+
+/**
+ * Precomputed multiples of a fixed vector of bases, for multi_exp_with_table.
+ *
+ * Level j holds 2^{j*stride*window} * P for every base P, in affine coordinates
+ * (normalized once, when the table is built), so that the bucket additions of a
+ * multi_exp read them directly and the others are mixed additions. With signed
+ * window digits of window bits, the windows j*stride + t of all levels are then
+ * summed in a single bucket pass for each t < stride, so that a multi_exp does
+ * stride bucket reductions and (stride-1)*window doublings, in place of one
+ * reduction per window and a doubling per bit. Memory grows as 1/stride.
+ */
+template<typename T>
+class multi_exp_base_table {
+public:
+    typedef decltype(T::X) coord_t;
+
+    size_t window;
+    size_t stride;
+    size_t num_bases;
+    size_t num_levels;
+    /* x then y of level j of base i at 2*(j*num_bases + i), (0, 0) for the point at infinity */
+    std::vector<coord_t> coords;
+
+    multi_exp_base_table() : window(0), stride(0), num_bases(0), num_levels(0) {}
+
+    /* the table for scalars of at most num_bits bits, levels computed in parallel when compiled with MULTICORE */
+    void build(typename std::vector<T>::const_iterator bases_start,
+               typename std::vector<T>::const_iterator bases_end,
+               const size_t window,
+               const size_t stride,
+               const size_t num_bits);
+
+    bool empty() const { return coords.empty(); }
+
+    const coord_t &x(const size_t i) const { return coords[2*i]; }
+    const coord_t &y(const size_t i) const { return coords[2*i+1]; }
+    bool is_zero(const size_t i) const { return x(i).is_zero() && y(i).is_zero(); }
+
+    /* entry i, in special form */
+    T base(const size_t i) const { return is_zero(i) ? T::zero() : T(x(i), y(i), coord_t::one()); }
+
+    size_t size_in_bytes() const { return coords.size() * sizeof(coord_t); }
+
+    /* number of levels of a table for scalars of at most num_bits bits */
+    static size_t levels(const size_t window, const size_t stride, const size_t num_bits)
+    {
+        const size_t num_windows = num_bits / window + 1;
+        return (num_windows + stride - 1) / stride;
+    }
+};
+
+/**
+ * Computes the sum
+ * \sum_i scalar_start[i] * table.base(first + i)
+ * from the multiples of the bases in the table, with the signed digits and
+ * batched affine additions of multi_exp_method_BDLO12_signed, and the same
+ * pre-processing of scalars equal to 0, 1 or -1 as multi_exp_with_mixed_addition.
+ * Input is split into the given number of chunks, and, when compiled with
+ * MULTICORE, the chunks are processed in parallel.
+ */
+template<typename T, typename FieldT>
+T multi_exp_with_table(const multi_exp_base_table<T> &table,
+                       const size_t first,
+                       typename std::vector<FieldT>::const_iterator scalar_start,
+                       typename std::vector<FieldT>::const_iterator scalar_end,
+                       const size_t chunks);
+
+/**
+ * Window size used by multi_exp_method_BDLO12_signed for length scalars of at most
+ * num_bits bits: the c minimizing the estimated cost
+ *     (num_bits/c + 1) * (length + 5 * 2^{c-1})
+ * i.e., one affine addition per scalar and window, and two Jacobian additions
+ * (about five affine ones) per bucket and window.
+ */
+size_t get_multi_exp_signed_window_size(const size_t length, const size_t num_bits);
+
+/**
+ * Window size of a multi_exp_base_table for multi_exps of length scalars of at most
+ * num_bits bits: as above, with stride bucket reductions in place of one per window,
+ * and at most multi_exp_table_max_window.
+ */
+const size_t multi_exp_table_max_window = 16;
+
+size_t get_multi_exp_table_window_size(const size_t length, const size_t num_bits, const size_t stride);
+
 /**
  * A convenience function for calculating a pure inner product, where the
  * more complicated methods are not required.
@@ -106,6 +250,10 @@ window_table<T> get_window_table(const size_t scalar_size,
                                  const size_t window,
                                  const T &g);
 
+/**
+ * pow * g from the table of g. For a group with an endomorphism (see glv.hpp), the table
+ * only covers the bits of the decomposed scalars, and pow * g = k1 * g + k2 * phi(g).
+ */
 template<typename T, typename FieldT>
 T windowed_exp(const size_t scalar_size,
                const size_t window,
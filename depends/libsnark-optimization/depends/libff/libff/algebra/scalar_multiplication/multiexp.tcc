@@ -19,7 +19,9 @@
 #include <type_traits>
 
 #include <libff/algebra/fields/bigint.hpp>
+#include <libff/algebra/fields/field_utils.hpp>
 #include <libff/algebra/fields/fp_aux.tcc>
+#include <libff/algebra/scalar_multiplication/glv.hpp>
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
 #include <libff/common/profiling.hpp>
@@ -283,6 +285,474 @@ T multi_exp_inner(
     return result;
 }
 
+inline size_t get_multi_exp_signed_window_size(const size_t length, const size_t num_bits)
+{
+    size_t best_c = 2;
+    double best_cost = -1;
+
+    /* c <= 16 keeps the buckets of one thread within a few MB, even for G2 */
+    for (size_t c = 2; c <= 16; ++c)
+    {
+        const double num_windows = num_bits / c + 1;
+        const double cost = num_windows * (length + 5.0 * (1ul << (c-1)));
+        if (best_cost < 0 || cost < best_cost)
+        {
+            best_cost = cost;
+            best_c = c;
+        }
+    }
+
+    return best_c;
+}
+
+inline size_t get_multi_exp_table_window_size(const size_t length, const size_t num_bits, const size_t stride)
+{
+    size_t best_c = 2;
+    double best_cost = -1;
+
+    for (size_t c = 2; c <= multi_exp_table_max_window; ++c)
+    {
+        const double num_windows = num_bits / c + 1;
+        const double cost = num_windows * length + stride * 5.0 * (1ul << (c-1));
+        if (best_cost < 0 || cost < best_cost)
+        {
+            best_cost = cost;
+            best_c = c;
+        }
+    }
+
+    return best_c;
+}
+
+/**
+ * Bits [start, start+count) of b, count < GMP_NUMB_BITS .
+ */
+template<mp_size_t n>
+size_t multi_exp_get_bits(const bigint<n> &b, const size_t start, const size_t count)
+{
+    const size_t limb = start / GMP_NUMB_BITS;
+    const size_t offset = start % GMP_NUMB_BITS;
+
+    if (limb >= (size_t) n)
+    {
+        return 0;
+    }
+
+    mp_limb_t v = b.data[limb] >> offset;
+    if (offset + count > GMP_NUMB_BITS && limb + 1 < (size_t) n)
+    {
+        v |= b.data[limb+1] << (GMP_NUMB_BITS - offset);
+    }
+
+    return v & ((1ul << count) - 1);
+}
+
+/**
+ * The buckets of multi_exp_method_BDLO12_signed. add() puts each point, with its
+ * nonzero signed digit d, in bucket |d|-1 (negated if d < 0), and sum() returns
+ * \sum_j j * bucket_j and empties the buckets. The points are read, in affine
+ * coordinates, through Points::x(p) and Points::y(p).
+ */
+template<typename T>
+class multi_exp_signed_buckets {
+public:
+    typedef decltype(T::X) coord_t;
+
+    explicit multi_exp_signed_buckets(const size_t num_buckets) :
+        num_buckets(num_buckets),
+        coord_one(coord_t::one()),
+        bucket_x(num_buckets),
+        bucket_y(num_buckets),
+        bucket_nonzero(num_buckets, 0),
+        bucket_round(num_buckets, 0),
+        round(0),
+        bucket_spill(num_buckets, T::zero())
+    {
+    }
+
+    template<typename Points>
+    void add(const Points &points,
+             const std::vector<size_t> &entry_point,
+             const std::vector<int64_t> &entry_digit);
+
+    T sum();
+
+private:
+    const size_t num_buckets;
+    const coord_t coord_one;
+
+    std::vector<coord_t> bucket_x, bucket_y;
+    std::vector<uint8_t> bucket_nonzero;
+    std::vector<size_t> bucket_round;
+    size_t round;
+
+    /* Jacobian part of the buckets, see add() */
+    std::vector<T> bucket_spill;
+    std::vector<size_t> spilled;
+
+    std::vector<size_t> pending, deferred;
+    std::vector<size_t> batch_bucket, batch_point;
+    std::vector<coord_t> batch_y, batch_den, batch_prefix;
+    std::vector<uint8_t> batch_double;
+};
+
+template<typename T>
+template<typename Points>
+void multi_exp_signed_buckets<T>::add(const Points &points,
+                                      const std::vector<size_t> &entry_point,
+                                      const std::vector<int64_t> &entry_digit)
+{
+    pending.resize(entry_point.size());
+    for (size_t e = 0; e < entry_point.size(); e++)
+    {
+        pending[e] = e;
+    }
+
+    /*
+      Accumulate the points into the buckets, in rounds. A round touches every
+      bucket at most once, so all its additions are independent, and the
+      denominators of their affine formulas are inverted together.
+      Additions into a bucket already touched by the round go to the next one.
+    */
+    while (!pending.empty())
+    {
+        ++round;
+        deferred.clear();
+        batch_bucket.clear();
+        batch_point.clear();
+        batch_y.clear();
+        batch_den.clear();
+        batch_double.clear();
+
+        for (const size_t e : pending)
+        {
+            const int64_t digit = entry_digit[e];
+            const size_t b = (digit > 0 ? digit : -digit) - 1;
+
+            if (bucket_round[b] == round)
+            {
+                deferred.emplace_back(e);
+                continue;
+            }
+
+            const size_t p = entry_point[e];
+            const coord_t py = (digit > 0 ? points.y(p) : -points.y(p));
+
+            if (!bucket_nonzero[b])
+            {
+                bucket_x[b] = points.x(p);
+                bucket_y[b] = py;
+                bucket_nonzero[b] = 1;
+                continue;
+            }
+
+            if (bucket_x[b] == points.x(p))
+            {
+                if (bucket_y[b] != py)
+                {
+                    // P + (-P) = O
+                    bucket_nonzero[b] = 0;
+                    continue;
+                }
+                batch_den.emplace_back(py + py);
+                batch_double.emplace_back(1);
+            }
+            else
+            {
+                batch_den.emplace_back(points.x(p) - bucket_x[b]);
+                batch_double.emplace_back(0);
+            }
+
+            bucket_round[b] = round;
+            batch_bucket.emplace_back(b);
+            batch_point.emplace_back(p);
+            batch_y.emplace_back(py);
+        }
+
+        const size_t batch_size = batch_den.size();
+        if (batch_size > 0)
+        {
+            /* Montgomery's trick */
+            batch_prefix.resize(batch_size);
+            coord_t acc = coord_one;
+            for (size_t j = 0; j < batch_size; j++)
+            {
+                batch_prefix[j] = acc;
+                acc = acc * batch_den[j];
+            }
+
+            coord_t acc_inverse = acc.inverse();
+            for (size_t j = batch_size; j-- > 0; )
+            {
+                const coord_t den = batch_den[j];
+                batch_den[j] = acc_inverse * batch_prefix[j];
+                acc_inverse = acc_inverse * den;
+            }
+
+            for (size_t j = 0; j < batch_size; j++)
+            {
+                const size_t b = batch_bucket[j];
+                const coord_t &x1 = bucket_x[b];
+                const coord_t &y1 = bucket_y[b];
+                const coord_t &x2 = points.x(batch_point[j]);
+                const coord_t &y2 = batch_y[j];
+
+                coord_t lambda;
+                if (batch_double[j])
+                {
+                    /* the tangent slope 3 x^2 / 2 y of a curve y^2 = x^3 + b (a = 0) */
+                    const coord_t x1_squared = x1.squared();
+                    lambda = (x1_squared + x1_squared + x1_squared) * batch_den[j];
+                }
+                else
+                {
+                    lambda = (y2 - y1) * batch_den[j];
+                }
+
+                const coord_t x3 = lambda.squared() - x1 - x2;
+                const coord_t y3 = lambda * (x1 - x3) - y1;
+                bucket_x[b] = x3;
+                bucket_y[b] = y3;
+            }
+        }
+
+        /*
+          A round too small to amortize its inversion, typically when most
+          digits fall in a few buckets: the deferred points are added to the
+          buckets with mixed additions instead.
+        */
+        if (batch_size < 64)
+        {
+            for (const size_t e : deferred)
+            {
+                const int64_t digit = entry_digit[e];
+                const size_t b = (digit > 0 ? digit : -digit) - 1;
+                const size_t p = entry_point[e];
+                const T g(points.x(p), (digit > 0 ? points.y(p) : -points.y(p)), coord_one);
+                if (bucket_spill[b].is_zero())
+                {
+                    spilled.emplace_back(b);
+                }
+                bucket_spill[b] = bucket_spill[b].mixed_add(g);
+            }
+            deferred.clear();
+        }
+
+        pending.swap(deferred);
+    }
+}
+
+template<typename T>
+T multi_exp_signed_buckets<T>::sum()
+{
+    /* \sum_j j * bucket_j */
+    T running_sum = T::zero();
+    T result = T::zero();
+    for (size_t j = num_buckets; j > 0; j--)
+    {
+        if (bucket_nonzero[j-1])
+        {
+            running_sum = running_sum.mixed_add(T(bucket_x[j-1], bucket_y[j-1], coord_one));
+        }
+        if (!bucket_spill[j-1].is_zero())
+        {
+            running_sum = running_sum + bucket_spill[j-1];
+        }
+        result = result + running_sum;
+    }
+
+    std::fill(bucket_nonzero.begin(), bucket_nonzero.end(), 0);
+    for (const size_t b : spilled)
+    {
+        bucket_spill[b] = T::zero();
+    }
+    spilled.clear();
+
+    return result;
+}
+
+/* points given by their affine coordinates */
+template<typename coord_t>
+class multi_exp_affine_points {
+public:
+    const std::vector<coord_t> &X;
+    const std::vector<coord_t> &Y;
+
+    multi_exp_affine_points(const std::vector<coord_t> &X, const std::vector<coord_t> &Y) : X(X), Y(Y) {}
+
+    const coord_t &x(const size_t p) const { return X[p]; }
+    const coord_t &y(const size_t p) const { return Y[p]; }
+};
+
+template<typename T, typename FieldT, multi_exp_method Method,
+    typename std::enable_if<(Method == multi_exp_method_BDLO12_signed), int>::type = 0>
+T multi_exp_inner(
+    typename std::vector<T>::const_iterator bases,
+    typename std::vector<T>::const_iterator bases_end,
+    typename std::vector<FieldT>::const_iterator exponents,
+    typename std::vector<FieldT>::const_iterator exponents_end)
+{
+    typedef decltype(T::X) coord_t;
+
+    const size_t length = bases_end - bases;
+
+    // below this size the per-call setup (affine conversion, bucket storage) does not pay off
+    if (length < 64)
+    {
+        return multi_exp_inner<T, FieldT, multi_exp_method_BDLO12>(bases, bases_end, exponents, exponents_end);
+    }
+
+    const mp_size_t exp_num_limbs =
+        std::remove_reference<decltype(*exponents)>::type::num_limbs;
+    std::vector<bigint<exp_num_limbs> > bn_exponents(length);
+    size_t num_bits = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        bn_exponents[i] = exponents[i].as_bigint();
+        num_bits = std::max(num_bits, bn_exponents[i].num_bits());
+    }
+
+    /*
+      with an endomorphism, term i is split into k1 * P + k2 * phi(P) (see glv.hpp) :
+      twice the terms, half the windows. The term of k2 is at length + i.
+    */
+    const bool use_glv = (glv_scalar_size<T>(num_bits) < num_bits);
+    const size_t num_terms = (use_glv ? 2 * length : length);
+    std::vector<uint8_t> negative(num_terms, 0);
+
+    if (use_glv)
+    {
+        bn_exponents.resize(num_terms);
+        num_bits = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            bool k1_negative, k2_negative;
+            glv_endomorphism<T>::decompose(bn_exponents[i],
+                                           bn_exponents[i], k1_negative,
+                                           bn_exponents[length + i], k2_negative);
+            negative[i] = k1_negative;
+            negative[length + i] = k2_negative;
+            num_bits = std::max(num_bits, std::max(bn_exponents[i].num_bits(), bn_exponents[length + i].num_bits()));
+        }
+    }
+
+    /* affine coordinates of the bases, zero bases are skipped */
+    const coord_t coord_one = coord_t::one();
+    std::vector<coord_t> base_x(num_terms), base_y(num_terms);
+    std::vector<uint8_t> base_nonzero(num_terms, 0);
+    {
+        std::vector<coord_t> Z_inverse;
+        std::vector<size_t> Z_index;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            const T &g = bases[i];
+            if (g.is_zero())
+            {
+                continue;
+            }
+
+            base_nonzero[i] = 1;
+            if (g.Z == coord_one)
+            {
+                base_x[i] = g.X;
+                base_y[i] = g.Y;
+            }
+            else
+            {
+                Z_index.emplace_back(i);
+                Z_inverse.emplace_back(g.Z);
+            }
+        }
+
+        if (!Z_inverse.empty())
+        {
+            batch_invert<coord_t>(Z_inverse);
+        }
+
+        for (size_t j = 0; j < Z_index.size(); j++)
+        {
+            const size_t i = Z_index[j];
+            const coord_t Z2 = Z_inverse[j].squared();
+            base_x[i] = bases[i].X * Z2;
+            base_y[i] = bases[i].Y * (Z2 * Z_inverse[j]);
+        }
+
+        if (use_glv)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                if (base_nonzero[i])
+                {
+                    const T image = glv_endomorphism<T>::apply(T(base_x[i], base_y[i], coord_one));
+                    base_x[length + i] = image.X;
+                    base_y[length + i] = image.Y;
+                    base_nonzero[length + i] = 1;
+                }
+            }
+        }
+    }
+
+    const size_t c = get_multi_exp_signed_window_size(num_terms, num_bits);
+    const size_t num_windows = num_bits / c + 1;
+    const size_t num_buckets = 1ul << (c-1);
+
+    /* allocated once and reused by every window */
+    const multi_exp_affine_points<coord_t> points(base_x, base_y);
+    multi_exp_signed_buckets<T> buckets(num_buckets);
+
+    std::vector<uint8_t> carry(num_terms, 0);
+    std::vector<size_t> entry_point;
+    std::vector<int64_t> entry_digit;
+    entry_point.reserve(num_terms);
+    entry_digit.reserve(num_terms);
+
+    std::vector<T> window_sums(num_windows, T::zero());
+
+    for (size_t k = 0; k < num_windows; k++)
+    {
+        /* signed digits of window k */
+        entry_point.clear();
+        entry_digit.clear();
+        for (size_t i = 0; i < num_terms; i++)
+        {
+            int64_t w = (int64_t) multi_exp_get_bits(bn_exponents[i], k*c, c) + carry[i];
+            if (w > (int64_t) num_buckets)
+            {
+                w -= 2 * (int64_t) num_buckets;
+                carry[i] = 1;
+            }
+            else
+            {
+                carry[i] = 0;
+            }
+
+            if (w != 0 && base_nonzero[i])
+            {
+                entry_point.emplace_back(i);
+                entry_digit.emplace_back(negative[i] ? -w : w);
+            }
+        }
+
+        buckets.add(points, entry_point, entry_digit);
+        window_sums[k] = buckets.sum();
+    }
+
+    T result = window_sums[num_windows-1];
+    for (size_t k = num_windows-1; k-- > 0; )
+    {
+        for (size_t i = 0; i < c; i++)
+        {
+            result = result.dbl();
+        }
+        result = result + window_sums[k];
+    }
+
+    UNUSED(exponents_end);
+    return result;
+}
+
 template<typename T, typename FieldT, multi_exp_method Method,
     typename std::enable_if<(Method == multi_exp_method_bos_coster), int>::type = 0>
 T multi_exp_inner(
@@ -442,6 +912,230 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
     return final;
 }
 
+template<typename T, multi_exp_method Method,
+    typename std::enable_if<(Method != multi_exp_method_BDLO12_signed), int>::type = 0>
+T multi_exp_sum_bases_inner(const std::vector<T> &bases)
+{
+    T acc = T::zero();
+
+    for (const T &g : bases)
+    {
+#ifdef USE_MIXED_ADDITION
+        acc = acc.mixed_add(g);
+#else
+        acc = acc + g;
+#endif
+    }
+
+    return acc;
+}
+
+template<typename T, multi_exp_method Method,
+    typename std::enable_if<(Method == multi_exp_method_BDLO12_signed), int>::type = 0>
+T multi_exp_sum_bases_inner(const std::vector<T> &bases)
+{
+    typedef decltype(T::X) coord_t;
+
+    // below this size the affine conversion does not pay off
+    if (bases.size() < 64)
+    {
+        return multi_exp_sum_bases_inner<T, multi_exp_method_BDLO12>(bases);
+    }
+
+    /* affine coordinates of the bases, zero bases are skipped */
+    const coord_t coord_one = coord_t::one();
+    std::vector<coord_t> x, y;
+    x.reserve(bases.size());
+    y.reserve(bases.size());
+    {
+        std::vector<coord_t> Z_inverse;
+        std::vector<size_t> Z_index;
+
+        for (const T &g : bases)
+        {
+            if (g.is_zero())
+            {
+                continue;
+            }
+
+            if (g.Z != coord_one)
+            {
+                Z_index.emplace_back(x.size());
+                Z_inverse.emplace_back(g.Z);
+            }
+            x.emplace_back(g.X);
+            y.emplace_back(g.Y);
+        }
+
+        if (!Z_inverse.empty())
+        {
+            batch_invert<coord_t>(Z_inverse);
+        }
+
+        for (size_t j = 0; j < Z_index.size(); j++)
+        {
+            const size_t i = Z_index[j];
+            const coord_t Z2 = Z_inverse[j].squared();
+            x[i] = x[i] * Z2;
+            y[i] = y[i] * (Z2 * Z_inverse[j]);
+        }
+    }
+
+    /*
+      Add the points pairwise, level by level. The additions of a level are
+      independent, so the denominators of their affine formulas are inverted
+      together; as in multi_exp_method_BDLO12_signed, a doubling uses the
+      formula of a curve y^2 = x^3 + b.
+    */
+    std::vector<coord_t> den;
+    std::vector<uint8_t> is_double, cancels;
+
+    while (x.size() > 1)
+    {
+        const size_t num_pairs = x.size() / 2;
+        den.resize(num_pairs);
+        is_double.assign(num_pairs, 0);
+        cancels.assign(num_pairs, 0);
+
+        for (size_t j = 0; j < num_pairs; j++)
+        {
+            const size_t a = 2*j, b = 2*j+1;
+            if (x[a] == x[b])
+            {
+                if (y[a] != y[b] || y[a].is_zero())
+                {
+                    // P + (-P) = O
+                    cancels[j] = 1;
+                    den[j] = coord_one;
+                }
+                else
+                {
+                    is_double[j] = 1;
+                    den[j] = y[a] + y[a];
+                }
+            }
+            else
+            {
+                den[j] = x[b] - x[a];
+            }
+        }
+
+        batch_invert<coord_t>(den);
+
+        size_t out = 0;
+        for (size_t j = 0; j < num_pairs; j++)
+        {
+            if (cancels[j])
+            {
+                continue;
+            }
+
+            const size_t a = 2*j, b = 2*j+1;
+            coord_t lambda;
+            if (is_double[j])
+            {
+                /* the tangent slope 3 x^2 / 2 y of a curve y^2 = x^3 + b (a = 0) */
+                const coord_t x_squared = x[a].squared();
+                lambda = (x_squared + x_squared + x_squared) * den[j];
+            }
+            else
+            {
+                lambda = (y[b] - y[a]) * den[j];
+            }
+
+            const coord_t x3 = lambda.squared() - x[a] - x[b];
+            const coord_t y3 = lambda * (x[a] - x3) - y[a];
+            x[out] = x3;
+            y[out] = y3;
+            ++out;
+        }
+
+        // an odd point is carried to the next level
+        if (x.size() % 2 == 1)
+        {
+            x[out] = x.back();
+            y[out] = y.back();
+            ++out;
+        }
+
+        x.resize(out);
+        y.resize(out);
+    }
+
+    if (x.empty())
+    {
+        return T::zero();
+    }
+
+    return T(x[0], y[0], coord_one);
+}
+
+template<typename T, multi_exp_method Method>
+T multi_exp_sum_bases(const std::vector<T> &bases)
+{
+    return multi_exp_sum_bases_inner<T, Method>(bases);
+}
+
+template<typename T, typename FieldT>
+void multi_exp_terms<T, FieldT>::add(const T &base, const FieldT &scalar)
+{
+    if (scalar.is_zero())
+    {
+        ++num_skip;
+        return;
+    }
+
+    if (scalar == FieldT::one())
+    {
+        ones.emplace_back(base);
+        return;
+    }
+
+    if (scalar.as_bigint().num_bits() <= small_scalar_bits)
+    {
+        small_bases.emplace_back(base);
+        small_scalars.emplace_back(scalar);
+        return;
+    }
+
+    const FieldT negated = -scalar;
+    if (negated == FieldT::one())
+    {
+        ones.emplace_back(-base);
+    }
+    else if (negated.as_bigint().num_bits() <= small_scalar_bits)
+    {
+        small_bases.emplace_back(-base);
+        small_scalars.emplace_back(negated);
+    }
+    else
+    {
+        dense_bases.emplace_back(base);
+        dense_scalars.emplace_back(scalar);
+    }
+}
+
+template<typename T, typename FieldT>
+template<multi_exp_method Method>
+T multi_exp_terms<T, FieldT>::sum(const size_t chunks) const
+{
+    T result = multi_exp_sum_bases<T, Method>(ones);
+
+    if (!small_bases.empty())
+    {
+        result = result + multi_exp<T, FieldT, Method>(small_bases.begin(), small_bases.end(),
+                                                       small_scalars.begin(), small_scalars.end(), chunks);
+    }
+
+    if (!dense_bases.empty())
+    {
+        result = result + multi_exp<T, FieldT, Method>(dense_bases.begin(), dense_bases.end(),
+                                                       dense_scalars.begin(), dense_scalars.end(), chunks);
+    }
+
+    return result;
+}
+
 template<typename T, typename FieldT, multi_exp_method Method>
 T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_start,
                                 typename std::vector<T>::const_iterator vec_end,
@@ -458,47 +1152,249 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
     auto value_it = vec_start;
     auto scalar_it = scalar_start;
 
-    const FieldT zero = FieldT::zero();
+    multi_exp_terms<T, FieldT> terms;
+
+    for (; scalar_it != scalar_end; ++scalar_it, ++value_it)
+    {
+        terms.add(*value_it, *scalar_it);
+    }
+    //leave_block("Process scalar vector");
+
+    return terms.template sum<Method>(chunks);
+}
+
+template<typename T>
+void multi_exp_base_table<T>::build(typename std::vector<T>::const_iterator bases_start,
+                                    typename std::vector<T>::const_iterator bases_end,
+                                    const size_t window,
+                                    const size_t stride,
+                                    const size_t num_bits)
+{
+    /* points converted to affine coordinates at a time */
+    const size_t affine_chunk = 1ul << 14;
+
+    this->window = window;
+    this->stride = stride;
+    this->num_bases = bases_end - bases_start;
+    this->num_levels = levels(window, stride, num_bits);
+
+    coords.resize(2 * num_levels * num_bases);
+
+    for (size_t j = 0; j < num_levels; j++)
+    {
+        const size_t level = j * num_bases;
+        const size_t num_chunks = (num_bases + affine_chunk - 1) / affine_chunk;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+        for (size_t k = 0; k < num_chunks; k++)
+        {
+            const size_t begin = k * affine_chunk;
+            const size_t end = std::min(num_bases, begin + affine_chunk);
+
+            std::vector<T> chunk;
+            chunk.reserve(end - begin);
+            for (size_t i = begin; i < end; i++)
+            {
+                if (j == 0)
+                {
+                    chunk.emplace_back(bases_start[i]);
+                    continue;
+                }
+
+                T g = base(level - num_bases + i);
+                for (size_t b = 0; b < stride * window; b++)
+                {
+                    g = g.dbl();
+                }
+                chunk.emplace_back(g);
+            }
+
+            batch_to_special<T>(chunk);
+            for (size_t i = begin; i < end; i++)
+            {
+                const T &g = chunk[i - begin];
+                const bool zero = g.is_zero();
+                coords[2 * (level + i)] = (zero ? coord_t::zero() : g.X);
+                coords[2 * (level + i) + 1] = (zero ? coord_t::zero() : g.Y);
+            }
+        }
+    }
+}
+
+template<typename T, typename FieldT>
+T multi_exp_with_table_inner(const multi_exp_base_table<T> &table,
+                             const size_t first,
+                             typename std::vector<FieldT>::const_iterator scalar_start,
+                             typename std::vector<FieldT>::const_iterator scalar_end)
+{
+    const mp_size_t n = FieldT::num_limbs;
+    const size_t length = scalar_end - scalar_start;
+
     const FieldT one = FieldT::one();
-    std::vector<FieldT> p;
-    std::vector<T> g;
+    const FieldT minus_one = -one;
 
-    T acc = T::zero();
+    /* scalars 1 and -1, then the others as a base index and a sign and size reduced exponent */
+    std::vector<T> ones;
+    std::vector<size_t> index;
+    std::vector<bigint<n> > exponent;
+    std::vector<int8_t> sign;
+    std::vector<FieldT> scalar;
 
-    size_t num_skip = 0;
-    size_t num_add = 0;
-    size_t num_other = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        const FieldT &s = scalar_start[i];
 
-    for (; scalar_it != scalar_end; ++scalar_it, ++value_it)
+        if (s.is_zero() || table.is_zero(first + i))
+        {
+            continue;
+        }
+
+        if (s == one)
+        {
+            ones.emplace_back(table.base(first + i));
+            continue;
+        }
+
+        if (s == minus_one)
+        {
+            ones.emplace_back(-table.base(first + i));
+            continue;
+        }
+
+        const bigint<n> b = s.as_bigint();
+        const bigint<n> nb = (-s).as_bigint();
+        const bool negate = (nb.num_bits() < b.num_bits());
+
+        index.emplace_back(first + i);
+        exponent.emplace_back(negate ? nb : b);
+        sign.emplace_back(negate ? -1 : 1);
+        scalar.emplace_back(s);
+    }
+
+    const T ones_sum = multi_exp_sum_bases<T, multi_exp_method_BDLO12_signed>(ones);
+    const size_t count = index.size();
+
+    // below this size the bucket reductions do not pay off
+    if (count < 64)
     {
-        if (*scalar_it == zero)
+        std::vector<T> g;
+        g.reserve(count);
+        for (const size_t i : index)
         {
-            // do nothing
-            ++num_skip;
+            g.emplace_back(table.base(i));
         }
-        else if (*scalar_it == one)
+        return ones_sum + multi_exp_inner<T, FieldT, multi_exp_method_BDLO12>(g.begin(), g.end(), scalar.begin(), scalar.end());
+    }
+
+    const size_t c = table.window;
+    const size_t num_windows = table.num_levels * table.stride;
+    const int64_t num_buckets = 1l << (c-1);
+
+    /* signed digits, digit of window k of exponent r at k*count + r */
+    std::vector<int32_t> digits(num_windows * count);
+    for (size_t r = 0; r < count; r++)
+    {
+        int64_t carry = 0;
+        for (size_t k = 0; k < num_windows; k++)
         {
-#ifdef USE_MIXED_ADDITION
-            acc = acc.mixed_add(*value_it);
-#else
-            acc = acc + (*value_it);
-#endif
-            ++num_add;
+            int64_t w = (int64_t) multi_exp_get_bits(exponent[r], k*c, c) + carry;
+            if (w > num_buckets)
+            {
+                w -= 2 * num_buckets;
+                carry = 1;
+            }
+            else
+            {
+                carry = 0;
+            }
+            digits[k * count + r] = (int32_t) (sign[r] * w);
         }
-        else
+    }
+
+    multi_exp_signed_buckets<T> buckets(num_buckets);
+
+    std::vector<size_t> entry_point;
+    std::vector<int64_t> entry_digit;
+    entry_point.reserve(count);
+    entry_digit.reserve(count);
+
+    T result = T::zero();
+
+    for (size_t t = table.stride; t-- > 0; )
+    {
+        for (size_t b = 0; b < c; b++)
+        {
+            result = result.dbl();
+        }
+
+        /* windows j*stride + t of all levels j, in the same buckets */
+        for (size_t j = 0; j < table.num_levels; j++)
         {
-            p.emplace_back(*scalar_it);
-            g.emplace_back(*value_it);
-            ++num_other;
+            const size_t k = j * table.stride + t;
+            const size_t level = j * table.num_bases;
+
+            entry_point.clear();
+            entry_digit.clear();
+            for (size_t r = 0; r < count; r++)
+            {
+                const int32_t d = digits[k * count + r];
+                if (d != 0)
+                {
+                    entry_point.emplace_back(level + index[r]);
+                    entry_digit.emplace_back(d);
+                }
+            }
+
+            buckets.add(table, entry_point, entry_digit);
         }
+
+        result = result + buckets.sum();
     }
-    //print_indent(); printf("* Elements of w skipped: %zu (%0.2f%%)\n", num_skip, 100.*num_skip/(num_skip+num_add+num_other));
-    //print_indent(); printf("* Elements of w processed with special addition: %zu (%0.2f%%)\n", num_add, 100.*num_add/(num_skip+num_add+num_other));
-    //print_indent(); printf("* Elements of w remaining: %zu (%0.2f%%)\n", num_other, 100.*num_other/(num_skip+num_add+num_other));
 
-    //leave_block("Process scalar vector");
+    return ones_sum + result;
+}
+
+template<typename T, typename FieldT>
+T multi_exp_with_table(const multi_exp_base_table<T> &table,
+                       const size_t first,
+                       typename std::vector<FieldT>::const_iterator scalar_start,
+                       typename std::vector<FieldT>::const_iterator scalar_end,
+                       const size_t chunks)
+{
+    const size_t total = scalar_end - scalar_start;
+    assert(first + total <= table.num_bases);
+
+    if ((total < chunks) || (chunks == 1))
+    {
+        return multi_exp_with_table_inner<T, FieldT>(table, first, scalar_start, scalar_end);
+    }
+
+    const size_t one = total/chunks;
+
+    std::vector<T> partial(chunks, T::zero());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        partial[i] = multi_exp_with_table_inner<T, FieldT>(
+             table,
+             first + i*one,
+             scalar_start + i*one,
+             (i == chunks-1 ? scalar_end : scalar_start + (i+1)*one));
+    }
+
+    T final = T::zero();
+
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        final = final + partial[i];
+    }
 
-    return acc + multi_exp<T, FieldT, Method>(g.begin(), g.end(), p.begin(), p.end(), chunks);
+    return final;
 }
 
 template <typename T>
@@ -555,9 +1451,11 @@ window_table<T> get_window_table(const size_t scalar_size,
                                  const size_t window,
                                  const T &g)
 {
+    /* with an endomorphism the table only covers the halves of the decomposed scalars, see windowed_exp */
+    const size_t table_size = glv_scalar_size<T>(scalar_size);
     const size_t in_window = 1ul<<window;
-    const size_t outerc = (scalar_size+window-1)/window;
-    const size_t last_in_window = 1ul<<(scalar_size - (outerc-1)*window);
+    const size_t outerc = (table_size+window-1)/window;
+    const size_t last_in_window = 1ul<<(table_size - (outerc-1)*window);
 #ifdef DEBUG
     /*if (!inhibit_profiling_info)
     {
@@ -588,14 +1486,13 @@ window_table<T> get_window_table(const size_t scalar_size,
     return powers_of_g;
 }
 
-template<typename T, typename FieldT>
-T windowed_exp(const size_t scalar_size,
-               const size_t window,
-               const window_table<T> &powers_of_g,
-               const FieldT &pow)
+template<typename T, mp_size_t n>
+T windowed_exp_bigint(const size_t scalar_size,
+                      const size_t window,
+                      const window_table<T> &powers_of_g,
+                      const bigint<n> &pow_val)
 {
     const size_t outerc = (scalar_size+window-1)/window;
-    const bigint<FieldT::num_limbs> pow_val = pow.as_bigint();
 
     /* exp */
     T res = powers_of_g[0][0];
@@ -617,6 +1514,29 @@ T windowed_exp(const size_t scalar_size,
     return res;
 }
 
+template<typename T, typename FieldT>
+T windowed_exp(const size_t scalar_size,
+               const size_t window,
+               const window_table<T> &powers_of_g,
+               const FieldT &pow)
+{
+    const size_t table_size = glv_scalar_size<T>(scalar_size);
+    if (table_size == scalar_size)
+    {
+        return windowed_exp_bigint<T, FieldT::num_limbs>(scalar_size, window, powers_of_g, pow.as_bigint());
+    }
+
+    /* pow * g = k1 * g + k2 * phi(g), both halves from the table of g */
+    bigint<FieldT::num_limbs> k1, k2;
+    bool k1_negative, k2_negative;
+    glv_endomorphism<T>::decompose(pow.as_bigint(), k1, k1_negative, k2, k2_negative);
+
+    const T res1 = windowed_exp_bigint<T, FieldT::num_limbs>(table_size, window, powers_of_g, k1);
+    const T res2 = glv_endomorphism<T>::apply(windowed_exp_bigint<T, FieldT::num_limbs>(table_size, window, powers_of_g, k2));
+
+    return (k1_negative ? -res1 : res1) + (k2_negative ? -res2 : res2);
+}
+
 template<typename T, typename FieldT>
 std::vector<T> batch_exp(const size_t scalar_size,
                          const size_t window,
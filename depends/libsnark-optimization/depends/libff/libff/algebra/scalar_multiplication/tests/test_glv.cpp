@@ -0,0 +1,113 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/scalar_multiplication/glv.hpp>
+#include <libff/common/profiling.hpp>
+
+using namespace libff;
+
+/* scalars that sit on the edges of the decomposition : 0, 1, lambda, r - lambda, r - 1, and random ones */
+template<typename GroupT>
+std::vector<typename GroupT::scalar_field> test_scalars(const size_t num_random)
+{
+    typedef typename GroupT::scalar_field FieldT;
+
+    const FieldT lambda = FieldT(GroupT::glv.lambda);
+    std::vector<FieldT> scalars = { FieldT::zero(), FieldT::one(), lambda, -lambda, -FieldT::one(), FieldT(2), -FieldT(2) };
+    for (size_t i = 0; i < num_random; ++i)
+    {
+        scalars.emplace_back(FieldT::random_element());
+    }
+    return scalars;
+}
+
+template<typename GroupT>
+void test_glv_decomposition(const char *name)
+{
+    typedef typename GroupT::scalar_field FieldT;
+    const mp_size_t n = FieldT::num_limbs;
+
+    const size_t num_bits = glv_endomorphism<GroupT>::num_bits();
+    assert(num_bits > 0);
+    assert(num_bits <= FieldT::size_in_bits() / 2 + 2);
+
+    const FieldT lambda = FieldT(GroupT::glv.lambda);
+    assert(lambda * lambda * lambda == FieldT::one());
+    assert(lambda != FieldT::one());
+
+    for (const FieldT &k : test_scalars<GroupT>(1000))
+    {
+        bigint<n> k1, k2;
+        bool k1_negative, k2_negative;
+        glv_endomorphism<GroupT>::decompose(k.as_bigint(), k1, k1_negative, k2, k2_negative);
+
+        /* both halves are short */
+        assert(k1.num_bits() <= num_bits);
+        assert(k2.num_bits() <= num_bits);
+
+        /* k1 + lambda k2 = k (mod r) */
+        FieldT f1 = FieldT(k1), f2 = FieldT(k2);
+        if (k1_negative) { f1 = -f1; }
+        if (k2_negative) { f2 = -f2; }
+        assert(f1 + lambda * f2 == k);
+    }
+
+    printf("* %s : decomposition ( %zu bits )\n", name, num_bits);
+}
+
+template<typename GroupT>
+void test_glv_scalar_mul(const char *name)
+{
+    typedef typename GroupT::scalar_field FieldT;
+    const mp_size_t n = FieldT::num_limbs;
+
+    const FieldT lambda = FieldT(GroupT::glv.lambda);
+    const std::vector<FieldT> scalars = test_scalars<GroupT>(20);
+
+    std::vector<GroupT> bases = { GroupT::zero(), GroupT::one(), -GroupT::one() };
+    for (size_t i = 0; i < 10; ++i)
+    {
+        bases.emplace_back(GroupT::random_element());
+    }
+
+    for (const GroupT &P : bases)
+    {
+        /* the endomorphism is the multiplication by lambda on the subgroup */
+        assert(P.endomorphism() == (scalar_mul<GroupT, n>(P, lambda.as_bigint())));
+
+        for (const FieldT &k : scalars)
+        {
+            const GroupT expected = scalar_mul<GroupT, n>(P, k.as_bigint());
+            assert((glv_scalar_mul<GroupT, n>(P, k.as_bigint())) == expected);
+            assert(field_scalar_mul<GroupT>(P, k) == expected);
+            assert(k * P == expected);
+        }
+    }
+
+    printf("* %s : scalar multiplication\n", name);
+}
+
+int main()
+{
+    alt_bn128_pp::init_public_params();
+    bls12_381_pp::init_public_params();
+
+    test_glv_decomposition<alt_bn128_G1>("alt_bn128 G1");
+    test_glv_decomposition<alt_bn128_G2>("alt_bn128 G2");
+    test_glv_decomposition<bls12_381_G1>("bls12_381 G1");
+    test_glv_decomposition<bls12_381_G2>("bls12_381 G2");
+
+    test_glv_scalar_mul<alt_bn128_G1>("alt_bn128 G1");
+    test_glv_scalar_mul<alt_bn128_G2>("alt_bn128 G2");
+    test_glv_scalar_mul<bls12_381_G1>("bls12_381 G1");
+    test_glv_scalar_mul<bls12_381_G2>("bls12_381 G2");
+}
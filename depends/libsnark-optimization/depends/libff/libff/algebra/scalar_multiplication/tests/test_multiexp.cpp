@@ -0,0 +1,214 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/profiling.hpp>
+
+using namespace libff;
+
+/* a scalar of at most 64 bits */
+template<typename FieldT>
+FieldT small_scalar()
+{
+    const unsigned long x = (((unsigned long) std::rand()) << 33) ^ (((unsigned long) std::rand()) << 2) ^ std::rand();
+    return FieldT(bigint<FieldT::num_limbs>(x));
+}
+
+/*
+  length scalars cycling through zero, one, minus one, small ones and their negations, and dense ones.
+  With repeated, the scalars of each kind are drawn from a few values, so that equal terms meet in
+  the buckets.
+*/
+template<typename FieldT>
+std::vector<FieldT> test_scalars(const size_t length, const bool repeated)
+{
+    std::vector<FieldT> small_pool, dense_pool;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        small_pool.emplace_back(small_scalar<FieldT>());
+        dense_pool.emplace_back(FieldT::random_element());
+    }
+
+    std::vector<FieldT> scalars;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const FieldT small = repeated ? small_pool[i % 3] : small_scalar<FieldT>();
+        const FieldT dense = repeated ? dense_pool[i % 3] : FieldT::random_element();
+        switch (i % 8)
+        {
+        case 0: scalars.emplace_back(FieldT::zero()); break;
+        case 1: scalars.emplace_back(FieldT::one()); break;
+        case 2: scalars.emplace_back(-FieldT::one()); break;
+        case 3: scalars.emplace_back(small); break;
+        case 4: scalars.emplace_back(-small); break;
+        case 5: scalars.emplace_back(FieldT(2)); break;
+        default: scalars.emplace_back(dense); break;
+        }
+    }
+    return scalars;
+}
+
+/* length bases in special form, drawn from three points and their negations when repeated */
+template<typename T>
+std::vector<T> test_bases(const size_t length, const bool repeated)
+{
+    std::vector<T> pool;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        pool.emplace_back(T::random_element());
+        pool.emplace_back(-pool.back());
+    }
+
+    std::vector<T> bases;
+    for (size_t i = 0; i < length; ++i)
+    {
+        bases.emplace_back(repeated ? pool[i % pool.size()] : T::random_element());
+    }
+    batch_to_special<T>(bases);
+    return bases;
+}
+
+template<typename T, typename FieldT>
+T naive_sum(const std::vector<T> &bases, const size_t first, const std::vector<FieldT> &scalars)
+{
+    return multi_exp<T, FieldT, multi_exp_method_naive>(bases.begin() + first, bases.begin() + first + scalars.size(),
+                                                        scalars.begin(), scalars.end(), 1);
+}
+
+template<typename T, typename FieldT>
+void test_multi_exp_methods(const std::vector<T> &bases, const std::vector<FieldT> &scalars, const size_t chunks)
+{
+    const T expected = naive_sum(bases, 0, scalars);
+
+    const T signed_sum = multi_exp<T, FieldT, multi_exp_method_BDLO12_signed>(
+        bases.begin(), bases.begin() + scalars.size(), scalars.begin(), scalars.end(), chunks);
+    assert(signed_sum == expected);
+
+    const T mixed_sum = multi_exp_with_mixed_addition<T, FieldT, multi_exp_method_BDLO12_signed>(
+        bases.begin(), bases.begin() + scalars.size(), scalars.begin(), scalars.end(), chunks);
+    assert(mixed_sum == expected);
+
+    const T mixed_BDLO12_sum = multi_exp_with_mixed_addition<T, FieldT, multi_exp_method_BDLO12>(
+        bases.begin(), bases.begin() + scalars.size(), scalars.begin(), scalars.end(), chunks);
+    assert(mixed_BDLO12_sum == expected);
+
+    multi_exp_terms<T, FieldT> terms;
+    for (size_t i = 0; i < scalars.size(); ++i)
+    {
+        terms.add(bases[i], scalars[i]);
+    }
+    assert(terms.num_skip + terms.ones.size() + terms.small_bases.size() + terms.dense_bases.size() == scalars.size());
+    assert(terms.template sum<multi_exp_method_BDLO12_signed>(chunks) == expected);
+    assert(terms.template sum<multi_exp_method_BDLO12>(chunks) == expected);
+}
+
+template<typename T, typename FieldT>
+void test_multi_exp_table(const std::vector<T> &bases, const size_t first, const std::vector<FieldT> &scalars,
+                          const size_t window, const size_t stride, const size_t chunks)
+{
+    multi_exp_base_table<T> table;
+    table.build(bases.begin(), bases.end(), window, stride, FieldT::size_in_bits());
+    assert(table.num_bases == bases.size());
+    assert(table.num_levels == multi_exp_base_table<T>::levels(window, stride, FieldT::size_in_bits()));
+
+    const T sum = multi_exp_with_table<T, FieldT>(table, first, scalars.begin(), scalars.end(), chunks);
+    assert(sum == naive_sum(bases, first, scalars));
+}
+
+/*
+  The levels of a table built from bases not in special form, one of them zero: affine
+  coordinates of the multiples 2^{j*stride*window} * P, and the sums over them.
+*/
+template<typename T, typename FieldT>
+void test_multi_exp_table_levels(const std::vector<T> &special_bases, const std::vector<FieldT> &scalars, const size_t stride)
+{
+    typedef decltype(T::X) coord_t;
+
+    std::vector<T> bases;
+    for (const T &g : special_bases)
+    {
+        bases.emplace_back(g.dbl());
+    }
+    bases[1] = T::zero();
+
+    const size_t window = 3;
+    multi_exp_base_table<T> table;
+    table.build(bases.begin(), bases.end(), window, stride, FieldT::size_in_bits());
+    assert(table.size_in_bytes() == 2 * sizeof(coord_t) * table.num_levels * table.num_bases);
+
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        T g = bases[i];
+        for (size_t j = 0; j < table.num_levels; ++j)
+        {
+            const size_t entry = j * table.num_bases + i;
+            assert(table.is_zero(entry) == g.is_zero());
+            assert(table.base(entry) == g);
+            assert(table.is_zero(entry) || table.base(entry).Z == coord_t::one());
+            for (size_t b = 0; b < stride * window; ++b)
+            {
+                g = g.dbl();
+            }
+        }
+    }
+
+    const T sum = multi_exp_with_table<T, FieldT>(table, 0, scalars.begin(), scalars.end(), 2);
+    assert(sum == naive_sum(bases, 0, scalars));
+}
+
+template<typename T, typename FieldT>
+void test_multi_exp(const char *name, const size_t length)
+{
+    for (const bool repeated : { false, true })
+    {
+        const std::vector<T> bases = test_bases<T>(length + 7, repeated);
+
+        for (const size_t size : { (size_t) 0, (size_t) 1, (size_t) 9, length })
+        {
+            const std::vector<FieldT> scalars = test_scalars<FieldT>(size, repeated);
+            for (const size_t chunks : { 1, 3 })
+            {
+                test_multi_exp_methods<T, FieldT>(bases, scalars, chunks);
+            }
+
+            /* only zeros, only ones, and only dense scalars */
+            test_multi_exp_methods<T, FieldT>(bases, std::vector<FieldT>(size, FieldT::zero()), 1);
+            test_multi_exp_methods<T, FieldT>(bases, std::vector<FieldT>(size, FieldT::one()), 1);
+            test_multi_exp_methods<T, FieldT>(bases, std::vector<FieldT>(size, FieldT::random_element()), 2);
+
+            for (const size_t stride : { 1, 2, 3 })
+            {
+                const size_t window = get_multi_exp_table_window_size(size, FieldT::size_in_bits(), stride);
+                for (const size_t first : { 0, 7 })
+                {
+                    test_multi_exp_table<T, FieldT>(bases, first, scalars, window, stride, 1);
+                    test_multi_exp_table<T, FieldT>(bases, first, scalars, 3, stride, 3);
+                }
+                test_multi_exp_table_levels<T, FieldT>(bases, scalars, stride);
+            }
+        }
+    }
+
+    printf("* %s : multi_exp methods and tables match multi_exp_method_naive\n", name);
+}
+
+int main()
+{
+    alt_bn128_pp::init_public_params();
+    bls12_381_pp::init_public_params();
+
+    test_multi_exp<alt_bn128_G1, alt_bn128_Fr>("alt_bn128 G1", 300);
+    test_multi_exp<alt_bn128_G2, alt_bn128_Fr>("alt_bn128 G2", 100);
+    test_multi_exp<bls12_381_G1, bls12_381_Fr>("bls12_381 G1", 300);
+    test_multi_exp<bls12_381_G2, bls12_381_Fr>("bls12_381 G2", 100);
+}
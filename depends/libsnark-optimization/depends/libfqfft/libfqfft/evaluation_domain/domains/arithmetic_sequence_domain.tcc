@@ -34,7 +34,7 @@ arithmetic_sequence_domain<FieldT>::arithmetic_sequence_domain(const size_t m) :
 }
 
 template<typename FieldT>
-void arithmetic_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a)
+void arithmetic_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a, const size_t num_threads)
 {
   if (a.size() != this->m) throw DomainSizeException("arithmetic: expected a.size() == this->m");
 
@@ -58,7 +58,7 @@ void arithmetic_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a)
   a.resize(this->m);
 
 #ifdef MULTICORE
-  #pragma omp parallel for
+  #pragma omp parallel for num_threads(_team_size(num_threads))
 #endif
   for (size_t i = 0; i < this->m; i++)
   {
@@ -67,8 +67,9 @@ void arithmetic_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void arithmetic_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a)
+void arithmetic_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a, const size_t num_threads)
 {
+  libff::UNUSED(num_threads);
   if (a.size() != this->m) throw DomainSizeException("arithmetic: expected a.size() == this->m");
   
   if (!this->precomputation_sentinel) do_precomputation();
@@ -97,16 +98,16 @@ void arithmetic_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void arithmetic_sequence_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void arithmetic_sequence_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
   _multiply_by_coset(a, g);
-  FFT(a);
+  FFT(a, num_threads);
 }
 
 template<typename FieldT>
-void arithmetic_sequence_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void arithmetic_sequence_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
-  iFFT(a);
+  iFFT(a, num_threads);
   _multiply_by_coset(a, g.inverse());
 }
 
@@ -217,8 +218,9 @@ void arithmetic_sequence_domain<FieldT>::add_poly_Z(const FieldT &coeff, std::ve
 }
 
 template<typename FieldT>
-void arithmetic_sequence_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P)
+void arithmetic_sequence_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads)
 {
+  libff::UNUSED(num_threads);
   const FieldT coset = this->arithmetic_generator; /* coset in arithmetic sequence? */
   const FieldT Z_inverse_at_coset = this->compute_vanishing_polynomial(coset).inverse();
   for (size_t i = 0; i < this->m; ++i)
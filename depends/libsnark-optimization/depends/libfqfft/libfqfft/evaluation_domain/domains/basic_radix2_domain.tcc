@@ -23,7 +23,7 @@
 namespace libfqfft {
 
 template<typename FieldT>
-basic_radix2_domain<FieldT>::basic_radix2_domain(const size_t m) : evaluation_domain<FieldT>(m)
+basic_radix2_domain<FieldT>::basic_radix2_domain(const size_t m) : evaluation_domain<FieldT>(m), precomputed(false)
 {
     if (m <= 1) throw InvalidSizeException("basic_radix2(): expected m > 1");
 
@@ -38,19 +38,34 @@ basic_radix2_domain<FieldT>::basic_radix2_domain(const size_t m) : evaluation_do
 }
 
 template<typename FieldT>
-void basic_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
+void basic_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a, const size_t num_threads)
 {
     if (a.size() != this->m) throw DomainSizeException("basic_radix2: expected a.size() == this->m");
 
-    _basic_radix2_FFT(a, omega);
+    if (precomputed)
+    {
+        if (_basic_radix2_use_four_step(this->m, num_threads)) _basic_four_step_radix2_FFT(a, twiddles, num_threads);
+        else _basic_radix2_FFT(a, omega, twiddles, num_threads);
+        return;
+    }
+
+    _basic_radix2_FFT(a, omega, num_threads);
 }
 
 template<typename FieldT>
-void basic_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
+void basic_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a, const size_t num_threads)
 {
     if (a.size() != this->m) throw DomainSizeException("basic_radix2: expected a.size() == this->m");
 
-    _basic_radix2_FFT(a, omega.inverse());
+    if (precomputed)
+    {
+        if (_basic_radix2_use_four_step(this->m, num_threads)) _basic_four_step_radix2_FFT(a, inverse_twiddles, num_threads);
+        else _basic_radix2_FFT(a, omega_inverse, inverse_twiddles, num_threads);
+        _multiply_by_constant(a, m_inverse, num_threads);
+        return;
+    }
+
+    _basic_radix2_FFT(a, omega.inverse(), num_threads);
 
     const FieldT sconst = FieldT(a.size()).inverse();
     for (size_t i = 0; i < a.size(); ++i)
@@ -60,17 +75,31 @@ void basic_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void basic_radix2_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void basic_radix2_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
-    _multiply_by_coset(a, g);
-    FFT(a);
+    if (precomputed && g == FieldT::multiplicative_generator)
+    {
+        _multiply_by_powers(a, coset_powers, num_threads);
+    }
+    else
+    {
+        _multiply_by_coset(a, g);
+    }
+    FFT(a, num_threads);
 }
 
 template<typename FieldT>
-void basic_radix2_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void basic_radix2_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
-    iFFT(a);
-    _multiply_by_coset(a, g.inverse());
+    iFFT(a, num_threads);
+    if (precomputed && g == FieldT::multiplicative_generator)
+    {
+        _multiply_by_powers(a, inverse_coset_powers, num_threads);
+    }
+    else
+    {
+        _multiply_by_coset(a, g.inverse());
+    }
 }
 
 template<typename FieldT>
@@ -101,8 +130,14 @@ void basic_radix2_domain<FieldT>::add_poly_Z(const FieldT &coeff, std::vector<Fi
 }
 
 template<typename FieldT>
-void basic_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P)
+void basic_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads)
 {
+    if (precomputed)
+    {
+        _multiply_by_constant(P, Z_inverse_at_coset, num_threads);
+        return;
+    }
+
     const FieldT coset = FieldT::multiplicative_generator;
     const FieldT Z_inverse_at_coset = this->compute_vanishing_polynomial(coset).inverse();
     for (size_t i = 0; i < this->m; ++i)
@@ -111,6 +146,23 @@ void basic_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P)
     }
 }
 
+template<typename FieldT>
+void basic_radix2_domain<FieldT>::precompute()
+{
+    if (precomputed) return;
+
+    omega_inverse = omega.inverse();
+    m_inverse = FieldT(this->m).inverse();
+    Z_inverse_at_coset = this->compute_vanishing_polynomial(FieldT::multiplicative_generator).inverse();
+
+    twiddles = _compute_powers(this->m/2, omega);
+    inverse_twiddles = _compute_powers(this->m/2, omega_inverse);
+    coset_powers = _compute_powers(this->m, FieldT::multiplicative_generator);
+    inverse_coset_powers = _compute_powers(this->m, FieldT::multiplicative_generator.inverse());
+
+    precomputed = true;
+}
+
 } // libfqfft
 
 #endif // BASIC_RADIX2_DOMAIN_TCC_
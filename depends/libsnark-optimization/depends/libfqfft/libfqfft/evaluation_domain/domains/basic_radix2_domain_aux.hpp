@@ -17,19 +17,55 @@
 
 #include <vector>
 
+#include <libfqfft/evaluation_domain/evaluation_domain.hpp>
+
 namespace libfqfft {
 
 /**
  * Compute the radix-2 FFT of the vector a over the set S={omega^{0},...,omega^{m-1}}.
+ *
+ * Here and below, num_threads is the size of the parallel regions, 0 for the default team.
  */
 template<typename FieldT>
-void _basic_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega);
+void _basic_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const size_t num_threads = 0);
+
+/**
+ * As above, but reads the butterfly factors from a precomputed table twiddles[i] = omega^i,
+ * i < N/2, where omega is a primitive N-th root of unity and a.size() divides N.
+ */
+template<typename FieldT>
+void _basic_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const std::vector<FieldT> &twiddles, const size_t num_threads = 0);
 
 /**
  * A multi-thread version of _basic_radix2_FFT.
  */
 template<typename FieldT>
-void _parallel_basic_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega);
+void _parallel_basic_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const size_t num_threads = 0);
+
+/**
+ * As _basic_radix2_FFT with a twiddle table, by the four-step method of [Bai90]: a is an n1 x n2
+ * matrix, n1 n2 = a.size(), and its FFT is n2 FFTs of size n1, a multiplication by the factors
+ * omega^{i j}, and n1 FFTs of size n2, on rows made contiguous by blocked transposes. The rows
+ * fit in the cache and are transformed in parallel, each with its own bit-reversal, so no pass
+ * over a, the bit-reversal included, strides across the whole vector.
+ *
+ * [Bai90] = Bailey, "FFTs in external or hierarchical memory", J. Supercomputing 4(1), 1990
+ */
+template<typename FieldT>
+void _basic_four_step_radix2_FFT(std::vector<FieldT> &a, const std::vector<FieldT> &twiddles, const size_t num_threads = 0);
+
+/**
+ * The size from which basic_radix2_domain runs its FFTs with _basic_four_step_radix2_FFT,
+ * once its twiddle tables are precomputed: below it, a fits in the caches anyway.
+ */
+const size_t basic_radix2_four_step_min_size = (1ul << 17);
+
+/**
+ * Whether an FFT of size n over a precomputed domain should use _basic_four_step_radix2_FFT:
+ * from basic_radix2_four_step_min_size on, and with more than one thread, since on a single
+ * thread its transposes and twiddle multiplications cost more than the locality saves.
+ */
+inline bool _basic_radix2_use_four_step(const size_t n, const size_t num_threads = 0);
 
 /**
  * Translate the vector a to a coset defined by g.
@@ -37,6 +73,24 @@ void _parallel_basic_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega);
 template<typename FieldT>
 void _multiply_by_coset(std::vector<FieldT> &a, const FieldT &g);
 
+/**
+ * Translate the vector a to a coset, given the precomputed powers g^i of its generator.
+ */
+template<typename FieldT>
+void _multiply_by_powers(std::vector<FieldT> &a, const std::vector<FieldT> &powers, const size_t num_threads = 0);
+
+/**
+ * Multiply every entry of the vector a by c.
+ */
+template<typename FieldT>
+void _multiply_by_constant(std::vector<FieldT> &a, const FieldT &c, const size_t num_threads = 0);
+
+/**
+ * Compute the n powers (1, g, g^2, ..., g^{n-1}).
+ */
+template<typename FieldT>
+std::vector<FieldT> _compute_powers(const size_t n, const FieldT &g);
+
 /**
  * Compute the m Lagrange coefficients, relative to the set S={omega^{0},...,omega^{m-1}}, at the field element t.
  */
@@ -22,6 +22,7 @@
 #endif
 
 #include <libff/algebra/fields/field_utils.hpp>
+#include <libff/common/utils.hpp>
 
 #include <libfqfft/tools/exceptions.hpp>
 
@@ -78,8 +79,68 @@ void _basic_serial_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega)
     }
 }
 
+/*
+ Same as above, but with w = omega_N^{j*N/(2m)} read from the table twiddles[i] = omega_N^i , i < N/2 .
+ Since a.size() divides N, the table built for the full domain also serves the sub-transforms
+ of the parallel FFT below.
+ */
+template<typename FieldT>
+void _basic_serial_radix2_FFT(FieldT *a, const size_t n, const std::vector<FieldT> &twiddles)
+{
+    const size_t logn = log2(n);
+    if (n != (1u << logn)) throw DomainSizeException("expected n == (1u << logn)");
+
+    const size_t N = 2 * twiddles.size();
+    if (n > N || N % n != 0) throw DomainSizeException("expected n to divide 2 * twiddles.size()");
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        const size_t rk = libff::bitreverse(k, logn);
+        if (k < rk)
+            std::swap(a[k], a[rk]);
+    }
+
+    size_t m = 1; // invariant: m = 2^{s-1}
+    for (size_t s = 1; s <= logn; ++s)
+    {
+        const size_t stride = N/(2*m);
+
+        for (size_t k = 0; k < n; k += 2*m)
+        {
+            for (size_t j = 0; j < m; ++j)
+            {
+                const FieldT t = twiddles[j*stride] * a[k+j+m];
+                a[k+j+m] = a[k+j] - t;
+                a[k+j] += t;
+            }
+        }
+        m *= 2;
+    }
+}
+
+template<typename FieldT>
+void _basic_serial_radix2_FFT(std::vector<FieldT> &a, const FieldT &, const std::vector<FieldT> &twiddles)
+{
+    _basic_serial_radix2_FFT(a.data(), a.size(), twiddles);
+}
+
+/* the serial FFTs, for callers passing a thread count to _basic_radix2_FFT */
 template<typename FieldT>
-void _basic_parallel_radix2_FFT_inner(std::vector<FieldT> &a, const FieldT &omega, const size_t log_cpus)
+void _basic_serial_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const size_t num_threads)
+{
+    libff::UNUSED(num_threads);
+    _basic_serial_radix2_FFT(a, omega);
+}
+
+template<typename FieldT>
+void _basic_serial_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const std::vector<FieldT> &twiddles, const size_t num_threads)
+{
+    libff::UNUSED(num_threads);
+    _basic_serial_radix2_FFT(a, omega, twiddles);
+}
+
+template<typename FieldT>
+void _basic_parallel_radix2_FFT_inner(std::vector<FieldT> &a, const FieldT &omega, const size_t log_cpus, const std::vector<FieldT> *twiddles = nullptr)
 {
     const size_t num_cpus = 1ul<<log_cpus;
 
@@ -89,7 +150,8 @@ void _basic_parallel_radix2_FFT_inner(std::vector<FieldT> &a, const FieldT &omeg
 
     if (log_m < log_cpus)
     {
-        _basic_serial_radix2_FFT(a, omega);
+        if (twiddles) _basic_serial_radix2_FFT(a, omega, *twiddles);
+        else _basic_serial_radix2_FFT(a, omega);
         return;
     }
 
@@ -100,7 +162,7 @@ void _basic_parallel_radix2_FFT_inner(std::vector<FieldT> &a, const FieldT &omeg
     }
 
 #ifdef MULTICORE
-    #pragma omp parallel for
+    #pragma omp parallel for num_threads(num_cpus)
 #endif
     for (size_t j = 0; j < num_cpus; ++j)
     {
@@ -124,15 +186,16 @@ void _basic_parallel_radix2_FFT_inner(std::vector<FieldT> &a, const FieldT &omeg
     const FieldT omega_num_cpus = omega^num_cpus;
 
 #ifdef MULTICORE
-    #pragma omp parallel for
+    #pragma omp parallel for num_threads(num_cpus)
 #endif
     for (size_t j = 0; j < num_cpus; ++j)
     {
-        _basic_serial_radix2_FFT(tmp[j], omega_num_cpus);
+        if (twiddles) _basic_serial_radix2_FFT(tmp[j], omega_num_cpus, *twiddles);
+        else _basic_serial_radix2_FFT(tmp[j], omega_num_cpus);
     }
 
 #ifdef MULTICORE
-    #pragma omp parallel for
+    #pragma omp parallel for num_threads(num_cpus)
 #endif
     for (size_t i = 0; i < num_cpus; ++i)
     {
@@ -145,13 +208,9 @@ void _basic_parallel_radix2_FFT_inner(std::vector<FieldT> &a, const FieldT &omeg
 }
 
 template<typename FieldT>
-void _basic_parallel_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega)
+void _basic_parallel_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const size_t num_threads = 0)
 {
-#ifdef MULTICORE
-    const size_t num_cpus = omp_get_max_threads();
-#else
-    const size_t num_cpus = 1;
-#endif
+    const size_t num_cpus = _team_size(num_threads);
     const size_t log_cpus = ((num_cpus & (num_cpus - 1)) == 0 ? log2(num_cpus) : log2(num_cpus) - 1);
 
 #ifdef DEBUG
@@ -168,6 +227,125 @@ void _basic_parallel_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega)
     }
 }
 
+template<typename FieldT>
+void _basic_parallel_radix2_FFT(std::vector<FieldT> &a, const FieldT &omega, const std::vector<FieldT> &twiddles, const size_t num_threads = 0)
+{
+    const size_t num_cpus = _team_size(num_threads);
+    const size_t log_cpus = ((num_cpus & (num_cpus - 1)) == 0 ? log2(num_cpus) : log2(num_cpus) - 1);
+
+    if (log_cpus == 0)
+    {
+        _basic_serial_radix2_FFT(a, omega, twiddles);
+    }
+    else
+    {
+        _basic_parallel_radix2_FFT_inner(a, omega, log_cpus, &twiddles);
+    }
+}
+
+/*
+ out = the transpose of the rows x cols matrix in, both stored by rows, a block of
+ block x block entries at a time so that the reads and the writes stay within a few cache lines.
+ */
+template<typename FieldT>
+void _blocked_transpose(const std::vector<FieldT> &in, std::vector<FieldT> &out, const size_t rows, const size_t cols,
+                        const size_t num_threads = 0)
+{
+    const size_t block = 16;
+
+#ifdef MULTICORE
+    #pragma omp parallel for num_threads(_team_size(num_threads))
+#endif
+    for (size_t bi = 0; bi < rows; bi += block)
+    {
+        const size_t i_end = std::min(bi + block, rows);
+        for (size_t bj = 0; bj < cols; bj += block)
+        {
+            const size_t j_end = std::min(bj + block, cols);
+            for (size_t i = bi; i < i_end; ++i)
+            {
+                for (size_t j = bj; j < j_end; ++j)
+                {
+                    out[j*rows + i] = in[i*cols + j];
+                }
+            }
+        }
+    }
+}
+
+inline bool _basic_radix2_use_four_step(const size_t n, const size_t num_threads)
+{
+#ifdef MULTICORE
+    return (n >= basic_radix2_four_step_min_size && _team_size(num_threads) > 1);
+#else
+    libff::UNUSED(n, num_threads);
+    return false;
+#endif
+}
+
+/*
+ With n = n1 n2 and a[j1 n2 + j2] the entry (j1, j2) of an n1 x n2 matrix,
+   X[k1 + n1 k2] = sum_{j2} omega_n2^{j2 k2} ( omega_n^{j2 k1} sum_{j1} omega_n1^{j1 k1} a[j1 n2 + j2] ),
+ i.e. an FFT of size n1 on every column, the twiddle factors omega_n^{j2 k1}, an FFT of size n2
+ on every row, and X read by columns. The transposes make columns rows and back.
+ */
+template<typename FieldT>
+void _basic_four_step_radix2_FFT(std::vector<FieldT> &a, const std::vector<FieldT> &twiddles, const size_t num_threads)
+{
+    const size_t n = a.size(), logn = log2(n);
+    if (n != (1u << logn)) throw DomainSizeException("expected n == (1u << logn)");
+
+    const size_t N = 2 * twiddles.size();
+    if (n > N || N % n != 0) throw DomainSizeException("expected n to divide 2 * twiddles.size()");
+
+    if (logn < 2)
+    {
+        _basic_serial_radix2_FFT(a.data(), n, twiddles);
+        return;
+    }
+
+    const size_t n1 = 1ul << (logn / 2);
+    const size_t n2 = n / n1;
+    /* omega_n^e = twiddles[e * stride] */
+    const size_t stride = N / n;
+
+    std::vector<FieldT> tmp(n);
+
+    /* tmp = a^T (n2 x n1), then the FFTs of its rows and the twiddle factors */
+    _blocked_transpose(a, tmp, n1, n2, num_threads);
+
+#ifdef MULTICORE
+    #pragma omp parallel for num_threads(_team_size(num_threads))
+#endif
+    for (size_t j2 = 0; j2 < n2; ++j2)
+    {
+        FieldT *row = tmp.data() + j2 * n1;
+        _basic_serial_radix2_FFT(row, n1, twiddles);
+
+        /* omega_n^e = -omega_n^{e - n/2} for e >= n/2 */
+        for (size_t k1 = 1, e = j2; k1 < n1; ++k1, e = (e + j2) & (n - 1))
+        {
+            if (e < n/2) row[k1] *= twiddles[e * stride];
+            else row[k1] *= -twiddles[(e - n/2) * stride];
+        }
+    }
+
+    /* a = tmp^T (n1 x n2), then the FFTs of its rows */
+    _blocked_transpose(tmp, a, n2, n1, num_threads);
+
+#ifdef MULTICORE
+    #pragma omp parallel for num_threads(_team_size(num_threads))
+#endif
+    for (size_t k1 = 0; k1 < n1; ++k1)
+    {
+        _basic_serial_radix2_FFT(a.data() + k1 * n2, n2, twiddles);
+    }
+
+    /* X[k1 + n1 k2] = a[k1 n2 + k2] */
+    _blocked_transpose(a, tmp, n1, n2, num_threads);
+    a.swap(tmp);
+}
+
 template<typename FieldT>
 void _multiply_by_coset(std::vector<FieldT> &a, const FieldT &g)
 {
@@ -179,6 +357,46 @@ void _multiply_by_coset(std::vector<FieldT> &a, const FieldT &g)
     }
 }
 
+template<typename FieldT>
+void _multiply_by_powers(std::vector<FieldT> &a, const std::vector<FieldT> &powers, const size_t num_threads)
+{
+    if (powers.size() < a.size()) throw DomainSizeException("expected powers.size() >= a.size()");
+
+#ifdef MULTICORE
+    #pragma omp parallel for num_threads(_team_size(num_threads))
+#endif
+    for (size_t i = 1; i < a.size(); ++i)
+    {
+        a[i] *= powers[i];
+    }
+}
+
+template<typename FieldT>
+void _multiply_by_constant(std::vector<FieldT> &a, const FieldT &c, const size_t num_threads)
+{
+#ifdef MULTICORE
+    #pragma omp parallel for num_threads(_team_size(num_threads))
+#endif
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] *= c;
+    }
+}
+
+template<typename FieldT>
+std::vector<FieldT> _compute_powers(const size_t n, const FieldT &g)
+{
+    std::vector<FieldT> powers(n);
+    if (n == 0) return powers;
+
+    powers[0] = FieldT::one();
+    for (size_t i = 1; i < n; ++i)
+    {
+        powers[i] = powers[i-1] * g;
+    }
+    return powers;
+}
+
 template<typename FieldT>
 std::vector<FieldT> _basic_radix2_evaluate_all_lagrange_polynomials(const size_t m, const FieldT &t)
 {
@@ -37,7 +37,7 @@ extended_radix2_domain<FieldT>::extended_radix2_domain(const size_t m) : evaluat
 }
 
 template<typename FieldT>
-void extended_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
+void extended_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a, const size_t num_threads)
 {
     if (a.size() != this->m) throw DomainSizeException("extended_radix2: expected a.size() == this->m");
 
@@ -55,8 +55,8 @@ void extended_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
         shift_i *= shift;
     }
 
-    _basic_radix2_FFT(a0, omega);
-    _basic_radix2_FFT(a1, omega);
+    _basic_radix2_FFT(a0, omega, num_threads);
+    _basic_radix2_FFT(a1, omega, num_threads);
 
     for (size_t i = 0; i < small_m; ++i)
     {
@@ -66,7 +66,7 @@ void extended_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void extended_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
+void extended_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a, const size_t num_threads)
 {
     if (a.size() != this->m) throw DomainSizeException("extended_radix2: expected a.size() == this->m");
 
@@ -75,8 +75,8 @@ void extended_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
     std::vector<FieldT> a1(a.begin() + small_m, a.end());
 
     const FieldT omega_inverse = omega.inverse();
-    _basic_radix2_FFT(a0, omega_inverse);
-    _basic_radix2_FFT(a1, omega_inverse);
+    _basic_radix2_FFT(a0, omega_inverse, num_threads);
+    _basic_radix2_FFT(a1, omega_inverse, num_threads);
 
     const FieldT shift_to_small_m = shift^libff::bigint<1>(small_m);
     const FieldT sconst = (FieldT(small_m) * (FieldT::one()-shift_to_small_m)).inverse();
@@ -94,16 +94,16 @@ void extended_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void extended_radix2_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void extended_radix2_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
     _multiply_by_coset(a, g);
-    FFT(a);
+    FFT(a, num_threads);
 }
 
 template<typename FieldT>
-void extended_radix2_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void extended_radix2_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
-    iFFT(a);
+    iFFT(a, num_threads);
     _multiply_by_coset(a, g.inverse());
 }
 
@@ -161,8 +161,9 @@ void extended_radix2_domain<FieldT>::add_poly_Z(const FieldT &coeff, std::vector
 }
 
 template<typename FieldT>
-void extended_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P)
+void extended_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads)
 {
+    libff::UNUSED(num_threads);
     const FieldT coset = FieldT::multiplicative_generator;
 
     const FieldT coset_to_small_m = coset^small_m;
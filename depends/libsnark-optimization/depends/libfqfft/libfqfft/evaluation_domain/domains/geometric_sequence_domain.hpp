@@ -29,15 +29,15 @@ namespace libfqfft {
 
     geometric_sequence_domain(const size_t m);
 
-    void FFT(std::vector<FieldT> &a);
-    void iFFT(std::vector<FieldT> &a);
-    void cosetFFT(std::vector<FieldT> &a, const FieldT &g);
-    void icosetFFT(std::vector<FieldT> &a, const FieldT &g);
+    void FFT(std::vector<FieldT> &a, const size_t num_threads = 0);
+    void iFFT(std::vector<FieldT> &a, const size_t num_threads = 0);
+    void cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads = 0);
+    void icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads = 0);
     std::vector<FieldT> evaluate_all_lagrange_polynomials(const FieldT &t);
     FieldT get_domain_element(const size_t idx);
     FieldT compute_vanishing_polynomial(const FieldT &t);
     void add_poly_Z(const FieldT &coeff, std::vector<FieldT> &H);
-    void divide_by_Z_on_coset(std::vector<FieldT> &P);
+    void divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads = 0);
 
   };
 
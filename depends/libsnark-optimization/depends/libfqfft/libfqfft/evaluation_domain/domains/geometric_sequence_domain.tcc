@@ -34,7 +34,7 @@ geometric_sequence_domain<FieldT>::geometric_sequence_domain(const size_t m) : e
 }
 
 template<typename FieldT>
-void geometric_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a)
+void geometric_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a, const size_t num_threads)
 { 
   if (a.size() != this->m) throw DomainSizeException("geometric: expected a.size() == this->m");
 
@@ -59,7 +59,7 @@ void geometric_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a)
   a.resize(this->m);
 
 #ifdef MULTICORE
-  #pragma omp parallel for
+  #pragma omp parallel for num_threads(_team_size(num_threads))
 #endif
   for (size_t i = 0; i < this->m; i++)
   {
@@ -68,7 +68,7 @@ void geometric_sequence_domain<FieldT>::FFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void geometric_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a)
+void geometric_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a, const size_t num_threads)
 {
   if (a.size() != this->m) throw DomainSizeException("geometric: expected a.size() == this->m");
   
@@ -95,7 +95,7 @@ void geometric_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a)
   a.resize(this->m);
 
 #ifdef MULTICORE
-  #pragma omp parallel for
+  #pragma omp parallel for num_threads(_team_size(num_threads))
 #endif
   for (size_t i = 0; i < this->m; i++)
   {
@@ -106,16 +106,16 @@ void geometric_sequence_domain<FieldT>::iFFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void geometric_sequence_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void geometric_sequence_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
   _multiply_by_coset(a, g);
-  FFT(a);
+  FFT(a, num_threads);
 }
 
 template<typename FieldT>
-void geometric_sequence_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void geometric_sequence_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
-  iFFT(a);
+  iFFT(a, num_threads);
   _multiply_by_coset(a, g.inverse());
 }
 
@@ -236,8 +236,9 @@ void geometric_sequence_domain<FieldT>::add_poly_Z(const FieldT &coeff, std::vec
 }
 
 template<typename FieldT>
-void geometric_sequence_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P)
+void geometric_sequence_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads)
 {
+  libff::UNUSED(num_threads);
   const FieldT coset = FieldT::multiplicative_generator; /* coset in geometric sequence? */
   const FieldT Z_inverse_at_coset = this->compute_vanishing_polynomial(coset).inverse();
   for (size_t i = 0; i < this->m; ++i)
@@ -36,7 +36,7 @@ step_radix2_domain<FieldT>::step_radix2_domain(const size_t m) : evaluation_doma
 }
 
 template<typename FieldT>
-void step_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
+void step_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a, const size_t num_threads)
 {
     if (a.size() != this->m) throw DomainSizeException("step_radix2: expected a.size() == this->m");
 
@@ -61,8 +61,8 @@ void step_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
         }
     }
 
-    _basic_radix2_FFT(c, omega.squared());
-    _basic_radix2_FFT(e, libff::get_root_of_unity<FieldT>(small_m));
+    _basic_radix2_FFT(c, omega.squared(), num_threads);
+    _basic_radix2_FFT(e, libff::get_root_of_unity<FieldT>(small_m), num_threads);
 
     for (size_t i = 0; i < big_m; ++i)
     {
@@ -76,15 +76,15 @@ void step_radix2_domain<FieldT>::FFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void step_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
+void step_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a, const size_t num_threads)
 {
     if (a.size() != this->m) throw DomainSizeException("step_radix2: expected a.size() == this->m");
 
     std::vector<FieldT> U0(a.begin(), a.begin() + big_m);
     std::vector<FieldT> U1(a.begin() + big_m, a.end());
 
-    _basic_radix2_FFT(U0, omega.squared().inverse());
-    _basic_radix2_FFT(U1, libff::get_root_of_unity<FieldT>(small_m).inverse());
+    _basic_radix2_FFT(U0, omega.squared().inverse(), num_threads);
+    _basic_radix2_FFT(U1, libff::get_root_of_unity<FieldT>(small_m).inverse(), num_threads);
 
     const FieldT U0_size_inv = FieldT(big_m).inverse();
     for (size_t i = 0; i < big_m; ++i)
@@ -144,16 +144,16 @@ void step_radix2_domain<FieldT>::iFFT(std::vector<FieldT> &a)
 }
 
 template<typename FieldT>
-void step_radix2_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void step_radix2_domain<FieldT>::cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
     _multiply_by_coset(a, g);
-    FFT(a);
+    FFT(a, num_threads);
 }
 
 template<typename FieldT>
-void step_radix2_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g)
+void step_radix2_domain<FieldT>::icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads)
 {
-    iFFT(a);
+    iFFT(a, num_threads);
     _multiply_by_coset(a, g.inverse());
 }
 
@@ -218,8 +218,9 @@ void step_radix2_domain<FieldT>::add_poly_Z(const FieldT &coeff, std::vector<Fie
 }
 
 template<typename FieldT>
-void step_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P)
+void step_radix2_domain<FieldT>::divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads)
 {
+    libff::UNUSED(num_threads);
     // (c^{2^k}-1) * (c^{2^r} * w^{2^{r+1}*i) - w^{2^r})
     const FieldT coset = FieldT::multiplicative_generator;
 
@@ -28,8 +28,26 @@
 
 #include <vector>
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 namespace libfqfft {
 
+/**
+ * The number of threads of a parallel region for a caller asking for num_threads of them,
+ * where 0 asks for the default team (omp_get_max_threads()).
+ */
+inline int _team_size(const size_t num_threads)
+{
+#ifdef MULTICORE
+    return (num_threads > 0 ? (int) num_threads : omp_get_max_threads());
+#else
+    (void) num_threads;
+    return 1;
+#endif
+}
+
 /**
  * An evaluation domain.
  */
@@ -53,23 +71,26 @@ public:
 
     /**
      * Compute the FFT, over the domain S, of the vector a.
+     *
+     * The transforms and divide_by_Z_on_coset run their parallel regions on num_threads
+     * threads, 0 for the default team, so that a caller can run them next to other work.
      */
-    virtual void FFT(std::vector<FieldT> &a) = 0;
+    virtual void FFT(std::vector<FieldT> &a, const size_t num_threads = 0) = 0;
 
     /**
      * Compute the inverse FFT, over the domain S, of the vector a.
      */
-    virtual void iFFT(std::vector<FieldT> &a) = 0;
+    virtual void iFFT(std::vector<FieldT> &a, const size_t num_threads = 0) = 0;
 
     /**
      * Compute the FFT, over the domain g*S, of the vector a.
      */
-    virtual void cosetFFT(std::vector<FieldT> &a, const FieldT &g) = 0;
+    virtual void cosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads = 0) = 0;
 
     /**
      * Compute the inverse FFT, over the domain g*S, of the vector a.
      */
-    virtual void icosetFFT(std::vector<FieldT> &a, const FieldT &g) = 0;
+    virtual void icosetFFT(std::vector<FieldT> &a, const FieldT &g, const size_t num_threads = 0) = 0;
 
     /**
      * Evaluate all Lagrange polynomials.
@@ -95,7 +116,13 @@ public:
     /**
      * Multiply by the evaluation, on a coset of S, of the inverse of the vanishing polynomial of S.
      */
-    virtual void divide_by_Z_on_coset(std::vector<FieldT> &P) = 0;
+    virtual void divide_by_Z_on_coset(std::vector<FieldT> &P, const size_t num_threads = 0) = 0;
+
+    /**
+     * Precompute the tables (twiddle factors, coset powers) reused by repeated
+     * transforms over S. Domains without such tables ignore the call.
+     */
+    virtual void precompute() {};
 
     virtual ~evaluation_domain(){}
 };
@@ -0,0 +1,90 @@
+/**
+ *****************************************************************************
+ * Times the FFTs of basic_radix2_domain : without tables, with the precomputed twiddles, and
+ * with the four-step method, over a range of sizes. Prints one line per size,
+ *     logn  no-table  twiddles  four-step  (milliseconds)
+ * and the domain's choice. Run with OMP_NUM_THREADS set to compare thread counts.
+ *
+ * Usage : profile_basic_radix2_domain [ min_logn [ max_logn ] ]
+ *****************************************************************************
+ * @author     This file is part of libfqfft, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+
+#include <libfqfft/evaluation_domain/domains/basic_radix2_domain.hpp>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+using namespace libfqfft;
+
+typedef libff::Fr<libff::alt_bn128_pp> FieldT;
+
+/* the best of a few runs of transform on a copy of a, in milliseconds, and its output */
+double time_FFT(const std::vector<FieldT> &a, std::vector<FieldT> &out,
+                const std::function<void(std::vector<FieldT> &)> &transform)
+{
+    const size_t runs = 3;
+    double best = -1;
+    for (size_t i = 0; i < runs; ++i)
+    {
+        out = a;
+        const auto start = std::chrono::steady_clock::now();
+        transform(out);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (best < 0 || ms < best) { best = ms; }
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const size_t min_logn = (argc > 1 ? std::atoi(argv[1]) : 14);
+    const size_t max_logn = (argc > 2 ? std::atoi(argv[2]) : 22);
+
+    libff::alt_bn128_pp::init_public_params();
+
+#ifdef MULTICORE
+    printf("* threads: %d\n", omp_get_max_threads());
+#endif
+    printf("logn\tno-table\ttwiddles\tfour-step\tdomain\n");
+
+    for (size_t logn = min_logn; logn <= max_logn; ++logn)
+    {
+        const size_t n = 1ul << logn;
+
+        /* the powers of a random element, which are as good as random entries and cheaper to draw */
+        std::vector<FieldT> a(n);
+        const FieldT r = FieldT::random_element();
+        a[0] = r;
+        for (size_t i = 1; i < n; ++i) { a[i] = a[i-1] * r; }
+
+        basic_radix2_domain<FieldT> domain(n);
+        domain.precompute();
+
+        std::vector<FieldT> plain, table, four_step;
+        const double plain_ms = time_FFT(a, plain, [&](std::vector<FieldT> &v) { _basic_radix2_FFT(v, domain.omega); });
+        const double table_ms = time_FFT(a, table, [&](std::vector<FieldT> &v) { _basic_radix2_FFT(v, domain.omega, domain.twiddles); });
+        const double four_step_ms = time_FFT(a, four_step, [&](std::vector<FieldT> &v) { _basic_four_step_radix2_FFT(v, domain.twiddles); });
+
+        printf("%zu\t%.1f\t%.1f\t%.1f\t%s\n", logn, plain_ms, table_ms, four_step_ms,
+               _basic_radix2_use_four_step(n) ? "four-step" : "twiddles");
+
+        if (table != plain || four_step != plain)
+        {
+            fprintf(stderr, "FFTs NOT MATCHING at logn = %zu\n", logn);
+            return 1;
+        }
+    }
+
+    return 0;
+}
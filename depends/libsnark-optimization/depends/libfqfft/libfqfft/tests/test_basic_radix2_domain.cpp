@@ -0,0 +1,177 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libfqfft, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+
+#include <libfqfft/evaluation_domain/domains/basic_radix2_domain.hpp>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+using namespace libfqfft;
+
+template<typename FieldT>
+std::vector<FieldT> random_vector(const size_t n)
+{
+    std::vector<FieldT> a(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = FieldT::random_element();
+    }
+    return a;
+}
+
+/* the transforms computed with _basic_serial_radix2_FFT and no table */
+template<typename FieldT>
+std::vector<FieldT> serial_FFT(std::vector<FieldT> a, const FieldT &omega)
+{
+    _basic_serial_radix2_FFT(a, omega);
+    return a;
+}
+
+template<typename FieldT>
+std::vector<FieldT> serial_iFFT(std::vector<FieldT> a, const FieldT &omega)
+{
+    _basic_serial_radix2_FFT(a, omega.inverse());
+    const FieldT m_inverse = FieldT(a.size()).inverse();
+    for (FieldT &v : a) { v *= m_inverse; }
+    return a;
+}
+
+template<typename FieldT>
+std::vector<FieldT> serial_cosetFFT(std::vector<FieldT> a, const FieldT &omega, const FieldT &g)
+{
+    FieldT u = FieldT::one();
+    for (FieldT &v : a) { v *= u; u *= g; }
+    return serial_FFT(a, omega);
+}
+
+template<typename FieldT>
+std::vector<FieldT> serial_icosetFFT(const std::vector<FieldT> &a, const FieldT &omega, const FieldT &g)
+{
+    std::vector<FieldT> b = serial_iFFT(a, omega);
+    const FieldT g_inverse = g.inverse();
+    FieldT u = FieldT::one();
+    for (FieldT &v : b) { v *= u; u *= g_inverse; }
+    return b;
+}
+
+/* _basic_four_step_radix2_FFT on its own, with the twiddles of the size and of twice the size */
+template<typename FieldT>
+void test_four_step_FFT(const size_t n)
+{
+    const std::vector<FieldT> a = random_vector<FieldT>(n);
+
+    basic_radix2_domain<FieldT> domain(n), double_domain(2 * n);
+    domain.precompute();
+    double_domain.precompute();
+
+    const std::vector<FieldT> expected = serial_FFT(a, domain.omega);
+
+    std::vector<FieldT> b = a;
+    _basic_four_step_radix2_FFT(b, domain.twiddles);
+    assert(b == expected);
+
+    b = a;
+    _basic_four_step_radix2_FFT(b, double_domain.twiddles);
+    assert(b == expected);
+
+    b = a;
+    _basic_four_step_radix2_FFT(b, domain.inverse_twiddles);
+    assert(b == serial_FFT(a, domain.omega.inverse()));
+
+    printf("* four-step FFT of size 2^%zu\n", libff::log2(n));
+}
+
+/* FFT, iFFT, cosetFFT and icosetFFT of a precomputed domain, against the serial transforms */
+template<typename FieldT>
+void test_precomputed_domain(const size_t n)
+{
+    const std::vector<FieldT> a = random_vector<FieldT>(n);
+    const FieldT g = FieldT::multiplicative_generator;
+    const FieldT h = FieldT::random_element();
+
+    basic_radix2_domain<FieldT> domain(n);
+    domain.precompute();
+
+    std::vector<FieldT> b = a;
+    domain.FFT(b);
+    assert(b == serial_FFT(a, domain.omega));
+
+    domain.iFFT(b);
+    assert(b == a);
+
+    b = a;
+    domain.iFFT(b);
+    assert(b == serial_iFFT(a, domain.omega));
+
+    /* the precomputed coset powers of the multiplicative generator, and another coset */
+    b = a;
+    domain.cosetFFT(b, g);
+    assert(b == serial_cosetFFT(a, domain.omega, g));
+
+    domain.icosetFFT(b, g);
+    assert(b == a);
+
+    b = a;
+    domain.icosetFFT(b, g);
+    assert(b == serial_icosetFFT(a, domain.omega, g));
+
+    b = a;
+    domain.cosetFFT(b, h);
+    assert(b == serial_cosetFFT(a, domain.omega, h));
+
+    b = a;
+    domain.icosetFFT(b, h);
+    assert(b == serial_icosetFFT(a, domain.omega, h));
+
+    /* on teams of a given size, the four-step FFT only from two threads on */
+    for (const size_t num_threads : { 1, 2, 3 })
+    {
+        b = a;
+        domain.cosetFFT(b, g, num_threads);
+        assert(b == serial_cosetFFT(a, domain.omega, g));
+
+        std::vector<FieldT> c = b;
+        domain.divide_by_Z_on_coset(b, num_threads);
+        domain.divide_by_Z_on_coset(c);
+        assert(b == c);
+
+        domain.icosetFFT(b, g, num_threads);
+        assert(b == serial_icosetFFT(c, domain.omega, g));
+    }
+
+    printf("* precomputed domain of size 2^%zu ( %s )\n", libff::log2(n),
+           _basic_radix2_use_four_step(n) ? "four-step" : "radix-2");
+}
+
+int main()
+{
+    libff::alt_bn128_pp::init_public_params();
+    typedef libff::Fr<libff::alt_bn128_pp> FieldT;
+
+#ifdef MULTICORE
+    /* a thread count that divides none of the sizes */
+    omp_set_num_threads(3);
+    assert(_basic_radix2_use_four_step(basic_radix2_four_step_min_size));
+#endif
+    assert(!_basic_radix2_use_four_step(basic_radix2_four_step_min_size / 2));
+
+    for (const size_t logn : { 1, 2, 3, 10, 11, 17, 18 })
+    {
+        test_four_step_FFT<FieldT>(1ul << logn);
+    }
+
+    for (const size_t logn : { 10, 11, 17, 18 })
+    {
+        test_precomputed_domain<FieldT>(1ul << logn);
+    }
+}
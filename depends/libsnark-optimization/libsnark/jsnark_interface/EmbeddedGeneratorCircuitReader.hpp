@@ -1,6 +1,4 @@
-
-
-#pragma once 
+#pragma once
 
 #include <memory.h>
 #include <iostream>
@@ -16,8 +14,8 @@
 #include <unistd.h>
 #include <stdio.h>
 
-#include <libsnark/gadgetlib2/integration.hpp>
-#include <libsnark/gadgetlib2/adapters.hpp>
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs.hpp>
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs_optimizer.hpp>
 #include <libff/common/profiling.hpp>
 
 #include <OpCode.hpp>
@@ -26,7 +24,6 @@
 
 using namespace std;
 using namespace libsnark;
-using namespace gadgetlib2;
 
 
 typedef struct {
@@ -35,64 +32,113 @@ typedef struct {
 } wire2VariableMap_t ;
 
 
+/**
+ * Lowers the BasicOps of an embedded circuit generator straight into an r1cs_constraint_system.
+ *
+ * Wires computed by additions, packs and constant multiplications are kept as linear combinations
+ * in one term arena ( sorted and merged , released on their last use ) ; every other wire gets a
+ * variable in a flat wire-to-variable table. Variables are numbered from the context exactly as the
+ * gadgetlib2 translation did , so the constraint system and the wire map stay the same.
+ */
 template<typename FieldT >
 class EmbeddedGeneratorCircuitReader  {
 
 public:
 
-	typedef ::std::shared_ptr<LinearCombination<FieldT>> LinearCombinationPtr;
 	typedef int32_t WIRE ;
-	typedef ::std::map<WIRE, unsigned int> WireMap;
 
-	EmbeddedGeneratorCircuitReader(CircuitGenerator * generator, 
-					ProtoboardPtr<FieldT> pb , 
-					wire2VariableMap_t** wire_variable_map , 
-					uint32_t* wire_variable_map_count , 
-					uint32_t** zero_variables_idx , 
+	EmbeddedGeneratorCircuitReader(CircuitGenerator * generator,
+					r1cs_constraint_system<FieldT> & cs ,
+					wire2VariableMap_t** wire_variable_map ,
+					uint32_t* wire_variable_map_count ,
+					uint32_t** zero_variables_idx ,
 					uint32_t* zero_variables_count ,
 					libff::profiling & profile ,
 					libsnark::Context_base * context );
-	
+
 	~EmbeddedGeneratorCircuitReader();
 
-	void evaluateInputs( libff::profiling & profile );
+	void evaluateInputs( const std::vector<FieldT> & wireValues ,
+						 r1cs_variable_assignment<FieldT> & full_assignment ,
+						 libff::profiling & profile );
+
+	void updateInputs( const std::vector<FieldT> & wireValues ,
+					   const std::vector<wireID_t> & changedWires ,
+					   r1cs_variable_assignment<FieldT> & full_assignment ,
+					   libff::profiling & profile );
+
+	// the nonzero checks read their condition variables and write their inverse variables
+	void keepVariables( r1cs_optimizer<FieldT> & optimizer ) const ;
+	void remapVariables( const std::vector<uint32_t> & variable_map );
 
 	int getNumInputs() { return numInputs;}
 	int getNumOutputs() { return numOutputs;}
-	
+
 
 private:
-	
-	CircuitGenerator * generator ;
 
-	ProtoboardPtr<FieldT> pb;
-	
-	std::vector<VariablePtr<FieldT>> variables;
-	std::vector<LinearCombinationPtr> wireLinearCombinations;
-	std::vector<LinearCombinationPtr> zeroPwires;
+	enum : uint32_t { NO_VARIABLE = 0xFFFFFFFF };
 
-	WireMap variableMap;
-	WireMap zeropMap;
+	// a term over a variable index , as handed out by the context ( the r1cs index is one more )
+	typedef struct {
+		uint32_t index ;
+		FieldT coeff ;
+	} term_t ;
 
-	std::vector<pair< WIRE , VariablePtr<FieldT> >>  variable_wireIds_map ; 
-	std::vector<pair< WIRE , VariablePtr<FieldT> >>  zerop_variable_wireIds_map ; 
+	// the terms of a wire : a run in the arena , or a single variable when size is zero
+	typedef struct {
+		size_t offset ;
+		uint32_t size ;
+		uint32_t variable ;
+	} wire_lc_t ;
 
-	std::vector<unsigned int> wireUseCounters;
-	std::vector<FieldT> wireValues;
+	typedef struct {
+		WIRE outputWire ;
+		uint32_t auxVariable ;
+		size_t offset ;
+		uint32_t size ;
+	} zero_check_t ;
 
-	std::vector<WIRE> toClean;
+	CircuitGenerator * generator ;
+	r1cs_constraint_system<FieldT> * cs ;
+	libsnark::Context_base * context ;
+
+	std::vector<uint32_t> wireVariables ;
+	std::vector<wire_lc_t> wireLinearCombinations ;
+	std::vector<unsigned int> wireUseCounters ;
+
+	std::vector<term_t> arena ;
+	size_t liveTerms ;
+	std::vector<WIRE> arenaWires ;
+	std::vector<WIRE> toClean ;
+
+	// the condition of every nonzero check , kept to assign its inverse
+	std::vector<zero_check_t> zeroChecks ;
+	std::vector<term_t> zeroConditions ;
+	std::vector<uint8_t> changedVariables ;
+
+	std::vector<term_t> A , B , C ;
 
 	wireID_t numWires;
 	wireID_t numInputs, numNizkInputs, numOutputs;
 
-	unsigned int currentVariableIdx , currentLinearCombinationIdx;
+	uint32_t firstVariable ;
 
-	void constructCircuit( ); 
-	void evaluate_inputs( );
-	void mapValuesToProtoboard();
+	void constructCircuit( );
 
-	int find(WIRE, LinearCombinationPtr&, bool intentionToEdit = false);
+	uint32_t newVariable( WIRE wireId );
+	void find( WIRE wireId , wire_lc_t & lc );
 	void clean();
+	void compact();
+
+	void append( const wire_lc_t & lc , std::vector<term_t> & terms );
+	void append( const wire_lc_t & lc , std::vector<term_t> & terms , const FieldT & scale );
+	void merge( std::vector<term_t> & terms );
+	void setLinearCombination( WIRE wireId , std::vector<term_t> & terms );
+	void convert( std::vector<term_t> & terms , const FieldT & constant , linear_combination<FieldT> & result );
+	void addConstraint( const FieldT & constantA , const FieldT & constantB , const FieldT & constantC );
+
+	void checkCompliance( WIRE outputWireId , const char * operation );
 
 	void addMulConstraint(const Wires & inputs, const Wires & outputs);
 	void addXorConstraint(const Wires & inputs, const Wires & outputs);
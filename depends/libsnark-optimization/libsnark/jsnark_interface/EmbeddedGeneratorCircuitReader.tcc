@@ -1,4 +1,5 @@
 
+#include <algorithm>
 
 #include <Instruction.hpp>
 #include <WireLabelInstruction.hpp>
@@ -9,49 +10,47 @@
 
 #include <logging.hpp>
 
- 
- 
+
+
 template<typename FieldT >
 EmbeddedGeneratorCircuitReader<FieldT>::EmbeddedGeneratorCircuitReader(
-					CircuitGenerator * generator, 
-					ProtoboardPtr<FieldT> pb,
-					wire2VariableMap_t** wire_variable_map , 
-					uint32_t* wire_variable_map_count , 
-					uint32_t** zero_variables_idx , 
+					CircuitGenerator * generator,
+					r1cs_constraint_system<FieldT> & cs ,
+					wire2VariableMap_t** wire_variable_map ,
+					uint32_t* wire_variable_map_count ,
+					uint32_t** zero_variables_idx ,
 					uint32_t* zero_variables_count ,
 					libff::profiling & profile ,
 					libsnark::Context_base * context)
 {
-	libff::UNUSED(context);
-	this->pb = pb;
+	this->cs = &cs ;
+	this->context = context ;
 	this->generator = generator ;
 	numInputs = numNizkInputs = numOutputs = 0;
+	liveTerms = 0 ;
 
 	std::vector<WIRE> inputWireIds;
 	std::vector<WIRE> nizkWireIds;
 	std::vector<WIRE> outputWireIds;
 
-	profile.enter_block("Circuit Reader" ); 
-	
+	profile.enter_block("Circuit Reader" );
+
 	numWires = generator->getNumWires();
 	wireUseCounters.resize(numWires);
-	wireLinearCombinations.resize(numWires);
-
-	inputWireIds.get_allocator().allocate(numWires);
-	nizkWireIds.get_allocator().allocate(numWires);
-	outputWireIds.get_allocator().allocate(numWires);
+	wireVariables.resize(numWires, NO_VARIABLE);
+	wireLinearCombinations.resize(numWires, { 0 , 0 , NO_VARIABLE });
 
 	EvaluationQueue& evalSequence = generator->getEvaluationQueue();
-	
+
 	for ( auto e : evalSequence ){
-		
+
 		if ( ! e->doneWithinCircuit()) { continue ; }
-		
+
 		if (e->instanceof_WireLabelInstruction()){
-			
+
 			WireLabelInstruction* label_instr = (WireLabelInstruction*)e ;
 			WIRE wireId = label_instr->getWire()->getWireId() ;
-			
+
 			switch(label_instr->getType()){
 				case input :
 					numInputs++;
@@ -72,10 +71,10 @@ EmbeddedGeneratorCircuitReader<FieldT>::EmbeddedGeneratorCircuitReader(
 		}
 
 		if (e->instanceof_BasicOp()) {
-			
+
 			BasicOp* Op = (BasicOp*)e ;
 			const short opcode = (short)Op->op_code() ;
-			
+
 			for ( WirePtr w : Op->getInputs() ){
 				WIRE inWireId = w->getWireId();
 				wireUseCounters[inWireId] ++ ;
@@ -87,88 +86,97 @@ EmbeddedGeneratorCircuitReader<FieldT>::EmbeddedGeneratorCircuitReader(
 
 		}
 	}
- 
-    LOGD("numInputs:%d , numOutputs:%d , numNizkInputs:%d \n", numInputs, numOutputs, numNizkInputs);
 
-    
-	currentVariableIdx = currentLinearCombinationIdx = 0;
+	LOGD("numInputs:%d , numOutputs:%d , numNizkInputs:%d \n", numInputs, numOutputs, numNizkInputs);
+
 
 	for (wireID_t i = 0; i < numInputs; i++) {
-		variables.push_back(make_shared<Variable<FieldT>>( pb->g_cxt() , "input"));
-		variableMap[inputWireIds[i]] = currentVariableIdx;
-		currentVariableIdx++;
+		newVariable(inputWireIds[i]);
 	}
 
 	for (wireID_t i = 0; i < numOutputs; i++) {
-		variables.push_back(make_shared<Variable<FieldT>>( pb->g_cxt()  , "output"));
-		variableMap[outputWireIds[i]] = currentVariableIdx;
-		currentVariableIdx++;
+		newVariable(outputWireIds[i]);
 	}
 
 	for (wireID_t i = 0; i < numNizkInputs; i++) {
-		variables.push_back(make_shared<Variable<FieldT>>(pb->g_cxt()  , "nizk input"));
-		variableMap[nizkWireIds[i]] = currentVariableIdx;
-		currentVariableIdx++;
+		newVariable(nizkWireIds[i]);
 	}
 
+	firstVariable = ( numInputs ) ? wireVariables[inputWireIds[0]] : 0 ;
+
+	inputWireIds.clear() ;
+	nizkWireIds.clear() ;
+	outputWireIds.clear() ;
+
 
-	
-	profile.enter_block("Construct Circuit"); 
+	profile.enter_block("Construct Circuit");
 	constructCircuit( );
-	profile.leave_block("Construct Circuit" ); 
+	profile.leave_block("Construct Circuit" );
 
 
-	size_t ix ;
-	
-	wire2VariableMap_t* w_v_map  = (wire2VariableMap_t*) malloc ( sizeof(wire2VariableMap_t) * variableMap.size() ) ;
-	*wire_variable_map = w_v_map ;
-	*wire_variable_map_count = variableMap.size() ;
-	variable_wireIds_map.get_allocator().allocate(variableMap.size()) ;
-	ix = 0 ;
+	size_t count = 0 ;
+	for ( wireID_t wireId = 0 ; wireId < numWires ; wireId++ ){
+		if ( wireVariables[wireId] != NO_VARIABLE ) { count++ ; }
+	}
 
-	for ( auto iter : variableMap ) {
-		variable_wireIds_map.push_back({ iter.first , variables[iter.second] }) ;
-		w_v_map[ix++] = { .wire_idx = static_cast<uint32_t>(iter.first) , 
-						  .variable_idx = static_cast<uint32_t>( variables[iter.second]->index() )
-						} ;
+	wire2VariableMap_t* w_v_map  = (wire2VariableMap_t*) malloc ( sizeof(wire2VariableMap_t) * count ) ;
+	*wire_variable_map = w_v_map ;
+	*wire_variable_map_count = count ;
+
+	size_t ix = 0 ;
+	for ( wireID_t wireId = 0 ; wireId < numWires ; wireId++ ){
+		if ( wireVariables[wireId] != NO_VARIABLE ) {
+			w_v_map[ix++] = { .wire_idx = static_cast<uint32_t>(wireId) ,
+							  .variable_idx = wireVariables[wireId]
+							} ;
+		}
 	}
 
 
-	uint32_t* z_v_map = ( zeropMap.size() ) ? (uint32_t*) malloc ( sizeof(uint32_t) * zeropMap.size() ) : NULL ;
+	// the zero variables are listed by the output wire of their check
+	std::stable_sort( zeroChecks.begin() , zeroChecks.end() ,
+					  []( const zero_check_t & a , const zero_check_t & b ){ return a.outputWire < b.outputWire ; } );
+
+	uint32_t* z_v_map = ( zeroChecks.size() ) ? (uint32_t*) malloc ( sizeof(uint32_t) * zeroChecks.size() ) : NULL ;
 	*zero_variables_idx = z_v_map ;
-	*zero_variables_count = zeropMap.size();
-	zerop_variable_wireIds_map.get_allocator().allocate(zeropMap.size()) ;
-	ix = 0 ;
+	*zero_variables_count = zeroChecks.size();
 
-	for ( auto iter  : zeropMap){
-		zerop_variable_wireIds_map.push_back({ iter.first ,  variables[iter.second] }) ;
-		z_v_map[ix++] = static_cast<uint32_t>( variables[iter.second]->index() ) ;
+	for ( ix = 0 ; ix < zeroChecks.size() ; ix++ ){
+		z_v_map[ix] = zeroChecks[ix].auxVariable ;
 	}
 
-	
+
 	wireUseCounters.clear() ;
-	inputWireIds.clear() ;
-	nizkWireIds.clear() ;
-	outputWireIds.clear() ;
-	variables.clear();
-	variableMap.clear();
-	zeropMap.clear();
+	wireUseCounters.shrink_to_fit() ;
 	wireLinearCombinations.clear() ;
-
-	profile.leave_block("Circuit Reader" ); 
+	wireLinearCombinations.shrink_to_fit() ;
+	arena.clear() ;
+	arena.shrink_to_fit() ;
+	arenaWires.clear() ;
+	arenaWires.shrink_to_fit() ;
+	A.clear() ; A.shrink_to_fit() ;
+	B.clear() ; B.shrink_to_fit() ;
+	C.clear() ; C.shrink_to_fit() ;
+
+	LOGD("Constraints:%zu , Variables:%zu , Wire Map:%zu , Zero Variables:%zu \n",
+		 cs.constraints.size() , (size_t)context->getLastVariableIndex() , count , zeroChecks.size() );
+
+	profile.leave_block("Circuit Reader" );
 }
 
 template<typename FieldT >
 EmbeddedGeneratorCircuitReader<FieldT>::~EmbeddedGeneratorCircuitReader(){
 	generator = NULL ;
-	variables.clear() ;
+	cs = NULL ;
+	wireVariables.clear() ;
 	wireLinearCombinations.clear() ;
-	zeroPwires.clear() ;
-	variableMap.clear() ;
-	zeropMap.clear();
 	wireUseCounters.clear() ;
-	wireValues.clear() ;
+	arena.clear() ;
+	arenaWires.clear() ;
 	toClean.clear() ;
+	zeroChecks.clear() ;
+	zeroConditions.clear() ;
+	changedVariables.clear() ;
 }
 
 
@@ -178,21 +186,21 @@ void EmbeddedGeneratorCircuitReader<FieldT>::constructCircuit( ){
 	LOGD("Translating Constraints \n");
 
 	EvaluationQueue& evalSequence = generator->getEvaluationQueue();
-	
+
 	for ( auto e : evalSequence ){
-		
+
 		if ( ! e->doneWithinCircuit()) {
 			continue ;
 		}
-		
+
 		if(e->instanceof_BasicOp()){
-			
+
 			BasicOp* Op = (BasicOp*)e ;
 			const short opcode = (short)Op->op_code() ;
 			const unsigned int numGateInputs = Op->getInputs().size();
 			const unsigned int numGateOutputs = Op->getOutputs().size() ;
 
-			 
+
 			if (opcode == ADD_OPCODE) {
 				assert(numGateOutputs == 1);
 				handleAddition( Op->getInputs() , Op->getOutputs() );
@@ -227,7 +235,7 @@ void EmbeddedGeneratorCircuitReader<FieldT>::constructCircuit( ){
 				assert(numGateOutputs == 1);
 				handlePackOperation(Op->getInputs() , Op->getOutputs() , numGateInputs);
 			}
-			
+
 		}
 
 		clean();
@@ -239,186 +247,145 @@ void EmbeddedGeneratorCircuitReader<FieldT>::constructCircuit( ){
 
 
 template<typename FieldT >
-void EmbeddedGeneratorCircuitReader<FieldT>::evaluateInputs(  libff::profiling & profile ){
+void EmbeddedGeneratorCircuitReader<FieldT>::evaluateInputs( const std::vector<FieldT> & wireValues ,
+															 r1cs_variable_assignment<FieldT> & full_assignment ,
+															 libff::profiling & profile ){
 
-	LOGD("Parsing and evaluating the inputs\n");
-	profile.enter_block("Parsing and evaluating the inputs" );
+	// the wire values come from the EvaluationProgram , only the variables are left to fill
+	LOGD("Map values to variables\n");
+	profile.enter_block("Map values to variables" );
 
-	EvaluationQueue& evalSequence = generator->getEvaluationQueue();
-	
-	wireValues.clear();
-	wireValues.resize(numWires);
-
-	for ( auto e : evalSequence){
-		if ( e->instanceof_WireLabelInstruction()){ 
-			WireLabelInstruction* wl = (WireLabelInstruction*) e ;
-			if ( (wl->getType() == LabelType::input) || 
-				 (wl->getType() == LabelType::nizkinput)) 
-			{
-				const WIRE wireId = wl->getWire()->getWireId();
-				wireValues[wireId] = convert2FieldT<FieldT>( generator->getCircuitEvaluator()->getAssignment( wireId )) ;
-			}
-		}		
+	for ( wireID_t wireId = 0 ; wireId < numWires ; wireId++ ){
+		if ( wireVariables[wireId] != NO_VARIABLE ) {
+			full_assignment[ wireVariables[wireId] ] = wireValues[wireId] ;
+		}
 	}
 
-	if (wireValues[0] != FieldT::one()) {
-		LOGD(">> Warning: when using jsnark circuit generator, the first input wire (#0) must have the value of 1.\n");
-		LOGD("\t If the circuit was generated using Pinocchio *without modification*, you can ignore this warning. Pinocchio uses a different indexing for the one-wire input. \n");
+	for ( const zero_check_t & check : zeroChecks ){
+		FieldT condition = FieldT::zero() ;
+		for ( size_t i = check.offset ; i < check.offset + check.size ; i++ ){
+			condition += zeroConditions[i].coeff * full_assignment[ zeroConditions[i].index ] ;
+		}
+		full_assignment[ check.auxVariable ] = ( condition.is_zero() ) ? FieldT::zero() : condition.inverse() ;
 	}
 
-	profile.leave_block("Parsing and evaluating the inputs" );
-
-	evaluate_inputs( );
-	
-	LOGD("Map values to protoboard\n");
-	profile.enter_block("Map values to protoboard" );
-	mapValuesToProtoboard();
-	profile.leave_block("Map values to protoboard" );
-	
-	wireValues.clear();
+	profile.leave_block("Map values to variables" );
 
 	return ;
 }
 
 
+/**
+ * Patches an assignment filled by a previous evaluateInputs : only the variables of the changed wires
+ * are written, and only the nonzero checks whose condition reads one of them are inverted again.
+ */
 template<typename FieldT >
-void EmbeddedGeneratorCircuitReader<FieldT>::evaluate_inputs( ) {
+void EmbeddedGeneratorCircuitReader<FieldT>::updateInputs( const std::vector<FieldT> & wireValues ,
+														   const std::vector<wireID_t> & changedWires ,
+														   r1cs_variable_assignment<FieldT> & full_assignment ,
+														   libff::profiling & profile ){
 
-	FieldT oneElement = FieldT::one();
-	FieldT zeroElement = FieldT::zero();
-	FieldT negOneElement = FieldT(-1);
+	LOGD("Map changed values to variables : %zu wires\n" , changedWires.size() );
+	profile.enter_block("Map changed values to variables" );
 
-	EvaluationQueue& evalSequence = generator->getEvaluationQueue();
- 
-	for ( auto e : evalSequence ){
-		
-		if ( ! e->doneWithinCircuit()) { continue ; }
-		
-		if (e->instanceof_BasicOp()) {
-			
-			BasicOp* Op = (BasicOp*)e ;
-			const short opcode = (short)Op->op_code() ;
-			std::vector<FieldT> inValues;
-			std::vector<WIRE> outWires;
-			
-
-			for ( WirePtr w : Op->getInputs() ){
-				WIRE inWireId = w->getWireId();
-				inValues.push_back(wireValues[inWireId]);		
-			}
+	changedVariables.resize( full_assignment.size() , 0 );
 
-			for ( WirePtr w : Op->getOutputs() ){
-				WIRE outWireId = w->getWireId();
-				outWires.push_back(outWireId);		
-			}
-
-			
-			FieldT constant;
+	for ( wireID_t wireId : changedWires ){
+		const uint32_t variable = wireVariables[wireId] ;
+		if ( variable != NO_VARIABLE ) {
+			full_assignment[ variable ] = wireValues[wireId] ;
+			changedVariables[ variable ] = 1 ;
+		}
+	}
 
-			if ( opcode == MULCONST_OPCODE ) {
-				ConstMulBasicOp* const_mul = (ConstMulBasicOp*)Op ;
-				if ( const_mul->get_inSign()) {
-					constant = convert2FieldT<FieldT>(const_mul->getOpCodeConstInteger()) * negOneElement ;
-				} else{
-					constant = convert2FieldT<FieldT>(const_mul->getOpCodeConstInteger()) ;
-				}
+	for ( const zero_check_t & check : zeroChecks ){
+		bool changed = false ;
+		for ( size_t i = check.offset ; i < check.offset + check.size && ! changed ; i++ ){
+			changed = changedVariables[ zeroConditions[i].index ] ;
+		}
+		if ( changed ){
+			FieldT condition = FieldT::zero() ;
+			for ( size_t i = check.offset ; i < check.offset + check.size ; i++ ){
+				condition += zeroConditions[i].coeff * full_assignment[ zeroConditions[i].index ] ;
 			}
+			full_assignment[ check.auxVariable ] = ( condition.is_zero() ) ? FieldT::zero() : condition.inverse() ;
+		}
+	}
 
-
-			if (opcode == ADD_OPCODE) {
-				FieldT sum;
-				for (auto &v : inValues)
-					sum += v;
-				wireValues[outWires[0]] = sum;
-			} else if (opcode == MUL_OPCODE) {
-				wireValues[outWires[0]] = inValues[0] * inValues[1];
-			} else if (opcode == XOR_OPCODE) {
-				wireValues[outWires[0]] =
-						(inValues[0] == inValues[1]) ? zeroElement : oneElement;
-			} else if (opcode == OR_OPCODE) {
-				wireValues[outWires[0]] =
-						(inValues[0] == zeroElement
-								&& inValues[1] == zeroElement) ?
-								zeroElement : oneElement;
-			} else if (opcode == NONZEROCHECK_OPCODE) {
-				wireValues[outWires[1]] =
-						(inValues[0] == zeroElement) ? zeroElement : oneElement;
-			} else if (opcode == PACK_OPCODE) {
-				FieldT sum, coeff;
-				FieldT two = oneElement;
-				for (auto &v : inValues) {
-					sum += two * v;
-					two += two;
-				}
-				wireValues[outWires[0]] = sum;
-			} else if (opcode == SPLIT_OPCODE) {
-				int size = outWires.size();
-				FElem<FieldT> inVal = inValues[0];
-				for (int i = 0; i < size; i++) {
-					wireValues[outWires[i]] = inVal.getBit(i, R1P);
-				}
-			} else if (opcode == MULCONST_OPCODE) {
-				wireValues[outWires[0]] = constant * inValues[0];
-			}
+	for ( wireID_t wireId : changedWires ){
+		if ( wireVariables[wireId] != NO_VARIABLE ) {
+			changedVariables[ wireVariables[wireId] ] = 0 ;
 		}
 	}
-	
 
+	profile.leave_block("Map changed values to variables" );
+
+	return ;
 }
 
 
 template<typename FieldT >
-void EmbeddedGeneratorCircuitReader<FieldT>::mapValuesToProtoboard() {
-
-	int zeropGateIndex = 0;
+void EmbeddedGeneratorCircuitReader<FieldT>::keepVariables( r1cs_optimizer<FieldT> & optimizer ) const {
 
-	for (auto variable_wireId : variable_wireIds_map) {
-		pb->val( *   variable_wireId.second ) = wireValues[variable_wireId.first];
+	for ( const zero_check_t & check : zeroChecks ){
+		optimizer.keep( check.auxVariable );
+	}
+	for ( const term_t & t : zeroConditions ){
+		optimizer.keep( t.index );
 	}
+}
 
 
-	for ( auto Iter  : zerop_variable_wireIds_map){
-		LinearCombination<FieldT> l = *zeroPwires[zeropGateIndex++];
-		if (pb->val(l) == 0) {
-			pb->val(* Iter.second ) = 0;
-		} else {
-			pb->val(* Iter.second ) = pb->val(l).inverse(pb->fieldType_);
+/**
+ * Moves the variables to the numbering of the optimized constraint system.
+ * The wires of removed variables are no longer mapped.
+ */
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::remapVariables( const std::vector<uint32_t> & variable_map ){
+
+	for ( uint32_t & variable : wireVariables ){
+		if ( variable != NO_VARIABLE ) {
+			variable = variable_map[variable] ;
 		}
 	}
 
-	#ifdef DEBUG
-	if (!pb->isSatisfied(PrintOptions::DBG_PRINT_IF_NOT_SATISFIED)) {
-		LOGD("Note: Protoboard Not Satisfied .. \n");
-		assert(false);
+	for ( zero_check_t & check : zeroChecks ){
+		check.auxVariable = variable_map[check.auxVariable] ;
+	}
+	for ( term_t & t : zeroConditions ){
+		t.index = variable_map[t.index] ;
 	}
-	#endif
+
+	firstVariable = variable_map[firstVariable] ;
+	changedVariables.clear() ;
 }
 
+
 template<typename FieldT >
-int EmbeddedGeneratorCircuitReader<FieldT>::find(WIRE wireId, LinearCombinationPtr& lc, bool intentionToEdit) {
+uint32_t EmbeddedGeneratorCircuitReader<FieldT>::newVariable( WIRE wireId ){
+
+	const uint32_t variable = static_cast<uint32_t>( context->getNextVariableIndex() );
+	wireVariables[wireId] = variable ;
+	return variable ;
+}
+
 
-	LinearCombinationPtr p = wireLinearCombinations[wireId];
-	if (p) {
-		wireUseCounters[wireId]--;
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::find(WIRE wireId, wire_lc_t & lc ) {
+
+	wireUseCounters[wireId]--;
+
+	if ( wireLinearCombinations[wireId].size ) {
+		lc = wireLinearCombinations[wireId] ;
 		if (wireUseCounters[wireId] == 0) {
 			toClean.push_back(wireId);
-			lc = p;
-		} else {
-			if (intentionToEdit) {
-				lc = make_shared<LinearCombination<FieldT>>(*p);
-			} else {
-				lc = p;
-			}
 		}
-		return 1;
 	} else {
-		wireUseCounters[wireId]--;
-		lc = make_shared<LinearCombination<FieldT>>(
-				LinearCombination<FieldT>(*variables[variableMap[wireId]]));
-		if (wireUseCounters[wireId] == 0) {
-			toClean.push_back(wireId);
+		// a wire never assigned falls back to the first variable , as the gadgetlib2 translation did
+		if ( wireVariables[wireId] == NO_VARIABLE ) {
+			wireVariables[wireId] = firstVariable ;
 		}
-		return 2;
+		lc = { 0 , 0 , wireVariables[wireId] } ;
 	}
 }
 
@@ -427,9 +394,136 @@ template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::clean() {
 
 	for (WIRE wireId : toClean) {
-		wireLinearCombinations[wireId].reset();
+		liveTerms -= wireLinearCombinations[wireId].size ;
+		wireLinearCombinations[wireId] = { 0 , 0 , NO_VARIABLE } ;
 	}
 	toClean.clear();
+
+	if ( arena.size() > 2 * liveTerms + 65536 ) {
+		compact();
+	}
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::compact() {
+
+	std::vector<term_t> live ;
+	live.reserve( liveTerms );
+
+	size_t ix = 0 ;
+	for ( WIRE wireId : arenaWires ){
+		wire_lc_t & lc = wireLinearCombinations[wireId] ;
+		if ( ! lc.size ) { continue ; }
+		live.insert( live.end() , arena.begin() + lc.offset , arena.begin() + lc.offset + lc.size );
+		lc.offset = live.size() - lc.size ;
+		arenaWires[ix++] = wireId ;
+	}
+	arenaWires.resize( ix );
+
+	arena.swap( live );
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::append( const wire_lc_t & lc , std::vector<term_t> & terms ) {
+
+	if ( lc.size ) {
+		terms.insert( terms.end() , arena.begin() + lc.offset , arena.begin() + lc.offset + lc.size );
+	} else {
+		terms.push_back( { lc.variable , FieldT::one() } );
+	}
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::append( const wire_lc_t & lc , std::vector<term_t> & terms , const FieldT & scale ) {
+
+	if ( lc.size ) {
+		for ( size_t i = lc.offset ; i < lc.offset + lc.size ; i++ ){
+			terms.push_back( { arena[i].index , arena[i].coeff * scale } );
+		}
+	} else {
+		terms.push_back( { lc.variable , scale } );
+	}
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::merge( std::vector<term_t> & terms ) {
+
+	// sort by variable and add up the terms of equal variables , zero coefficients are kept
+	std::sort( terms.begin() , terms.end() ,
+			   []( const term_t & a , const term_t & b ){ return a.index < b.index ; } );
+
+	size_t last = 0 ;
+	for ( size_t i = 1 ; i < terms.size() ; i++ ){
+		if ( terms[i].index == terms[last].index ){
+			terms[last].coeff += terms[i].coeff ;
+		} else {
+			terms[++last] = terms[i] ;
+		}
+	}
+
+	if ( terms.size() ) {
+		terms.resize( last + 1 );
+	}
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::setLinearCombination( WIRE wireId , std::vector<term_t> & terms ) {
+
+	merge( terms );
+
+	// a linear combination nobody reads is not kept
+	if ( wireUseCounters[wireId] ) {
+		wireLinearCombinations[wireId] = { arena.size() , static_cast<uint32_t>( terms.size() ) , NO_VARIABLE } ;
+		arena.insert( arena.end() , terms.begin() , terms.end() );
+		arenaWires.push_back( wireId );
+		liveTerms += terms.size() ;
+	}
+
+	terms.clear();
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::convert( std::vector<term_t> & terms , const FieldT & constant , linear_combination<FieldT> & result ) {
+
+	merge( terms );
+
+	// the constant term always leads , as variable 0 of the constraint system
+	result.terms.reserve( terms.size() + 1 );
+	result.terms.emplace_back( 0 , constant );
+	for ( const term_t & lt : terms ){
+		result.terms.emplace_back( lt.index + 1 , lt.coeff );
+	}
+
+	terms.clear();
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::addConstraint( const FieldT & constantA , const FieldT & constantB , const FieldT & constantC ) {
+
+	cs->constraints.emplace_back();
+	r1cs_constraint<FieldT> & constraint = cs->constraints.back() ;
+
+	convert( A , constantA , constraint.a );
+	convert( B , constantB , constraint.b );
+	convert( C , constantC , constraint.c );
+}
+
+
+template<typename FieldT >
+void EmbeddedGeneratorCircuitReader<FieldT>::checkCompliance( WIRE outputWireId , const char * operation ) {
+
+	if (wireVariables[outputWireId] != NO_VARIABLE) {
+		LOGD("An output of %s operation was either defined before, or is declared directly as circuit output. Non-compliant Circuit.\n" , operation );
+		LOGD("\t If the second, the wire has to be multiplied by a wire the has the value of 1 first (input #0 in circuits generated by jsnark) . \n");
+		exit(-1);
+	}
 }
 
 
@@ -442,22 +536,23 @@ void EmbeddedGeneratorCircuitReader<FieldT>::addMulConstraint(const Wires & inpu
 	inWireId2 = inputs[1]->getWireId();
 	outputWireId = outputs[0]->getWireId();
 
-	LinearCombinationPtr l1, l2;
+	wire_lc_t l1, l2;
 	find(inWireId1, l1);
 	find(inWireId2, l2);
 
-	if (variableMap.find(outputWireId) == variableMap.end()) {
-		variables.push_back(make_shared<Variable<FieldT>>(pb->g_cxt() , "mul out"));
-		variableMap[outputWireId] = currentVariableIdx;
-		pb->addRank1Constraint(*l1, *l2, *variables[currentVariableIdx], "Mul ..");
-		currentVariableIdx++;
-	} else {
-		pb->addRank1Constraint(*l1, *l2, *variables[variableMap[outputWireId]], "Mul ..");
+	uint32_t out = wireVariables[outputWireId] ;
+	if (out == NO_VARIABLE) {
+		out = newVariable(outputWireId);
 	}
+
+	append(l1, A);
+	append(l2, B);
+	C.push_back({ out , FieldT::one() });
+	addConstraint(FieldT::zero(), FieldT::zero(), FieldT::zero());
 }
 
 
-template<typename FieldT > 
+template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::addXorConstraint(const Wires & inputs, const Wires & outputs) {
 
 	WIRE outputWireId, inWireId1, inWireId2;
@@ -466,22 +561,22 @@ void EmbeddedGeneratorCircuitReader<FieldT>::addXorConstraint(const Wires & inpu
 	inWireId2 = inputs[1]->getWireId();
 	outputWireId = outputs[0]->getWireId();
 
-	LinearCombinationPtr lp1, lp2;
-	find(inWireId1, lp1);
-	find(inWireId2, lp2);
-	LinearCombination<FieldT> l1, l2;
-	l1 = *lp1;
-	l2 = *lp2;
-	if (variableMap.find(outputWireId) == variableMap.end()) {
-		variables.push_back(make_shared<Variable<FieldT>>(pb->g_cxt() , "xor out"));
-		variableMap[outputWireId] = currentVariableIdx;
-		pb->addRank1Constraint(2 * l1, l2,
-				l1 + l2 - *variables[currentVariableIdx], "XOR ..");
-		currentVariableIdx++;
-	} else {
-		pb->addRank1Constraint(2 * l1, l2,
-				l1 + l2 - *variables[variableMap[outputWireId]], "XOR ..");
+	wire_lc_t l1, l2;
+	find(inWireId1, l1);
+	find(inWireId2, l2);
+
+	uint32_t out = wireVariables[outputWireId] ;
+	if (out == NO_VARIABLE) {
+		out = newVariable(outputWireId);
 	}
+
+	// 2 * l1 * l2 = l1 + l2 - out
+	append(l1, A, FieldT(2));
+	append(l2, B);
+	append(l1, C);
+	append(l2, C);
+	C.push_back({ out , -FieldT::one() });
+	addConstraint(FieldT::zero(), FieldT::zero(), FieldT::zero());
 }
 
 
@@ -494,22 +589,22 @@ void EmbeddedGeneratorCircuitReader<FieldT>::addOrConstraint(const Wires & input
 	inWireId2 = inputs[1]->getWireId();
 	outputWireId = outputs[0]->getWireId();
 
-	LinearCombinationPtr lp1, lp2;
-	find(inWireId1, lp1);
-	find(inWireId2, lp2);
-	LinearCombination<FieldT> l1, l2;
-	l1 = *lp1;
-	l2 = *lp2;
-	if (variableMap.find(outputWireId) == variableMap.end()) {
-		variables.push_back(make_shared<Variable<FieldT>>(pb->g_cxt() , "or out"));
-		variableMap[outputWireId] = currentVariableIdx;
-		pb->addRank1Constraint(l1, l2, l1 + l2 - *variables[currentVariableIdx],
-				"OR ..");
-		currentVariableIdx++;
-	} else {
-		pb->addRank1Constraint(l1, l2,
-				l1 + l2 - *variables[variableMap[outputWireId]], "OR ..");
+	wire_lc_t l1, l2;
+	find(inWireId1, l1);
+	find(inWireId2, l2);
+
+	uint32_t out = wireVariables[outputWireId] ;
+	if (out == NO_VARIABLE) {
+		out = newVariable(outputWireId);
 	}
+
+	// l1 * l2 = l1 + l2 - out
+	append(l1, A);
+	append(l2, B);
+	append(l1, C);
+	append(l2, C);
+	C.push_back({ out , -FieldT::one() });
+	addConstraint(FieldT::zero(), FieldT::zero(), FieldT::zero());
 }
 
 
@@ -522,114 +617,110 @@ void EmbeddedGeneratorCircuitReader<FieldT>::addAssertionConstraint(const Wires
 	inWireId2 = inputs[1]->getWireId();
 	outputWireId = outputs[0]->getWireId();
 
-	LinearCombinationPtr lp1, lp2, lp3;
-	find(inWireId1, lp1);
-	find(inWireId2, lp2);
-	find(outputWireId, lp3);
-
-	LinearCombination<FieldT> l1, l2, l3;
-	l1 = *lp1;
-	l2 = *lp2;
-	l3 = *lp3;
-	pb->addRank1Constraint(l1, l2, l3, "Assertion ..");
+	wire_lc_t l1, l2, l3;
+	find(inWireId1, l1);
+	find(inWireId2, l2);
+	find(outputWireId, l3);
 
+	append(l1, A);
+	append(l2, B);
+	append(l3, C);
+	addConstraint(FieldT::zero(), FieldT::zero(), FieldT::zero());
 }
 
- 
+
 template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::addSplitConstraint(const Wires & inputs, const Wires & outputs, unsigned short n) {
 
 	WIRE inWireId;
 	inWireId = inputs[0]->getWireId();
-	
-	LinearCombinationPtr l;
-	find(inWireId, l);
 
-	LinearCombination<FieldT> sum;
-	FElem<FieldT> two_i = FieldT ("1");
+	wire_lc_t l;
+	find(inWireId, l);
 
+	// the sum is kept aside , A B C are taken by the booleanity constraints
+	std::vector<term_t> sum ;
+	sum.reserve(n);
+	FieldT two_i = FieldT::one();
 
 	for (int i = 0; i < n; i++) {
 		WIRE bitWireId;
 		bitWireId = outputs[i]->getWireId();
-		VariablePtr<FieldT> vptr;
-		if (variableMap.find(bitWireId) == variableMap.end()) {
-			variables.push_back(make_shared<Variable<FieldT>>(pb->g_cxt() , "bit out"));
-			variableMap[bitWireId] = currentVariableIdx;
-			vptr = variables[currentVariableIdx];
-			currentVariableIdx++;
-		} else {
-			vptr = variables[variableMap[bitWireId]];
+		uint32_t bit = wireVariables[bitWireId] ;
+		if (bit == NO_VARIABLE) {
+			bit = newVariable(bitWireId);
 		}
-		pb->enforceBooleanity(*vptr);
-		sum += LinearTerm<FieldT>(*vptr, two_i);
+
+		// bit * ( bit - 1 ) = 0
+		A.push_back({ bit , FieldT::one() });
+		B.push_back({ bit , FieldT::one() });
+		addConstraint(FieldT::zero(), -FieldT::one(), FieldT::zero());
+
+		sum.push_back({ bit , two_i });
 		two_i += two_i;
 	}
 
-
-	pb->addRank1Constraint(*l, 1, sum, "Split Constraint");
+	append(l, A);
+	C.swap(sum);
+	addConstraint(FieldT::zero(), FieldT::one(), FieldT::zero());
 }
 
- 
+
 template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::addNonzeroCheckConstraint(const Wires & inputs, const Wires & outputs) {
 
-	Variable<FieldT> auxConditionInverse_(pb->g_cxt());
+	// the gadgetlib2 translation spent one variable index on a local auxiliary , keep the numbering
+	context->getNextVariableIndex();
+
 	WIRE outputWireId, inWireId;
 
 	inWireId = inputs[0]->getWireId();
 	outputWireId = outputs[1]->getWireId();
-	LinearCombinationPtr l;
 
+	wire_lc_t l;
 	find(inWireId, l);
-	VariablePtr<FieldT> vptr;
-	if (variableMap.find(outputWireId) == variableMap.end()) {
-		variables.push_back(make_shared<Variable<FieldT>
-		>(pb->g_cxt() , "zerop out"));
-		variableMap[outputWireId] = currentVariableIdx;
-		vptr = variables[currentVariableIdx];
-		currentVariableIdx++;
-	} else {
-		vptr = variables[variableMap[outputWireId]];
-	}
-	variables.push_back(make_shared<Variable<FieldT>>(pb->g_cxt() , "zerop aux"));
-	pb->addRank1Constraint(*l, 1 - *vptr, 0, "condition * not(output) = 0");
-	pb->addRank1Constraint(*l, *variables[currentVariableIdx], *vptr,
-			"condition * auxConditionInverse = output");
-
-	zeroPwires.push_back(l);
-	zeropMap[outputWireId] = currentVariableIdx;
-	currentVariableIdx++;
 
+	uint32_t out = wireVariables[outputWireId] ;
+	if (out == NO_VARIABLE) {
+		out = newVariable(outputWireId);
+	}
+	const uint32_t aux = static_cast<uint32_t>( context->getNextVariableIndex() );
+
+	// condition * not(output) = 0
+	append(l, A);
+	B.push_back({ out , -FieldT::one() });
+	addConstraint(FieldT::zero(), FieldT::one(), FieldT::zero());
+
+	// condition * auxConditionInverse = output
+	append(l, A);
+	B.push_back({ aux , FieldT::one() });
+	C.push_back({ out , FieldT::one() });
+	addConstraint(FieldT::zero(), FieldT::zero(), FieldT::zero());
+
+	const size_t offset = zeroConditions.size() ;
+	append(l, zeroConditions);
+	zeroChecks.push_back({ outputWireId , aux , offset , static_cast<uint32_t>( zeroConditions.size() - offset ) });
 }
 
- 
+
 template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::handlePackOperation(const Wires & inputs, const Wires & outputs, unsigned short n){
 
 	WIRE outputWireId;
 	outputWireId = outputs[0]->getWireId();
 
-	if (variableMap.find(outputWireId) != variableMap.end()) {
-		LOGD("An output of a pack operation was either defined before, or is declared directly as circuit output. Non-compliant Circuit.\n");
-                LOGD("\t If the second, the wire has to be multiplied by a wire the has the value of 1 first (input #0 in circuits generated by jsnark) . \n");
-		exit(-1);
-	}
-
+	checkCompliance(outputWireId, "a pack");
 
-	LinearCombinationPtr sum;
-	WIRE bitWireId;
-	bitWireId = inputs[0]->getWireId();
-	find(bitWireId, sum, true);
-	FElem<FieldT> two_i = FieldT ("1");
-	for (int i = 1; i < n; i++) {
+	FieldT two_i = FieldT::one();
+	for (int i = 0; i < n; i++) {
+		WIRE bitWireId;
 		bitWireId = inputs[i]->getWireId();
-		LinearCombinationPtr l;
+		wire_lc_t l;
 		find(bitWireId, l);
+		append(l, A, two_i);
 		two_i += two_i;
-		*sum += two_i * (*l);
 	}
-	wireLinearCombinations[outputWireId] = sum;
+	setLinearCombination(outputWireId, A);
 }
 
 
@@ -639,25 +730,18 @@ void EmbeddedGeneratorCircuitReader<FieldT>::handleAddition( const Wires & input
 	WIRE inWireId, outputWireId;
 	outputWireId = outputs[0]->getWireId();
 
-	if (variableMap.find(outputWireId) != variableMap.end()) {
-		LOGD("An output of an add operation was either defined before, or is declared directly as circuit output. Non-compliant Circuit.\n");
-                LOGD("\t If the second, the wire has to be multiplied by a wire the has the value of 1 first (input #0 in circuits generated by jsnark) . \n");
-		exit(-1);
-	}
+	checkCompliance(outputWireId, "an add");
 
-	LinearCombinationPtr s, l;
-	inWireId = inputs[0]->getWireId();
-	find(inWireId, l, true);
-	s = l;
-	for ( size_t i = 1 ; i < inputs.size() ; i++ ){
+	for ( size_t i = 0 ; i < inputs.size() ; i++ ){
 		inWireId = inputs[i]->getWireId();
+		wire_lc_t l;
 		find(inWireId, l);
-		*s += *l;
+		append(l, A);
 	}
-	wireLinearCombinations[outputWireId] = s;
+	setLinearCombination(outputWireId, A);
 }
 
- 
+
 template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::handleMulConst( const BigInteger & constant , const Wires & inputs, const Wires & outputs) {
 
@@ -665,39 +749,27 @@ void EmbeddedGeneratorCircuitReader<FieldT>::handleMulConst( const BigInteger &
 
 	outputWireId = outputs[0]->getWireId();
 
-	if (variableMap.find(outputWireId) != variableMap.end()) {
-		LOGD("An output of a const-mul operation was either defined before, or is declared directly as a circuit output. Non-compliant Circuit.\n");
-                LOGD("\t If the second, the wire has to be multiplied by a wire the has the value of 1 first (input #0 in circuits generated by jsnark) . \n");
-		exit(-1);
-	}
+	checkCompliance(outputWireId, "a const-mul");
 
 	inWireId = inputs[0]->getWireId();
-	LinearCombinationPtr l;
-	find(inWireId, l, true);
-	wireLinearCombinations[outputWireId] = l;
-	*(wireLinearCombinations[outputWireId]) *= convert2FieldT<FieldT>(constant) ;
+	wire_lc_t l;
+	find(inWireId, l);
+	append(l, A, convert2FieldT<FieldT>(constant));
+	setLinearCombination(outputWireId, A);
 }
 
- 
+
 template<typename FieldT >
 void EmbeddedGeneratorCircuitReader<FieldT>::handleMulNegConst(const BigInteger & constant , const Wires & inputs, const Wires & outputs ) {
 
 	WIRE outputWireId, inWireId;
 	outputWireId = outputs[0]->getWireId();
 
-	if (variableMap.find(outputWireId) != variableMap.end()) {
-		LOGD("An output of a const-mul-neg operation was either defined before, or is declared directly as circuit output. Non-compliant Circuit.\n");
-                LOGD("\t If the second, the wire has to be multiplied by a wire the has the value of 1 first (input #0 in circuits generated by jsnark) . \n");
-		exit(-1);
-	}
+	checkCompliance(outputWireId, "a const-mul-neg");
 
 	inWireId = inputs[0]->getWireId();
-
-	LinearCombinationPtr l;
-	find(inWireId, l, true);
-
-	wireLinearCombinations[outputWireId] = l;
-	*(wireLinearCombinations[outputWireId]) *= convert2FieldT<FieldT>(constant) ;
-	*(wireLinearCombinations[outputWireId]) *= FieldT(-1); //TODO: make shared FieldT constants
-
+	wire_lc_t l;
+	find(inWireId, l);
+	append(l, A, -convert2FieldT<FieldT>(constant));
+	setLinearCombination(outputWireId, A);
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <global.hpp>
+#include <BigInteger.hpp>
+
+#include <logging.hpp>
+
+
+using namespace std;
+
+
+/**
+ * The primary inputs of an EvaluationProgram restored from a snapshot : the input labels of the
+ * circuit generator , the wires they set , and their current values. With no generator to hold
+ * them , the context updates them here , with the same functions and return codes.
+ */
+class EvaluationInputs {
+
+public:
+
+	std::map<string , std::pair<wireID_t , BigInteger>> primary_inputs ;
+	std::map<string , std::pair<std::vector<wireID_t> , std::vector<BigInteger>>> primary_array_inputs ;
+
+	int update_primary_input( const char* input_name , const BigInteger & value ){
+
+		auto it = primary_inputs.find( string(input_name) );
+		if( it == primary_inputs.end() ){
+			LOGD( "** Error : Unknown primary input name [%s] **\n" , input_name );
+			return 1 ;
+		}
+
+		it->second.second = value ;
+		return 0 ;
+	}
+
+	int update_primary_input( const char* input_name , int value ){
+		return update_primary_input( input_name , BigInteger((long)value) ) ;
+	}
+
+	int update_primary_input( const char* input_name , const char* value_str ){
+		return update_primary_input( input_name , BigInteger( value_str , 16 ) ) ;
+	}
+
+	int update_primary_input_array( const char* input_name , size_t array_index , const BigInteger & value ){
+
+		auto it = primary_array_inputs.find( string(input_name) );
+		if( it == primary_array_inputs.end() ){
+			LOGD( "** Error : Unknown primary input name [%s] ** \n" , input_name );
+			return 1 ;
+		}
+
+		if( array_index >= it->second.second.size() ){
+			LOGD( "** Error : Index [%lu] out of range for primary input array [%s] ** \n" , array_index , input_name );
+			return 2 ;
+		}
+
+		it->second.second[array_index] = value ;
+		return 0 ;
+	}
+
+	int update_primary_input_array( const char* input_name , int array_index , int value ){
+		return update_primary_input_array( input_name , (size_t)array_index , BigInteger((long)value) ) ;
+	}
+
+	int update_primary_input_array( const char* input_name , int array_index , const char* value_str ){
+		return update_primary_input_array( input_name , (size_t)array_index , BigInteger( value_str , 16 ) ) ;
+	}
+
+	int reset_primary_input_array( const char* input_name , const BigInteger & value ){
+
+		auto it = primary_array_inputs.find( string(input_name) );
+		if( it == primary_array_inputs.end() ){
+			LOGD( "** Error : Unknown primary input name [%s] ** \n" , input_name );
+			return 1 ;
+		}
+
+		for ( BigInteger & v : it->second.second ){ v = value ; }
+		return 0 ;
+	}
+
+	int reset_primary_input_array( const char* input_name , int value ){
+		return reset_primary_input_array( input_name , BigInteger((long)value) ) ;
+	}
+
+	int reset_primary_input_array( const char* input_name , const char* value_str ){
+		return reset_primary_input_array( input_name , BigInteger( value_str , 16 ) ) ;
+	}
+
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+
+#include <libff/common/profiling.hpp>
+
+#include <OpCode.hpp>
+#include <CircuitGenerator.hpp>
+#include <NativeWitnessInstruction.hpp>
+
+#include <libsnark/jsnark_interface/EvaluationInputs.hpp>
+
+
+using namespace std;
+
+
+/**
+ * The evaluation queue of an embedded circuit generator, lowered once into a flat program.
+ *
+ * Each instruction is an opcode plus a run of operand indices (wire ids, constant ids);
+ * the interpreter evaluates it straight over FieldT, in place, so a witness costs one pass
+ * and no per-gate allocation. Instructions without a field semantic (the square operations,
+ * verbose labels, a prover hint with no native routine) run through the CircuitEvaluator
+ * as before, which reads the program values it needs on demand.
+ *
+ * Once a witness has been evaluated, the next evaluation compares the new input values with
+ * the previous ones and re-runs only the instructions that read a changed wire ( the dependency
+ * cone of the changed inputs ). changedWires() then lists what moved, for the caller to patch
+ * its own assignment ; after a full evaluation, isIncremental() is false and everything did.
+ *
+ * A gadget that registers a native witness routine ( MiMC7 , Poseidon ) is compiled into a single
+ * instruction that fills all of its wires in one call ; its BasicOps are then left out, except
+ * the assertions. SHA256 has no such routine : its witness is bit level ( splits , xors and packs
+ * over wires shared through the operation cache ), so its BasicOps are still compiled one by one.
+ * A batch of such routines ( a Merkle tree level ) is one instruction as well ,
+ * and so are the prover hints of the gadget library ( field division , mod constant , the y
+ * coordinate of a curve point ).
+ *
+ * With MULTICORE, a large program is also grouped into dependency levels, and the full
+ * evaluation runs level by level with the wide levels spread over the threads.
+ *
+ * A program with no CircuitEvaluator instruction left ( the verbose labels aside ) can be saved to
+ * a snapshot , and loaded back without the circuit generator : the inputs are then assigned from the
+ * labels of the snapshot , through inputs(). See save() for the layout.
+ */
+template<typename FieldT >
+class EvaluationProgram  {
+
+public:
+
+	EvaluationProgram( CircuitGenerator * generator , libff::profiling & profile );
+
+	~EvaluationProgram();
+
+	// NULL when the snapshot does not hold a program for this tag , or is not valid
+	static EvaluationProgram * load( std::istream & in , const std::string & tag , libff::profiling & profile );
+
+	// false when the program still runs instructions through the CircuitEvaluator
+	bool save( std::ostream & out , const std::string & tag ) const ;
+
+	void evaluate( libff::profiling & profile );
+
+	// the inputs of a program loaded from a snapshot , NULL for a program of a circuit generator
+	EvaluationInputs * inputs() { return snapshotInputs ; }
+
+	// for a program loaded from a snapshot , the generator's flag otherwise
+	void setIgnoreFailedAssertion( bool ignore ){ ignoreFailedAssertion = ignore ; }
+
+	const std::vector<FieldT> & values() const { return wireValues ; }
+
+	const FieldT & value( wireID_t wireId ) const { return wireValues[wireId] ; }
+
+	size_t size() const { return opcodes.size() ; }
+
+	// the dependency levels of a full evaluation , 0 when it runs in program order
+	size_t numLevels() const { return levelOffsets.empty() ? 0 : levelOffsets.size() - 1 ; }
+
+	bool isIncremental() const { return incremental ; }
+
+	const std::vector<wireID_t> & changedWires() const { return changed ; }
+
+private:
+
+	enum { FALLBACK_OPCODE = 0 , NATIVE_OPCODE = 0xFF };
+
+	// an output of a native routine that the gadget did not create ( a cached wire )
+	enum : uint32_t { NO_WIRE = 0xFFFFFFFF };
+
+	// below these sizes, the threads cost more than they save
+	enum { PARALLEL_PROGRAM_SIZE = 1 << 15 , PARALLEL_LEVEL_SIZE = 1 << 10 , PARALLEL_BATCH_SIZE = 64 };
+
+	CircuitGenerator * generator ;
+	std::string name ;
+
+	// the wires a program loaded from a snapshot assigns before running ( the constant wires )
+	EvaluationInputs * snapshotInputs ;
+	std::vector<wireID_t> presetWires ;
+	std::vector<FieldT> presetValues ;
+	bool ignoreFailedAssertion ;
+
+	std::vector<uint8_t> opcodes ;
+	std::vector<uint32_t> operands ;
+	std::vector<FieldT> constants ;
+	std::vector<Instruction*> fallbacks ;
+	std::vector<uint32_t> instructionOffsets ;
+
+	// wires written by the interpreter, handed to the evaluator as external values
+	std::vector<wireID_t> computedWires ;
+
+	std::vector<wireID_t> assignments ;
+	std::vector<FieldT> wireValues ;
+
+	// incremental re-evaluation : the instructions reading each wire , and the pending instructions ( one bit each )
+	bool evaluated ;
+	bool incremental ;
+	size_t failedAssertions ;
+	std::vector<uint32_t> readerOffsets ;
+	std::vector<uint32_t> readers ;
+	std::vector<uint64_t> pending ;
+	std::vector<uint8_t> dirty ;
+	std::vector<wireID_t> changed ;
+
+	// the instructions sorted by dependency level
+	std::vector<uint32_t> levelOffsets ;
+	std::vector<uint32_t> schedule ;
+
+	EvaluationProgram();
+
+	void emit( uint8_t opcode );
+	void compile( Instruction * e , const std::vector<uint8_t> & covered );
+	void compileNative( NativeWitnessInstruction * native , std::map<const void*, uint32_t> & nativeConstants );
+	void importAssignments( CircuitEvaluator * evaluator );
+	void assignSnapshotInputs();
+	void assignValue( wireID_t wireId , const FieldT & v );
+	bool isValid() const ;
+	bool isValidNative( uint32_t type , const uint32_t * params , uint32_t num_params , const uint32_t * out , uint32_t num_outputs ,
+						uint32_t num_inputs , uint64_t num_constants ) const ;
+	void buildReaders( libff::profiling & profile );
+	template<typename F > void forEachRead( size_t pc , F f ) const ;
+	const uint32_t * outputsOf( uint8_t opcode , const uint32_t * operand , uint32_t & count ) const ;
+	void buildLevels( libff::profiling & profile );
+	void markChanged( wireID_t wireId );
+	void run( CircuitEvaluator * evaluator );
+	void runLevels( CircuitEvaluator * evaluator );
+	void runIncremental( CircuitEvaluator * evaluator );
+	size_t step( uint8_t opcode , const uint32_t * operand , CircuitEvaluator * evaluator );
+	void native( uint32_t type , const uint32_t * params , const FieldT * constant , const uint32_t * in , const uint32_t * out );
+	void nativeBatch( const uint32_t * params , const FieldT * constant , const uint32_t * in , uint32_t num_inputs , const uint32_t * out , uint32_t num_outputs );
+	void nativeMiMC7( const uint32_t * params , const FieldT * roundConstants , const uint32_t * in , const uint32_t * out );
+	void nativePoseidon( const uint32_t * params , const FieldT * constant , const uint32_t * in , const uint32_t * out );
+	void nativeFieldDivision( const uint32_t * in , const uint32_t * out );
+	void nativeModConstant( const uint32_t * params , const uint32_t * in , const uint32_t * out );
+	void nativeECYCoordinate( const uint32_t * params , const uint32_t * in , const uint32_t * out );
+
+};
@@ -0,0 +1,1496 @@
+
+#include <cstring>
+
+#include <Instruction.hpp>
+#include <WireLabelInstruction.hpp>
+#include <Wire.hpp>
+#include <ConstantWire.hpp>
+#include <CircuitEvaluator.hpp>
+#include <BasicOp.hpp>
+#include <ConstMulBasicOp.hpp>
+#include <NativeWitnessInstruction.hpp>
+
+#include <integer_functions.hpp>
+#include <logging.hpp>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+
+// step() also runs on the threads of runLevels : its messages are written one at a time
+#ifdef MULTICORE
+#define STEP_LOGD(...) { _Pragma("omp critical (evaluation_program_log)") LOGD(__VA_ARGS__) }
+#else
+#define STEP_LOGD(...) LOGD(__VA_ARGS__)
+#endif
+
+
+namespace evaluation_program {
+
+	template<typename FieldT >
+	BigInteger to_BigInteger( const FieldT & x ){
+		mpz_t value ;
+		mpz_init( value );
+		x.as_bigint().to_mpz( value );
+		BigInteger v( value );
+		mpz_clear( value );
+		return v ;
+	}
+
+	template<typename FieldT >
+	BigInteger modulus(){
+		mpz_t value ;
+		mpz_init( value );
+		FieldT::mod.to_mpz( value );
+		BigInteger v( value );
+		mpz_clear( value );
+		return v ;
+	}
+
+	// a params run of NativeWitnessInstruction::words
+	inline BigInteger from_words( const uint32_t * words ){
+		mpz_t value ;
+		mpz_init( value );
+		mpz_import( value , words[0] , -1 , sizeof(uint32_t) , 0 , 0 , words + 1 );
+		BigInteger v( value );
+		mpz_clear( value );
+		return v ;
+	}
+
+
+	// snapshot files
+
+	static const char snapshot_magic[] = "EvaluationProgram" ;
+	static const uint32_t snapshot_version = 1 ;
+
+	template<typename T >
+	void write( std::ostream & out , const T & v ){
+		out.write( (const char*) &v , sizeof(T) );
+	}
+
+	template<typename T >
+	void write_vector( std::ostream & out , const std::vector<T> & v ){
+		write<uint64_t>( out , v.size() );
+		out.write( (const char*) v.data() , sizeof(T) * v.size() );
+	}
+
+	inline void write_string( std::ostream & out , const std::string & s ){
+		write<uint64_t>( out , s.size() );
+		out.write( s.data() , s.size() );
+	}
+
+	template<typename FieldT >
+	void write_field_elements( std::ostream & out , const std::vector<FieldT> & v ){
+		write<uint64_t>( out , v.size() );
+		for ( const FieldT & x : v ){
+			out.write( (const char*) x.mont_repr.data , sizeof( x.mont_repr.data[0] ) * FieldT::num_limbs );
+		}
+	}
+
+	// the bytes left in the stream , so that a corrupted size does not allocate
+	inline uint64_t bytes_left( std::istream & in ){
+		const std::streampos pos = in.tellg() ;
+		in.seekg( 0 , in.end );
+		const std::streampos end = in.tellg() ;
+		in.seekg( pos );
+		return ( pos < 0 || end < pos ) ? 0 : static_cast<uint64_t>( end - pos ) ;
+	}
+
+	template<typename T >
+	bool read( std::istream & in , T & v ){
+		in.read( (char*) &v , sizeof(T) );
+		return in.good() ;
+	}
+
+	template<typename T >
+	bool read_vector( std::istream & in , std::vector<T> & v ){
+		uint64_t size ;
+		if ( ! read( in , size ) || size > bytes_left( in ) / sizeof(T) ){ return false ; }
+		v.resize( size );
+		in.read( (char*) v.data() , sizeof(T) * size );
+		return in.good() ;
+	}
+
+	inline bool read_string( std::istream & in , std::string & s ){
+		uint64_t size ;
+		if ( ! read( in , size ) || size > bytes_left( in ) ){ return false ; }
+		s.resize( size );
+		in.read( &s[0] , size );
+		return in.good() ;
+	}
+
+	template<typename FieldT >
+	bool read_field_elements( std::istream & in , std::vector<FieldT> & v ){
+		const size_t element_size = sizeof( v[0].mont_repr.data[0] ) * FieldT::num_limbs ;
+		uint64_t size ;
+		if ( ! read( in , size ) || size > bytes_left( in ) / element_size ){ return false ; }
+		v.resize( size );
+		for ( FieldT & x : v ){ in.read( (char*) x.mont_repr.data , element_size ); }
+		return in.good() ;
+	}
+
+}
+
+
+
+template<typename FieldT >
+EvaluationProgram<FieldT>::EvaluationProgram( CircuitGenerator * generator , libff::profiling & profile )
+{
+	this->generator = generator ;
+	name = generator->getName() ;
+	snapshotInputs = NULL ;
+	ignoreFailedAssertion = false ;
+
+	profile.enter_block("Compile Evaluation Program" );
+
+	EvaluationQueue& evalSequence = generator->getEvaluationQueue();
+
+	// the native routines, in the order of their first instruction, and the wires they fill
+	std::vector<NativeWitnessInstruction*> natives ;
+	std::vector<uint8_t> covered( generator->getNumWires() , 0 );
+
+	for ( auto e : evalSequence ){
+		if ( e->instanceof_NativeWitnessInstruction() ){
+			NativeWitnessInstruction * native = (NativeWitnessInstruction*) e ;
+			if ( native->isBatched() ){ continue ; }
+			natives.push_back( native );
+			for ( WirePtr w : native->getOutputs() ){
+				if ( w != NULL ){ covered[w->getWireId()] = 1 ; }
+			}
+		}
+	}
+
+	std::stable_sort( natives.begin() , natives.end() ,
+		[]( NativeWitnessInstruction * a , NativeWitnessInstruction * b ){ return a->getQueuePosition() < b->getQueuePosition() ; } );
+
+	std::map<const void*, uint32_t> nativeConstants ;
+	size_t position = 0 ;
+	size_t next = 0 ;
+
+	for ( auto e : evalSequence ){
+		while ( next < natives.size() && natives[next]->getQueuePosition() <= position ){
+			compileNative( natives[next++] , nativeConstants );
+		}
+		compile( e , covered );
+		position++ ;
+	}
+
+	while ( next < natives.size() ){
+		compileNative( natives[next++] , nativeConstants );
+	}
+
+	evaluated = false ;
+	incremental = false ;
+	failedAssertions = 0 ;
+
+	wireValues.resize( generator->getNumWires() );
+
+#ifdef MULTICORE
+	if ( opcodes.size() >= PARALLEL_PROGRAM_SIZE ){
+		buildLevels( profile );
+	}
+#endif
+
+	LOGD("Evaluation Program : %zu instructions , %zu operands , %zu constants , %zu fallbacks \n",
+		 opcodes.size() , operands.size() , constants.size() , fallbacks.size() );
+
+	profile.leave_block("Compile Evaluation Program" );
+}
+
+
+template<typename FieldT >
+EvaluationProgram<FieldT>::EvaluationProgram()
+	: generator( NULL ) , snapshotInputs( NULL ) , ignoreFailedAssertion( false ) ,
+	  evaluated( false ) , incremental( false ) , failedAssertions( 0 )
+{}
+
+
+template<typename FieldT >
+EvaluationProgram<FieldT>::~EvaluationProgram(){
+	generator = NULL ;
+	if ( snapshotInputs ){ delete snapshotInputs ; }
+	snapshotInputs = NULL ;
+	presetWires.clear() ;
+	presetValues.clear() ;
+	opcodes.clear() ;
+	operands.clear() ;
+	constants.clear() ;
+	fallbacks.clear() ;
+	instructionOffsets.clear() ;
+	levelOffsets.clear() ;
+	schedule.clear() ;
+	readerOffsets.clear() ;
+	readers.clear() ;
+	pending.clear() ;
+	dirty.clear() ;
+	changed.clear() ;
+	computedWires.clear() ;
+	assignments.clear() ;
+	wireValues.clear() ;
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::emit( uint8_t opcode ){
+	instructionOffsets.push_back( operands.size() );
+	opcodes.push_back( opcode );
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::compile( Instruction * e , const std::vector<uint8_t> & covered ){
+
+	if ( e->instanceof_NativeWitnessInstruction() ){
+		// compiled at the position of the gadget's first instruction
+		return ;
+	}
+
+	if ( e->instanceof_WireLabelInstruction() ){
+
+		// labels only print, and only when the config asks for it
+		WireLabelInstruction* wl = (WireLabelInstruction*) e ;
+
+		if ( ! ((wl->getType() == LabelType::output && generator->config.outputVerbose) ||
+				(wl->getType() == LabelType::debug && generator->config.debugVerbose)) )
+		{
+			return ;
+		}
+	}
+
+	if ( e->instanceof_BasicOp() ){
+
+		BasicOp* Op = (BasicOp*)e ;
+		const uint8_t opcode = (uint8_t)Op->op_code() ;
+		const Wires & inputs = Op->getInputs() ;
+		const Wires & outputs = Op->getOutputs() ;
+
+		// a native routine already fills the outputs ; the assertions still run
+		if ( opcode != CONSTRAINT_OPCODE ){
+			bool skip = outputs.size() > 0 ;
+			for ( WirePtr w : outputs ){ skip = skip && covered[w->getWireId()] ; }
+			if ( skip ){ return ; }
+		}
+
+		switch( opcode ){
+
+			case ADD_OPCODE :
+			case PACK_OPCODE :
+				emit( opcode );
+				operands.push_back( inputs.size() );
+				operands.push_back( outputs[0]->getWireId() );
+				for ( WirePtr w : inputs ){ operands.push_back( w->getWireId() ); }
+				computedWires.push_back( outputs[0]->getWireId() );
+				return ;
+
+			case MUL_OPCODE :
+			case XOR_OPCODE :
+			case OR_OPCODE :
+			case CONSTRAINT_OPCODE :
+				emit( opcode );
+				operands.push_back( inputs[0]->getWireId() );
+				operands.push_back( inputs[1]->getWireId() );
+				operands.push_back( outputs[0]->getWireId() );
+				if ( opcode != CONSTRAINT_OPCODE ){ computedWires.push_back( outputs[0]->getWireId() ); }
+				return ;
+
+			case NONZEROCHECK_OPCODE :
+				emit( opcode );
+				operands.push_back( inputs[0]->getWireId() );
+				operands.push_back( outputs[0]->getWireId() );
+				operands.push_back( outputs[1]->getWireId() );
+				computedWires.push_back( outputs[0]->getWireId() );
+				computedWires.push_back( outputs[1]->getWireId() );
+				return ;
+
+			case SPLIT_OPCODE :
+				emit( opcode );
+				operands.push_back( outputs.size() );
+				operands.push_back( inputs[0]->getWireId() );
+				for ( WirePtr w : outputs ){
+					operands.push_back( w->getWireId() );
+					computedWires.push_back( w->getWireId() );
+				}
+				return ;
+
+			case MULCONST_OPCODE : {
+				ConstMulBasicOp* const_mul = (ConstMulBasicOp*)Op ;
+				FieldT constant = convert2FieldT<FieldT>( const_mul->getOpCodeConstInteger() ) ;
+				if ( const_mul->get_inSign() ) { constant = -constant ; }
+				emit( opcode );
+				operands.push_back( constants.size() );
+				operands.push_back( inputs[0]->getWireId() );
+				operands.push_back( outputs[0]->getWireId() );
+				constants.push_back( constant );
+				computedWires.push_back( outputs[0]->getWireId() );
+				return ;
+			}
+
+			default :
+				break ;
+		}
+	}
+
+	// prover hints and the (constant) square operations keep their BigInteger code
+	emit( FALLBACK_OPCODE );
+	operands.push_back( fallbacks.size() );
+	fallbacks.push_back( e );
+}
+
+
+/**
+ * operands : type , #params , #outputs , #inputs , constant offset , params... , outputs... , inputs...
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::compileNative( NativeWitnessInstruction * native , std::map<const void*, uint32_t> & nativeConstants ){
+
+	const vector<BigInteger> & gadgetConstants = native->getConstants() ;
+
+	// the constants are shared by every instance of the gadget, convert them once
+	auto it = nativeConstants.find( &gadgetConstants );
+	if ( it == nativeConstants.end() ){
+		it = nativeConstants.insert( std::make_pair( &gadgetConstants , (uint32_t) constants.size() ) ).first ;
+		for ( const BigInteger & c : gadgetConstants ){ constants.push_back( convert2FieldT<FieldT>( c ) ); }
+	}
+
+	const vector<uint32_t> & params = native->getParams() ;
+	const vector<WirePtr> & outputs = native->getOutputs() ;
+	const Wires & inputs = native->getInputs() ;
+
+	emit( NATIVE_OPCODE );
+	operands.push_back( native->getType() );
+	operands.push_back( params.size() );
+	operands.push_back( outputs.size() );
+	operands.push_back( inputs.size() );
+	operands.push_back( it->second );
+	for ( uint32_t p : params ){ operands.push_back( p ); }
+	for ( WirePtr w : outputs ){
+		if ( w == NULL ){
+			operands.push_back( NO_WIRE );
+		}else{
+			operands.push_back( w->getWireId() );
+			computedWires.push_back( w->getWireId() );
+		}
+	}
+	for ( WirePtr w : inputs ){ operands.push_back( w->getWireId() ); }
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::evaluate( libff::profiling & profile ){
+
+	LOGD("Running Evaluation Program for < %s > \n" , name.c_str() );
+
+	// a previous evaluation that ran to the end, and met no ignored assertion, can be updated in place
+	incremental = evaluated && failedAssertions == 0 ;
+	evaluated = false ;
+	failedAssertions = 0 ;
+
+	for ( wireID_t wireId : changed ){ dirty[wireId] = 0 ; }
+	changed.clear();
+
+	if ( incremental && readerOffsets.empty() ){
+		buildReaders( profile );
+	}
+
+	// a program loaded from a snapshot has no instruction left for the evaluator
+	CircuitEvaluator * evaluator = NULL ;
+
+	profile.enter_block("Assign Inputs" );
+	if ( generator ){
+		ignoreFailedAssertion = generator->ignore_failed_assertion ;
+		assignments.clear();
+		evaluator = generator->prepareCircuitEvaluator( & assignments );
+		importAssignments( evaluator );
+	}else{
+		assignSnapshotInputs();
+	}
+	profile.leave_block("Assign Inputs" );
+
+	if ( evaluator ){
+		evaluator->bindExternalValues(
+			[this]( wireID_t wireId , BigInteger & v ){
+				mpz_t value ;
+				mpz_init( value );
+				wireValues[wireId].as_bigint().to_mpz( value );
+				v.assign( value );
+				mpz_clear( value );
+			} ,
+			computedWires );
+	}
+
+	profile.enter_block("Run Evaluation Program" );
+	if ( incremental ){
+		runIncremental( evaluator );
+		LOGD("Evaluation Program : %zu changed wires \n" , changed.size() );
+	}else{
+		run( evaluator );
+	}
+	profile.leave_block("Run Evaluation Program" );
+
+	if ( evaluator ){
+		evaluator->recordAssignments( NULL );
+		evaluator->checkAssignments();
+	}
+
+	if (wireValues[0] != FieldT::one()) {
+		LOGD(">> Warning: when using jsnark circuit generator, the first input wire (#0) must have the value of 1.\n");
+	}
+
+	evaluated = true ;
+
+	return ;
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::importAssignments( CircuitEvaluator * evaluator ){
+
+	for ( wireID_t wireId : assignments ){
+		assignValue( wireId , convert2FieldT<FieldT>( evaluator->getAssignment( wireId ) ) );
+	}
+	assignments.clear();
+}
+
+
+/**
+ * The constant wires and the primary inputs, as the circuit generator's prepareCircuitEvaluator() assigns them.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::assignSnapshotInputs(){
+
+	for ( size_t i = 0 ; i < presetWires.size() ; i++ ){
+		assignValue( presetWires[i] , presetValues[i] );
+	}
+
+	for ( auto & Itr : snapshotInputs->primary_inputs ){
+		const BigInteger & val = Itr.second.second ;
+		if ( val.signum() < 0 ){
+			throw invalid_argument("Only positive values that are less than the modulus are allowed for this method.");
+		}
+		assignValue( Itr.second.first , convert2FieldT<FieldT>( val ) );
+	}
+
+	for ( auto & Itr : snapshotInputs->primary_array_inputs ){
+		const std::vector<wireID_t> & ws = Itr.second.first ;
+		const std::vector<BigInteger> & values = Itr.second.second ;
+		for ( size_t ix = 0 ; ix < values.size() ; ix++ ){
+			if ( values[ix].signum() < 0 ){
+				throw invalid_argument("Only positive values that are less than the modulus are allowed for this method.");
+			}
+			assignValue( ws[ix] , convert2FieldT<FieldT>( values[ix] ) );
+		}
+	}
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::assignValue( wireID_t wireId , const FieldT & v ){
+
+	if ( ! incremental ){
+		wireValues[wireId] = v ;
+	}else if ( v != wireValues[wireId] ){
+		wireValues[wireId] = v ;
+		markChanged( wireId );
+	}
+}
+
+
+/**
+ * Indexes, for every wire, the instructions that read it ( the wire's direct dependents ).
+ * Built once, on the first incremental evaluation.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::buildReaders( libff::profiling & profile ){
+
+	profile.enter_block("Index Evaluation Program Readers" );
+
+	const size_t program_size = opcodes.size() ;
+
+	readerOffsets.assign( wireValues.size() + 1 , 0 );
+	for ( size_t pc = 0 ; pc < program_size ; pc++ ){
+		forEachRead( pc , [this]( uint32_t wireId ){ readerOffsets[wireId + 1]++ ; } );
+	}
+	for ( size_t i = 1 ; i < readerOffsets.size() ; i++ ){
+		readerOffsets[i] += readerOffsets[i - 1] ;
+	}
+
+	readers.resize( readerOffsets.back() );
+	std::vector<uint32_t> next( readerOffsets.begin() , readerOffsets.end() - 1 );
+	for ( size_t pc = 0 ; pc < program_size ; pc++ ){
+		forEachRead( pc , [this, &next, pc]( uint32_t wireId ){ readers[next[wireId]++] = pc ; } );
+	}
+
+	pending.assign( ( program_size + 63 ) / 64 , 0 );
+	dirty.assign( wireValues.size() , 0 );
+
+	LOGD("Evaluation Program : %zu reads indexed \n" , readers.size() );
+
+	profile.leave_block("Index Evaluation Program Readers" );
+}
+
+
+template<typename FieldT >
+template<typename F >
+void EvaluationProgram<FieldT>::forEachRead( size_t pc , F f ) const {
+
+	const uint32_t * operand = operands.data() + instructionOffsets[pc] ;
+
+	switch( opcodes[pc] ){
+		case ADD_OPCODE :
+		case PACK_OPCODE :
+			for ( uint32_t i = 0 ; i < operand[0] ; i++ ){ f( operand[2+i] ); }
+			break ;
+		case MUL_OPCODE :
+		case XOR_OPCODE :
+		case OR_OPCODE :
+			f( operand[0] ); f( operand[1] );
+			break ;
+		case CONSTRAINT_OPCODE :
+			f( operand[0] ); f( operand[1] ); f( operand[2] );
+			break ;
+		case NONZEROCHECK_OPCODE :
+			f( operand[0] );
+			break ;
+		case SPLIT_OPCODE :
+		case MULCONST_OPCODE :
+			f( operand[1] );
+			break ;
+		case NATIVE_OPCODE : {
+			const uint32_t * in = operand + 5 + operand[1] + operand[2] ;
+			for ( uint32_t i = 0 ; i < operand[3] ; i++ ){ f( in[i] ); }
+			break ;
+		}
+		default :
+			break ;
+	}
+}
+
+
+/**
+ * The wires an instruction writes : they are always a contiguous run of its operands.
+ * Prover hints report theirs through the evaluator, so none are listed for them.
+ */
+template<typename FieldT >
+const uint32_t * EvaluationProgram<FieldT>::outputsOf( uint8_t opcode , const uint32_t * operand , uint32_t & count ) const {
+
+	switch( opcode ){
+		case ADD_OPCODE :
+		case PACK_OPCODE :
+			count = 1 ;
+			return operand + 1 ;
+		case MUL_OPCODE :
+		case XOR_OPCODE :
+		case OR_OPCODE :
+		case MULCONST_OPCODE :
+			count = 1 ;
+			return operand + 2 ;
+		case NONZEROCHECK_OPCODE :
+			count = 2 ;
+			return operand + 1 ;
+		case SPLIT_OPCODE :
+			count = operand[0] ;
+			return operand + 2 ;
+		case NATIVE_OPCODE :
+			// may hold NO_WIRE entries
+			count = operand[2] ;
+			return operand + 5 + operand[1] ;
+		default :
+			count = 0 ;
+			return operand ;
+	}
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::markChanged( wireID_t wireId ){
+
+	if ( dirty[wireId] ){ return ; }
+
+	dirty[wireId] = 1 ;
+	changed.push_back( wireId );
+
+	for ( uint32_t i = readerOffsets[wireId] ; i < readerOffsets[wireId + 1] ; i++ ){
+		const uint32_t pc = readers[i] ;
+		pending[pc >> 6] |= ( uint64_t(1) << ( pc & 63 ) ) ;
+	}
+}
+
+
+/**
+ * Groups the instructions into dependency levels : an instruction lands one level above the
+ * deepest writer of its inputs, so the instructions of a level never read each other's outputs.
+ * A prover hint may read or write any wire ; it gets a level of its own, above everything before it,
+ * and everything after it lands above it.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::buildLevels( libff::profiling & profile ){
+
+	profile.enter_block("Level Evaluation Program" );
+
+	const size_t program_size = opcodes.size() ;
+
+	std::vector<uint32_t> wireLevel( wireValues.size() , 0 );
+	std::vector<uint32_t> instructionLevel( program_size );
+
+	uint32_t floor = 0 ;
+	uint32_t top = 0 ;
+
+	for ( size_t pc = 0 ; pc < program_size ; pc++ ){
+
+		uint32_t level = floor ;
+
+		if ( opcodes[pc] == FALLBACK_OPCODE ){
+			level = top + 1 ;
+			floor = level + 1 ;
+		}else{
+			forEachRead( pc , [&wireLevel, &level]( uint32_t wireId ){ level = std::max( level , wireLevel[wireId] + 1 ) ; } );
+			uint32_t count ;
+			const uint32_t * out = outputsOf( opcodes[pc] , operands.data() + instructionOffsets[pc] , count ) ;
+			for ( uint32_t i = 0 ; i < count ; i++ ){
+				if ( out[i] != NO_WIRE ){ wireLevel[out[i]] = level ; }
+			}
+		}
+
+		instructionLevel[pc] = level ;
+		top = std::max( top , level ) ;
+	}
+
+	// counting sort by level, keeping program order inside a level
+	levelOffsets.assign( top + 2 , 0 );
+	for ( size_t pc = 0 ; pc < program_size ; pc++ ){ levelOffsets[instructionLevel[pc] + 1]++ ; }
+	for ( size_t i = 1 ; i < levelOffsets.size() ; i++ ){ levelOffsets[i] += levelOffsets[i - 1] ; }
+
+	schedule.resize( program_size );
+	std::vector<uint32_t> next( levelOffsets.begin() , levelOffsets.end() - 1 );
+	for ( size_t pc = 0 ; pc < program_size ; pc++ ){ schedule[next[instructionLevel[pc]]++] = pc ; }
+
+	size_t wide = 0 ;
+	for ( size_t level = 0 ; level + 1 < levelOffsets.size() ; level++ ){
+		const size_t width = levelOffsets[level + 1] - levelOffsets[level] ;
+		if ( width >= PARALLEL_LEVEL_SIZE ){ wide += width ; }
+	}
+
+	LOGD("Evaluation Program : %zu levels , %zu instructions in wide levels \n" , levelOffsets.size() - 1 , wide );
+
+	// a program of long chains ( MiMC , Poseidon ) gains nothing, and keeps the plain loop
+	if ( wide < program_size / 4 ){
+		levelOffsets.clear() ;
+		schedule.clear() ;
+	}
+
+	profile.leave_block("Level Evaluation Program" );
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::run( CircuitEvaluator * evaluator ){
+
+#ifdef MULTICORE
+	if ( levelOffsets.size() && omp_get_max_threads() > 1 ){
+		runLevels( evaluator );
+		return ;
+	}
+#endif
+
+	const uint32_t * operand = operands.data() ;
+	const size_t program_size = opcodes.size() ;
+
+	for ( size_t pc = 0 ; pc < program_size ; pc++ ){
+		operand += step( opcodes[pc] , operand , evaluator );
+	}
+}
+
+
+/**
+ * Runs the program level by level ; a wide enough level is spread over the threads.
+ * Prover hints stay on the calling thread, the evaluator is not shared.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::runLevels( CircuitEvaluator * evaluator ){
+
+	const size_t num_levels = levelOffsets.size() - 1 ;
+
+	for ( size_t level = 0 ; level < num_levels ; level++ ){
+
+		const size_t begin = levelOffsets[level] ;
+		const size_t end = levelOffsets[level + 1] ;
+
+		if ( end - begin < PARALLEL_LEVEL_SIZE ){
+			for ( size_t i = begin ; i < end ; i++ ){
+				const uint32_t pc = schedule[i] ;
+				step( opcodes[pc] , operands.data() + instructionOffsets[pc] , evaluator );
+			}
+			continue ;
+		}
+
+		// an exception may not leave a parallel region
+		bool failed = false ;
+
+#ifdef MULTICORE
+#pragma omp parallel for schedule(dynamic, 64) reduction(||:failed)
+#endif
+		for ( size_t i = begin ; i < end ; i++ ){
+			const uint32_t pc = schedule[i] ;
+			try {
+				step( opcodes[pc] , operands.data() + instructionOffsets[pc] , evaluator );
+			} catch ( ... ){
+				failed = true ;
+			}
+		}
+
+		if ( failed ){
+			throw runtime_error("Error During Evaluation");
+		}
+	}
+}
+
+
+/**
+ * Runs only the instructions downstream of a changed wire, in program order.
+ * An instruction whose outputs come out unchanged stops the propagation there;
+ * prover hints read wires the program cannot see, so they always run again.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::runIncremental( CircuitEvaluator * evaluator ){
+
+	for ( size_t pc = 0 ; pc < opcodes.size() ; pc++ ){
+		if ( opcodes[pc] == FALLBACK_OPCODE ){
+			pending[pc >> 6] |= ( uint64_t(1) << ( pc & 63 ) ) ;
+		}
+	}
+
+	std::vector<FieldT> previous ;
+
+	for ( size_t word = 0 ; word < pending.size() ; word++ ){
+
+		// instructions only read wires written before them, so new work always lands ahead
+		while ( pending[word] ){
+
+			const size_t pc = ( word << 6 ) + __builtin_ctzll( pending[word] ) ;
+			pending[word] &= pending[word] - 1 ;
+
+			const uint8_t opcode = opcodes[pc] ;
+			const uint32_t * operand = operands.data() + instructionOffsets[pc] ;
+
+			uint32_t count ;
+			const uint32_t * out = outputsOf( opcode , operand , count ) ;
+
+			previous.resize( count );
+			for ( uint32_t i = 0 ; i < count ; i++ ){
+				if ( out[i] != NO_WIRE ){ previous[i] = wireValues[out[i]] ; }
+			}
+
+			step( opcode , operand , evaluator );
+
+			for ( uint32_t i = 0 ; i < count ; i++ ){
+				if ( out[i] != NO_WIRE && wireValues[out[i]] != previous[i] ){ markChanged( out[i] ); }
+			}
+		}
+	}
+}
+
+
+template<typename FieldT >
+size_t EvaluationProgram<FieldT>::step( uint8_t opcode , const uint32_t * operand , CircuitEvaluator * evaluator ){
+
+	const FieldT oneElement = FieldT::one();
+	const FieldT zeroElement = FieldT::zero();
+
+	FieldT * values = wireValues.data() ;
+
+	switch( opcode ){
+
+		case ADD_OPCODE : {
+			const uint32_t n = operand[0] ;
+			FieldT & out = values[operand[1]] ;
+			FieldT sum = values[operand[2]] ;
+			for ( uint32_t i = 1 ; i < n ; i++ ){ sum += values[operand[2+i]] ; }
+			out = sum ;
+			return 2 + n ;
+		}
+
+		case PACK_OPCODE : {
+			// horner's rule : sum = 2 * sum + bit , from the most significant input down
+			const uint32_t n = operand[0] ;
+			FieldT sum = zeroElement ;
+			for ( uint32_t i = n ; i > 0 ; i-- ){
+				const FieldT & bit = values[operand[1+i]] ;
+				if ( ! ( bit.is_zero() || bit == oneElement ) ){
+					STEP_LOGD("Error - Input(s) to Pack are not binary. wire#%u\n" , operand[1+i] );
+					throw runtime_error ("Error During Evaluation");
+				}
+				sum += sum ;
+				sum += bit ;
+			}
+			values[operand[1]] = sum ;
+			return 2 + n ;
+		}
+
+		case MUL_OPCODE :
+			values[operand[2]] = values[operand[0]] * values[operand[1]] ;
+			return 3 ;
+
+		case XOR_OPCODE :
+			if ( ! ( ( values[operand[0]].is_zero() || values[operand[0]] == oneElement ) && 
+					 ( values[operand[1]].is_zero() || values[operand[1]] == oneElement ) ) )
+			{
+				STEP_LOGD("Error - Input(s) to XOR are not binary. wire#%u , wire#%u \n" , operand[0] , operand[1] );
+				throw runtime_error("Error During Evaluation");
+			}
+			values[operand[2]] = ( values[operand[0]] == values[operand[1]] ) ? zeroElement : oneElement ;
+			return 3 ;
+
+		case OR_OPCODE :
+			if ( ! ( ( values[operand[0]].is_zero() || values[operand[0]] == oneElement ) && 
+					 ( values[operand[1]].is_zero() || values[operand[1]] == oneElement ) ) )
+			{
+				STEP_LOGD("Error - Input(s) to OR are not binary. wire#%u , wire#%u \n" , operand[0] , operand[1] );
+				throw runtime_error("Error During Evaluation");
+			}
+			values[operand[2]] = ( values[operand[0]].is_zero() && values[operand[1]].is_zero() ) ? zeroElement : oneElement ;
+			return 3 ;
+
+		case CONSTRAINT_OPCODE :
+			if ( values[operand[0]] * values[operand[1]] != values[operand[2]] ){
+				STEP_LOGD(" *** Assertion Failed ***\n[ wire#%u * wire#%u != wire#%u ] \n" , operand[0] , operand[1] , operand[2] );
+				if( ! ignoreFailedAssertion ){
+					throw runtime_error("Error During Evaluation");
+				}
+#ifdef MULTICORE
+#pragma omp atomic
+#endif
+				failedAssertions++ ;
+			}
+			return 3 ;
+
+		case NONZEROCHECK_OPCODE :
+			values[operand[1]] = zeroElement ; // a dummy value
+			values[operand[2]] = values[operand[0]].is_zero() ? zeroElement : oneElement ;
+			return 3 ;
+
+		case SPLIT_OPCODE : {
+			const uint32_t n = operand[0] ;
+			const auto in = values[operand[1]].as_bigint() ;
+			if ( in.num_bits() > n ) {
+				STEP_LOGD("Error in Split --- The number of bits does not fit -- wire#%u : %zu bits , %u outputs \n" , operand[1] , in.num_bits() , n );
+				throw runtime_error ("Error During Evaluation");
+			}
+			for ( uint32_t i = 0 ; i < n ; i++ ){
+				values[operand[2+i]] = in.test_bit(i) ? oneElement : zeroElement ;
+			}
+			return 2 + n ;
+		}
+
+		case MULCONST_OPCODE :
+			values[operand[2]] = constants[operand[0]] * values[operand[1]] ;
+			return 3 ;
+
+		case FALLBACK_OPCODE : {
+			Instruction * e = fallbacks[operand[0]] ;
+			e->evaluate( *evaluator );
+			e->emit( *evaluator );
+			importAssignments( evaluator );
+			return 1 ;
+		}
+
+		case NATIVE_OPCODE : {
+			const uint32_t num_params = operand[1] ;
+			const uint32_t num_outputs = operand[2] ;
+			const uint32_t * params = operand + 5 ;
+			const uint32_t * out = params + num_params ;
+			const uint32_t * in = out + num_outputs ;
+			const FieldT * constant = constants.data() + operand[4] ;
+			if ( operand[0] == native_batch ){
+				nativeBatch( params , constant , in , operand[3] , out , num_outputs );
+			}else{
+				native( operand[0] , params , constant , in , out );
+			}
+			return 5 + num_params + num_outputs + operand[3] ;
+		}
+	}
+
+	return 0 ;
+}
+
+
+template<typename FieldT >
+void EvaluationProgram<FieldT>::native( uint32_t type , const uint32_t * params , const FieldT * constant , const uint32_t * in , const uint32_t * out ){
+	switch( type ){
+		case native_mimc7 :
+			nativeMiMC7( params , constant , in , out );
+			break ;
+		case native_poseidon :
+			nativePoseidon( params , constant , in , out );
+			break ;
+		case native_field_division :
+			nativeFieldDivision( in , out );
+			break ;
+		case native_mod_constant :
+			nativeModConstant( params , in , out );
+			break ;
+		case native_ec_y_coordinate :
+			nativeECYCoordinate( params , in , out );
+			break ;
+	}
+}
+
+
+/**
+ * A native_batch , params : member type , member count , member params.
+ * The members are independent, so a large batch is spread over the threads. An incremental
+ * evaluation only re-runs the members with a changed input.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::nativeBatch( const uint32_t * params , const FieldT * constant ,
+											  const uint32_t * in , uint32_t num_inputs ,
+											  const uint32_t * out , uint32_t num_outputs )
+{
+	const uint32_t type = params[0] ;
+	const size_t count = params[1] ;
+	const uint32_t member_inputs = num_inputs / count ;
+	const uint32_t member_outputs = num_outputs / count ;
+	const bool skip_unchanged = incremental && ! dirty.empty() ;
+
+	auto member = [&]( size_t i ){
+		const uint32_t * member_in = in + i * member_inputs ;
+		if ( skip_unchanged ){
+			bool changed_input = false ;
+			for ( uint32_t j = 0 ; j < member_inputs ; j++ ){ changed_input = changed_input || dirty[member_in[j]] ; }
+			if ( ! changed_input ){ return ; }
+		}
+		native( type , params + 2 , constant , member_in , out + i * member_outputs );
+	};
+
+#ifdef MULTICORE
+	if ( count >= PARALLEL_BATCH_SIZE && ! skip_unchanged && ! omp_in_parallel() ){
+#pragma omp parallel for schedule(dynamic, 4)
+		for ( size_t i = 0 ; i < count ; i++ ){ member( i ); }
+		return ;
+	}
+#endif
+
+	for ( size_t i = 0 ; i < count ; i++ ){ member( i ); }
+}
+
+
+/**
+ * MiMC7Gadget::hash , params : rounds ; inputs : left , right.
+ * The outputs follow the gadget : six per round , then the key addition and the two feed-forward additions.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::nativeMiMC7( const uint32_t * params , const FieldT * roundConstants , const uint32_t * in , const uint32_t * out ){
+
+	FieldT * values = wireValues.data() ;
+	auto put = [values, &out]( const FieldT & v ){
+		if ( *out != NO_WIRE ){ values[*out] = v ; }
+		out++ ;
+	};
+
+	const FieldT left = values[in[0]] ;
+	const FieldT key = values[in[1]] ;
+	FieldT message = left ;
+
+	for ( uint32_t r = 0 ; r < params[0] ; r++ ){
+		FieldT x = message + key ;
+		put( x );
+		// the first round adds no constant
+		if ( r ){ x += roundConstants[r] ; }
+		put( x );
+		const FieldT x2 = x.squared() ;
+		put( x2 );
+		const FieldT x3 = x * x2 ;
+		put( x3 );
+		const FieldT x4 = x2.squared() ;
+		put( x4 );
+		message = x3 * x4 ;
+		put( message );
+	}
+
+	message += key ;
+	put( message );
+	message += left ;
+	put( message );
+	message += key ;
+	put( message );
+}
+
+
+/**
+ * PoseidonGadget , params : t , full rounds , partial rounds , |c| , |s| ; inputs : the initial state.
+ * The constants are c , s , m and p , the matrices row by row ; the outputs follow the gadget's buildCircuit.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::nativePoseidon( const uint32_t * params , const FieldT * constant , const uint32_t * in , const uint32_t * out ){
+
+	FieldT * values = wireValues.data() ;
+	auto put = [values, &out]( const FieldT & v ){
+		if ( *out != NO_WIRE ){ values[*out] = v ; }
+		out++ ;
+	};
+
+	const uint32_t t = params[0] ;
+	const uint32_t half_full_rounds = params[1] / 2 ;
+	const uint32_t partial_rounds = params[2] ;
+	const FieldT * c = constant ;
+	const FieldT * s = c + params[3] ;
+	const FieldT * m = s + params[4] ;
+	const FieldT * p = m + t * t ;
+
+	std::vector<FieldT> state( t );
+	std::vector<FieldT> mixed( t );
+	for ( uint32_t i = 0 ; i < t ; i++ ){ state[i] = values[in[i]] ; }
+
+	auto ark = [&]( uint32_t r ){
+		for ( uint32_t i = 0 ; i < t ; i++ ){
+			state[i] += c[r + i] ;
+			put( state[i] );
+		}
+	};
+
+	auto exp5 = [&]( FieldT & x ){
+		const FieldT x2 = x.squared() ;
+		put( x2 );
+		const FieldT x4 = x2.squared() ;
+		put( x4 );
+		x = x4 * x ;
+		put( x );
+	};
+
+	auto exp5state = [&](){
+		for ( uint32_t i = 0 ; i < t ; i++ ){ exp5( state[i] ); }
+	};
+
+	auto mix = [&]( const FieldT * matrix ){
+		for ( uint32_t i = 0 ; i < t ; i++ ){
+			FieldT sum = FieldT::zero() ;
+			for ( uint32_t j = 0 ; j < t ; j++ ){
+				const FieldT term = state[j] * matrix[j * t + i] ;
+				put( term );
+				sum += term ;
+				put( sum );
+			}
+			mixed[i] = sum ;
+		}
+		state.swap( mixed );
+	};
+
+	ark( 0 );
+
+	for ( uint32_t i = 0 ; i + 1 < half_full_rounds ; i++ ){
+		exp5state();
+		ark( ( i + 1 ) * t );
+		mix( m );
+	}
+
+	exp5state();
+	ark( half_full_rounds * t );
+	mix( p );
+
+	for ( uint32_t i = 0 ; i < partial_rounds ; i++ ){
+		const FieldT * sparse = s + ( 2 * t - 1 ) * i ;
+		exp5( state[0] );
+		state[0] += c[( half_full_rounds + 1 ) * t + i] ;
+		put( state[0] );
+		FieldT first = FieldT::zero() ;
+		for ( uint32_t j = 0 ; j < t ; j++ ){
+			const FieldT term = state[j] * sparse[j] ;
+			put( term );
+			first += term ;
+			put( first );
+		}
+		for ( uint32_t k = 1 ; k < t ; k++ ){
+			const FieldT term = state[0] * sparse[t + k - 1] ;
+			put( term );
+			state[k] += term ;
+			put( state[k] );
+		}
+		state[0] = first ;
+	}
+
+	for ( uint32_t i = 0 ; i + 1 < half_full_rounds ; i++ ){
+		exp5state();
+		ark( ( half_full_rounds + 1 ) * t + partial_rounds + i * t );
+		mix( m );
+	}
+
+	exp5state();
+	mix( m );
+}
+
+
+
+/**
+ * native_field_division , inputs : a , b ; outputs : c = a / b.
+ * As BigInteger::modInverse , a zero b gives a zero c , which the gadget's assertion then rejects.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::nativeFieldDivision( const uint32_t * in , const uint32_t * out ){
+
+	FieldT * values = wireValues.data() ;
+	const FieldT & b = values[in[1]] ;
+
+	values[out[0]] = b.is_zero() ? FieldT::zero() : values[in[0]] * b.inverse() ;
+}
+
+
+/**
+ * native_mod_constant , params : c as words ; inputs : v ; outputs : v mod c , floor( v / c ).
+ * c may not fit in the field ( the order of the embedded curve ) , so this one runs over BigInteger.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::nativeModConstant( const uint32_t * params , const uint32_t * in , const uint32_t * out ){
+
+	FieldT * values = wireValues.data() ;
+	const BigInteger c = evaluation_program::from_words( params ) ;
+	const BigInteger v = evaluation_program::to_BigInteger( values[in[0]] ) ;
+
+	values[out[0]] = convert2FieldT<FieldT>( v.mod( c ) ) ;
+	values[out[1]] = convert2FieldT<FieldT>( v.fdivide( c ) ) ;
+}
+
+
+/**
+ * native_ec_y_coordinate , params : COEFF_A as words ; inputs : x ; outputs : y.
+ * The square root is IntegerFunctions::ressol , the one of the gadget , so that the same root comes out.
+ */
+template<typename FieldT >
+void EvaluationProgram<FieldT>::nativeECYCoordinate( const uint32_t * params , const uint32_t * in , const uint32_t * out ){
+
+	FieldT * values = wireValues.data() ;
+	const FieldT & x = values[in[0]] ;
+	const FieldT a = convert2FieldT<FieldT>( evaluation_program::from_words( params ) ) ;
+	const FieldT x2 = x.squared() ;
+	const FieldT y2 = x2 * x + a * x2 + x ;
+
+	const BigInteger y = IntegerFunctions::ressol( evaluation_program::to_BigInteger( y2 ) , evaluation_program::modulus<FieldT>() ) ;
+	values[out[0]] = convert2FieldT<FieldT>( y ) ;
+}
+
+
+/**
+ * Snapshot layout , little endian , every size as an uint64 :
+ *
+ *   magic , version , the field modulus ( limbs ) , the tag , the circuit name , the number of wires ,
+ *   the preset wires and their values , the primary inputs ( label , wire ) ,
+ *   the primary input arrays ( label , wires ) , the opcodes , the instruction offsets , the operands ,
+ *   the constants ( montgomery limbs ).
+ *
+ * The tag identifies the circuit the program was built for ( name and arguments ) ; load() refuses
+ * a snapshot of another tag. Verbose labels only print , and are left out.
+ */
+template<typename FieldT >
+bool EvaluationProgram<FieldT>::save( std::ostream & out , const std::string & tag ) const {
+
+	using namespace evaluation_program ;
+
+	std::vector<uint8_t> savedOpcodes ;
+	std::vector<uint32_t> savedOffsets ;
+	std::vector<uint32_t> savedOperands ;
+
+	for ( size_t pc = 0 ; pc < opcodes.size() ; pc++ ){
+
+		const uint32_t begin = instructionOffsets[pc] ;
+		const uint32_t end = ( pc + 1 < opcodes.size() ) ? instructionOffsets[pc + 1] : operands.size() ;
+
+		if ( opcodes[pc] == FALLBACK_OPCODE ){
+			if ( fallbacks[operands[begin]]->instanceof_WireLabelInstruction() ){ continue ; }
+			LOGD("Evaluation Program : < %s > runs instructions through the CircuitEvaluator , no snapshot \n" , name.c_str() );
+			return false ;
+		}
+
+		savedOpcodes.push_back( opcodes[pc] );
+		savedOffsets.push_back( savedOperands.size() );
+		savedOperands.insert( savedOperands.end() , operands.begin() + begin , operands.begin() + end );
+	}
+
+	std::vector<wireID_t> preset( presetWires ) ;
+	std::vector<FieldT> presetVals( presetValues ) ;
+	std::vector<std::pair<std::string , wireID_t>> scalars ;
+	std::vector<std::pair<std::string , std::vector<wireID_t>>> arrays ;
+
+	if ( generator ){
+		preset = { generator->oneWire->getWireId() , generator->zeroWire->getWireId() } ;
+		presetVals = { FieldT::one() , FieldT::zero() } ;
+		for ( auto & Itr : generator->get_primary_inputs() ){
+			scalars.push_back( std::make_pair( Itr.first , Itr.second.first->getWireId() ) );
+		}
+		for ( auto & Itr : generator->get_primary_array_inputs() ){
+			std::vector<wireID_t> ws ;
+			for ( size_t ix = 0 ; ix < Itr.second.second.size() ; ix++ ){ ws.push_back( (*Itr.second.first)[ix]->getWireId() ); }
+			arrays.push_back( std::make_pair( Itr.first , ws ) );
+		}
+	}else{
+		for ( auto & Itr : snapshotInputs->primary_inputs ){
+			scalars.push_back( std::make_pair( Itr.first , Itr.second.first ) );
+		}
+		for ( auto & Itr : snapshotInputs->primary_array_inputs ){
+			arrays.push_back( std::make_pair( Itr.first , Itr.second.first ) );
+		}
+	}
+
+	out.write( snapshot_magic , sizeof(snapshot_magic) );
+	write( out , snapshot_version );
+	write<uint64_t>( out , FieldT::num_limbs );
+	out.write( (const char*) FieldT::mod.data , sizeof( FieldT::mod.data[0] ) * FieldT::num_limbs );
+	write_string( out , tag );
+	write_string( out , name );
+	write<uint64_t>( out , wireValues.size() );
+
+	write_vector( out , preset );
+	write_field_elements( out , presetVals );
+
+	write<uint64_t>( out , scalars.size() );
+	for ( auto & input : scalars ){
+		write_string( out , input.first );
+		write( out , input.second );
+	}
+
+	write<uint64_t>( out , arrays.size() );
+	for ( auto & input : arrays ){
+		write_string( out , input.first );
+		write_vector( out , input.second );
+	}
+
+	write_vector( out , savedOpcodes );
+	write_vector( out , savedOffsets );
+	write_vector( out , savedOperands );
+	write_field_elements( out , constants );
+
+	LOGD("Evaluation Program : snapshot of %zu instructions , %zu operands , %zu constants \n" ,
+		 savedOpcodes.size() , savedOperands.size() , constants.size() );
+
+	return out.good() ;
+}
+
+
+template<typename FieldT >
+EvaluationProgram<FieldT> * EvaluationProgram<FieldT>::load( std::istream & in , const std::string & tag , libff::profiling & profile ){
+
+	using namespace evaluation_program ;
+
+	profile.enter_block("Load Evaluation Program" );
+
+	EvaluationProgram * program = new EvaluationProgram() ;
+	program->snapshotInputs = new EvaluationInputs() ;
+
+	char magic[sizeof(snapshot_magic)] ;
+	uint32_t version = 0 ;
+	uint64_t num_limbs = 0 ;
+	uint64_t num_wires = 0 ;
+	uint64_t num_inputs = 0 ;
+	std::vector<char> mod( sizeof( FieldT::mod.data[0] ) * FieldT::num_limbs ) ;
+	std::string snapshot_tag ;
+
+	in.read( magic , sizeof(magic) );
+	bool ok = in.good() && memcmp( magic , snapshot_magic , sizeof(magic) ) == 0 ;
+	ok = ok && read( in , version ) && version == snapshot_version ;
+	ok = ok && read( in , num_limbs ) && num_limbs == FieldT::num_limbs ;
+	ok = ok && in.read( mod.data() , mod.size() ).good() && memcmp( mod.data() , FieldT::mod.data , mod.size() ) == 0 ;
+	ok = ok && read_string( in , snapshot_tag ) && snapshot_tag == tag ;
+	ok = ok && read_string( in , program->name ) ;
+	ok = ok && read( in , num_wires ) && num_wires > 0 && num_wires < ( uint64_t(1) << 31 ) ;
+
+	ok = ok && read_vector( in , program->presetWires ) ;
+	ok = ok && read_field_elements( in , program->presetValues ) ;
+	ok = ok && program->presetWires.size() == program->presetValues.size() ;
+
+	ok = ok && read( in , num_inputs ) && num_inputs <= bytes_left( in ) ;
+	for ( uint64_t i = 0 ; ok && i < num_inputs ; i++ ){
+		std::string label ;
+		wireID_t wireId ;
+		ok = read_string( in , label ) && read( in , wireId ) ;
+		program->snapshotInputs->primary_inputs[label] = std::make_pair( wireId , BigInteger::ZERO() ) ;
+	}
+
+	ok = ok && read( in , num_inputs ) && num_inputs <= bytes_left( in ) ;
+	for ( uint64_t i = 0 ; ok && i < num_inputs ; i++ ){
+		std::string label ;
+		std::vector<wireID_t> ws ;
+		ok = read_string( in , label ) && read_vector( in , ws ) ;
+		const size_t size = ws.size() ;
+		program->snapshotInputs->primary_array_inputs[label] = std::make_pair( ws , std::vector<BigInteger>( size , BigInteger::ZERO() ) ) ;
+	}
+
+	ok = ok && read_vector( in , program->opcodes ) ;
+	ok = ok && read_vector( in , program->instructionOffsets ) ;
+	ok = ok && read_vector( in , program->operands ) ;
+	ok = ok && read_field_elements( in , program->constants ) ;
+
+	if ( ok ){
+		program->wireValues.resize( num_wires );
+		ok = program->isValid() ;
+	}
+
+	if ( ! ok ){
+		LOGD("Evaluation Program : the snapshot is not a valid program for [%s] \n" , tag.c_str() );
+		delete program ;
+		profile.leave_block("Load Evaluation Program" );
+		return NULL ;
+	}
+
+#ifdef MULTICORE
+	if ( program->opcodes.size() >= PARALLEL_PROGRAM_SIZE ){
+		program->buildLevels( profile );
+	}
+#endif
+
+	LOGD("Evaluation Program : %zu instructions , %zu operands , %zu constants loaded for < %s > \n",
+		 program->opcodes.size() , program->operands.size() , program->constants.size() , program->name.c_str() );
+
+	profile.leave_block("Load Evaluation Program" );
+
+	return program ;
+}
+
+
+/**
+ * Bounds checks of a loaded program : the instructions are known and fit their operands , and every
+ * wire and constant they use is in range.
+ */
+template<typename FieldT >
+bool EvaluationProgram<FieldT>::isValid() const {
+
+	const uint64_t num_wires = wireValues.size() ;
+	bool valid = instructionOffsets.size() == opcodes.size() ;
+
+	auto wire = [num_wires]( uint64_t wireId ){ return wireId < num_wires ; };
+
+	for ( wireID_t w : presetWires ){ valid = valid && wire( (uint32_t) w ) ; }
+	for ( auto & Itr : snapshotInputs->primary_inputs ){ valid = valid && wire( (uint32_t) Itr.second.first ) ; }
+	for ( auto & Itr : snapshotInputs->primary_array_inputs ){
+		for ( wireID_t w : Itr.second.first ){ valid = valid && wire( (uint32_t) w ) ; }
+	}
+
+	for ( size_t pc = 0 ; valid && pc < opcodes.size() ; pc++ ){
+
+		const uint64_t begin = instructionOffsets[pc] ;
+		const uint64_t end = ( pc + 1 < opcodes.size() ) ? instructionOffsets[pc + 1] : operands.size() ;
+		if ( begin > end || end > operands.size() ){ return false ; }
+
+		const uint32_t * operand = operands.data() + begin ;
+		const uint64_t length = end - begin ;
+		uint64_t expected = 0 ;
+
+		switch( opcodes[pc] ){
+			case ADD_OPCODE :
+			case PACK_OPCODE :
+			case SPLIT_OPCODE :
+				// step() reads the first input of an ADD whatever the count
+				expected = length >= 2 ? 2 + uint64_t( operand[0] ) : 2 ;
+				valid = length >= 2 && operand[0] >= 1 ;
+				break ;
+			case MUL_OPCODE :
+			case XOR_OPCODE :
+			case OR_OPCODE :
+			case CONSTRAINT_OPCODE :
+			case NONZEROCHECK_OPCODE :
+				expected = 3 ;
+				break ;
+			case MULCONST_OPCODE :
+				expected = 3 ;
+				valid = length == 3 && operand[0] < constants.size() ;
+				break ;
+			case NATIVE_OPCODE :
+				expected = length >= 5 ? 5 + uint64_t( operand[1] ) + operand[2] + operand[3] : 5 ;
+				valid = length == expected && operand[4] <= constants.size() &&
+						isValidNative( operand[0] , operand + 5 , operand[1] , operand + 5 + operand[1] , operand[2] ,
+									   operand[3] , constants.size() - operand[4] ) ;
+				break ;
+			default :
+				return false ;
+		}
+
+		if ( ! valid || length != expected ){ return false ; }
+
+		forEachRead( pc , [&valid, &wire]( uint32_t wireId ){ valid = valid && wire( wireId ) ; } );
+		uint32_t count ;
+		const uint32_t * out = outputsOf( opcodes[pc] , operand , count ) ;
+		for ( uint32_t i = 0 ; i < count ; i++ ){
+			valid = valid && ( out[i] == NO_WIRE || wire( out[i] ) ) ;
+		}
+	}
+
+	return valid ;
+}
+
+
+/**
+ * Checks a native routine against what native() reads and writes : its arity , the span of its
+ * constants , and the length prefix of a word-encoded param. A batch checks one of its members.
+ */
+template<typename FieldT >
+bool EvaluationProgram<FieldT>::isValidNative( uint32_t type , const uint32_t * params , uint32_t num_params ,
+												const uint32_t * out , uint32_t num_outputs ,
+												uint32_t num_inputs , uint64_t num_constants ) const
+{
+	// a BigInteger param : the word count , then the words , the most significant one nonzero
+	auto words = [params, num_params]( bool nonzero ){
+		if ( num_params < 1 || uint64_t( num_params ) != 1 + uint64_t( params[0] ) ){ return false ; }
+		return params[0] ? params[num_params - 1] != 0 : ! nonzero ;
+	};
+
+	// the routines that do not check for a cached output wire
+	auto all_wires = [out, num_outputs](){
+		for ( uint32_t i = 0 ; i < num_outputs ; i++ ){
+			if ( out[i] == NO_WIRE ){ return false ; }
+		}
+		return true ;
+	};
+
+	switch( type ){
+
+		case native_mimc7 :
+			// six outputs per round , then three additions ; one constant per round
+			return num_params == 1 && num_inputs == 2 &&
+				   uint64_t( num_outputs ) == 6 * uint64_t( params[0] ) + 3 && params[0] <= num_constants ;
+
+		case native_poseidon : {
+			if ( num_params != 5 ){ return false ; }
+			const uint64_t t = params[0] ;
+			const uint64_t half_full_rounds = params[1] / 2 ;
+			const uint64_t partial_rounds = params[2] ;
+			if ( t < 1 || t != num_inputs || t >= ( 1 << 16 ) || half_full_rounds < 1 || params[1] >= ( 1 << 16 ) || partial_rounds >= ( 1 << 16 ) ){
+				return false ;
+			}
+			// per full round : ark , exp5 and mix ; per partial round : exp5 , one addition and the sparse mix
+			const uint64_t outputs = 2 * half_full_rounds * ( 4 * t + 2 * t * t ) + partial_rounds * ( 4 * t + 2 ) ;
+			return outputs == num_outputs &&
+				   params[3] >= 2 * half_full_rounds * t + partial_rounds &&
+				   params[4] >= ( 2 * t - 1 ) * partial_rounds &&
+				   uint64_t( params[3] ) + params[4] + 2 * t * t <= num_constants ;
+		}
+
+		case native_field_division :
+			return num_params == 0 && num_inputs == 2 && num_outputs == 1 && all_wires() ;
+
+		case native_mod_constant :
+			return words( true ) && num_inputs == 1 && num_outputs == 2 && all_wires() ;
+
+		case native_ec_y_coordinate :
+			return words( false ) && num_inputs == 1 && num_outputs == 1 && all_wires() ;
+
+		case native_batch : {
+			if ( num_params < 2 ){ return false ; }
+			const uint32_t member_type = params[0] ;
+			const uint32_t count = params[1] ;
+			if ( member_type == native_batch || count < 1 || num_inputs % count || num_outputs % count ){
+				return false ;
+			}
+			const uint32_t member_outputs = num_outputs / count ;
+			for ( uint32_t i = 0 ; i < count ; i++ ){
+				if ( ! isValidNative( member_type , params + 2 , num_params - 2 , out + uint64_t( i ) * member_outputs ,
+									  member_outputs , num_inputs / count , num_constants ) ){
+					return false ;
+				}
+			}
+			return true ;
+		}
+
+		default :
+			return false ;
+	}
+}
+
+
+#undef STEP_LOGD
@@ -0,0 +1,212 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/common/profiling.hpp>
+
+#include <utilities.hpp>
+#include <CircuitGenerator.hpp>
+#include <CircuitEvaluator.hpp>
+#include <WireArray.hpp>
+
+#include <api/context_base.hpp>
+#include <libsnark/jsnark_interface/EmbeddedGeneratorCircuitReader.hpp>
+#include <libsnark/jsnark_interface/EmbeddedGeneratorCircuitReader.tcc>
+#include <libsnark/gadgetlib2/integration.hpp>
+#include <libsnark/gadgetlib2/adapters.hpp>
+#include <gadgetlib2/adapters.tcc>
+#include <gadgetlib2/variable.tcc>
+#include <gadgetlib2/constraint.tcc>
+#include <gadgetlib2/protoboard.tcc>
+#include <gadgetlib2/integration.tcc>
+
+#include "gadgetlib2_circuit_reader.hpp"
+
+using namespace CircuitBuilder;
+
+/* the readers only take their variable indices from the context */
+class VariableCounter : public Context_base {
+
+public:
+
+    VariableCounter(const Config &config)
+        : Context_base(0, "VariableCounter", 0, config, NULL, "", "", "") {}
+
+    int build_circuit() { return 1; }
+    int run_setup() { return 1; }
+    int run_proof() { return 1; }
+    int run_proof_batch(const char*, const char**) { return 1; }
+    int run_verify() { return 1; }
+    int run_verify_batch(const char*, const char*, int*) { return 1; }
+    int run_verify_batch_with_inputs(const char*, const char*, int*) { return 1; }
+    int run_verify_with_inputs(const char*) { return 1; }
+    int create_verifier(const char*) { return 1; }
+    int set_pk_table_memory(size_t) { return 1; }
+    int set_coset_H_query(bool) { return 1; }
+    int write_cs(const char*, bool, const string &) { return 1; }
+    int verify_cs_chechsum(const char*, const string &) { return 1; }
+    int write_circuit_to_file(const char*) { return 1; }
+    int write_inputs_to_file(const char*) { return 1; }
+    int write_evaluation_program(const char*) { return 1; }
+    int read_evaluation_program(const char*) { return 1; }
+    int write_vk(const char*) { return 1; }
+    int read_vk(const char*) { return 1; }
+    int write_pk(const char*) { return 1; }
+    int read_pk(const char*) { return 1; }
+    int write_pk_binary(const char*, bool) { return 1; }
+    int read_pk_binary(const char*, bool) { return 1; }
+    int write_proof(const char*) { return 1; }
+    int read_proof(const char*) { return 1; }
+    const char* serialize_pk_object() { return NULL; }
+    int de_serialize_pk_object(const char*) { return 1; }
+    const char* serialize_vk_object() { return NULL; }
+    int de_serialize_vk_object(const char*) { return 1; }
+    const char* serialize_proof_object() { return NULL; }
+    int de_serialize_proof_object(const char*) { return 1; }
+    const char* serialize_primary_inputs() { return NULL; }
+    int get_set_serialize_format(int) { return 1; }
+};
+
+/*
+  Every BasicOp the reader translates : additions , constant multiplications of either sign ,
+  multiplications , splits , packs , xor , or , assertions and nonzero checks , the last two
+  also on wires that are linear combinations.
+*/
+class SampleCircuit : public CircuitGenerator {
+
+    WiresPtr xs;
+
+protected:
+
+    void buildCircuit()
+    {
+        xs = createInputWireArray(3, "xs");
+        WirePtr a = (*xs)[0], b = (*xs)[1], c = (*xs)[2];
+        WirePtr w = createProverWitnessWire("w");
+
+        WirePtr product = a->mul(b);
+        WirePtr sum = product->add(a->mul(3))->sub(b)->add(c->mul(-5));
+
+        WireArray *bits = a->getBitWires(8);
+        WirePtr packed = bits->packAsBits(6);
+        WirePtr x = (*bits)[0]->XOR((*bits)[1]);
+        WirePtr o = (*bits)[2]->OR((*bits)[3]);
+
+        WirePtr isZero = sum->checkNonZero();
+        WirePtr isEqual = a->isEqualTo(b->add(1));
+        WirePtr less = c->isLessThan(a, 16);
+
+        addEqualityAssertion(w, product->add(c));
+        addAssertion(sum, a, w->mul(sum)->add(x));
+
+        makeOutput(packed->add(x)->mul(o));
+        makeOutput(isZero);
+        makeOutput(isEqual->add(less));
+    }
+
+public:
+
+    SampleCircuit(Config &config) : CircuitGenerator("SampleCircuit", config), xs(NULL) {}
+
+    void assignInputs(CircuitEvaluator &evaluator) { assign_inputs(evaluator); }
+
+    void finalize()
+    {
+        if (xs) { delete xs; }
+        CircuitGenerator::finalize();
+    }
+};
+
+Config sample_circuit_config()
+{
+    Config config;
+    config.FIELD_PRIME = BigInteger("21888242871839275222246405745257275088548364400416034343698204186575808495617", 10);
+    config.LOG2_FIELD_PRIME = config.FIELD_PRIME.size_in_base(2);
+    config.outputVerbose = false;
+    config.debugVerbose = false;
+    return config;
+}
+
+/* the same circuit lowered through gadgetlib2 and straight into the r1cs */
+template<typename FieldT>
+void test_direct_lowering(CircuitGenerator *generator)
+{
+    libff::profiling profile;
+
+    VariableCounter reference_counter(generator->config);
+    ProtoboardPtr<FieldT> pb = gadgetlib2::Protoboard<FieldT>::create(&reference_counter, gadgetlib2::R1P);
+    wire2VariableMap_t *reference_map = NULL;
+    uint32_t reference_map_count = 0, *reference_zero = NULL, reference_zero_count = 0;
+    Gadgetlib2CircuitReader<FieldT> reference(generator, pb, &reference_map, &reference_map_count,
+                                              &reference_zero, &reference_zero_count, profile, &reference_counter);
+    r1cs_constraint_system<FieldT> reference_cs;
+    get_constraint_system_from_gadgetlib2_2<FieldT>(*pb, reference_cs, false, profile, &reference_counter);
+    reference_cs.primary_input_size = reference.getNumInputs() + reference.getNumOutputs();
+    reference_cs.auxiliary_input_size = reference_counter.getLastVariableIndex() - reference_cs.num_inputs();
+
+    VariableCounter direct_counter(generator->config);
+    wire2VariableMap_t *direct_map = NULL;
+    uint32_t direct_map_count = 0, *direct_zero = NULL, direct_zero_count = 0;
+    r1cs_constraint_system<FieldT> direct_cs;
+    EmbeddedGeneratorCircuitReader<FieldT> direct(generator, direct_cs, &direct_map, &direct_map_count,
+                                                  &direct_zero, &direct_zero_count, profile, &direct_counter);
+    direct_cs.primary_input_size = direct.getNumInputs() + direct.getNumOutputs();
+    direct_cs.auxiliary_input_size = direct_counter.getLastVariableIndex() - direct_cs.num_inputs();
+
+    /* the nonzero checks spend a variable each on the protoboard's local auxiliary */
+    assert(direct_counter.getLastVariableIndex() == reference_counter.getLastVariableIndex());
+    assert(direct_cs.num_variables() == reference_cs.num_variables());
+    assert(direct_cs.num_inputs() == reference_cs.num_inputs());
+    assert(direct_cs.num_constraints() == reference_cs.num_constraints());
+    for (size_t i = 0; i < direct_cs.num_constraints(); ++i)
+    {
+        assert(direct_cs.constraints[i] == reference_cs.constraints[i]);
+    }
+
+    assert(direct_map_count == reference_map_count);
+    for (uint32_t i = 0; i < direct_map_count; ++i)
+    {
+        assert(direct_map[i].wire_idx == reference_map[i].wire_idx);
+        assert(direct_map[i].variable_idx == reference_map[i].variable_idx);
+    }
+
+    assert(direct_zero_count == reference_zero_count && direct_zero_count > 0);
+    for (uint32_t i = 0; i < direct_zero_count; ++i)
+    {
+        assert(direct_zero[i] == reference_zero[i]);
+    }
+
+    printf("* Direct lowering of %zu constraints over %zu variables matches gadgetlib2 ( %u mapped wires , %u nonzero checks )\n",
+           direct_cs.num_constraints(), direct_cs.num_variables(), direct_map_count, direct_zero_count);
+
+    free(reference_map);
+    free(reference_zero);
+    free(direct_map);
+    free(direct_zero);
+}
+
+int main(void)
+{
+    libff::alt_bn128_pp::init_public_params();
+    typedef libff::Fr<libff::alt_bn128_pp> FieldT;
+
+    Config config = sample_circuit_config();
+    SampleCircuit *generator = new SampleCircuit(config);
+    generator->generateCircuit();
+
+    test_direct_lowering<FieldT>(generator);
+
+    generator->finalize();
+    delete generator;
+
+    return 0;
+}
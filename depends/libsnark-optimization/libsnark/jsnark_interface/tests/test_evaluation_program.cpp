@@ -0,0 +1,438 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/common/profiling.hpp>
+
+#include <utilities.hpp>
+#include <CircuitGenerator.hpp>
+#include <CircuitEvaluator.hpp>
+#include <Instruction.hpp>
+
+#include <libsnark/jsnark_interface/EvaluationProgram.hpp>
+#include <libsnark/jsnark_interface/EvaluationProgram.tcc>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+using namespace CircuitBuilder;
+
+typedef std::vector<std::pair<uint8_t, std::vector<uint32_t> > > instructions;
+
+static const std::string tag = "test_evaluation_program";
+static const uint32_t num_wires = 31;
+static const uint32_t no_wire = 0xFFFFFFFF;
+
+/*
+  Wires : 0 = one , 1 = a , 2 = b , 3 = a + b , 4 = a * b , 5 = a / b , 6..14 MiMC7 ( one round ) ,
+  15..26 Poseidon ( t = 1 , two full rounds ) , 27 , 28 = a mod 7 , a / 7 , 29 , 30 = a batch of
+  two field divisions ( a / b , b / a ).
+  Constants : the MiMC7 round constant , then the Poseidon c ( 2 ) , m and p.
+*/
+static instructions valid_program()
+{
+    const uint8_t native = 0xFF;
+    instructions program;
+
+    program.push_back({ ADD_OPCODE, { 2, 3, 1, 2 } });
+    program.push_back({ MUL_OPCODE, { 1, 2, 4 } });
+    program.push_back({ native, { native_field_division, 0, 1, 2, 0, 5, 1, 2 } });
+
+    std::vector<uint32_t> mimc7 = { native_mimc7, 1, 9, 2, 0, 1 };
+    for (uint32_t w = 6; w <= 14; ++w) { mimc7.push_back(w); }
+    mimc7.push_back(1); mimc7.push_back(2);
+    program.push_back({ native, mimc7 });
+
+    std::vector<uint32_t> poseidon = { native_poseidon, 5, 12, 1, 1, 1, 2, 0, 2, 0 };
+    for (uint32_t w = 15; w <= 26; ++w) { poseidon.push_back(w); }
+    poseidon.push_back(1);
+    program.push_back({ native, poseidon });
+
+    program.push_back({ native, { native_mod_constant, 2, 2, 1, 0, 1, 7, 27, 28, 1 } });
+    program.push_back({ native, { native_batch, 2, 2, 4, 0, native_field_division, 2, 29, 30, 1, 2, 2, 1 } });
+
+    return program;
+}
+
+template<typename FieldT>
+std::vector<FieldT> valid_constants()
+{
+    return { FieldT(0), FieldT(11), FieldT(13), FieldT(3), FieldT(5) };
+}
+
+/* the header of the snapshot, up to the program */
+template<typename FieldT>
+std::string snapshot_header()
+{
+    using namespace evaluation_program;
+
+    std::ostringstream out;
+    out.write(snapshot_magic, sizeof(snapshot_magic));
+    write(out, snapshot_version);
+    write<uint64_t>(out, FieldT::num_limbs);
+    out.write((const char*) FieldT::mod.data, sizeof(FieldT::mod.data[0]) * FieldT::num_limbs);
+    write_string(out, tag);
+    write_string(out, std::string("test"));
+    write<uint64_t>(out, num_wires);
+
+    write_vector(out, std::vector<wireID_t>{ 0 });
+    write_field_elements(out, std::vector<FieldT>{ FieldT::one() });
+
+    write<uint64_t>(out, 2);
+    write_string(out, std::string("a"));
+    write(out, (wireID_t) 1);
+    write_string(out, std::string("b"));
+    write(out, (wireID_t) 2);
+
+    write<uint64_t>(out, 0);
+    return out.str();
+}
+
+template<typename FieldT>
+std::string snapshot_program(const instructions &program, const std::vector<FieldT> &constants)
+{
+    using namespace evaluation_program;
+
+    std::vector<uint8_t> opcodes;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> operands;
+    for (auto &instruction : program)
+    {
+        opcodes.push_back(instruction.first);
+        offsets.push_back(operands.size());
+        operands.insert(operands.end(), instruction.second.begin(), instruction.second.end());
+    }
+
+    std::ostringstream out;
+    write_vector(out, opcodes);
+    write_vector(out, offsets);
+    write_vector(out, operands);
+    write_field_elements(out, constants);
+    return out.str();
+}
+
+template<typename FieldT>
+EvaluationProgram<FieldT> *load(const std::string &snapshot)
+{
+    libff::profiling profile;
+    std::istringstream in(snapshot);
+    return EvaluationProgram<FieldT>::load(in, tag, profile);
+}
+
+template<typename FieldT>
+bool rejected(const instructions &program, const std::vector<FieldT> &constants)
+{
+    EvaluationProgram<FieldT> *loaded = load<FieldT>(snapshot_header<FieldT>() + snapshot_program(program, constants));
+    delete loaded;
+    return loaded == NULL;
+}
+
+template<typename FieldT>
+void test_valid_snapshot()
+{
+    EvaluationProgram<FieldT> *program = load<FieldT>(snapshot_header<FieldT>() + snapshot_program(valid_program(), valid_constants<FieldT>()));
+    assert(program != NULL);
+
+    program->inputs()->update_primary_input("a", 100);
+    program->inputs()->update_primary_input("b", 9);
+
+    libff::profiling profile;
+    program->evaluate(profile);
+
+    const FieldT a(100), b(9), x = a + b;
+    const FieldT x7 = x.squared() * x * x.squared().squared();
+    assert(program->value(3) == a + b);
+    assert(program->value(4) == a * b);
+    assert(program->value(5) == a * b.inverse());
+    assert(program->value(11) == x7);
+    assert(program->value(14) == x7 + b + a + b);
+    assert(program->value(27) == FieldT(2));
+    assert(program->value(28) == FieldT(14));
+    assert(program->value(29) == a * b.inverse());
+    assert(program->value(30) == b * a.inverse());
+
+    delete program;
+    printf("* Valid snapshot loaded and evaluated\n");
+}
+
+template<typename FieldT>
+void test_truncated_snapshot()
+{
+    const std::string snapshot = snapshot_header<FieldT>() + snapshot_program(valid_program(), valid_constants<FieldT>());
+
+    for (size_t size = 0; size < snapshot.size(); ++size)
+    {
+        EvaluationProgram<FieldT> *loaded = load<FieldT>(snapshot.substr(0, size));
+        assert(loaded == NULL);
+    }
+
+    printf("* %zu truncated snapshots rejected\n", snapshot.size());
+}
+
+template<typename FieldT>
+void test_corrupted_snapshot()
+{
+    const std::vector<FieldT> constants = valid_constants<FieldT>();
+    const size_t add = 0, mul = 1, division = 2, mimc7 = 3, poseidon = 4, mod_constant = 5, batch = 6;
+    std::vector<instructions> corrupted;
+    instructions p;
+
+    /* an ADD , PACK or SPLIT of no wire */
+    p = valid_program(); p[add] = { ADD_OPCODE, { 0, 3 } }; corrupted.push_back(p);
+    p = valid_program(); p[add] = { PACK_OPCODE, { 0, 3 } }; corrupted.push_back(p);
+    p = valid_program(); p[add] = { SPLIT_OPCODE, { 0, 1 } }; corrupted.push_back(p);
+
+    /* an unknown opcode , a wire out of range */
+    p = valid_program(); p[mul].first = 42; corrupted.push_back(p);
+    p = valid_program(); p[mul].second[2] = num_wires; corrupted.push_back(p);
+
+    /* MiMC7 : more rounds than outputs , the round constants past the end */
+    p = valid_program(); p[mimc7].second[5] = 2; corrupted.push_back(p);
+    p = valid_program(); p[mimc7].second[4] = constants.size(); corrupted.push_back(p);
+
+    /* Poseidon : t and the inputs differ , the constants past the end , an output missing */
+    p = valid_program(); p[poseidon].second[5] = 2; corrupted.push_back(p);
+    p = valid_program(); p[poseidon].second[8] = 3; corrupted.push_back(p);
+    p = valid_program(); p[poseidon].second[2] = 11; p[poseidon].second.erase(p[poseidon].second.begin() + 10); corrupted.push_back(p);
+
+    /* field division : three inputs , a cached output */
+    p = valid_program(); p[division].second[3] = 3; p[division].second.push_back(1); corrupted.push_back(p);
+    p = valid_program(); p[division].second[5] = no_wire; corrupted.push_back(p);
+
+    /* mod constant : a length prefix past the params , a zero length , a zero modulus */
+    p = valid_program(); p[mod_constant].second[5] = 2; corrupted.push_back(p);
+    p = valid_program(); p[mod_constant].second = { native_mod_constant, 1, 2, 1, 0, 0, 27, 28, 1 }; corrupted.push_back(p);
+    p = valid_program(); p[mod_constant].second[6] = 0; corrupted.push_back(p);
+
+    /* batch : no member , a nested batch , an unknown member , members of unequal inputs */
+    p = valid_program(); p[batch].second[6] = 0; corrupted.push_back(p);
+    p = valid_program(); p[batch].second[5] = native_batch; corrupted.push_back(p);
+    p = valid_program(); p[batch].second[5] = 9; corrupted.push_back(p);
+    p = valid_program(); p[batch].second[6] = 3; corrupted.push_back(p);
+
+    /* an unknown native routine */
+    p = valid_program(); p[division].second[0] = 0; corrupted.push_back(p);
+
+    assert(!rejected(valid_program(), constants));
+    for (size_t i = 0; i < corrupted.size(); ++i)
+    {
+        assert(rejected(corrupted[i], constants));
+    }
+
+    printf("* %zu corrupted programs rejected\n", corrupted.size());
+
+    /*
+      Any byte of the program flipped : the snapshot is either rejected, or a program
+      that stays inside its wires and constants ( an evaluation may still throw ).
+    */
+    const std::string header = snapshot_header<FieldT>();
+    const std::string body = snapshot_program(valid_program(), constants);
+    size_t loaded = 0;
+
+    for (size_t i = 0; i < body.size(); ++i)
+    {
+        std::string flipped = body;
+        flipped[i] ^= 0x5a;
+
+        EvaluationProgram<FieldT> *program = load<FieldT>(header + flipped);
+        if (program)
+        {
+            ++loaded;
+            program->inputs()->update_primary_input("a", 100);
+            program->inputs()->update_primary_input("b", 9);
+            libff::profiling profile;
+            try {
+                program->evaluate(profile);
+            } catch (const std::exception &e) {
+            }
+            delete program;
+        }
+    }
+
+    printf("* %zu flipped bytes , %zu still load as a valid program\n", body.size(), loaded);
+}
+
+/* a prover hint with no native routine : the program runs it through the CircuitEvaluator */
+class SumHint : public Instruction {
+
+    WirePtr a, b, sum;
+
+public:
+
+    SumHint(CircuitGenerator *generator, WirePtr __a, WirePtr __b, WirePtr __sum)
+        : Instruction(generator), a(__a), b(__b), sum(__sum) {}
+
+    void evaluate(CircuitEvaluator &evaluator)
+    {
+        evaluator.setWireValue(sum, evaluator.getWireValue(a).add(evaluator.getWireValue(b)).mod(generator->config.FIELD_PRIME));
+    }
+};
+
+/*
+  Layers of width wires over the input array xs : x'[i] = x[i] * x[i+1] + x[i].
+  Halfway, a prover hint adds x[0] and x[1] into x[0].
+*/
+class LayerCircuit : public CircuitGenerator {
+
+    int width, depth;
+    WiresPtr xs;
+
+protected:
+
+    void buildCircuit()
+    {
+        xs = createInputWireArray(width, "xs");
+        Wires layer = *xs;
+
+        for (int d = 0; d < depth; ++d)
+        {
+            if (d == depth / 2)
+            {
+                WirePtr sum = create_prover_witness_wire();
+                specifyProverWitnessComputation(allocate<SumHint>(this, layer[0], layer[1], sum));
+                layer.set(0, sum);
+            }
+
+            Wires next((size_t) width);
+            for (int i = 0; i < width; ++i)
+            {
+                next.set(i, layer[i]->mul(layer[(i + 1) % width])->add(layer[i]));
+            }
+            layer = next;
+        }
+    }
+
+public:
+
+    LayerCircuit(int __width, int __depth, Config &config)
+        : CircuitGenerator("LayerCircuit", config), width(__width), depth(__depth), xs(NULL) {}
+
+    void assignInputs(CircuitEvaluator &evaluator) { assign_inputs(evaluator); }
+
+    void finalize()
+    {
+        if (xs) { delete xs; }
+        CircuitGenerator::finalize();
+    }
+};
+
+Config layer_circuit_config()
+{
+    Config config;
+    config.FIELD_PRIME = BigInteger("21888242871839275222246405745257275088548364400416034343698204186575808495617", 10);
+    config.LOG2_FIELD_PRIME = config.FIELD_PRIME.size_in_base(2);
+    config.outputVerbose = false;
+    config.debugVerbose = false;
+    return config;
+}
+
+template<typename FieldT>
+std::vector<FieldT> evaluate_fresh(CircuitGenerator *generator)
+{
+    libff::profiling profile;
+    EvaluationProgram<FieldT> program(generator, profile);
+    program.evaluate(profile);
+    return program.values();
+}
+
+template<typename FieldT>
+void test_incremental_evaluation(const int width, const int depth)
+{
+    Config config = layer_circuit_config();
+    LayerCircuit *generator = new LayerCircuit(width, depth, config);
+    generator->generateCircuit();
+
+    for (int i = 0; i < width; ++i)
+    {
+        generator->update_primary_input_array("xs", i, i + 1);
+    }
+
+    libff::profiling profile;
+    EvaluationProgram<FieldT> program(generator, profile);
+    program.evaluate(profile);
+    assert(!program.isIncremental());
+    assert(program.values() == evaluate_fresh<FieldT>(generator));
+
+    /* one input , then two far apart , then the same inputs again */
+    const std::vector<std::vector<int> > updates = { { 5 }, { 0, width - 1 }, {} };
+    size_t round = 0;
+
+    for (auto &update : updates)
+    {
+        for (int i : update)
+        {
+            generator->update_primary_input_array("xs", i, 1000 + i + (int) round);
+        }
+        program.evaluate(profile);
+        assert(program.isIncremental());
+        assert(program.values() == evaluate_fresh<FieldT>(generator));
+        assert(program.changedWires().size() < program.values().size());
+        if (update.empty())
+        {
+            assert(program.changedWires().empty());
+        }
+        ++round;
+    }
+
+    printf("* Incremental evaluation of %d x %d layers matches a full evaluation\n", width, depth);
+
+    generator->finalize();
+    delete generator;
+}
+
+#ifdef MULTICORE
+template<typename FieldT>
+void test_level_evaluation(const int width, const int depth, const int num_threads)
+{
+    Config config = layer_circuit_config();
+    LayerCircuit *generator = new LayerCircuit(width, depth, config);
+    generator->generateCircuit();
+
+    for (int i = 0; i < width; ++i)
+    {
+        generator->update_primary_input_array("xs", i, 3 * i + 2);
+    }
+
+    /* one thread runs the program in order */
+    omp_set_num_threads(1);
+    const std::vector<FieldT> serial = evaluate_fresh<FieldT>(generator);
+
+    /* the prover hint halfway is a level of its own, a barrier between the wide levels */
+    omp_set_num_threads(num_threads);
+    libff::profiling profile;
+    EvaluationProgram<FieldT> program(generator, profile);
+    assert(program.numLevels() > 2 * (size_t) depth);
+    program.evaluate(profile);
+    assert(program.values() == serial);
+
+    printf("* Level evaluation of %d x %d layers on %d threads matches 1 thread ( %zu levels )\n",
+           width, depth, num_threads, program.numLevels());
+
+    generator->finalize();
+    delete generator;
+}
+#endif
+
+int main()
+{
+    libff::alt_bn128_pp::init_public_params();
+
+    test_valid_snapshot<libff::Fr<libff::alt_bn128_pp> >();
+    test_truncated_snapshot<libff::Fr<libff::alt_bn128_pp> >();
+    test_corrupted_snapshot<libff::Fr<libff::alt_bn128_pp> >();
+    test_incremental_evaluation<libff::Fr<libff::alt_bn128_pp> >(64, 6);
+#ifdef MULTICORE
+    test_level_evaluation<libff::Fr<libff::alt_bn128_pp> >(2048, 10, 3);
+#endif
+}
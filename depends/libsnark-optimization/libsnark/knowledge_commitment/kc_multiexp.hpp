@@ -37,6 +37,32 @@ knowledge_commitment<T1, T2> kc_multi_exp_with_mixed_addition(const knowledge_co
                                                                 typename std::vector<FieldT>::const_iterator scalar_end,
                                                                 const size_t chunks);
 
+/**
+ * The g (part = &knowledge_commitment<T1, T2>::g) or the h part alone of
+ * kc_multi_exp_with_mixed_addition .
+ */
+template<typename T1, typename T2, typename FieldT, libff::multi_exp_method Method, typename T>
+T kc_multi_exp_part_with_mixed_addition(const knowledge_commitment_vector<T1, T2> &vec,
+                                        T knowledge_commitment<T1, T2>::*part,
+                                        const size_t min_idx,
+                                        const size_t max_idx,
+                                        typename std::vector<FieldT>::const_iterator scalar_start,
+                                        typename std::vector<FieldT>::const_iterator scalar_end,
+                                        const size_t chunks);
+
+/**
+ * Same as kc_multi_exp_part_with_mixed_addition, from a table of the part of the
+ * values of vec (base i of the table is the part of vec.values[i]).
+ */
+template<typename T1, typename T2, typename FieldT, typename T>
+T kc_multi_exp_part_with_table(const knowledge_commitment_vector<T1, T2> &vec,
+                               const libff::multi_exp_base_table<T> &table,
+                               const size_t min_idx,
+                               const size_t max_idx,
+                               typename std::vector<FieldT>::const_iterator scalar_start,
+                               typename std::vector<FieldT>::const_iterator scalar_end,
+                               const size_t chunks);
+
 template<typename T1, typename T2, typename FieldT>
 knowledge_commitment_vector<T1, T2> kc_batch_exp(const size_t scalar_size,
                                                  const size_t T1_window,
@@ -18,13 +18,14 @@ knowledge_commitment<T1,T2> opt_window_wnaf_exp(const knowledge_commitment<T1,T2
                                        opt_window_wnaf_exp(base.h, scalar, scalar_bits));
 }
 
-template<typename T1, typename T2, typename FieldT, libff::multi_exp_method Method>
-knowledge_commitment<T1, T2> kc_multi_exp_with_mixed_addition(const knowledge_commitment_vector<T1, T2> &vec,
-                                                                const size_t min_idx,
-                                                                const size_t max_idx,
-                                                                typename std::vector<FieldT>::const_iterator scalar_start,
-                                                                typename std::vector<FieldT>::const_iterator scalar_end,
-                                                                const size_t chunks)
+template<typename T1, typename T2, typename FieldT, libff::multi_exp_method Method, typename T>
+T kc_multi_exp_part_with_mixed_addition(const knowledge_commitment_vector<T1, T2> &vec,
+                                        T knowledge_commitment<T1, T2>::*part,
+                                        const size_t min_idx,
+                                        const size_t max_idx,
+                                        typename std::vector<FieldT>::const_iterator scalar_start,
+                                        typename std::vector<FieldT>::const_iterator scalar_end,
+                                        const size_t chunks)
 {
     const size_t scalar_length = std::distance(scalar_start, scalar_end);
 #ifndef NDEBUG
@@ -39,17 +40,7 @@ knowledge_commitment<T1, T2> kc_multi_exp_with_mixed_addition(const knowledge_co
 
     auto value_it = vec.values.begin() + offset;
 
-    const FieldT zero = FieldT::zero();
-    const FieldT one = FieldT::one();
-
-    std::vector<FieldT> p;
-    std::vector<knowledge_commitment<T1, T2> > g;
-
-    knowledge_commitment<T1, T2> acc = knowledge_commitment<T1, T2>::zero();
-
-    size_t num_skip = 0;
-    size_t num_add = 0;
-    size_t num_other = 0;
+    libff::multi_exp_terms<T, FieldT> terms;
 
     while (index_it != vec.indices.end() && *index_it < max_idx)
     {
@@ -58,41 +49,65 @@ knowledge_commitment<T1, T2> kc_multi_exp_with_mixed_addition(const knowledge_co
         assert(scalar_position < scalar_length);
 #endif
 
-        const FieldT scalar = *(scalar_start + scalar_position);
-
-        if (scalar == zero)
-        {
-            // do nothing
-            ++num_skip;
-        }
-        else if (scalar == one)
-        {
-#ifdef USE_MIXED_ADDITION
-            acc.g = acc.g.mixed_add(value_it->g);
-            acc.h = acc.h.mixed_add(value_it->h);
-#else
-            acc.g = acc.g + value_it->g;
-            acc.h = acc.h + value_it->h;
-#endif
-            ++num_add;
-        }
-        else
-        {
-            p.emplace_back(scalar);
-            g.emplace_back(*value_it);
-            ++num_other;
-        }
+        terms.add((*value_it).*part, *(scalar_start + scalar_position));
 
         ++index_it;
         ++value_it;
     }
 
-    /*libff::print_indent(); printf("* Elements of w skipped: %zu (%0.2f%%)\n", num_skip, 100.*num_skip/(num_skip+num_add+num_other));
-    libff::print_indent(); printf("* Elements of w processed with special addition: %zu (%0.2f%%)\n", num_add, 100.*num_add/(num_skip+num_add+num_other));
-    libff::print_indent(); printf("* Elements of w remaining: %zu (%0.2f%%)\n", num_other, 100.*num_other/(num_skip+num_add+num_other));
+    /*libff::print_indent(); printf("* Elements of w skipped: %zu\n", terms.num_skip);
+    libff::print_indent(); printf("* Elements of w processed with special addition: %zu\n", terms.ones.size());
+    libff::print_indent(); printf("* Elements of w with small scalars: %zu\n", terms.small_bases.size());
+    libff::print_indent(); printf("* Elements of w remaining: %zu\n", terms.dense_bases.size());
     libff::leave_block("Process scalar vector");*/
 
-    return acc + libff::multi_exp<knowledge_commitment<T1, T2>, FieldT, Method>(g.begin(), g.end(), p.begin(), p.end(), chunks);
+    return terms.template sum<Method>(chunks);
+}
+
+template<typename T1, typename T2, typename FieldT, typename T>
+T kc_multi_exp_part_with_table(const knowledge_commitment_vector<T1, T2> &vec,
+                               const libff::multi_exp_base_table<T> &table,
+                               const size_t min_idx,
+                               const size_t max_idx,
+                               typename std::vector<FieldT>::const_iterator scalar_start,
+                               typename std::vector<FieldT>::const_iterator scalar_end,
+                               const size_t chunks)
+{
+    const size_t scalar_length = std::distance(scalar_start, scalar_end);
+#ifndef NDEBUG
+    assert((size_t)(scalar_length) <= vec.domain_size_);
+#else
+    libff::UNUSED(scalar_length);
+#endif
+
+    const size_t begin = std::lower_bound(vec.indices.begin(), vec.indices.end(), min_idx) - vec.indices.begin();
+    const size_t end = std::lower_bound(vec.indices.begin(), vec.indices.end(), max_idx) - vec.indices.begin();
+
+    /* the scalars of the values [begin, end), i.e. of the bases [begin, end) of the table */
+    std::vector<FieldT> scalars;
+    scalars.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
+    {
+        scalars.emplace_back(*(scalar_start + (vec.indices[i] - min_idx)));
+    }
+
+    return libff::multi_exp_with_table<T, FieldT>(table, begin, scalars.begin(), scalars.end(), chunks);
+}
+
+template<typename T1, typename T2, typename FieldT, libff::multi_exp_method Method>
+knowledge_commitment<T1, T2> kc_multi_exp_with_mixed_addition(const knowledge_commitment_vector<T1, T2> &vec,
+                                                                const size_t min_idx,
+                                                                const size_t max_idx,
+                                                                typename std::vector<FieldT>::const_iterator scalar_start,
+                                                                typename std::vector<FieldT>::const_iterator scalar_end,
+                                                                const size_t chunks)
+{
+    /* the g and h parts are summed apart, each by a multi_exp on its own group */
+    return knowledge_commitment<T1, T2>(
+        kc_multi_exp_part_with_mixed_addition<T1, T2, FieldT, Method>(vec, &knowledge_commitment<T1, T2>::g,
+                                                                      min_idx, max_idx, scalar_start, scalar_end, chunks),
+        kc_multi_exp_part_with_mixed_addition<T1, T2, FieldT, Method>(vec, &knowledge_commitment<T1, T2>::h,
+                                                                      min_idx, max_idx, scalar_start, scalar_end, chunks));
 }
 
 template<typename T1, typename T2, typename FieldT>
@@ -32,8 +32,13 @@
 #ifndef R1CS_TO_QAP_HPP_
 #define R1CS_TO_QAP_HPP_
 
+#include <memory>
+
+#include <libfqfft/evaluation_domain/evaluation_domain.hpp>
+
 #include <libsnark/relations/arithmetic_programs/qap/qap.hpp>
 #include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs.hpp>
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs_sparse_matrices.hpp>
 
 namespace libsnark {
 
@@ -63,6 +68,49 @@ qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT>
                                             const FieldT &d2,
                                             const FieldT &d3);
 
+/**
+ * Same as above, but over a caller-supplied evaluation domain for cs
+ * (of size at least cs.num_constraints() + cs.num_inputs() + 1), so that
+ * repeated calls for the same constraint system reuse the domain and its tables.
+ */
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                            const r1cs_constraint_system<FieldT> &cs,
+                                            const r1cs_primary_input<FieldT> &primary_input,
+                                            const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                            const FieldT &d1,
+                                            const FieldT &d2,
+                                            const FieldT &d3);
+
+/**
+ * Same as above, but reading the constraint system from its flattened (CSR) matrices,
+ * whose rows are evaluated in parallel. The parallel regions (the matrix rows and the FFTs)
+ * run on num_threads threads, 0 for the default team.
+ */
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                            const r1cs_sparse_matrices<FieldT> &matrices,
+                                            const r1cs_primary_input<FieldT> &primary_input,
+                                            const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                            const FieldT &d1,
+                                            const FieldT &d2,
+                                            const FieldT &d3,
+                                            const size_t num_threads = 0);
+
+/**
+ * Same as above, without zero knowledge (d1 = d2 = d3 = 0), but the coefficients_for_H
+ * of the witness are the evaluations of H on the coset FieldT::multiplicative_generator * S
+ * of the domain S, in the order of S (domain->m of them): the inverse coset FFT that
+ * turns them into coefficients is skipped. A proving key whose H-query is in the
+ * Lagrange basis of that coset takes them as they are.
+ */
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map_on_coset(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                                     const r1cs_sparse_matrices<FieldT> &matrices,
+                                                     const r1cs_primary_input<FieldT> &primary_input,
+                                                     const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                                     const size_t num_threads = 0);
+
 } // libsnark
 
 #include <libsnark/reductions/r1cs_to_qap/r1cs_to_qap.tcc>
@@ -18,6 +18,10 @@
 #include <libff/common/utils.hpp>
 #include <libfqfft/evaluation_domain/get_evaluation_domain.hpp>
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 namespace libsnark {
 
 /**
@@ -174,48 +178,36 @@ qap_instance_evaluation<FieldT> r1cs_to_qap_instance_map_with_evaluation(const r
 }
 
 /**
- * Witness map for the R1CS-to-QAP reduction.
+ * Common part of the witness maps below. The callbacks fill the evaluations of
+ * the rows of A and B (resp. C) on the full variable assignment, i.e., the
+ * first num_constraints entries of aA and aB (resp. aC).
  *
- * The witness map takes zero knowledge into account when d1,d2,d3 are random.
+ * With H_on_coset, the witness holds the evaluations of H on the coset T
+ * instead of its coefficients, i.e., steps (5) and (6) below are skipped;
+ * this requires d1 = d2 = d3 = 0.
  *
- * More precisely, compute the coefficients
- *     h_0,h_1,...,h_n
- * of the polynomial
- *     H(z) := (A(z)*B(z)-C(z))/Z(z)
- * where
- *   A(z) := A_0(z) + \sum_{k=1}^{m} w_k A_k(z) + d1 * Z(z)
- *   B(z) := B_0(z) + \sum_{k=1}^{m} w_k B_k(z) + d2 * Z(z)
- *   C(z) := C_0(z) + \sum_{k=1}^{m} w_k C_k(z) + d3 * Z(z)
- *   Z(z) := "vanishing polynomial of set S"
- * and
- *   m = number of variables of the QAP
- *   n = degree of the QAP
- *
- * This is done as follows:
- *  (1) compute evaluations of A,B,C on S = {sigma_1,...,sigma_n}
- *  (2) compute coefficients of A,B,C
- *  (3) compute evaluations of A,B,C on T = "coset of S"
- *  (4) compute evaluation of H on T
- *  (5) compute coefficients of H
- *  (6) patch H to account for d1,d2,d3 (i.e., add coefficients of the polynomial (A d2 + B d1 - d3) + d1*d2*Z )
- *
- * The code below is not as simple as the above high-level description due to
- * some reshuffling to save space.
+ * The parallel regions here and in the domain run on num_threads threads (0 for the
+ * default team); the callbacks take care of their own.
  */
-template<typename FieldT>
-qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT> &cs,
-                                            const r1cs_primary_input<FieldT> &primary_input,
-                                            const r1cs_auxiliary_input<FieldT> &auxiliary_input,
-                                            const FieldT &d1,
-                                            const FieldT &d2,
-                                            const FieldT &d3)
+template<typename FieldT, typename EvaluateAB, typename EvaluateC>
+qap_witness<FieldT> _r1cs_to_qap_witness_map(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                             const size_t num_constraints,
+                                             const size_t num_inputs,
+                                             const size_t num_variables,
+                                             const r1cs_primary_input<FieldT> &primary_input,
+                                             const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                             const EvaluateAB &evaluate_AB,
+                                             const EvaluateC &evaluate_C,
+                                             const FieldT &d1,
+                                             const FieldT &d2,
+                                             const FieldT &d3,
+                                             const bool H_on_coset,
+                                             const size_t num_threads)
 {
     //libff::enter_block("Call to r1cs_to_qap_witness_map");
 
-    /* sanity check */
-    assert(cs.is_satisfied(primary_input, auxiliary_input));
-
-    const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > domain = libfqfft::get_evaluation_domain<FieldT>(cs.num_constraints() + cs.num_inputs() + 1);
+    assert(domain->m >= num_constraints + num_inputs + 1);
+    assert(!H_on_coset || (d1.is_zero() && d2.is_zero() && d3.is_zero()));
 
     r1cs_variable_assignment<FieldT> full_variable_assignment = primary_input;
     full_variable_assignment.insert(full_variable_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
@@ -224,52 +216,52 @@ qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT>
     std::vector<FieldT> aA(domain->m, FieldT::zero()), aB(domain->m, FieldT::zero());
 
     /* account for the additional constraints input_i * 0 = 0 */
-    for (size_t i = 0; i <= cs.num_inputs(); ++i)
+    for (size_t i = 0; i <= num_inputs; ++i)
     {
-        aA[i+cs.num_constraints()] = (i > 0 ? full_variable_assignment[i-1] : FieldT::one());
+        aA[i+num_constraints] = (i > 0 ? full_variable_assignment[i-1] : FieldT::one());
     }
     /* account for all other constraints */
-    for (size_t i = 0; i < cs.num_constraints(); ++i)
-    {
-        aA[i] += cs.constraints[i].a.evaluate(full_variable_assignment);
-        aB[i] += cs.constraints[i].b.evaluate(full_variable_assignment);
-    }
+    evaluate_AB(full_variable_assignment, aA, aB);
     //libff::leave_block("Compute evaluation of polynomials A, B on set S");
 
     //libff::enter_block("Compute coefficients of polynomial A");
-    domain->iFFT(aA);
+    domain->iFFT(aA, num_threads);
     //libff::leave_block("Compute coefficients of polynomial A");
 
     //libff::enter_block("Compute coefficients of polynomial B");
-    domain->iFFT(aB);
+    domain->iFFT(aB, num_threads);
     //libff::leave_block("Compute coefficients of polynomial B");
 
     //libff::enter_block("Compute ZK-patch");
-    std::vector<FieldT> coefficients_for_H(domain->m+1, FieldT::zero());
+    std::vector<FieldT> coefficients_for_H;
+    if (!H_on_coset)
+    {
+        coefficients_for_H.resize(domain->m+1, FieldT::zero());
 #ifdef MULTICORE
-#pragma omp parallel for
+#pragma omp parallel for num_threads(libfqfft::_team_size(num_threads))
 #endif
-    /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z */
-    for (size_t i = 0; i < domain->m; ++i)
-    {
-        coefficients_for_H[i] = d2*aA[i] + d1*aB[i];
+        /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z */
+        for (size_t i = 0; i < domain->m; ++i)
+        {
+            coefficients_for_H[i] = d2*aA[i] + d1*aB[i];
+        }
+        coefficients_for_H[0] -= d3;
+        domain->add_poly_Z(d1*d2, coefficients_for_H);
     }
-    coefficients_for_H[0] -= d3;
-    domain->add_poly_Z(d1*d2, coefficients_for_H);
     //libff::leave_block("Compute ZK-patch");
 
     //libff::enter_block("Compute evaluation of polynomial A on set T");
-    domain->cosetFFT(aA, FieldT::multiplicative_generator);
+    domain->cosetFFT(aA, FieldT::multiplicative_generator, num_threads);
     //libff::leave_block("Compute evaluation of polynomial A on set T");
 
     //libff::enter_block("Compute evaluation of polynomial B on set T");
-    domain->cosetFFT(aB, FieldT::multiplicative_generator);
+    domain->cosetFFT(aB, FieldT::multiplicative_generator, num_threads);
     //libff::leave_block("Compute evaluation of polynomial B on set T");
 
     //libff::enter_block("Compute evaluation of polynomial H on set T");
     std::vector<FieldT> &H_tmp = aA; // can overwrite aA because it is not used later
 #ifdef MULTICORE
-#pragma omp parallel for
+#pragma omp parallel for num_threads(libfqfft::_team_size(num_threads))
 #endif
     for (size_t i = 0; i < domain->m; ++i)
     {
@@ -279,22 +271,19 @@ qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT>
 
     //libff::enter_block("Compute evaluation of polynomial C on set S");
     std::vector<FieldT> aC(domain->m, FieldT::zero());
-    for (size_t i = 0; i < cs.num_constraints(); ++i)
-    {
-        aC[i] += cs.constraints[i].c.evaluate(full_variable_assignment);
-    }
+    evaluate_C(full_variable_assignment, aC);
     //libff::leave_block("Compute evaluation of polynomial C on set S");
 
     //libff::enter_block("Compute coefficients of polynomial C");
-    domain->iFFT(aC);
+    domain->iFFT(aC, num_threads);
     //libff::leave_block("Compute coefficients of polynomial C");
 
     //libff::enter_block("Compute evaluation of polynomial C on set T");
-    domain->cosetFFT(aC, FieldT::multiplicative_generator);
+    domain->cosetFFT(aC, FieldT::multiplicative_generator, num_threads);
     //libff::leave_block("Compute evaluation of polynomial C on set T");
 
 #ifdef MULTICORE
-#pragma omp parallel for
+#pragma omp parallel for num_threads(libfqfft::_team_size(num_threads))
 #endif
     for (size_t i = 0; i < domain->m; ++i)
     {
@@ -302,18 +291,32 @@ qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT>
     }
 
     //libff::enter_block("Divide by Z on set T");
-    domain->divide_by_Z_on_coset(H_tmp);
+    domain->divide_by_Z_on_coset(H_tmp, num_threads);
     //libff::leave_block("Divide by Z on set T");
 
     //libff::leave_block("Compute evaluation of polynomial H on set T");
 
+    if (H_on_coset)
+    {
+        //libff::leave_block("Call to r1cs_to_qap_witness_map");
+
+        return qap_witness<FieldT>(num_variables,
+                                   domain->m,
+                                   num_inputs,
+                                   d1,
+                                   d2,
+                                   d3,
+                                   full_variable_assignment,
+                                   std::move(H_tmp));
+    }
+
     //libff::enter_block("Compute coefficients of polynomial H");
-    domain->icosetFFT(H_tmp, FieldT::multiplicative_generator);
+    domain->icosetFFT(H_tmp, FieldT::multiplicative_generator, num_threads);
     //libff::leave_block("Compute coefficients of polynomial H");
 
     //libff::enter_block("Compute sum of H and ZK-patch");
 #ifdef MULTICORE
-#pragma omp parallel for
+#pragma omp parallel for num_threads(libfqfft::_team_size(num_threads))
 #endif
     for (size_t i = 0; i < domain->m; ++i)
     {
@@ -323,9 +326,9 @@ qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT>
 
     //libff::leave_block("Call to r1cs_to_qap_witness_map");
 
-    return qap_witness<FieldT>(cs.num_variables(),
+    return qap_witness<FieldT>(num_variables,
                                domain->m,
-                               cs.num_inputs(),
+                               num_inputs,
                                d1,
                                d2,
                                d3,
@@ -333,6 +336,133 @@ qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT>
                                std::move(coefficients_for_H));
 }
 
+/**
+ * Witness map for the R1CS-to-QAP reduction.
+ *
+ * The witness map takes zero knowledge into account when d1,d2,d3 are random.
+ *
+ * More precisely, compute the coefficients
+ *     h_0,h_1,...,h_n
+ * of the polynomial
+ *     H(z) := (A(z)*B(z)-C(z))/Z(z)
+ * where
+ *   A(z) := A_0(z) + \sum_{k=1}^{m} w_k A_k(z) + d1 * Z(z)
+ *   B(z) := B_0(z) + \sum_{k=1}^{m} w_k B_k(z) + d2 * Z(z)
+ *   C(z) := C_0(z) + \sum_{k=1}^{m} w_k C_k(z) + d3 * Z(z)
+ *   Z(z) := "vanishing polynomial of set S"
+ * and
+ *   m = number of variables of the QAP
+ *   n = degree of the QAP
+ *
+ * This is done as follows:
+ *  (1) compute evaluations of A,B,C on S = {sigma_1,...,sigma_n}
+ *  (2) compute coefficients of A,B,C
+ *  (3) compute evaluations of A,B,C on T = "coset of S"
+ *  (4) compute evaluation of H on T
+ *  (5) compute coefficients of H
+ *  (6) patch H to account for d1,d2,d3 (i.e., add coefficients of the polynomial (A d2 + B d1 - d3) + d1*d2*Z )
+ *
+ * The code below is not as simple as the above high-level description due to
+ * some reshuffling to save space.
+ */
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map(const r1cs_constraint_system<FieldT> &cs,
+                                            const r1cs_primary_input<FieldT> &primary_input,
+                                            const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                            const FieldT &d1,
+                                            const FieldT &d2,
+                                            const FieldT &d3)
+{
+    const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > domain = libfqfft::get_evaluation_domain<FieldT>(cs.num_constraints() + cs.num_inputs() + 1);
+
+    return r1cs_to_qap_witness_map(domain, cs, primary_input, auxiliary_input, d1, d2, d3);
+}
+
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                            const r1cs_constraint_system<FieldT> &cs,
+                                            const r1cs_primary_input<FieldT> &primary_input,
+                                            const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                            const FieldT &d1,
+                                            const FieldT &d2,
+                                            const FieldT &d3)
+{
+    /* sanity check */
+    assert(cs.is_satisfied(primary_input, auxiliary_input));
+
+    const auto evaluate_AB = [&cs](const r1cs_variable_assignment<FieldT> &assignment, std::vector<FieldT> &aA, std::vector<FieldT> &aB)
+    {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+        for (size_t i = 0; i < cs.num_constraints(); ++i)
+        {
+            aA[i] = cs.constraints[i].a.evaluate(assignment);
+            aB[i] = cs.constraints[i].b.evaluate(assignment);
+        }
+    };
+
+    const auto evaluate_C = [&cs](const r1cs_variable_assignment<FieldT> &assignment, std::vector<FieldT> &aC)
+    {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+        for (size_t i = 0; i < cs.num_constraints(); ++i)
+        {
+            aC[i] = cs.constraints[i].c.evaluate(assignment);
+        }
+    };
+
+    return _r1cs_to_qap_witness_map(domain, cs.num_constraints(), cs.num_inputs(), cs.num_variables(),
+                                    primary_input, auxiliary_input, evaluate_AB, evaluate_C, d1, d2, d3, false, 0);
+}
+
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                            const r1cs_sparse_matrices<FieldT> &matrices,
+                                            const r1cs_primary_input<FieldT> &primary_input,
+                                            const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                            const FieldT &d1,
+                                            const FieldT &d2,
+                                            const FieldT &d3,
+                                            const size_t num_threads)
+{
+    const auto evaluate_AB = [&matrices, num_threads](const r1cs_variable_assignment<FieldT> &assignment, std::vector<FieldT> &aA, std::vector<FieldT> &aB)
+    {
+        matrices.evaluate_AB(assignment, aA, aB, num_threads);
+    };
+
+    const auto evaluate_C = [&matrices, num_threads](const r1cs_variable_assignment<FieldT> &assignment, std::vector<FieldT> &aC)
+    {
+        matrices.evaluate_C(assignment, aC, num_threads);
+    };
+
+    return _r1cs_to_qap_witness_map(domain, matrices.num_constraints, matrices.num_inputs, matrices.num_variables,
+                                    primary_input, auxiliary_input, evaluate_AB, evaluate_C, d1, d2, d3, false, num_threads);
+}
+
+template<typename FieldT>
+qap_witness<FieldT> r1cs_to_qap_witness_map_on_coset(const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > &domain,
+                                                     const r1cs_sparse_matrices<FieldT> &matrices,
+                                                     const r1cs_primary_input<FieldT> &primary_input,
+                                                     const r1cs_auxiliary_input<FieldT> &auxiliary_input,
+                                                     const size_t num_threads)
+{
+    const auto evaluate_AB = [&matrices, num_threads](const r1cs_variable_assignment<FieldT> &assignment, std::vector<FieldT> &aA, std::vector<FieldT> &aB)
+    {
+        matrices.evaluate_AB(assignment, aA, aB, num_threads);
+    };
+
+    const auto evaluate_C = [&matrices, num_threads](const r1cs_variable_assignment<FieldT> &assignment, std::vector<FieldT> &aC)
+    {
+        matrices.evaluate_C(assignment, aC, num_threads);
+    };
+
+    return _r1cs_to_qap_witness_map(domain, matrices.num_constraints, matrices.num_inputs, matrices.num_variables,
+                                    primary_input, auxiliary_input, evaluate_AB, evaluate_C,
+                                    FieldT::zero(), FieldT::zero(), FieldT::zero(), true, num_threads);
+}
+
 } // libsnark
 
 #endif // R1CS_TO_QAP_TCC_
@@ -80,6 +80,38 @@ void test_qap(const size_t qap_degree, const size_t num_inputs, const bool binar
     assert(qap_inst_2.is_satisfied(qap_wit));
     libff::leave_block("Check satisfiability of QAP instance 2");
 
+    /*
+      Without zero knowledge, the witness map on the coset gS gives the evaluations of H on gS,
+      and a proving key in the coset Lagrange basis holds L_j(t/g) Z(t), so that the H query
+      sums to H(t) Z(t) as with the coefficients of H and the monomial basis.
+    */
+    libff::enter_block("Check H(t)*Z(t) of the coset Lagrange basis");
+    const std::shared_ptr<libfqfft::evaluation_domain<FieldT> > domain =
+        libfqfft::get_evaluation_domain<FieldT>(example.constraint_system.num_constraints() + example.constraint_system.num_inputs() + 1);
+    const FieldT zero = FieldT::zero();
+
+    const qap_witness<FieldT> monomial_wit = r1cs_to_qap_witness_map(domain, example.constraint_system, example.primary_input, example.auxiliary_input, zero, zero, zero);
+    const qap_witness<FieldT> coset_wit = r1cs_to_qap_witness_map_on_coset(domain, r1cs_sparse_matrices<FieldT>(example.constraint_system), example.primary_input, example.auxiliary_input);
+    assert(coset_wit.coefficients_for_H.size() == domain->m);
+
+    FieldT monomial_H_at_t = zero, t_power = FieldT::one();
+    for (size_t i = 0; i < monomial_wit.coefficients_for_H.size(); ++i)
+    {
+        monomial_H_at_t += monomial_wit.coefficients_for_H[i] * t_power;
+        t_power *= t;
+    }
+
+    const std::vector<FieldT> coset_lagrange = domain->evaluate_all_lagrange_polynomials(t * FieldT::multiplicative_generator.inverse());
+    FieldT coset_H_at_t = zero;
+    for (size_t i = 0; i < domain->m; ++i)
+    {
+        coset_H_at_t += coset_wit.coefficients_for_H[i] * coset_lagrange[i];
+    }
+
+    const FieldT Z_at_t = domain->compute_vanishing_polynomial(t);
+    assert(coset_H_at_t * Z_at_t == monomial_H_at_t * Z_at_t);
+    libff::leave_block("Check H(t)*Z(t) of the coset Lagrange basis");
+
     libff::leave_block("Call to test_qap");
 }
 
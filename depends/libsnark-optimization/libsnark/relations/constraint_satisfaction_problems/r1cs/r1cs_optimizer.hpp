@@ -0,0 +1,95 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for an optimization pass over a R1CS constraint
+ system, run once after the circuit is lowered and before the setup.
+
+ A constraint whose A or B side is a constant is a linear equation over the
+ variables. When the equation holds an auxiliary variable v, v can be
+ written as a linear combination of the other variables, substituted into
+ every other constraint, and dropped together with the equation. The pass
+ then removes constraints left trivially satisfied, removes duplicate
+ constraints, and renumbers the auxiliary variables that are still in use.
+
+ Every constraint left is the original constraint with the eliminated
+ variables substituted, so the values of the variables that are kept come
+ unchanged from the witness of the original system.
+
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef R1CS_OPTIMIZER_HPP_
+#define R1CS_OPTIMIZER_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs.hpp>
+
+namespace libsnark {
+
+template<typename FieldT>
+class r1cs_optimizer {
+public:
+    /* new index of a variable the pass removed */
+    static const uint32_t removed = 0xFFFFFFFF;
+
+    /* an equation with more terms is not used for a substitution */
+    size_t max_substitution_terms;
+    /* largest number of terms a substitution may add to the other constraints */
+    size_t max_fill_in;
+
+    size_t num_substituted;
+    size_t num_trivial;
+    size_t num_duplicates;
+    size_t num_unused;
+
+    r1cs_optimizer();
+
+    /**
+     * The variable ( an index into the assignment , i.e. the r1cs index minus one )
+     * keeps a value of its own : it is neither substituted nor dropped.
+     */
+    void keep(const size_t variable);
+
+    /**
+     * Optimize the constraint system in place. Returns the new assignment
+     * index of every variable of the original assignment , or removed.
+     * The primary inputs keep their indices.
+     */
+    std::vector<uint32_t> optimize(r1cs_constraint_system<FieldT> &cs);
+
+    /**
+     * The assignment of the optimized system , from one of the original system.
+     */
+    static void project(const std::vector<uint32_t> &variable_map,
+                        const std::vector<FieldT> &assignment,
+                        std::vector<FieldT> &projected);
+
+private:
+    typedef std::vector<linear_term<FieldT> > terms_t;
+
+    std::vector<uint8_t> kept;
+    std::vector<uint8_t> substituted;
+    std::vector<terms_t> substitutions;
+    std::vector<std::vector<var_index_t> > users;
+
+    void merge(terms_t &terms) const;
+    bool substitute(terms_t &terms) const;
+    void eliminate(const var_index_t index, const terms_t &equation, const size_t pivot);
+
+    static bool is_constant(const linear_combination<FieldT> &lc, FieldT &value);
+    static bool is_zero(const linear_combination<FieldT> &lc);
+    static bool is_trivial(const r1cs_constraint<FieldT> &constraint);
+    static uint64_t hash(const r1cs_constraint<FieldT> &constraint);
+    static bool equal(const linear_combination<FieldT> &a, const linear_combination<FieldT> &b);
+};
+
+} // libsnark
+
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs_optimizer.tcc>
+
+#endif // R1CS_OPTIMIZER_HPP_
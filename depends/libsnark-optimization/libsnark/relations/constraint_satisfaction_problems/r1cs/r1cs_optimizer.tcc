@@ -0,0 +1,475 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for an optimization pass over a R1CS
+ constraint system.
+
+ See r1cs_optimizer.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef R1CS_OPTIMIZER_TCC_
+#define R1CS_OPTIMIZER_TCC_
+
+#include <algorithm>
+
+namespace libsnark {
+
+template<typename FieldT>
+r1cs_optimizer<FieldT>::r1cs_optimizer() :
+    max_substitution_terms(32),
+    max_fill_in(4096),
+    num_substituted(0),
+    num_trivial(0),
+    num_duplicates(0),
+    num_unused(0)
+{
+}
+
+template<typename FieldT>
+void r1cs_optimizer<FieldT>::keep(const size_t variable)
+{
+    // kept is indexed like the constraints , the constant takes index 0
+    if (variable + 1 >= kept.size())
+    {
+        kept.resize(variable + 2, 0);
+    }
+    kept[variable + 1] = 1;
+}
+
+template<typename FieldT>
+void r1cs_optimizer<FieldT>::merge(terms_t &terms) const
+{
+    // sort by variable , add up the terms of equal variables and drop the zero ones
+    std::sort(terms.begin(), terms.end(),
+              [](const linear_term<FieldT> &a, const linear_term<FieldT> &b) { return a.index < b.index; });
+
+    size_t last = 0;
+    for (size_t i = 0; i < terms.size(); ++i)
+    {
+        if (last && terms[last-1].index == terms[i].index)
+        {
+            terms[last-1].coeff += terms[i].coeff;
+        }
+        else
+        {
+            terms[last++] = terms[i];
+        }
+    }
+    terms.resize(last);
+
+    terms.erase(std::remove_if(terms.begin(), terms.end(),
+                               [](const linear_term<FieldT> &t) { return t.coeff.is_zero(); }),
+                terms.end());
+}
+
+template<typename FieldT>
+bool r1cs_optimizer<FieldT>::substitute(terms_t &terms) const
+{
+    bool changed = false;
+    const size_t size = terms.size();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const var_index_t index = terms[i].index;
+        if (!substituted[index])
+        {
+            continue;
+        }
+
+        const FieldT coeff = terms[i].coeff;
+        terms[i].coeff = FieldT::zero();
+        for (const linear_term<FieldT> &t : substitutions[index])
+        {
+            terms.emplace_back(t.index, coeff * t.coeff);
+        }
+        changed = true;
+    }
+
+    if (changed)
+    {
+        merge(terms);
+    }
+    return changed;
+}
+
+template<typename FieldT>
+void r1cs_optimizer<FieldT>::eliminate(const var_index_t index, const terms_t &equation, const size_t pivot)
+{
+    // equation = 0 , solved for the pivot
+    const FieldT scale = -equation[pivot].coeff.inverse();
+
+    terms_t substitution;
+    substitution.reserve(equation.size() - 1);
+    for (size_t i = 0; i < equation.size(); ++i)
+    {
+        if (i != pivot)
+        {
+            substitution.emplace_back(equation[i].index, equation[i].coeff * scale);
+        }
+    }
+
+    // the earlier substitutions stay free of eliminated variables
+    for (const var_index_t user : users[index])
+    {
+        terms_t &terms = substitutions[user];
+
+        typename terms_t::iterator it =
+            std::find_if(terms.begin(), terms.end(),
+                         [index](const linear_term<FieldT> &t) { return t.index == index; });
+        if (it == terms.end())
+        {
+            continue;
+        }
+
+        const FieldT coeff = it->coeff;
+        terms.erase(it);
+        for (const linear_term<FieldT> &t : substitution)
+        {
+            terms.emplace_back(t.index, coeff * t.coeff);
+            if (t.index)
+            {
+                users[t.index].emplace_back(user);
+            }
+        }
+        merge(terms);
+    }
+    users[index].clear();
+    users[index].shrink_to_fit();
+
+    for (const linear_term<FieldT> &t : substitution)
+    {
+        if (t.index)
+        {
+            users[t.index].emplace_back(index);
+        }
+    }
+
+    substitutions[index].swap(substitution);
+    substituted[index] = 1;
+}
+
+template<typename FieldT>
+bool r1cs_optimizer<FieldT>::is_constant(const linear_combination<FieldT> &lc, FieldT &value)
+{
+    value = FieldT::zero();
+    for (const linear_term<FieldT> &t : lc.terms)
+    {
+        if (t.index)
+        {
+            return false;
+        }
+        value += t.coeff;
+    }
+    return true;
+}
+
+template<typename FieldT>
+bool r1cs_optimizer<FieldT>::is_zero(const linear_combination<FieldT> &lc)
+{
+    // unchanged linear combinations may hold terms with a zero coefficient
+    bool all_zero = true;
+    for (const linear_term<FieldT> &t : lc.terms)
+    {
+        all_zero = all_zero && t.coeff.is_zero();
+    }
+
+    FieldT value;
+    return all_zero || (is_constant(lc, value) && value.is_zero());
+}
+
+template<typename FieldT>
+bool r1cs_optimizer<FieldT>::is_trivial(const r1cs_constraint<FieldT> &constraint)
+{
+    // 0 * B = 0 or A * 0 = 0
+    return (is_zero(constraint.a) || is_zero(constraint.b)) && is_zero(constraint.c);
+}
+
+template<typename FieldT>
+uint64_t r1cs_optimizer<FieldT>::hash(const r1cs_constraint<FieldT> &constraint)
+{
+    uint64_t h = 14695981039346656037ull;
+    const linear_combination<FieldT> *lcs[3] = { &constraint.a, &constraint.b, &constraint.c };
+
+    for (const linear_combination<FieldT> *lc : lcs)
+    {
+        h = (h ^ lc->terms.size()) * 1099511628211ull;
+        for (const linear_term<FieldT> &t : lc->terms)
+        {
+            h = (h ^ t.index) * 1099511628211ull;
+            h = (h ^ t.coeff.as_bigint().data[0]) * 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+template<typename FieldT>
+bool r1cs_optimizer<FieldT>::equal(const linear_combination<FieldT> &a, const linear_combination<FieldT> &b)
+{
+    if (a.terms.size() != b.terms.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.terms.size(); ++i)
+    {
+        if (a.terms[i].index != b.terms[i].index || a.terms[i].coeff != b.terms[i].coeff)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename FieldT>
+std::vector<uint32_t> r1cs_optimizer<FieldT>::optimize(r1cs_constraint_system<FieldT> &cs)
+{
+    const size_t num_variables = cs.num_variables();
+    const size_t num_constraints = cs.num_constraints();
+    const var_index_t first_auxiliary = cs.primary_input_size + 1;
+
+    kept.resize(num_variables + 1, 0);
+    substituted.assign(num_variables + 1, 0);
+    substitutions.assign(num_variables + 1, terms_t());
+    users.assign(num_variables + 1, std::vector<var_index_t>());
+    num_substituted = num_trivial = num_duplicates = num_unused = 0;
+
+    std::vector<size_t> occurrences(num_variables + 1, 0);
+    for (const r1cs_constraint<FieldT> &c : cs.constraints)
+    {
+        for (const linear_term<FieldT> &t : c.a.terms) { occurrences[t.index]++; }
+        for (const linear_term<FieldT> &t : c.b.terms) { occurrences[t.index]++; }
+        for (const linear_term<FieldT> &t : c.c.terms) { occurrences[t.index]++; }
+    }
+
+    std::vector<uint8_t> dropped(num_constraints, 0);
+
+    // eliminate the variables defined by linear equations , in constraint order
+    terms_t equation;
+    for (size_t k = 0; k < num_constraints; ++k)
+    {
+        const r1cs_constraint<FieldT> &c = cs.constraints[k];
+
+        FieldT value;
+        equation.clear();
+        if (is_constant(c.a, value))
+        {
+            for (const linear_term<FieldT> &t : c.b.terms) { equation.emplace_back(t.index, value * t.coeff); }
+        }
+        else if (is_constant(c.b, value))
+        {
+            for (const linear_term<FieldT> &t : c.a.terms) { equation.emplace_back(t.index, value * t.coeff); }
+        }
+        else
+        {
+            continue;
+        }
+        for (const linear_term<FieldT> &t : c.c.terms) { equation.emplace_back(t.index, -t.coeff); }
+
+        if (!substitute(equation))
+        {
+            merge(equation);
+        }
+
+        if (equation.empty())
+        {
+            dropped[k] = 1;
+            num_trivial++;
+            continue;
+        }
+
+        if (equation.size() - 1 > max_substitution_terms)
+        {
+            continue;
+        }
+
+        // the auxiliary variable used the least , so the substitution adds the fewest terms
+        size_t pivot = equation.size();
+        for (size_t i = 0; i < equation.size(); ++i)
+        {
+            const var_index_t index = equation[i].index;
+            if (index >= first_auxiliary && !kept[index] &&
+                (pivot == equation.size() || occurrences[index] < occurrences[equation[pivot].index]))
+            {
+                pivot = i;
+            }
+        }
+
+        if (pivot == equation.size())
+        {
+            continue;
+        }
+
+        const var_index_t index = equation[pivot].index;
+        if (occurrences[index] * (equation.size() - 1) > max_fill_in)
+        {
+            continue;
+        }
+
+        for (const linear_term<FieldT> &t : equation)
+        {
+            if (t.index != index)
+            {
+                occurrences[t.index] += occurrences[index];
+            }
+        }
+
+        eliminate(index, equation, pivot);
+        dropped[k] = 1;
+        num_substituted++;
+    }
+
+    // substitute into the other constraints
+    for (size_t k = 0; k < num_constraints; ++k)
+    {
+        if (dropped[k])
+        {
+            continue;
+        }
+
+        r1cs_constraint<FieldT> &c = cs.constraints[k];
+        substitute(c.a.terms);
+        substitute(c.b.terms);
+        substitute(c.c.terms);
+
+        if (is_trivial(c))
+        {
+            dropped[k] = 1;
+            num_trivial++;
+        }
+    }
+
+    substitutions.clear();
+    substitutions.shrink_to_fit();
+    users.clear();
+    users.shrink_to_fit();
+
+    // drop duplicates , the first copy is kept
+    {
+        std::vector<std::pair<uint64_t, size_t> > hashes;
+        hashes.reserve(num_constraints);
+        for (size_t k = 0; k < num_constraints; ++k)
+        {
+            if (!dropped[k])
+            {
+                hashes.emplace_back(hash(cs.constraints[k]), k);
+            }
+        }
+        std::sort(hashes.begin(), hashes.end());
+
+        for (size_t i = 0; i < hashes.size(); )
+        {
+            size_t j = i + 1;
+            while (j < hashes.size() && hashes[j].first == hashes[i].first)
+            {
+                ++j;
+            }
+
+            for (size_t x = i + 1; x < j; ++x)
+            {
+                const r1cs_constraint<FieldT> &cx = cs.constraints[hashes[x].second];
+                for (size_t y = i; y < x; ++y)
+                {
+                    if (dropped[hashes[y].second])
+                    {
+                        continue;
+                    }
+                    const r1cs_constraint<FieldT> &cy = cs.constraints[hashes[y].second];
+                    if (equal(cx.a, cy.a) && equal(cx.b, cy.b) && equal(cx.c, cy.c))
+                    {
+                        dropped[hashes[x].second] = 1;
+                        num_duplicates++;
+                        break;
+                    }
+                }
+            }
+            i = j;
+        }
+    }
+
+    // renumber the auxiliary variables still in use
+    std::vector<uint8_t> used(num_variables + 1, 0);
+    for (size_t k = 0; k < num_constraints; ++k)
+    {
+        if (dropped[k])
+        {
+            continue;
+        }
+        const r1cs_constraint<FieldT> &c = cs.constraints[k];
+        for (const linear_term<FieldT> &t : c.a.terms) { used[t.index] = 1; }
+        for (const linear_term<FieldT> &t : c.b.terms) { used[t.index] = 1; }
+        for (const linear_term<FieldT> &t : c.c.terms) { used[t.index] = 1; }
+    }
+
+    std::vector<uint32_t> variable_map(num_variables, removed);
+    uint32_t next = 0;
+    for (var_index_t index = 1; index <= num_variables; ++index)
+    {
+        if (index < first_auxiliary || (!substituted[index] && (used[index] || kept[index])))
+        {
+            variable_map[index-1] = next++;
+        }
+        else if (!substituted[index])
+        {
+            num_unused++;
+        }
+    }
+
+    std::vector<r1cs_constraint<FieldT> > constraints;
+    constraints.reserve(num_constraints - std::count(dropped.begin(), dropped.end(), 1));
+    for (size_t k = 0; k < num_constraints; ++k)
+    {
+        if (dropped[k])
+        {
+            continue;
+        }
+        r1cs_constraint<FieldT> &c = cs.constraints[k];
+        for (linear_term<FieldT> &t : c.a.terms) { if (t.index) { t.index = variable_map[t.index-1] + 1; } }
+        for (linear_term<FieldT> &t : c.b.terms) { if (t.index) { t.index = variable_map[t.index-1] + 1; } }
+        for (linear_term<FieldT> &t : c.c.terms) { if (t.index) { t.index = variable_map[t.index-1] + 1; } }
+        constraints.emplace_back(std::move(c));
+    }
+
+    cs.constraints.swap(constraints);
+    cs.auxiliary_input_size = next - cs.primary_input_size;
+#ifdef DEBUG
+    cs.constraint_annotations.clear();
+    cs.variable_annotations.clear();
+#endif
+
+    substituted.clear();
+    substituted.shrink_to_fit();
+
+    return variable_map;
+}
+
+template<typename FieldT>
+void r1cs_optimizer<FieldT>::project(const std::vector<uint32_t> &variable_map,
+                                     const std::vector<FieldT> &assignment,
+                                     std::vector<FieldT> &projected)
+{
+    size_t size = 0;
+    for (const uint32_t index : variable_map)
+    {
+        if (index != removed)
+        {
+            size = std::max<size_t>(size, index + 1);
+        }
+    }
+
+    projected.assign(size, FieldT::zero());
+    for (size_t i = 0; i < variable_map.size() && i < assignment.size(); ++i)
+    {
+        if (variable_map[i] != removed)
+        {
+            projected[variable_map[i]] = assignment[i];
+        }
+    }
+}
+
+} // libsnark
+
+#endif // R1CS_OPTIMIZER_TCC_
@@ -0,0 +1,99 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for a flattened (CSR) copy of the A, B and C
+ matrices of a R1CS constraint system.
+
+ The linear combinations of a r1cs_constraint_system are stored one vector
+ per constraint, which scatters the terms over the heap. Evaluating them for
+ every proof is therefore both serial and cache-unfriendly. The class below
+ stores each matrix in compressed sparse row (CSR) form, i.e., row i of A is
+ the run of terms [row_offsets[i], row_offsets[i+1]) of the arrays
+ (indices, coeffs), and evaluates all rows of a matrix in parallel, one
+ block of consecutive rows at a time.
+
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef R1CS_SPARSE_MATRICES_HPP_
+#define R1CS_SPARSE_MATRICES_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs.hpp>
+
+namespace libsnark {
+
+/**
+ * One of the matrices A, B, C of a R1CS constraint system, in CSR form.
+ */
+template<typename FieldT>
+class r1cs_sparse_matrix {
+public:
+    std::vector<size_t> row_offsets;
+    std::vector<var_index_t> indices;
+    std::vector<FieldT> coeffs;
+    std::vector<uint8_t> unit_coeffs; // 1 if coeffs[k] == 1 , the multiplication is skipped
+
+    size_t num_rows() const { return row_offsets.empty() ? 0 : row_offsets.size() - 1; }
+    size_t num_terms() const { return indices.size(); }
+
+    void reserve(const size_t num_rows, const size_t num_terms);
+    void append_row(const linear_combination<FieldT> &lc);
+
+    /**
+     * out[i] = < row i , (1, assignment) > , for i in [row_begin, row_end) .
+     */
+    void evaluate_rows(const size_t row_begin,
+                       const size_t row_end,
+                       const std::vector<FieldT> &assignment,
+                       std::vector<FieldT> &out) const;
+};
+
+/**
+ * The matrices A, B, C of a R1CS constraint system, in CSR form.
+ */
+template<typename FieldT>
+class r1cs_sparse_matrices {
+public:
+    /* number of consecutive rows evaluated by one thread at a time */
+    static const size_t block_size = 256;
+
+    size_t num_constraints;
+    size_t num_inputs;
+    size_t num_variables;
+
+    r1cs_sparse_matrix<FieldT> A, B, C;
+
+    r1cs_sparse_matrices() : num_constraints(0), num_inputs(0), num_variables(0) {};
+    r1cs_sparse_matrices(const r1cs_constraint_system<FieldT> &cs);
+
+    /**
+     * Evaluate all rows of A and of B on (1, assignment) , in parallel
+     * on num_threads threads (0 for the default team).
+     * aA and aB must have at least num_constraints entries.
+     */
+    void evaluate_AB(const std::vector<FieldT> &assignment,
+                     std::vector<FieldT> &aA,
+                     std::vector<FieldT> &aB,
+                     const size_t num_threads = 0) const;
+
+    /**
+     * Evaluate all rows of C on (1, assignment) , in parallel
+     * on num_threads threads (0 for the default team).
+     * aC must have at least num_constraints entries.
+     */
+    void evaluate_C(const std::vector<FieldT> &assignment,
+                    std::vector<FieldT> &aC,
+                    const size_t num_threads = 0) const;
+};
+
+} // libsnark
+
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs_sparse_matrices.tcc>
+
+#endif // R1CS_SPARSE_MATRICES_HPP_
@@ -0,0 +1,149 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for a flattened (CSR) copy of the A, B and C
+ matrices of a R1CS constraint system.
+
+ See r1cs_sparse_matrices.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef R1CS_SPARSE_MATRICES_TCC_
+#define R1CS_SPARSE_MATRICES_TCC_
+
+#include <algorithm>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <libfqfft/evaluation_domain/evaluation_domain.hpp>
+
+namespace libsnark {
+
+template<typename FieldT>
+void r1cs_sparse_matrix<FieldT>::reserve(const size_t num_rows, const size_t num_terms)
+{
+    row_offsets.reserve(num_rows + 1);
+    indices.reserve(num_terms);
+    coeffs.reserve(num_terms);
+    unit_coeffs.reserve(num_terms);
+}
+
+template<typename FieldT>
+void r1cs_sparse_matrix<FieldT>::append_row(const linear_combination<FieldT> &lc)
+{
+    if (row_offsets.empty())
+    {
+        row_offsets.emplace_back(0);
+    }
+
+    const FieldT one = FieldT::one();
+    for (const linear_term<FieldT> &lt : lc.terms)
+    {
+        indices.emplace_back(lt.index);
+        coeffs.emplace_back(lt.coeff);
+        unit_coeffs.emplace_back(lt.coeff == one ? 1 : 0);
+    }
+    row_offsets.emplace_back(indices.size());
+}
+
+template<typename FieldT>
+void r1cs_sparse_matrix<FieldT>::evaluate_rows(const size_t row_begin,
+                                               const size_t row_end,
+                                               const std::vector<FieldT> &assignment,
+                                               std::vector<FieldT> &out) const
+{
+    const FieldT one = FieldT::one();
+
+    for (size_t i = row_begin; i < row_end; ++i)
+    {
+        FieldT acc = FieldT::zero();
+        for (size_t k = row_offsets[i]; k < row_offsets[i+1]; ++k)
+        {
+            const var_index_t idx = indices[k];
+            const FieldT &x = (idx == 0 ? one : assignment[idx-1]);
+            if (unit_coeffs[k])
+            {
+                acc += x;
+            }
+            else
+            {
+                acc += x * coeffs[k];
+            }
+        }
+        out[i] = acc;
+    }
+}
+
+template<typename FieldT>
+r1cs_sparse_matrices<FieldT>::r1cs_sparse_matrices(const r1cs_constraint_system<FieldT> &cs) :
+    num_constraints(cs.num_constraints()),
+    num_inputs(cs.num_inputs()),
+    num_variables(cs.num_variables())
+{
+    size_t num_terms_A = 0, num_terms_B = 0, num_terms_C = 0;
+    for (const r1cs_constraint<FieldT> &c : cs.constraints)
+    {
+        num_terms_A += c.a.terms.size();
+        num_terms_B += c.b.terms.size();
+        num_terms_C += c.c.terms.size();
+    }
+
+    A.reserve(num_constraints, num_terms_A);
+    B.reserve(num_constraints, num_terms_B);
+    C.reserve(num_constraints, num_terms_C);
+
+    for (const r1cs_constraint<FieldT> &c : cs.constraints)
+    {
+        A.append_row(c.a);
+        B.append_row(c.b);
+        C.append_row(c.c);
+    }
+}
+
+template<typename FieldT>
+void r1cs_sparse_matrices<FieldT>::evaluate_AB(const std::vector<FieldT> &assignment,
+                                               std::vector<FieldT> &aA,
+                                               std::vector<FieldT> &aB,
+                                               const size_t num_threads) const
+{
+    const size_t num_blocks = (num_constraints + block_size - 1) / block_size;
+
+#ifdef MULTICORE
+#pragma omp parallel for schedule(dynamic) num_threads(libfqfft::_team_size(num_threads))
+#endif
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        const size_t row_begin = b * block_size;
+        const size_t row_end = std::min(row_begin + block_size, num_constraints);
+        A.evaluate_rows(row_begin, row_end, assignment, aA);
+        B.evaluate_rows(row_begin, row_end, assignment, aB);
+    }
+}
+
+template<typename FieldT>
+void r1cs_sparse_matrices<FieldT>::evaluate_C(const std::vector<FieldT> &assignment,
+                                              std::vector<FieldT> &aC,
+                                              const size_t num_threads) const
+{
+    const size_t num_blocks = (num_constraints + block_size - 1) / block_size;
+
+#ifdef MULTICORE
+#pragma omp parallel for schedule(dynamic) num_threads(libfqfft::_team_size(num_threads))
+#endif
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        const size_t row_begin = b * block_size;
+        const size_t row_end = std::min(row_begin + block_size, num_constraints);
+        C.evaluate_rows(row_begin, row_end, assignment, aC);
+    }
+}
+
+} // libsnark
+
+#endif // R1CS_SPARSE_MATRICES_TCC_
@@ -0,0 +1,95 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs_optimizer.hpp>
+
+using namespace libsnark;
+
+template<typename FieldT>
+void test_r1cs_optimizer()
+{
+    /*
+      Variables (r1cs index) : x = 1 , y = 2 are primary inputs ,
+      a = 3 , b = 4 , p = 5 , s1 = 6 , s2 = 7 , q = 8 , k = 9 , u = 10 are auxiliary.
+      s1 and s2 form a chain of linear constraints , a * b = p is stated twice ,
+      x * 0 = 0 is trivial , k is kept and u is in no constraint.
+    */
+    const variable<FieldT> x(1), y(2), a(3), b(4), p(5), s1(6), s2(7), q(8), k(9);
+    const linear_combination<FieldT> one(FieldT::one()), zero;
+
+    r1cs_constraint_system<FieldT> cs;
+    cs.primary_input_size = 2;
+    cs.auxiliary_input_size = 8;
+
+    cs.add_constraint(r1cs_constraint<FieldT>(x, y, b));
+    cs.add_constraint(r1cs_constraint<FieldT>(a, b, p));
+    cs.add_constraint(r1cs_constraint<FieldT>(one, x + p, s1));
+    cs.add_constraint(r1cs_constraint<FieldT>(one, s1 + FieldT(2) * a, s2));
+    cs.add_constraint(r1cs_constraint<FieldT>(s2, s2, q));
+    cs.add_constraint(r1cs_constraint<FieldT>(a, b, p));
+    cs.add_constraint(r1cs_constraint<FieldT>(y + a, one, k));
+    cs.add_constraint(r1cs_constraint<FieldT>(x, zero, zero));
+
+    const FieldT vx(3), vy(5), va(7), vb = vx * vy, vp = va * vb,
+        vs1 = vx + vp, vs2 = vs1 + va + va, vq = vs2 * vs2, vk = vy + va;
+
+    const r1cs_primary_input<FieldT> primary_input = { vx, vy };
+    const r1cs_auxiliary_input<FieldT> auxiliary_input = { va, vb, vp, vs1, vs2, vq, vk, FieldT::random_element() };
+
+    assert(cs.is_satisfied(primary_input, auxiliary_input));
+
+    const size_t num_constraints = cs.num_constraints();
+    const size_t num_variables = cs.num_variables();
+
+    r1cs_optimizer<FieldT> optimizer;
+    optimizer.keep(k.index - 1);
+    const std::vector<uint32_t> variable_map = optimizer.optimize(cs);
+
+    printf("* Constraints: %zu -> %zu\n", num_constraints, cs.num_constraints());
+    printf("* Variables: %zu -> %zu\n", num_variables, cs.num_variables());
+
+    assert(variable_map.size() == num_variables);
+    assert(variable_map[x.index - 1] == x.index - 1);
+    assert(variable_map[y.index - 1] == y.index - 1);
+    assert(variable_map[k.index - 1] != r1cs_optimizer<FieldT>::removed);
+    assert(cs.num_inputs() == 2);
+    assert(cs.num_constraints() < num_constraints);
+    assert(cs.num_variables() < num_variables);
+    assert(optimizer.num_substituted >= 2);
+    assert(optimizer.num_duplicates >= 1);
+    assert(optimizer.num_trivial >= 1);
+    assert(optimizer.num_unused >= 1);
+
+    r1cs_variable_assignment<FieldT> full_assignment = primary_input;
+    full_assignment.insert(full_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+    r1cs_variable_assignment<FieldT> projected;
+    r1cs_optimizer<FieldT>::project(variable_map, full_assignment, projected);
+    assert(projected.size() == cs.num_variables());
+
+    const r1cs_primary_input<FieldT> projected_primary(projected.begin(), projected.begin() + cs.num_inputs());
+    r1cs_auxiliary_input<FieldT> projected_auxiliary(projected.begin() + cs.num_inputs(), projected.end());
+
+    assert(cs.is_satisfied(projected_primary, projected_auxiliary));
+
+    projected_auxiliary[variable_map[k.index - 1] - cs.num_inputs()] += FieldT::one();
+    assert(!cs.is_satisfied(projected_primary, projected_auxiliary));
+
+    printf("* Optimized system satisfied , tampered witness rejected\n");
+}
+
+int main()
+{
+    libff::alt_bn128_pp::init_public_params();
+
+    test_r1cs_optimizer<libff::Fr<libff::alt_bn128_pp> >();
+}
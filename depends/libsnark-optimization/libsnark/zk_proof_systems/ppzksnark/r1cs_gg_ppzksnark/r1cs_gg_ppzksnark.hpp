@@ -10,6 +10,7 @@ This includes:
 - class for processed verification key
 - class for key pair (proving key & verification key)
 - class for proof
+- class for prepared prover
 - generator algorithm
 - prover algorithm
 - verifier algorithm (with strong or weak input consistency)
@@ -49,11 +50,14 @@ References:
 #include <memory>
 
 #include <libff/algebra/curves/public_params.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libfqfft/evaluation_domain/evaluation_domain.hpp>
 
 #include <libsnark/common/data_structures/accumulation_vector.hpp>
 #include <libsnark/common/default_types/r1cs_keypair.hpp>
 #include <libsnark/knowledge_commitment/knowledge_commitment.hpp>
 #include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs.hpp>
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs_sparse_matrices.hpp>
 #include <libsnark/zk_proof_systems/ppzksnark/r1cs_gg_ppzksnark/r1cs_gg_ppzksnark_params.hpp>
 
 namespace libsnark {
@@ -69,6 +73,20 @@ std::ostream& operator<<(std::ostream &out, const r1cs_gg_ppzksnark_proving_key<
 template<typename ppT>
 std::istream& operator>>(std::istream &in, r1cs_gg_ppzksnark_proving_key<ppT> &pk);
 
+/**
+ * The basis of the H-query of a proving key, for a QAP domain S of size m.
+ *
+ * - monomial: H_query[i] = t^i Z(t)/delta, for i < m-1, taken with the coefficients of H.
+ * - coset_lagrange: H_query[j] = L_j(t/g) Z(t)/delta, for j < m, where L_j are the
+ *   Lagrange polynomials of S and g = Fr::multiplicative_generator. Since H has degree
+ *   at most m-2, H(t) = sum_j H(g sigma_j) L_j(t/g), so the key is taken with the
+ *   evaluations of H on the coset g S, and the prover skips the inverse coset FFT.
+ */
+enum r1cs_gg_ppzksnark_H_query_basis {
+    r1cs_gg_ppzksnark_H_query_monomial = 0,
+    r1cs_gg_ppzksnark_H_query_coset_lagrange = 1
+};
+
 /**
  * A proving key for the R1CS GG-ppzkSNARK.
  */
@@ -86,6 +104,8 @@ public:
     libff::G1_vector<ppT> H_query;
     libff::G1_vector<ppT> L_query;
 
+    r1cs_gg_ppzksnark_H_query_basis H_query_basis = r1cs_gg_ppzksnark_H_query_monomial;
+
     // r1cs_gg_ppzksnark_constraint_system<ppT> constraint_system;
 
     r1cs_gg_ppzksnark_proving_key() {};
@@ -115,6 +135,12 @@ public:
         // constraint_system(std::move(constraint_system))
     {};
 
+    /* the size of H_query in its basis, for a QAP domain of size domain_size */
+    size_t H_query_size(const size_t domain_size) const
+    {
+        return (H_query_basis == r1cs_gg_ppzksnark_H_query_coset_lagrange ? domain_size : domain_size - 1);
+    }
+
     size_t G1_size() const
     {
         // 1 (alpha_g1) + 1 (beta_g1) + 1 (delta_g1) + A_query + B_query + H_query + L_query
@@ -261,8 +287,7 @@ std::istream& operator>>(std::istream &in, r1cs_gg_ppzksnark_processed_verificat
 template<typename ppT>
 class r1cs_gg_ppzksnark_processed_verification_key {
 public:
-    libff::G1_precomp<ppT> vk_alpha_g1_precomp;
-    libff::G2_precomp<ppT> vk_beta_g2_precomp;
+    libff::GT<ppT> vk_alpha_g1_beta_g2;
     libff::G2_precomp<ppT> vk_generator_g2_precomp;
     libff::G2_precomp<ppT> vk_delta_g2_precomp;
 
@@ -398,6 +423,116 @@ public:
 };
 
 
+/****************************** Prepared prover ******************************/
+
+/**
+ * Fixed-base tables of the queries of a proving key (see libff::multi_exp_base_table).
+ *
+ * The A, B, H and L queries do not change after the setup, so a long-lived prover
+ * can keep multiples of their points, and do each of its multi-exponentiations with
+ * larger windows, fewer bucket reductions and fewer doublings. All the tables have
+ * the same stride, the smallest one (at most max_stride) whose tables fit in the
+ * memory budget; if there is none, no table is built.
+ * The tables of the B-query are indexed by position in B_query.values .
+ */
+template<typename ppT>
+class r1cs_gg_ppzksnark_proving_key_tables {
+public:
+    static const size_t max_stride = 8;
+
+    libff::multi_exp_base_table<libff::G1<ppT> > A_query;
+    libff::multi_exp_base_table<libff::G2<ppT> > B_query_g2;
+    libff::multi_exp_base_table<libff::G1<ppT> > B_query_g1;
+    libff::multi_exp_base_table<libff::G1<ppT> > H_query;
+    libff::multi_exp_base_table<libff::G1<ppT> > L_query;
+
+    r1cs_gg_ppzksnark_proving_key_tables() {};
+
+    /* tables of pk, sized for proofs on num_threads threads */
+    r1cs_gg_ppzksnark_proving_key_tables(const r1cs_gg_ppzksnark_proving_key<ppT> &pk,
+                                         const size_t memory_budget,
+                                         const size_t num_threads,
+                                         libff::profiling & profile);
+
+    bool empty() const
+    {
+        return A_query.empty() && B_query_g2.empty() && B_query_g1.empty() && H_query.empty() && L_query.empty();
+    }
+
+    size_t size_in_bytes() const
+    {
+        return A_query.size_in_bytes() + B_query_g2.size_in_bytes() + B_query_g1.size_in_bytes() +
+               H_query.size_in_bytes() + L_query.size_in_bytes();
+    }
+};
+
+/**
+ * Per-circuit state of the prover for the R1CS GG-ppzkSNARK.
+ *
+ * The prover works on the constraint system with A and B swapped (if beneficial)
+ * and on the QAP evaluation domain of that system. Neither depends on the witness,
+ * so a prepared prover computes both once (the domain together with its twiddle
+ * and coset tables, the constraint system in flattened CSR form), and every
+ * subsequent proof only does per-witness work.
+ * The swapped constraint system itself is only kept in DEBUG builds, for their checks.
+ * With tables (not owned), the multi-exponentiations of the queries use them.
+ */
+template<typename ppT>
+class r1cs_gg_ppzksnark_prepared_prover {
+public:
+#ifdef DEBUG
+    r1cs_gg_ppzksnark_constraint_system<ppT> constraint_system;
+#endif
+    r1cs_sparse_matrices<libff::Fr<ppT> > matrices;
+    std::shared_ptr<libfqfft::evaluation_domain<libff::Fr<ppT> > > domain;
+    const r1cs_gg_ppzksnark_proving_key_tables<ppT> *tables;
+
+    r1cs_gg_ppzksnark_prepared_prover(const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs,
+                                      libff::profiling & profile);
+};
+
+/**
+ * How the prover for the R1CS GG-ppzkSNARK spreads one proof over num_threads threads.
+ *
+ * The multi-exponentiations for the A-query, the B-query (G1 and G2 parts) and the
+ * L-query only depend on the assignment, so they run as tasks while the polynomial H
+ * is computed, and only the H-query multi-exponentiation has to wait for H.
+ *
+ * Each of the four multi-exponentiations is cut into a number of pieces proportional
+ * to its estimated cost, where an addition in G2 counts as G2_cost additions in G1.
+ * Idle threads take the next piece of whichever multi-exponentiation has work left,
+ * so the G2 part of the B-query gets a proportionally larger share of the cores.
+ * H is computed on a separate thread, by its own teams of H_threads threads, sized
+ * to finish together with the tasks.
+ */
+template<typename ppT>
+class r1cs_gg_ppzksnark_prover_schedule {
+public:
+    /* relative cost of an addition in G2, and of a multiplication in Fr, to an addition in G1 */
+    static constexpr double G2_cost = 3.0;
+    static constexpr double Fr_mul_cost = 1.0 / 6;
+    /* pieces per thread, and minimal number of points per piece */
+    static const size_t pieces_per_thread = 4;
+    static const size_t min_piece_size = 1024;
+
+    size_t num_threads;
+    size_t H_threads;
+
+    size_t A_pieces;
+    size_t B_g1_pieces;
+    size_t B_g2_pieces;
+    size_t L_pieces;
+
+    r1cs_gg_ppzksnark_prover_schedule(const size_t num_threads,
+                                      const size_t num_variables,
+                                      const size_t num_inputs,
+                                      const size_t domain_size);
+
+    /* estimated cost of a multi-exponentiation of length points, in G1 additions */
+    static double multi_exp_cost(const size_t length);
+};
+
+
 /***************************** Main algorithms *******************************/
 
 /**
@@ -406,7 +541,10 @@ public:
  * Given a R1CS constraint system CS, this algorithm produces proving and verification keys for CS.
  */
 template<typename ppT>
-int r1cs_gg_ppzksnark_generator(const r1cs_gg_ppzksnark_constraint_system<ppT> &cs, r1cs_gg_ppzksnark_keypair<ppT> & keypair );
+int r1cs_gg_ppzksnark_generator(const r1cs_gg_ppzksnark_constraint_system<ppT> &cs,
+                                r1cs_gg_ppzksnark_keypair<ppT> & keypair,
+                                libff::profiling & profile,
+                                const r1cs_gg_ppzksnark_H_query_basis H_query_basis = r1cs_gg_ppzksnark_H_query_monomial);
 
 /**
  * A prover algorithm for the R1CS GG-ppzkSNARK.
@@ -423,6 +561,20 @@ int r1cs_gg_ppzksnark_prover(const r1cs_gg_ppzksnark_constraint_system<ppT> &r1c
                              const r1cs_gg_ppzksnark_auxiliary_input<ppT> &auxiliary_input,
                              r1cs_gg_ppzksnark_proof<ppT> &proof );
 
+/**
+ * Same as above, but for a prepared prover of CS (see r1cs_gg_ppzksnark_prepared_prover).
+ *
+ * Both return 1, with no proof, when the H-query of pk does not have the size its basis
+ * requires on the domain of CS, i.e., when pk is of another circuit or its basis tag is wrong.
+ */
+template<typename ppT>
+int r1cs_gg_ppzksnark_prover(const r1cs_gg_ppzksnark_prepared_prover<ppT> &prepared,
+                             const r1cs_gg_ppzksnark_proving_key<ppT> &pk,
+                             const r1cs_gg_ppzksnark_primary_input<ppT> &primary_input,
+                             const r1cs_gg_ppzksnark_auxiliary_input<ppT> &auxiliary_input,
+                             r1cs_gg_ppzksnark_proof<ppT> &proof,
+                             libff::profiling & profile );
+
 
 /*
   Below are four variants of verifier algorithm for the R1CS GG-ppzkSNARK.
@@ -484,6 +636,26 @@ bool r1cs_gg_ppzksnark_online_verifier_strong_IC(const r1cs_gg_ppzksnark_process
                                                  const r1cs_gg_ppzksnark_primary_input<ppT> &primary_input,
                                                  const r1cs_gg_ppzksnark_proof<ppT> &proof);
 
+/**
+ * A batch verifier algorithm for the R1CS GG-ppzkSNARK that:
+ * (1) accepts a processed verification key,
+ * (2) has strong input consistency, and
+ * (3) checks all the proofs with one multi-Miller loop and one final exponentiation.
+ *
+ * The verification equations are combined with random 128-bit scalars r_i:
+ *   prod_i e(r_i A_i, B_i) = e(alpha, beta)^{sum_i r_i} * e(sum_i r_i acc_i, g2) * e(sum_i r_i C_i, delta)
+ * where the inputs of all the proofs are accumulated by a single multi-exponentiation.
+ * When the combined check fails, the batch is bisected to find the invalid proofs.
+ *
+ * Sets results[i] for each proof and returns true if all of them are valid.
+ */
+template<typename ppT>
+bool r1cs_gg_ppzksnark_online_batch_verifier_strong_IC(const r1cs_gg_ppzksnark_processed_verification_key<ppT> &pvk,
+                                                       const std::vector<r1cs_gg_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                                       const std::vector<r1cs_gg_ppzksnark_proof<ppT> > &proofs,
+                                                       std::vector<bool> &results,
+                                                       libff::profiling & profile);
+
 /****************************** Miscellaneous ********************************/
 
 /**
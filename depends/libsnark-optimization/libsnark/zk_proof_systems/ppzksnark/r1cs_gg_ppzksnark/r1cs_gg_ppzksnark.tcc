@@ -16,9 +16,13 @@ See r1cs_gg_ppzksnark.hpp .
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <exception>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/common/profiling.hpp>
@@ -30,6 +34,7 @@ See r1cs_gg_ppzksnark.hpp .
 
 #include <libsnark/knowledge_commitment/kc_multiexp.hpp>
 #include <libsnark/reductions/r1cs_to_qap/r1cs_to_qap.hpp>
+#include <libfqfft/evaluation_domain/get_evaluation_domain.hpp>
 
 namespace libsnark {
 
@@ -44,14 +49,23 @@ bool r1cs_gg_ppzksnark_proving_key<ppT>::operator==(const r1cs_gg_ppzksnark_prov
             this->A_query == other.A_query &&
             this->B_query == other.B_query &&
             this->H_query == other.H_query &&
-            this->L_query == other.L_query //&&
+            this->L_query == other.L_query &&
+            this->H_query_basis == other.H_query_basis //&&
             // this->constraint_system == other.constraint_system
             );
 }
 
+/* opens a proving key whose H-query is not in the monomial basis, followed by the basis as one digit */
+static const std::string r1cs_gg_ppzksnark_H_query_basis_tag = "H_query_basis=";
+
 template<typename ppT>
 std::ostream& operator<<(std::ostream &out, const r1cs_gg_ppzksnark_proving_key<ppT> &pk)
 {
+    /* keys in the monomial basis have no tag, as the ones written before the tag */
+    if (pk.H_query_basis != r1cs_gg_ppzksnark_H_query_monomial)
+    {
+        out << r1cs_gg_ppzksnark_H_query_basis_tag << static_cast<char>('0' + pk.H_query_basis) << OUTPUT_NEWLINE;
+    }
     out << pk.alpha_g1 << OUTPUT_NEWLINE;
     out << pk.beta_g1 << OUTPUT_NEWLINE;
     out << pk.beta_g2 << OUTPUT_NEWLINE;
@@ -69,6 +83,23 @@ std::ostream& operator<<(std::ostream &out, const r1cs_gg_ppzksnark_proving_key<
 template<typename ppT>
 std::istream& operator>>(std::istream &in, r1cs_gg_ppzksnark_proving_key<ppT> &pk)
 {
+    /* a point starts with its is_zero digit, so a key starting with anything else has a tag */
+    pk.H_query_basis = r1cs_gg_ppzksnark_H_query_monomial;
+    if (in.peek() == r1cs_gg_ppzksnark_H_query_basis_tag[0])
+    {
+        std::string tag(r1cs_gg_ppzksnark_H_query_basis_tag.size(), '\0');
+        char basis = 0;
+        in.read(&tag[0], tag.size());
+        in.read(&basis, 1);
+        if (tag != r1cs_gg_ppzksnark_H_query_basis_tag ||
+            (basis - '0' != r1cs_gg_ppzksnark_H_query_monomial && basis - '0' != r1cs_gg_ppzksnark_H_query_coset_lagrange))
+        {
+            in.setstate(std::ios::failbit);
+            return in;
+        }
+        pk.H_query_basis = static_cast<r1cs_gg_ppzksnark_H_query_basis>(basis - '0');
+        libff::consume_OUTPUT_NEWLINE(in);
+    }
     in >> pk.alpha_g1;
     libff::consume_OUTPUT_NEWLINE(in);
     in >> pk.beta_g1;
@@ -129,8 +160,7 @@ std::istream& operator>>(std::istream &in, r1cs_gg_ppzksnark_verification_key<pp
 template<typename ppT>
 bool r1cs_gg_ppzksnark_processed_verification_key<ppT>::operator==(const r1cs_gg_ppzksnark_processed_verification_key<ppT> &other) const
 {
-    return (this->vk_alpha_g1_precomp == other.vk_alpha_g1_precomp &&
-            this->vk_beta_g2_precomp == other.vk_beta_g2_precomp &&
+    return (this->vk_alpha_g1_beta_g2 == other.vk_alpha_g1_beta_g2 &&
             this->vk_generator_g2_precomp == other.vk_generator_g2_precomp &&
             this->vk_delta_g2_precomp == other.vk_delta_g2_precomp &&
             this->ABC_g1 == other.ABC_g1);
@@ -139,8 +169,7 @@ bool r1cs_gg_ppzksnark_processed_verification_key<ppT>::operator==(const r1cs_gg
 template<typename ppT>
 std::ostream& operator<<(std::ostream &out, const r1cs_gg_ppzksnark_processed_verification_key<ppT> &pvk)
 {
-    out << pvk.vk_alpha_g1_precomp << OUTPUT_NEWLINE;
-    out << pvk.vk_beta_g2_precomp << OUTPUT_NEWLINE;
+    out << pvk.vk_alpha_g1_beta_g2 << OUTPUT_NEWLINE;
     out << pvk.vk_generator_g2_precomp << OUTPUT_NEWLINE;
     out << pvk.vk_delta_g2_precomp << OUTPUT_NEWLINE;
     out << pvk.ABC_g1 << OUTPUT_NEWLINE;
@@ -151,9 +180,7 @@ std::ostream& operator<<(std::ostream &out, const r1cs_gg_ppzksnark_processed_ve
 template<typename ppT>
 std::istream& operator>>(std::istream &in, r1cs_gg_ppzksnark_processed_verification_key<ppT> &pvk)
 {
-    in >> pvk.vk_alpha_g1_precomp;
-    libff::consume_OUTPUT_NEWLINE(in);
-    in >> pvk.vk_beta_g2_precomp;
+    in >> pvk.vk_alpha_g1_beta_g2;
     libff::consume_OUTPUT_NEWLINE(in);
     in >> pvk.vk_generator_g2_precomp;
     libff::consume_OUTPUT_NEWLINE(in);
@@ -229,7 +256,8 @@ int r1cs_gg_ppzksnark_generator_from_secrets(
     const libff::Fr<ppT> &delta,
     const libff::G1<ppT> &g1_generator,
     const libff::G2<ppT> &g2_generator,
-    libff::profiling & profile )
+    libff::profiling & profile,
+    const r1cs_gg_ppzksnark_H_query_basis H_query_basis = r1cs_gg_ppzksnark_H_query_monomial )
 {
     profile.enter_block("Call to r1cs_gg_ppzksnark_generator_from_secrets");
 
@@ -293,12 +321,22 @@ int r1cs_gg_ppzksnark_generator_from_secrets(
     }
     profile.leave_block("Compute L query for R1CS proving key");
 
-    /**
-     * Note that H for Groth's proof system is degree d-2, but the QAP
-     * reduction returns coefficients for degree d polynomial H (in
-     * style of PGHR-type proof systems)
-     */
-    Ht.resize(Ht.size() - 2);
+    if (H_query_basis == r1cs_gg_ppzksnark_H_query_coset_lagrange)
+    {
+        /* L_j(t/g) for the Lagrange polynomials L_j of the domain (see r1cs_gg_ppzksnark_H_query_basis) */
+        profile.enter_block("Compute Lagrange polynomials of the coset at t");
+        Ht = qap.domain->evaluate_all_lagrange_polynomials(t * libff::Fr<ppT>::multiplicative_generator.inverse());
+        profile.leave_block("Compute Lagrange polynomials of the coset at t");
+    }
+    else
+    {
+        /**
+         * Note that H for Groth's proof system is degree d-2, but the QAP
+         * reduction returns coefficients for degree d polynomial H (in
+         * style of PGHR-type proof systems)
+         */
+        Ht.resize(Ht.size() - 2);
+    }
 
 #ifdef MULTICORE
     const size_t chunks = omp_get_max_threads(); // to override, set OMP_NUM_THREADS env var or call omp_set_num_threads()
@@ -325,11 +363,11 @@ int r1cs_gg_ppzksnark_generator_from_secrets(
     profile.leave_block("Generating G2 MSM window table");
 
     profile.enter_block("Generate R1CS proving key");
-    libff::G1<ppT> alpha_g1 = alpha * g1_generator;
-    libff::G1<ppT> beta_g1 = beta * g1_generator;
-    libff::G2<ppT> beta_g2 = beta * g2_generator;
-    libff::G1<ppT> delta_g1 = delta * g1_generator;
-    libff::G2<ppT> delta_g2 = delta * g2_generator;
+    libff::G1<ppT> alpha_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, alpha);
+    libff::G1<ppT> beta_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, beta);
+    libff::G2<ppT> beta_g2 = libff::field_scalar_mul<libff::G2<ppT> >(g2_generator, beta);
+    libff::G1<ppT> delta_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, delta);
+    libff::G2<ppT> delta_g2 = libff::field_scalar_mul<libff::G2<ppT> >(g2_generator, delta);
 
     profile.enter_block("Generate queries");
     profile.enter_block("Compute the A-query", false);
@@ -388,6 +426,7 @@ int r1cs_gg_ppzksnark_generator_from_secrets(
     keypair.pk.B_query = B_query ;
     keypair.pk.H_query = H_query ;
     keypair.pk.L_query = L_query ;
+    keypair.pk.H_query_basis = H_query_basis ;
     // keypair.pk.constraint_system = r1cs_copy ;
 
     keypair.pk.print_size();
@@ -397,7 +436,10 @@ int r1cs_gg_ppzksnark_generator_from_secrets(
 }
 
 template <typename ppT>
-int r1cs_gg_ppzksnark_generator(const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs, r1cs_gg_ppzksnark_keypair<ppT> & keypair , libff::profiling & profile ) 
+int r1cs_gg_ppzksnark_generator(const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs,
+                                r1cs_gg_ppzksnark_keypair<ppT> & keypair ,
+                                libff::profiling & profile ,
+                                const r1cs_gg_ppzksnark_H_query_basis H_query_basis ) 
 {
     profile.enter_block("Call to r1cs_gg_ppzksnark_generator");
 
@@ -410,13 +452,193 @@ int r1cs_gg_ppzksnark_generator(const r1cs_gg_ppzksnark_constraint_system<ppT> &
     const libff::G2<ppT> g2_generator = libff::G2<ppT>::one();
 
     r1cs_gg_ppzksnark_generator_from_secrets<ppT>(
-        keypair, r1cs, t, alpha, beta, delta, g1_generator, g2_generator,profile);
+        keypair, r1cs, t, alpha, beta, delta, g1_generator, g2_generator, profile, H_query_basis);
 
     profile.leave_block("Call to r1cs_gg_ppzksnark_generator");
 
     return 0 ;
 }
 
+template <typename ppT>
+r1cs_gg_ppzksnark_prepared_prover<ppT>::r1cs_gg_ppzksnark_prepared_prover(const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs,
+                                                                          libff::profiling & profile) :
+#ifdef DEBUG
+    constraint_system(r1cs),
+#endif
+    tables(nullptr)
+{
+    profile.enter_block("Call to r1cs_gg_ppzksnark_prepared_prover");
+
+    /* the swapped system is only kept for the checks of DEBUG builds, the prover needs just its CSR form */
+#ifdef DEBUG
+    r1cs_gg_ppzksnark_constraint_system<ppT> &swapped = constraint_system;
+#else
+    r1cs_gg_ppzksnark_constraint_system<ppT> swapped(r1cs);
+#endif
+
+    profile.enter_block("swap_AB_if_beneficial");
+    swapped.swap_AB_if_beneficial(profile);
+    profile.leave_block("swap_AB_if_beneficial");
+
+    profile.enter_block("Flatten constraint matrices");
+    matrices = r1cs_sparse_matrices<libff::Fr<ppT> >(swapped);
+    profile.leave_block("Flatten constraint matrices");
+
+    profile.enter_block("Prepare evaluation domain");
+    domain = libfqfft::get_evaluation_domain<libff::Fr<ppT> >(matrices.num_constraints + matrices.num_inputs + 1);
+    domain->precompute();
+    profile.leave_block("Prepare evaluation domain");
+
+    profile.leave_block("Call to r1cs_gg_ppzksnark_prepared_prover");
+}
+
+template<typename ppT>
+const size_t r1cs_gg_ppzksnark_proving_key_tables<ppT>::max_stride;
+
+template<typename ppT>
+r1cs_gg_ppzksnark_proving_key_tables<ppT>::r1cs_gg_ppzksnark_proving_key_tables(const r1cs_gg_ppzksnark_proving_key<ppT> &pk,
+                                                                                const size_t memory_budget,
+                                                                                const size_t num_threads,
+                                                                                libff::profiling & profile)
+{
+    typedef libff::G1<ppT> G1;
+    typedef libff::G2<ppT> G2;
+
+    if (pk.A_query.empty())
+    {
+        return;
+    }
+
+    const size_t num_bits = libff::Fr<ppT>::size_in_bits();
+    const size_t num_variables = pk.A_query.size() - 1;
+    const size_t num_inputs = num_variables - pk.L_query.size();
+    const size_t domain_size = pk.H_query.size() + (pk.H_query_basis == r1cs_gg_ppzksnark_H_query_coset_lagrange ? 0 : 1);
+    const r1cs_gg_ppzksnark_prover_schedule<ppT> schedule(num_threads, num_variables, num_inputs, domain_size);
+
+    /* length of the multi-exponentiations of the prover (see r1cs_gg_ppzksnark_prover) */
+    const size_t A_length = pk.A_query.size() / schedule.A_pieces;
+    const size_t B_g2_length = pk.B_query.values.size() / schedule.B_g2_pieces;
+    const size_t B_g1_length = pk.B_query.values.size() / schedule.B_g1_pieces;
+    const size_t H_length = pk.H_query.size() / schedule.num_threads;
+    const size_t L_length = pk.L_query.size() / schedule.L_pieces;
+
+    const auto window = [&](const size_t length, const size_t stride) {
+        return libff::get_multi_exp_table_window_size(length, num_bits, stride);
+    };
+    const auto table_size = [&](const size_t num_bases, const size_t length, const size_t point_size, const size_t stride) {
+        return num_bases * libff::multi_exp_base_table<G1>::levels(window(length, stride), stride, num_bits) * point_size;
+    };
+
+    /* the tables keep affine coordinates */
+    const size_t G1_size = 2 * sizeof(typename libff::multi_exp_base_table<G1>::coord_t);
+    const size_t G2_size = 2 * sizeof(typename libff::multi_exp_base_table<G2>::coord_t);
+
+    size_t stride = 1;
+    for (; stride <= max_stride; ++stride)
+    {
+        const size_t size =
+            table_size(pk.A_query.size(), A_length, G1_size, stride) +
+            table_size(pk.B_query.values.size(), B_g2_length, G2_size, stride) +
+            table_size(pk.B_query.values.size(), B_g1_length, G1_size, stride) +
+            table_size(pk.H_query.size(), H_length, G1_size, stride) +
+            table_size(pk.L_query.size(), L_length, G1_size, stride);
+        if (size <= memory_budget)
+        {
+            break;
+        }
+    }
+
+    if (stride > max_stride)
+    {
+        profile.print_indent(); profile_printf("* Proving key tables do not fit in %zu bytes\n", memory_budget);
+        return;
+    }
+
+    profile.enter_block("Call to r1cs_gg_ppzksnark_proving_key_tables");
+
+    std::vector<G2> B_g2;
+    std::vector<G1> B_g1;
+    B_g2.reserve(pk.B_query.values.size());
+    B_g1.reserve(pk.B_query.values.size());
+    for (const knowledge_commitment<G2, G1> &v : pk.B_query.values)
+    {
+        B_g2.emplace_back(v.g);
+        B_g1.emplace_back(v.h);
+    }
+
+    A_query.build(pk.A_query.begin(), pk.A_query.end(), window(A_length, stride), stride, num_bits);
+    B_query_g2.build(B_g2.begin(), B_g2.end(), window(B_g2_length, stride), stride, num_bits);
+    B_query_g1.build(B_g1.begin(), B_g1.end(), window(B_g1_length, stride), stride, num_bits);
+    H_query.build(pk.H_query.begin(), pk.H_query.end(), window(H_length, stride), stride, num_bits);
+    L_query.build(pk.L_query.begin(), pk.L_query.end(), window(L_length, stride), stride, num_bits);
+
+    profile.print_indent(); profile_printf("* Proving key tables: stride %zu, %zu bytes\n", stride, size_in_bytes());
+    profile.leave_block("Call to r1cs_gg_ppzksnark_proving_key_tables");
+}
+
+template<typename ppT>
+constexpr double r1cs_gg_ppzksnark_prover_schedule<ppT>::G2_cost;
+
+template<typename ppT>
+constexpr double r1cs_gg_ppzksnark_prover_schedule<ppT>::Fr_mul_cost;
+
+template<typename ppT>
+const size_t r1cs_gg_ppzksnark_prover_schedule<ppT>::pieces_per_thread;
+
+template<typename ppT>
+const size_t r1cs_gg_ppzksnark_prover_schedule<ppT>::min_piece_size;
+
+template<typename ppT>
+double r1cs_gg_ppzksnark_prover_schedule<ppT>::multi_exp_cost(const size_t length)
+{
+    if (length == 0)
+    {
+        return 0;
+    }
+
+    const size_t num_bits = libff::Fr<ppT>::size_in_bits();
+    const size_t c = libff::get_multi_exp_signed_window_size(length, num_bits);
+    return (double) (num_bits / c + 1) * (length + 5.0 * (1ul << (c-1)));
+}
+
+template<typename ppT>
+r1cs_gg_ppzksnark_prover_schedule<ppT>::r1cs_gg_ppzksnark_prover_schedule(const size_t num_threads,
+                                                                          const size_t num_variables,
+                                                                          const size_t num_inputs,
+                                                                          const size_t domain_size) :
+    num_threads(std::max<size_t>(num_threads, 1))
+{
+    const double A_cost = multi_exp_cost(num_variables + 1);
+    const double B_g1_cost = A_cost;
+    const double B_g2_cost = G2_cost * A_cost;
+    const double L_cost = multi_exp_cost(num_variables - num_inputs);
+    const double tasks_cost = A_cost + B_g1_cost + B_g2_cost + L_cost;
+
+    /* three iFFTs, three coset FFTs and one inverse coset FFT */
+    const double H_cost = Fr_mul_cost * 7 * (domain_size / 2) * libff::log2(domain_size);
+
+    H_threads = 1;
+    if (this->num_threads > 1)
+    {
+        const size_t share = std::round(this->num_threads * H_cost / (H_cost + tasks_cost));
+        H_threads = std::min(std::max<size_t>(share, 1), this->num_threads - 1);
+    }
+
+    const size_t task_threads = (this->num_threads > 1 ? this->num_threads - H_threads : 1);
+    const double total_pieces = pieces_per_thread * task_threads;
+
+    const auto pieces = [&](const size_t length, const double cost) {
+        const size_t max_pieces = std::max<size_t>(length / min_piece_size, 1);
+        const size_t n = (tasks_cost > 0 ? std::round(total_pieces * cost / tasks_cost) : 1);
+        return std::min(std::max<size_t>(n, 1), max_pieces);
+    };
+
+    A_pieces = pieces(num_variables + 1, A_cost);
+    B_g1_pieces = pieces(num_variables + 1, B_g1_cost);
+    B_g2_pieces = pieces(num_variables + 1, B_g2_cost);
+    L_pieces = pieces(num_variables - num_inputs, L_cost);
+}
+
 template <typename ppT>
 int r1cs_gg_ppzksnark_prover(const r1cs_gg_ppzksnark_constraint_system<ppT>  &r1cs ,
                              const r1cs_gg_ppzksnark_proving_key<ppT> &pk,
@@ -425,112 +647,345 @@ int r1cs_gg_ppzksnark_prover(const r1cs_gg_ppzksnark_constraint_system<ppT>  &r1
                              r1cs_gg_ppzksnark_proof<ppT> &proof,
                              libff::profiling & profile )
 {
-    profile.enter_block("Call to r1cs_gg_ppzksnark_prover");
-
 #ifdef DEBUG
     assert(r1cs /*pk.constraint_system*/ .is_satisfied(primary_input, auxiliary_input));
 #endif
 
-    profile.enter_block("swap_AB_if_beneficial");
-    r1cs_gg_ppzksnark_constraint_system<ppT> r1cs_copy(r1cs);
-    r1cs_copy.swap_AB_if_beneficial(profile);
-    profile.leave_block("swap_AB_if_beneficial");
+    const r1cs_gg_ppzksnark_prepared_prover<ppT> prepared(r1cs, profile);
 
-    profile.enter_block("Compute the polynomial H");
-    const qap_witness<libff::Fr<ppT> > qap_wit = r1cs_to_qap_witness_map(r1cs_copy /*pk.constraint_system*/, primary_input, auxiliary_input, libff::Fr<ppT>::zero(), libff::Fr<ppT>::zero(), libff::Fr<ppT>::zero());
+    return r1cs_gg_ppzksnark_prover<ppT>(prepared, pk, primary_input, auxiliary_input, proof, profile);
+}
 
-    /* We are dividing degree 2(d-1) polynomial by degree d polynomial
-       and not adding a PGHR-style ZK-patch, so our H is degree d-2 */
-    assert(!qap_wit.coefficients_for_H[qap_wit.degree()-2].is_zero());
-    assert(qap_wit.coefficients_for_H[qap_wit.degree()-1].is_zero());
-    assert(qap_wit.coefficients_for_H[qap_wit.degree()].is_zero());
-    profile.leave_block("Compute the polynomial H");
+template <typename ppT>
+int r1cs_gg_ppzksnark_prover(const r1cs_gg_ppzksnark_prepared_prover<ppT> &prepared,
+                             const r1cs_gg_ppzksnark_proving_key<ppT> &pk,
+                             const r1cs_gg_ppzksnark_primary_input<ppT> &primary_input,
+                             const r1cs_gg_ppzksnark_auxiliary_input<ppT> &auxiliary_input,
+                             r1cs_gg_ppzksnark_proof<ppT> &proof,
+                             libff::profiling & profile )
+{
+    profile.enter_block("Call to r1cs_gg_ppzksnark_prover");
 
 #ifdef DEBUG
-    const libff::Fr<ppT> t = libff::Fr<ppT>::random_element();
-    qap_instance_evaluation<libff::Fr<ppT> > qap_inst = r1cs_to_qap_instance_map_with_evaluation(r1cs_copy /*pk.constraint_system*/, t);
-    assert(qap_inst.is_satisfied(qap_wit));
+    const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs = prepared.constraint_system;
 #endif
+    const size_t num_variables = prepared.matrices.num_variables;
+    const size_t num_inputs = prepared.matrices.num_inputs;
+
+#ifdef MULTICORE
+    const size_t num_threads = omp_get_max_threads(); // to override, set OMP_NUM_THREADS env var or call omp_set_num_threads()
+#else
+    const size_t num_threads = 1;
+#endif
+    const r1cs_gg_ppzksnark_prover_schedule<ppT> schedule(num_threads, num_variables, num_inputs, prepared.domain->m);
+
+    /* a key of another basis, or of another circuit, has an H-query of another size */
+    const bool H_on_coset = (pk.H_query_basis == r1cs_gg_ppzksnark_H_query_coset_lagrange);
+    const size_t H_size = pk.H_query_size(prepared.domain->m);
+    if (pk.H_query.size() != H_size)
+    {
+        profile.print_indent(); profile_printf("* H-query of %zu elements, expected %zu in its basis\n", pk.H_query.size(), H_size);
+        profile.leave_block("Call to r1cs_gg_ppzksnark_prover");
+        return 1;
+    }
 
     /* Choose two random field elements for prover zero-knowledge. */
     const libff::Fr<ppT> r = libff::Fr<ppT>::random_element();
     const libff::Fr<ppT> s = libff::Fr<ppT>::random_element();
 
 #ifdef DEBUG
-    assert(qap_wit.coefficients_for_ABCs.size() == qap_wit.num_variables());
-    assert(pk.A_query.size() == qap_wit.num_variables()+1);
-    assert(pk.B_query.domain_size() == qap_wit.num_variables()+1);
-    assert(pk.H_query.size() == qap_wit.degree() - 1);
-    assert(pk.L_query.size() == qap_wit.num_variables() - qap_wit.num_inputs());
+    assert(primary_input.size() + auxiliary_input.size() == num_variables);
+    assert(pk.A_query.size() == num_variables+1);
+    assert(pk.B_query.domain_size() == num_variables+1);
+    assert(pk.L_query.size() == num_variables - num_inputs);
 #endif
 
+    profile.enter_block("Compute the proof");
+
+    // TODO: sort out indexing
+    libff::Fr_vector<ppT> const_padded_assignment(1, libff::Fr<ppT>::one());
+    const_padded_assignment.insert(const_padded_assignment.end(), primary_input.begin(), primary_input.end());
+    const_padded_assignment.insert(const_padded_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+    std::unique_ptr<const qap_witness<libff::Fr<ppT> > > qap_wit;
+
+    const r1cs_gg_ppzksnark_proving_key_tables<ppT> *tables = prepared.tables;
+
+    std::vector<libff::G1<ppT> > partial_At(schedule.A_pieces, libff::G1<ppT>::zero());
+    std::vector<libff::G1<ppT> > partial_Bt_g1(schedule.B_g1_pieces, libff::G1<ppT>::zero());
+    std::vector<libff::G2<ppT> > partial_Bt_g2(schedule.B_g2_pieces, libff::G2<ppT>::zero());
+    std::vector<libff::G1<ppT> > partial_Lt(schedule.L_pieces, libff::G1<ppT>::zero());
+
+    /* piece i of n of [begin, end) */
+    const auto piece_begin = [](const size_t begin, const size_t end, const size_t i, const size_t n) {
+        return begin + (end - begin) * i / n;
+    };
+
+    const auto compute_H = [&]() {
+        profile.enter_block("Compute the polynomial H");
+        if (H_on_coset)
+        {
+            qap_wit.reset(new qap_witness<libff::Fr<ppT> >(
+                r1cs_to_qap_witness_map_on_coset(prepared.domain, prepared.matrices, primary_input, auxiliary_input,
+                                                 schedule.H_threads)));
+        }
+        else
+        {
+            qap_wit.reset(new qap_witness<libff::Fr<ppT> >(
+                r1cs_to_qap_witness_map(prepared.domain, prepared.matrices, primary_input, auxiliary_input,
+                                        libff::Fr<ppT>::zero(), libff::Fr<ppT>::zero(), libff::Fr<ppT>::zero(),
+                                        schedule.H_threads)));
+        }
+        profile.leave_block("Compute the polynomial H");
+    };
+
+    profile.enter_block("Compute H and evaluations to A, B and L-queries");
 #ifdef MULTICORE
-    const size_t chunks = omp_get_max_threads(); // to override, set OMP_NUM_THREADS env var or call omp_set_num_threads()
+    /* H is computed on a thread of its own, whose parallel regions are top-level teams of
+       H_threads threads, next to the team running the tasks */
+    const size_t task_threads = (schedule.num_threads > schedule.H_threads ? schedule.num_threads - schedule.H_threads : 1);
+    std::exception_ptr H_error;
+    std::thread H_thread;
+    if (schedule.num_threads > 1)
+    {
+        H_thread = std::thread([&]() {
+            try
+            {
+                compute_H();
+            }
+            catch (...)
+            {
+                H_error = std::current_exception();
+            }
+        });
+    }
+    else
+    {
+        compute_H();
+    }
+#pragma omp parallel num_threads(task_threads)
+#pragma omp single
 #else
-    const size_t chunks = 1;
+    compute_H();
 #endif
+    {
+        /* the G2 pieces are the most expensive ones, so they are queued first */
+        for (size_t i = 0; i < schedule.B_g2_pieces; ++i)
+        {
+#ifdef MULTICORE
+#pragma omp task
+#endif
+            {
+                const size_t begin = piece_begin(0, num_variables + 1, i, schedule.B_g2_pieces);
+                const size_t end = piece_begin(0, num_variables + 1, i + 1, schedule.B_g2_pieces);
+                if (tables && !tables->B_query_g2.empty())
+                {
+                    partial_Bt_g2[i] = kc_multi_exp_part_with_table<libff::G2<ppT>, libff::G1<ppT>, libff::Fr<ppT> >(
+                        pk.B_query,
+                        tables->B_query_g2,
+                        begin,
+                        end,
+                        const_padded_assignment.begin() + begin,
+                        const_padded_assignment.begin() + end,
+                        1);
+                }
+                else
+                {
+                    partial_Bt_g2[i] = kc_multi_exp_part_with_mixed_addition<libff::G2<ppT>,
+                                                                             libff::G1<ppT>,
+                                                                             libff::Fr<ppT>,
+                                                                             libff::multi_exp_method_BDLO12_signed>(
+                        pk.B_query,
+                        &knowledge_commitment<libff::G2<ppT>, libff::G1<ppT> >::g,
+                        begin,
+                        end,
+                        const_padded_assignment.begin() + begin,
+                        const_padded_assignment.begin() + end,
+                        1);
+                }
+            }
+        }
 
-    profile.enter_block("Compute the proof");
+        for (size_t i = 0; i < schedule.B_g1_pieces; ++i)
+        {
+#ifdef MULTICORE
+#pragma omp task
+#endif
+            {
+                const size_t begin = piece_begin(0, num_variables + 1, i, schedule.B_g1_pieces);
+                const size_t end = piece_begin(0, num_variables + 1, i + 1, schedule.B_g1_pieces);
+                if (tables && !tables->B_query_g1.empty())
+                {
+                    partial_Bt_g1[i] = kc_multi_exp_part_with_table<libff::G2<ppT>, libff::G1<ppT>, libff::Fr<ppT> >(
+                        pk.B_query,
+                        tables->B_query_g1,
+                        begin,
+                        end,
+                        const_padded_assignment.begin() + begin,
+                        const_padded_assignment.begin() + end,
+                        1);
+                }
+                else
+                {
+                    partial_Bt_g1[i] = kc_multi_exp_part_with_mixed_addition<libff::G2<ppT>,
+                                                                             libff::G1<ppT>,
+                                                                             libff::Fr<ppT>,
+                                                                             libff::multi_exp_method_BDLO12_signed>(
+                        pk.B_query,
+                        &knowledge_commitment<libff::G2<ppT>, libff::G1<ppT> >::h,
+                        begin,
+                        end,
+                        const_padded_assignment.begin() + begin,
+                        const_padded_assignment.begin() + end,
+                        1);
+                }
+            }
+        }
 
-    profile.enter_block("Compute evaluation to A-query", false);
-    // TODO: sort out indexing
-    libff::Fr_vector<ppT> const_padded_assignment(1, libff::Fr<ppT>::one());
-    const_padded_assignment.insert(const_padded_assignment.end(), qap_wit.coefficients_for_ABCs.begin(), qap_wit.coefficients_for_ABCs.end());
-
-    libff::G1<ppT> evaluation_At = libff::multi_exp_with_mixed_addition<libff::G1<ppT>,
-                                                                        libff::Fr<ppT>,
-                                                                        libff::multi_exp_method_BDLO12>(
-        pk.A_query.begin(),
-        pk.A_query.begin() + qap_wit.num_variables() + 1,
-        const_padded_assignment.begin(),
-        const_padded_assignment.begin() + qap_wit.num_variables() + 1,
-        chunks);
-    profile.leave_block("Compute evaluation to A-query", false);
-
-    profile.enter_block("Compute evaluation to B-query", false);
-    knowledge_commitment<libff::G2<ppT>, libff::G1<ppT> > evaluation_Bt = kc_multi_exp_with_mixed_addition<libff::G2<ppT>,
-                                                                                                           libff::G1<ppT>,
-                                                                                                           libff::Fr<ppT>,
-                                                                                                           libff::multi_exp_method_BDLO12>(
-        pk.B_query,
-        0,
-        qap_wit.num_variables() + 1,
-        const_padded_assignment.begin(),
-        const_padded_assignment.begin() + qap_wit.num_variables() + 1,
-        chunks);
-    profile.leave_block("Compute evaluation to B-query", false);
+        for (size_t i = 0; i < schedule.A_pieces; ++i)
+        {
+#ifdef MULTICORE
+#pragma omp task
+#endif
+            {
+                const size_t begin = piece_begin(0, num_variables + 1, i, schedule.A_pieces);
+                const size_t end = piece_begin(0, num_variables + 1, i + 1, schedule.A_pieces);
+                if (tables && !tables->A_query.empty())
+                {
+                    partial_At[i] = libff::multi_exp_with_table<libff::G1<ppT>, libff::Fr<ppT> >(
+                        tables->A_query,
+                        begin,
+                        const_padded_assignment.begin() + begin,
+                        const_padded_assignment.begin() + end,
+                        1);
+                }
+                else
+                {
+                    partial_At[i] = libff::multi_exp_with_mixed_addition<libff::G1<ppT>,
+                                                                         libff::Fr<ppT>,
+                                                                         libff::multi_exp_method_BDLO12_signed>(
+                        pk.A_query.begin() + begin,
+                        pk.A_query.begin() + end,
+                        const_padded_assignment.begin() + begin,
+                        const_padded_assignment.begin() + end,
+                        1);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < schedule.L_pieces; ++i)
+        {
+#ifdef MULTICORE
+#pragma omp task
+#endif
+            {
+                const size_t begin = piece_begin(0, num_variables - num_inputs, i, schedule.L_pieces);
+                const size_t end = piece_begin(0, num_variables - num_inputs, i + 1, schedule.L_pieces);
+                if (tables && !tables->L_query.empty())
+                {
+                    partial_Lt[i] = libff::multi_exp_with_table<libff::G1<ppT>, libff::Fr<ppT> >(
+                        tables->L_query,
+                        begin,
+                        const_padded_assignment.begin() + num_inputs + 1 + begin,
+                        const_padded_assignment.begin() + num_inputs + 1 + end,
+                        1);
+                }
+                else
+                {
+                    partial_Lt[i] = libff::multi_exp_with_mixed_addition<libff::G1<ppT>,
+                                                                         libff::Fr<ppT>,
+                                                                         libff::multi_exp_method_BDLO12_signed>(
+                        pk.L_query.begin() + begin,
+                        pk.L_query.begin() + end,
+                        const_padded_assignment.begin() + num_inputs + 1 + begin,
+                        const_padded_assignment.begin() + num_inputs + 1 + end,
+                        1);
+                }
+            }
+        }
+    }
+#ifdef MULTICORE
+    if (H_thread.joinable())
+    {
+        H_thread.join();
+    }
+    if (H_error)
+    {
+        std::rethrow_exception(H_error);
+    }
+#endif
+    profile.leave_block("Compute H and evaluations to A, B and L-queries");
+
+    if (!H_on_coset)
+    {
+        /* We are dividing degree 2(d-1) polynomial by degree d polynomial
+           and not adding a PGHR-style ZK-patch, so our H is degree d-2 */
+        assert(!qap_wit->coefficients_for_H[qap_wit->degree()-2].is_zero());
+        assert(qap_wit->coefficients_for_H[qap_wit->degree()-1].is_zero());
+        assert(qap_wit->coefficients_for_H[qap_wit->degree()].is_zero());
+
+#ifdef DEBUG
+        const libff::Fr<ppT> t = libff::Fr<ppT>::random_element();
+        qap_instance_evaluation<libff::Fr<ppT> > qap_inst = r1cs_to_qap_instance_map_with_evaluation(r1cs, t);
+        assert(qap_inst.is_satisfied(*qap_wit));
+#endif
+    }
+
+    libff::G1<ppT> evaluation_At = libff::G1<ppT>::zero();
+    for (const libff::G1<ppT> &partial : partial_At)
+    {
+        evaluation_At = evaluation_At + partial;
+    }
+
+    knowledge_commitment<libff::G2<ppT>, libff::G1<ppT> > evaluation_Bt = knowledge_commitment<libff::G2<ppT>, libff::G1<ppT> >::zero();
+    for (const libff::G2<ppT> &partial : partial_Bt_g2)
+    {
+        evaluation_Bt.g = evaluation_Bt.g + partial;
+    }
+    for (const libff::G1<ppT> &partial : partial_Bt_g1)
+    {
+        evaluation_Bt.h = evaluation_Bt.h + partial;
+    }
+
+    libff::G1<ppT> evaluation_Lt = libff::G1<ppT>::zero();
+    for (const libff::G1<ppT> &partial : partial_Lt)
+    {
+        evaluation_Lt = evaluation_Lt + partial;
+    }
 
     profile.enter_block("Compute evaluation to H-query", false);
-    libff::G1<ppT> evaluation_Ht = libff::multi_exp<libff::G1<ppT>,
-                                                    libff::Fr<ppT>,
-                                                    libff::multi_exp_method_BDLO12>(
-        pk.H_query.begin(),
-        pk.H_query.begin() + (qap_wit.degree() - 1),
-        qap_wit.coefficients_for_H.begin(),
-        qap_wit.coefficients_for_H.begin() + (qap_wit.degree() - 1),
-        chunks);
+    libff::G1<ppT> evaluation_Ht;
+    if (tables && !tables->H_query.empty())
+    {
+        evaluation_Ht = libff::multi_exp_with_table<libff::G1<ppT>, libff::Fr<ppT> >(
+            tables->H_query,
+            0,
+            qap_wit->coefficients_for_H.begin(),
+            qap_wit->coefficients_for_H.begin() + H_size,
+            schedule.num_threads);
+    }
+    else
+    {
+        evaluation_Ht = libff::multi_exp<libff::G1<ppT>,
+                                         libff::Fr<ppT>,
+                                         libff::multi_exp_method_BDLO12_signed>(
+            pk.H_query.begin(),
+            pk.H_query.begin() + H_size,
+            qap_wit->coefficients_for_H.begin(),
+            qap_wit->coefficients_for_H.begin() + H_size,
+            schedule.num_threads);
+    }
     profile.leave_block("Compute evaluation to H-query", false);
 
-    profile.enter_block("Compute evaluation to L-query", false);
-    libff::G1<ppT> evaluation_Lt = libff::multi_exp_with_mixed_addition<libff::G1<ppT>,
-                                                                        libff::Fr<ppT>,
-                                                                        libff::multi_exp_method_BDLO12>(
-        pk.L_query.begin(),
-        pk.L_query.end(),
-        const_padded_assignment.begin() + qap_wit.num_inputs() + 1,
-        const_padded_assignment.begin() + qap_wit.num_variables() + 1,
-        chunks);
-    profile.leave_block("Compute evaluation to L-query", false);
-
     /* A = alpha + sum_i(a_i*A_i(t)) + r*delta */
-    libff::G1<ppT> g1_A = pk.alpha_g1 + evaluation_At + r * pk.delta_g1;
+    libff::G1<ppT> g1_A = pk.alpha_g1 + evaluation_At + libff::field_scalar_mul<libff::G1<ppT> >(pk.delta_g1, r);
     
     /* B = beta + sum_i(a_i*B_i(t)) + s*delta */
-    libff::G1<ppT> g1_B = pk.beta_g1 + evaluation_Bt.h + s * pk.delta_g1;
-    libff::G2<ppT> g2_B = pk.beta_g2 + evaluation_Bt.g + s * pk.delta_g2;
+    libff::G1<ppT> g1_B = pk.beta_g1 + evaluation_Bt.h + libff::field_scalar_mul<libff::G1<ppT> >(pk.delta_g1, s);
+    libff::G2<ppT> g2_B = pk.beta_g2 + evaluation_Bt.g + libff::field_scalar_mul<libff::G2<ppT> >(pk.delta_g2, s);
     
     /* C = sum_i(a_i*((beta*A_i(t) + alpha*B_i(t) + C_i(t)) + H(t)*Z(t))/delta) + A*s + r*b - r*s*delta */
-    libff::G1<ppT> g1_C = evaluation_Ht + evaluation_Lt + s *  g1_A + r * g1_B - (r * s) * pk.delta_g1;
+    libff::G1<ppT> g1_C = evaluation_Ht + evaluation_Lt + libff::field_scalar_mul<libff::G1<ppT> >(g1_A, s) + libff::field_scalar_mul<libff::G1<ppT> >(g1_B, r) - libff::field_scalar_mul<libff::G1<ppT> >(pk.delta_g1, r * s);
     
     profile.leave_block("Compute the proof");
 
@@ -550,8 +1005,7 @@ r1cs_gg_ppzksnark_processed_verification_key<ppT> r1cs_gg_ppzksnark_verifier_pro
     profile.enter_block("Call to r1cs_gg_ppzksnark_verifier_process_vk");
 
     r1cs_gg_ppzksnark_processed_verification_key<ppT> pvk;
-    pvk.vk_alpha_g1_precomp = ppT::precompute_G1(vk.alpha_g1);
-    pvk.vk_beta_g2_precomp = ppT::precompute_G2(vk.beta_g2);
+    pvk.vk_alpha_g1_beta_g2 = ppT::reduced_pairing(vk.alpha_g1, vk.beta_g2);
     pvk.vk_generator_g2_precomp = ppT::precompute_G2(libff::G2<ppT>::one());
     pvk.vk_delta_g2_precomp = ppT::precompute_G2(vk.delta_g2);
     pvk.ABC_g1 = vk.ABC_g1;
@@ -595,16 +1049,13 @@ bool r1cs_gg_ppzksnark_online_verifier_weak_IC(const r1cs_gg_ppzksnark_processed
     const libff::G1_precomp<ppT> proof_g_C_precomp = ppT::precompute_G1(proof.g_C);
     const libff::G1_precomp<ppT> acc_precomp = ppT::precompute_G1(acc);
 
-    const libff::Fqk<ppT> f = ppT::miller_loop(pvk.vk_alpha_g1_precomp,  pvk.vk_beta_g2_precomp);
-    const libff::GT<ppT> vk_alpha_g1_beta_g2 = ppT::final_exponentiation(f);
-
     const libff::Fqk<ppT> QAP1 = ppT::miller_loop(proof_g_A_precomp,  proof_g_B_precomp);
     const libff::Fqk<ppT> QAP2 = ppT::double_miller_loop(
         acc_precomp, pvk.vk_generator_g2_precomp,
         proof_g_C_precomp, pvk.vk_delta_g2_precomp);
     const libff::GT<ppT> QAP = ppT::final_exponentiation(QAP1 * QAP2.unitary_inverse());
 
-    if (QAP != vk_alpha_g1_beta_g2)
+    if (QAP != pvk.vk_alpha_g1_beta_g2)
     {
         //if (!libff::inhibit_profiling_info)
         {
@@ -669,6 +1120,160 @@ bool r1cs_gg_ppzksnark_verifier_strong_IC(const r1cs_gg_ppzksnark_verification_k
     return result;
 }
 
+/**
+ * Combined pairing check of the proofs in indices (see r1cs_gg_ppzksnark_online_batch_verifier_strong_IC).
+ * The inputs must already have the expected length.
+ */
+template<typename ppT>
+bool r1cs_gg_ppzksnark_batch_check(const r1cs_gg_ppzksnark_processed_verification_key<ppT> &pvk,
+                                   const std::vector<r1cs_gg_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                   const std::vector<r1cs_gg_ppzksnark_proof<ppT> > &proofs,
+                                   const std::vector<libff::bigint<libff::Fr<ppT>::num_limbs> > &r,
+                                   const std::vector<size_t> &indices)
+{
+    typedef libff::Fr<ppT> FieldT;
+
+    const size_t num_proofs = indices.size();
+    const size_t num_inputs = pvk.ABC_g1.domain_size();
+
+    /* sum_i r_i acc_i = (sum_i r_i) ABC_0 + sum_j (sum_i r_i x_ij) ABC_j */
+    FieldT r_sum = FieldT::zero();
+    std::vector<FieldT> input_scalars(num_inputs, FieldT::zero());
+    std::vector<FieldT> C_scalars(num_proofs);
+    std::vector<libff::G1<ppT> > C_bases(num_proofs);
+
+    for (size_t k = 0; k < num_proofs; ++k)
+    {
+        const size_t i = indices[k];
+        C_scalars[k] = FieldT(r[i]);
+        C_bases[k] = proofs[i].g_C;
+        r_sum += C_scalars[k];
+        for (size_t j = 0; j < num_inputs; ++j)
+        {
+            input_scalars[j] += C_scalars[k] * primary_inputs[i][j];
+        }
+    }
+
+    const libff::G1<ppT> acc =
+        pvk.ABC_g1.template accumulate_chunk<FieldT>(input_scalars.begin(), input_scalars.end(), 0).first +
+        (r_sum - FieldT::one()) * pvk.ABC_g1.first;
+    const libff::G1<ppT> C =
+        libff::multi_exp<libff::G1<ppT>, FieldT, libff::multi_exp_method_BDLO12>(
+            C_bases.begin(), C_bases.end(), C_scalars.begin(), C_scalars.end(), 1);
+
+    std::vector<libff::G1_precomp<ppT> > P(num_proofs + 2);
+    std::vector<libff::G2_precomp<ppT> > Q(num_proofs + 2);
+
+#ifdef MULTICORE
+    #pragma omp parallel for
+#endif
+    for (size_t k = 0; k < num_proofs; ++k)
+    {
+        const size_t i = indices[k];
+        P[k] = ppT::precompute_G1(r[i] * proofs[i].g_A);
+        Q[k] = ppT::precompute_G2(proofs[i].g_B);
+    }
+
+    P[num_proofs] = ppT::precompute_G1(-acc);
+    Q[num_proofs] = pvk.vk_generator_g2_precomp;
+    P[num_proofs + 1] = ppT::precompute_G1(-C);
+    Q[num_proofs + 1] = pvk.vk_delta_g2_precomp;
+
+    const libff::GT<ppT> QAP = ppT::final_exponentiation(ppT::multi_miller_loop(P, Q));
+
+    return QAP == pvk.vk_alpha_g1_beta_g2.cyclotomic_exp(r_sum.as_bigint());
+}
+
+/**
+ * Bisect a failed batch. If known_failing is set, the combined check of the
+ * whole range is skipped. Returns true if any proof in indices is invalid.
+ */
+template<typename ppT>
+bool r1cs_gg_ppzksnark_batch_bisect(const r1cs_gg_ppzksnark_processed_verification_key<ppT> &pvk,
+                                    const std::vector<r1cs_gg_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                    const std::vector<r1cs_gg_ppzksnark_proof<ppT> > &proofs,
+                                    const std::vector<libff::bigint<libff::Fr<ppT>::num_limbs> > &r,
+                                    const std::vector<size_t> &indices,
+                                    const bool known_failing,
+                                    std::vector<bool> &results)
+{
+    if (indices.empty()) { return false; }
+
+    if (!known_failing && r1cs_gg_ppzksnark_batch_check<ppT>(pvk, primary_inputs, proofs, r, indices))
+    {
+        for (size_t i : indices) { results[i] = true; }
+        return false;
+    }
+
+    if (indices.size() == 1)
+    {
+        results[indices[0]] = false;
+        return true;
+    }
+
+    const std::vector<size_t> left(indices.begin(), indices.begin() + indices.size() / 2);
+    const std::vector<size_t> right(indices.begin() + indices.size() / 2, indices.end());
+
+    const bool left_failing = r1cs_gg_ppzksnark_batch_bisect<ppT>(pvk, primary_inputs, proofs, r, left, false, results);
+    r1cs_gg_ppzksnark_batch_bisect<ppT>(pvk, primary_inputs, proofs, r, right, !left_failing, results);
+
+    return true;
+}
+
+template<typename ppT>
+bool r1cs_gg_ppzksnark_online_batch_verifier_strong_IC(const r1cs_gg_ppzksnark_processed_verification_key<ppT> &pvk,
+                                                       const std::vector<r1cs_gg_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                                       const std::vector<r1cs_gg_ppzksnark_proof<ppT> > &proofs,
+                                                       std::vector<bool> &results,
+                                                       libff::profiling & profile)
+{
+    typedef libff::bigint<libff::Fr<ppT>::num_limbs> scalar_t;
+
+    profile.enter_block("Call to r1cs_gg_ppzksnark_online_batch_verifier_strong_IC");
+
+    results.assign(proofs.size(), false);
+
+    std::vector<size_t> indices;
+    indices.reserve(proofs.size());
+    for (size_t i = 0; i < proofs.size(); ++i)
+    {
+        if (i >= primary_inputs.size() || primary_inputs[i].size() != pvk.ABC_g1.domain_size())
+        {
+            profile.print_indent(); profile_printf("Input length of proof %zu differs from expected (expected %zu).\n", i, pvk.ABC_g1.domain_size());
+        }
+        else if (!proofs[i].is_well_formed())
+        {
+            profile.print_indent(); profile_printf("At least one of the elements of proof %zu does not lie on the curve.\n", i);
+        }
+        else
+        {
+            indices.emplace_back(i);
+        }
+    }
+
+    profile.enter_block("Draw batching scalars");
+    const mp_size_t random_limbs = 128 / GMP_NUMB_BITS;
+    std::vector<scalar_t> r(proofs.size());
+    for (scalar_t &ri : r)
+    {
+        ri.randomize();
+        for (mp_size_t l = random_limbs; l < scalar_t::N; ++l) { ri.data[l] = 0; }
+        if (ri.is_zero()) { ri.data[0] = 1; }
+    }
+    profile.leave_block("Draw batching scalars");
+
+    profile.enter_block("Check QAP divisibility");
+    r1cs_gg_ppzksnark_batch_bisect<ppT>(pvk, primary_inputs, proofs, r, indices, false, results);
+    profile.leave_block("Check QAP divisibility");
+
+    const bool result = (indices.size() == proofs.size() &&
+                         std::find(results.begin(), results.end(), false) == results.end());
+
+    profile.leave_block("Call to r1cs_gg_ppzksnark_online_batch_verifier_strong_IC");
+
+    return result;
+}
+
 template<typename ppT>
 bool r1cs_gg_ppzksnark_affine_verifier_weak_IC(const r1cs_gg_ppzksnark_verification_key<ppT> &vk,
                                                const r1cs_gg_ppzksnark_primary_input<ppT> &primary_input,
@@ -42,7 +42,8 @@ template<typename ppT>
 int run_r1cs_gg_ppzksnark_setup(
     const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs,
     r1cs_gg_ppzksnark_keypair<ppT> & keypair ,
-    libff::profiling & profile);
+    libff::profiling & profile,
+    const r1cs_gg_ppzksnark_H_query_basis H_query_basis = r1cs_gg_ppzksnark_H_query_monomial);
 
 
 template<typename ppT>
@@ -54,6 +55,16 @@ int run_r1cs_gg_ppzksnark(
     libff::profiling & profile);
 
 
+template<typename ppT>
+int run_r1cs_gg_ppzksnark(
+    const r1cs_gg_ppzksnark_prepared_prover<ppT> &prepared,
+    const r1cs_gg_ppzksnark_primary_input<ppT> &primary_input,
+    const r1cs_gg_ppzksnark_auxiliary_input<ppT> &auxiliary_input,
+    const r1cs_gg_ppzksnark_keypair<ppT>  & keypair , 
+    r1cs_gg_ppzksnark_proof<ppT>  &proof ,
+    libff::profiling & profile);
+
+
 template<typename ppT>  bool
 run_r1cs_gg_ppzksnark_verify(
     const r1cs_example<libff::Fr<ppT> > &example,
@@ -63,6 +74,14 @@ run_r1cs_gg_ppzksnark_verify(
     libff::profiling & profile);
 
 
+template<typename ppT>  bool
+run_r1cs_gg_ppzksnark_verify(
+    const r1cs_gg_ppzksnark_processed_verification_key<ppT> & pvk ,
+    const r1cs_gg_ppzksnark_primary_input<ppT> & primary_input ,
+    const r1cs_gg_ppzksnark_proof<ppT> & proof,
+    libff::profiling & profile);
+
+
 template<typename ppT>
 bool run_r1cs_gg_ppzksnark_all(
         const r1cs_example<libff::Fr<ppT> > &example,
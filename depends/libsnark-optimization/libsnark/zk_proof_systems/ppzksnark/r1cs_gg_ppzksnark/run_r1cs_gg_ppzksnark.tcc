@@ -68,11 +68,12 @@ namespace libsnark {
         int run_r1cs_gg_ppzksnark_setup(
             const r1cs_gg_ppzksnark_constraint_system<ppT> &r1cs,
             r1cs_gg_ppzksnark_keypair<ppT> & keypair ,
-            libff::profiling & profile)
+            libff::profiling & profile,
+            const r1cs_gg_ppzksnark_H_query_basis H_query_basis)
     {
         
         LOGD("Call to R1CS GG-ppzkSNARK Generator\n");
-        r1cs_gg_ppzksnark_generator<ppT>(r1cs , keypair , profile);
+        r1cs_gg_ppzksnark_generator<ppT>(r1cs , keypair , profile , H_query_basis);
         LOGD("End Call to R1CS GG-ppzkSNARK Generator\n");
         
         return 0 ;
@@ -90,10 +91,27 @@ namespace libsnark {
         libff::UNUSED(test_serialization);
 
         LOGD("Call to R1CS GG-ppzkSNARK Prover\n");
-        r1cs_gg_ppzksnark_prover<ppT>(example.constraint_system, keypair.pk, example.primary_input, example.auxiliary_input , proof, profile );
+        const int retval = r1cs_gg_ppzksnark_prover<ppT>(example.constraint_system, keypair.pk, example.primary_input, example.auxiliary_input , proof, profile );
         LOGD("End Call to R1CS GG-ppzkSNARK Prover\n");
 
-        return 0;
+        return retval;
+    }
+
+
+    template<typename ppT> 
+        int run_r1cs_gg_ppzksnark(
+                const r1cs_gg_ppzksnark_prepared_prover<ppT> &prepared,
+                const r1cs_gg_ppzksnark_primary_input<ppT> &primary_input,
+                const r1cs_gg_ppzksnark_auxiliary_input<ppT> &auxiliary_input,
+                const r1cs_gg_ppzksnark_keypair<ppT>  & keypair,
+                r1cs_gg_ppzksnark_proof<ppT> &proof ,
+                libff::profiling & profile)
+    {
+        LOGD("Call to R1CS GG-ppzkSNARK Prover (prepared)\n");
+        const int retval = r1cs_gg_ppzksnark_prover<ppT>(prepared, keypair.pk, primary_input, auxiliary_input , proof, profile );
+        LOGD("End Call to R1CS GG-ppzkSNARK Prover (prepared)\n");
+
+        return retval;
     }
 
 
@@ -130,6 +148,25 @@ namespace libsnark {
 
         return ans;
     }
+
+
+
+    template<typename ppT>
+    bool run_r1cs_gg_ppzksnark_verify(
+            const r1cs_gg_ppzksnark_processed_verification_key<ppT> & pvk ,
+            const r1cs_gg_ppzksnark_primary_input<ppT> & primary_input ,
+            const r1cs_gg_ppzksnark_proof<ppT> & proof,
+            libff::profiling & profile )
+    {
+        LOGD("Call to run_r1cs_gg_ppzksnark verify (processed vk)\n");
+
+        const bool ans = r1cs_gg_ppzksnark_online_verifier_strong_IC<ppT>(pvk, primary_input, proof, profile);
+        LOGD("* The verification result is: %s\n", (ans ? "PASS" : "FAIL"));
+
+        LOGD("End Call to run_r1cs_gg_ppzksnark verify (processed vk)\n");
+
+        return ans;
+    }
      
 
 
@@ -500,6 +500,26 @@ bool r1cs_rom_se_ppzksnark_online_verifier_strong_IC(const r1cs_rom_se_ppzksnark
                                                  const r1cs_rom_se_ppzksnark_primary_input<ppT> &primary_input,
                                                  const r1cs_rom_se_ppzksnark_proof<ppT> &proof);
 
+/**
+ * A batch verifier algorithm for the R1CS ROM-SE-ppzkSNARK that:
+ * (1) accepts a processed verification key,
+ * (2) has strong input consistency, and
+ * (3) checks all the proofs with one multi-Miller loop and one final exponentiation.
+ *
+ * With A'_i = A_i + h1_i g1, the verification equations are combined with random 128-bit scalars r_i:
+ *   prod_i e(r_i A'_i, B_i) * e(sum_i h2_i r_i A'_i, delta) = e(alpha, beta)^{sum_i r_i} * e(sum_i r_i acc_i, gamma) * e(sum_i r_i C_i, g2)
+ * so that the h2 delta term of B moves to G1 and no G2 scalar multiplication is done per proof.
+ * When the combined check fails, the batch is bisected to find the invalid proofs.
+ *
+ * Sets results[i] for each proof and returns true if all of them are valid.
+ */
+template<typename ppT>
+bool r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC(const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> &pvk,
+                                                           const std::vector<r1cs_rom_se_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                                           const std::vector<r1cs_rom_se_ppzksnark_proof<ppT> > &proofs,
+                                                           std::vector<bool> &results,
+                                                           libff::profiling & profile);
+
 /****************************** Miscellaneous ********************************/
 
 /**
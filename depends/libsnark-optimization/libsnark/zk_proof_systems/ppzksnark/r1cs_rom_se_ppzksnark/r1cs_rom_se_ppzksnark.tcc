@@ -350,12 +350,12 @@ r1cs_rom_se_ppzksnark_keypair<ppT> r1cs_rom_se_ppzksnark_generator(const r1cs_ro
     profile.enter_block("Generate R1CS proving key");
     libff::G1<ppT> g1 = g1_generator;
     libff::G2<ppT> g2 = g2_generator;
-    libff::G1<ppT> alpha_g1 = alpha * g1_generator;
-    libff::G1<ppT> beta_g1 = beta * g1_generator;
-    libff::G1<ppT> delta_g1 = delta * g1_generator;
-    libff::G1<ppT> alpha_delta_g1 = (alpha * delta) * g1_generator;
-    libff::G2<ppT> beta_g2 = beta * g2_generator;
-    libff::G2<ppT> delta_g2 = delta * g2_generator;
+    libff::G1<ppT> alpha_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, alpha);
+    libff::G1<ppT> beta_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, beta);
+    libff::G1<ppT> delta_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, delta);
+    libff::G1<ppT> alpha_delta_g1 = libff::field_scalar_mul<libff::G1<ppT> >(g1_generator, alpha * delta);
+    libff::G2<ppT> beta_g2 = libff::field_scalar_mul<libff::G2<ppT> >(g2_generator, beta);
+    libff::G2<ppT> delta_g2 = libff::field_scalar_mul<libff::G2<ppT> >(g2_generator, delta);
 
     profile.enter_block("Generate queries");
     profile.enter_block("Compute the A-query", false);
@@ -390,7 +390,7 @@ r1cs_rom_se_ppzksnark_keypair<ppT> r1cs_rom_se_ppzksnark_generator(const r1cs_ro
 
     profile.enter_block("Generate R1CS verification key");
     libff::GT<ppT> alpha_g1_beta_g2 = ppT::reduced_pairing(alpha_g1, beta_g2);
-    libff::G2<ppT> gamma_g2 = gamma * g2_generator;
+    libff::G2<ppT> gamma_g2 = libff::field_scalar_mul<libff::G2<ppT> >(g2_generator, gamma);
 
     profile.enter_block("Encode gamma_ABC for R1CS verification key");
     libff::G1<ppT> gamma_ABC_g1_0 = gamma_ABC_0 * g1_generator;
@@ -532,17 +532,17 @@ r1cs_rom_se_ppzksnark_proof<ppT> r1cs_rom_se_ppzksnark_prover(const r1cs_rom_se_
     profile.leave_block("Compute evaluation to L-query", false);
 
     /* A = alpha + sum_i(a_i*A_i(t)) + r */
-    libff::G1<ppT> g1_A = pk.alpha_g1 + evaluation_At.g + r * pk.g1;
-    libff::G1<ppT> g1_A_delta = pk.alpha_delta_g1 + evaluation_At.h + r * pk.delta_g1;
+    libff::G1<ppT> g1_A = pk.alpha_g1 + evaluation_At.g + libff::field_scalar_mul<libff::G1<ppT> >(pk.g1, r);
+    libff::G1<ppT> g1_A_delta = pk.alpha_delta_g1 + evaluation_At.h + libff::field_scalar_mul<libff::G1<ppT> >(pk.delta_g1, r);
 
     /* B = beta + sum_i(a_i*B_i(t)) + s */
-    libff::G1<ppT> g1_B = pk.beta_g1 + evaluation_Bt.h + s * pk.g1;
-    libff::G2<ppT> g2_B = pk.beta_g2 + evaluation_Bt.g + s * pk.g2;
+    libff::G1<ppT> g1_B = pk.beta_g1 + evaluation_Bt.h + libff::field_scalar_mul<libff::G1<ppT> >(pk.g1, s);
+    libff::G2<ppT> g2_B = pk.beta_g2 + evaluation_Bt.g + libff::field_scalar_mul<libff::G2<ppT> >(pk.g2, s);
 
     /* C = sum_i(a_i*(gamma*(beta*A_i(t) + alpha*B_i(t) + gamma*C_i(t)) + gamma^2*H(t)*Z(t) + a*s + r*b - r*s  + delta*a*h_2 + b*h_1 + delta*h_1*h_2*/
     const libff::Fr<ppT> h1 = hash<ppT>(g1_A, g2_B, 1);
     const libff::Fr<ppT> h2 = hash<ppT>(g1_A, g2_B, 2);
-    libff::G1<ppT> g1_C = evaluation_Ht + evaluation_Lt + s *  g1_A + r * g1_B - (r * s) * pk.g1 + h2 * g1_A_delta + h1 * g1_B + h1 * h2 * pk.delta_g1;
+    libff::G1<ppT> g1_C = evaluation_Ht + evaluation_Lt + libff::field_scalar_mul<libff::G1<ppT> >(g1_A, s) + libff::field_scalar_mul<libff::G1<ppT> >(g1_B, r) - libff::field_scalar_mul<libff::G1<ppT> >(pk.g1, r * s) + libff::field_scalar_mul<libff::G1<ppT> >(g1_A_delta, h2) + libff::field_scalar_mul<libff::G1<ppT> >(g1_B, h1) + libff::field_scalar_mul<libff::G1<ppT> >(pk.delta_g1, h1 * h2);
 
     profile.leave_block("Compute the proof");
 
@@ -683,6 +683,171 @@ bool r1cs_rom_se_ppzksnark_verifier_strong_IC(const r1cs_rom_se_ppzksnark_verifi
     return result;
 }
 
+/**
+ * Combined pairing check of the proofs in indices (see r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC).
+ * The inputs must already have the expected length.
+ */
+template<typename ppT>
+bool r1cs_rom_se_ppzksnark_batch_check(const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> &pvk,
+                                       const std::vector<r1cs_rom_se_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                       const std::vector<r1cs_rom_se_ppzksnark_proof<ppT> > &proofs,
+                                       const std::vector<libff::bigint<libff::Fr<ppT>::num_limbs> > &r,
+                                       const std::vector<size_t> &indices)
+{
+    typedef libff::Fr<ppT> FieldT;
+
+    const size_t num_proofs = indices.size();
+    const size_t num_inputs = pvk.gamma_ABC_g1.domain_size();
+
+    /* sum_i r_i acc_i = (sum_i r_i) gamma_ABC_0 + sum_j (sum_i r_i x_ij) gamma_ABC_j */
+    FieldT r_sum = FieldT::zero();
+    std::vector<FieldT> input_scalars(num_inputs, FieldT::zero());
+    std::vector<FieldT> C_scalars(num_proofs);
+    std::vector<libff::G1<ppT> > C_bases(num_proofs);
+
+    for (size_t k = 0; k < num_proofs; ++k)
+    {
+        const size_t i = indices[k];
+        C_scalars[k] = FieldT(r[i]);
+        C_bases[k] = proofs[i].g_C;
+        r_sum += C_scalars[k];
+        for (size_t j = 0; j < num_inputs; ++j)
+        {
+            input_scalars[j] += C_scalars[k] * primary_inputs[i][j];
+        }
+    }
+
+    const libff::G1<ppT> acc =
+        pvk.gamma_ABC_g1.template accumulate_chunk<FieldT>(input_scalars.begin(), input_scalars.end(), 0).first +
+        (r_sum - FieldT::one()) * pvk.gamma_ABC_g1.first;
+    const libff::G1<ppT> C =
+        libff::multi_exp<libff::G1<ppT>, FieldT, libff::multi_exp_method_BDLO12>(
+            C_bases.begin(), C_bases.end(), C_scalars.begin(), C_scalars.end(), 1);
+
+    std::vector<libff::G1_precomp<ppT> > P(num_proofs + 3);
+    std::vector<libff::G2_precomp<ppT> > Q(num_proofs + 3);
+    std::vector<FieldT> D_scalars(num_proofs);
+    std::vector<libff::G1<ppT> > D_bases(num_proofs);
+
+#ifdef MULTICORE
+    #pragma omp parallel for
+#endif
+    for (size_t k = 0; k < num_proofs; ++k)
+    {
+        const size_t i = indices[k];
+        const FieldT h1 = hash<ppT>(proofs[i].g_A, proofs[i].g_B, 1);
+        D_scalars[k] = hash<ppT>(proofs[i].g_A, proofs[i].g_B, 2);
+        D_bases[k] = r[i] * (proofs[i].g_A + h1 * pvk.vk_g1);
+        P[k] = ppT::precompute_G1(D_bases[k]);
+        Q[k] = ppT::precompute_G2(proofs[i].g_B);
+    }
+
+    const libff::G1<ppT> D =
+        libff::multi_exp<libff::G1<ppT>, FieldT, libff::multi_exp_method_BDLO12>(
+            D_bases.begin(), D_bases.end(), D_scalars.begin(), D_scalars.end(), 1);
+
+    P[num_proofs] = ppT::precompute_G1(D);
+    Q[num_proofs] = pvk.vk_delta_g2_precomp;
+    P[num_proofs + 1] = ppT::precompute_G1(-acc);
+    Q[num_proofs + 1] = pvk.vk_gamma_g2_precomp;
+    P[num_proofs + 2] = ppT::precompute_G1(-C);
+    Q[num_proofs + 2] = pvk.vk_g2_precomp;
+
+    const libff::GT<ppT> QAP = ppT::final_exponentiation(ppT::multi_miller_loop(P, Q));
+
+    return QAP == pvk.vk_alpha_g1_beta_g2.cyclotomic_exp(r_sum.as_bigint());
+}
+
+/**
+ * Bisect a failed batch. If known_failing is set, the combined check of the
+ * whole range is skipped. Returns true if any proof in indices is invalid.
+ */
+template<typename ppT>
+bool r1cs_rom_se_ppzksnark_batch_bisect(const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> &pvk,
+                                        const std::vector<r1cs_rom_se_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                        const std::vector<r1cs_rom_se_ppzksnark_proof<ppT> > &proofs,
+                                        const std::vector<libff::bigint<libff::Fr<ppT>::num_limbs> > &r,
+                                        const std::vector<size_t> &indices,
+                                        const bool known_failing,
+                                        std::vector<bool> &results)
+{
+    if (indices.empty()) { return false; }
+
+    if (!known_failing && r1cs_rom_se_ppzksnark_batch_check<ppT>(pvk, primary_inputs, proofs, r, indices))
+    {
+        for (size_t i : indices) { results[i] = true; }
+        return false;
+    }
+
+    if (indices.size() == 1)
+    {
+        results[indices[0]] = false;
+        return true;
+    }
+
+    const std::vector<size_t> left(indices.begin(), indices.begin() + indices.size() / 2);
+    const std::vector<size_t> right(indices.begin() + indices.size() / 2, indices.end());
+
+    const bool left_failing = r1cs_rom_se_ppzksnark_batch_bisect<ppT>(pvk, primary_inputs, proofs, r, left, false, results);
+    r1cs_rom_se_ppzksnark_batch_bisect<ppT>(pvk, primary_inputs, proofs, r, right, !left_failing, results);
+
+    return true;
+}
+
+template<typename ppT>
+bool r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC(const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> &pvk,
+                                                           const std::vector<r1cs_rom_se_ppzksnark_primary_input<ppT> > &primary_inputs,
+                                                           const std::vector<r1cs_rom_se_ppzksnark_proof<ppT> > &proofs,
+                                                           std::vector<bool> &results,
+                                                           libff::profiling & profile)
+{
+    typedef libff::bigint<libff::Fr<ppT>::num_limbs> scalar_t;
+
+    profile.enter_block("Call to r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC");
+
+    results.assign(proofs.size(), false);
+
+    std::vector<size_t> indices;
+    indices.reserve(proofs.size());
+    for (size_t i = 0; i < proofs.size(); ++i)
+    {
+        if (i >= primary_inputs.size() || primary_inputs[i].size() != pvk.gamma_ABC_g1.domain_size())
+        {
+            profile.print_indent(); profile_printf("Input length of proof %zu differs from expected (expected %zu).\n", i, pvk.gamma_ABC_g1.domain_size());
+        }
+        else if (!proofs[i].is_well_formed())
+        {
+            profile.print_indent(); profile_printf("At least one of the elements of proof %zu does not lie on the curve.\n", i);
+        }
+        else
+        {
+            indices.emplace_back(i);
+        }
+    }
+
+    profile.enter_block("Draw batching scalars");
+    const mp_size_t random_limbs = 128 / GMP_NUMB_BITS;
+    std::vector<scalar_t> r(proofs.size());
+    for (scalar_t &ri : r)
+    {
+        ri.randomize();
+        for (mp_size_t l = random_limbs; l < scalar_t::N; ++l) { ri.data[l] = 0; }
+        if (ri.is_zero()) { ri.data[0] = 1; }
+    }
+    profile.leave_block("Draw batching scalars");
+
+    profile.enter_block("Check QAP divisibility");
+    r1cs_rom_se_ppzksnark_batch_bisect<ppT>(pvk, primary_inputs, proofs, r, indices, false, results);
+    profile.leave_block("Check QAP divisibility");
+
+    const bool result = (indices.size() == proofs.size() &&
+                         std::find(results.begin(), results.end(), false) == results.end());
+
+    profile.leave_block("Call to r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC");
+
+    return result;
+}
+
 template<typename ppT>
 bool r1cs_rom_se_ppzksnark_affine_verifier_weak_IC(const r1cs_rom_se_ppzksnark_verification_key<ppT> &vk,
                                                const r1cs_rom_se_ppzksnark_primary_input<ppT> &primary_input,
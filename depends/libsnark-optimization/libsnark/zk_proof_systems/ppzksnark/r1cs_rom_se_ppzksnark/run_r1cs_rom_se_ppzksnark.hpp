@@ -62,6 +62,14 @@ run_r1cs_rom_se_ppzksnark_verify(
     const r1cs_rom_se_ppzksnark_proof<ppT> & proof);
 
 
+template<typename ppT>  bool
+run_r1cs_rom_se_ppzksnark_verify(
+    const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> & pvk ,
+    const r1cs_rom_se_ppzksnark_primary_input<ppT> & primary_input ,
+    const r1cs_rom_se_ppzksnark_proof<ppT> & proof,
+    libff::profiling & profile);
+
+
 template<typename ppT>
 bool run_r1cs_rom_se_ppzksnark_all(
         const r1cs_example<libff::Fr<ppT> > &example,
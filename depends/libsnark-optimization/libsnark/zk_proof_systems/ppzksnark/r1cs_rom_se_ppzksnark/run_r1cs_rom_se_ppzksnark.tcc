@@ -137,6 +137,25 @@ namespace libsnark {
 
         return ans;
     }
+
+
+
+    template<typename ppT>
+    bool run_r1cs_rom_se_ppzksnark_verify(
+            const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> & pvk ,
+            const r1cs_rom_se_ppzksnark_primary_input<ppT> & primary_input ,
+            const r1cs_rom_se_ppzksnark_proof<ppT> & proof,
+            libff::profiling & profile )
+    {
+        LOGD("Call to run_r1cs_rom_se_ppzksnark verify (processed vk)\n");
+
+        const bool ans = r1cs_rom_se_ppzksnark_online_verifier_strong_IC<ppT>(pvk, primary_input, proof, profile);
+        LOGD("* The verification result is: %s\n", (ans ? "PASS" : "FAIL"));
+
+        LOGD("End Call to run_r1cs_rom_se_ppzksnark verify (processed vk)\n");
+
+        return ans;
+    }
      
 
 
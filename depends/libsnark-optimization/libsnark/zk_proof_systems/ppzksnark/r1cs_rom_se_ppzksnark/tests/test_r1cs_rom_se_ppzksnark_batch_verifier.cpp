@@ -0,0 +1,80 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/common/profiling.hpp>
+
+#include <libsnark/zk_proof_systems/ppzksnark/r1cs_rom_se_ppzksnark/r1cs_rom_se_ppzksnark.hpp>
+#include <libsnark/zk_proof_systems/ppzksnark/tests/batch_verifier_fixture.hpp>
+
+using namespace libsnark;
+
+template<typename ppT>
+struct r1cs_rom_se_ppzksnark_scheme {
+    typedef r1cs_rom_se_ppzksnark_processed_verification_key<ppT> processed_verification_key;
+    typedef r1cs_rom_se_ppzksnark_primary_input<ppT> primary_input;
+    typedef r1cs_rom_se_ppzksnark_proof<ppT> proof;
+
+    static bool batch_verify(const processed_verification_key &pvk, const std::vector<primary_input> &primary_inputs,
+                             const std::vector<proof> &proofs, std::vector<bool> &results, libff::profiling &profile)
+    {
+        return r1cs_rom_se_ppzksnark_online_batch_verifier_strong_IC<ppT>(pvk, primary_inputs, proofs, results, profile);
+    }
+
+    static bool verify(const processed_verification_key &pvk, const primary_input &input, const proof &pi, libff::profiling &profile)
+    {
+        return r1cs_rom_se_ppzksnark_online_verifier_strong_IC<ppT>(pvk, input, pi, profile);
+    }
+};
+
+template<typename ppT>
+void test_r1cs_rom_se_ppzksnark_batch_verifier(const size_t num_constraints, const size_t num_inputs, const size_t num_proofs)
+{
+    typedef r1cs_rom_se_ppzksnark_scheme<ppT> scheme;
+    libff::profiling profile;
+
+    r1cs_rom_se_ppzksnark_constraint_system<ppT> cs;
+    r1cs_rom_se_ppzksnark_primary_input<ppT> primary_input;
+    r1cs_rom_se_ppzksnark_auxiliary_input<ppT> auxiliary_input;
+    chain_example<libff::Fr<ppT> >(num_constraints, num_inputs, cs, primary_input, auxiliary_input);
+
+    const r1cs_rom_se_ppzksnark_keypair<ppT> keypair = r1cs_rom_se_ppzksnark_generator<ppT>(cs, profile);
+    const r1cs_rom_se_ppzksnark_processed_verification_key<ppT> pvk = r1cs_rom_se_ppzksnark_verifier_process_vk<ppT>(keypair.vk, profile);
+
+    /* num_proofs proofs of the same statement, each with its own randomness */
+    std::vector<r1cs_rom_se_ppzksnark_proof<ppT> > proofs(num_proofs);
+    for (r1cs_rom_se_ppzksnark_proof<ppT> &proof : proofs)
+    {
+        proof = r1cs_rom_se_ppzksnark_prover<ppT>(keypair.pk, primary_input, auxiliary_input, profile);
+    }
+
+    test_batch_verifier_common<ppT, scheme>(pvk, primary_input, proofs, profile);
+
+    /*
+      ROM-SE binds C to the hashes of (A, B) : the re-randomization a GG proof survives
+      must be flagged, alone and next to a tampered proof
+    */
+    const std::vector<r1cs_rom_se_ppzksnark_primary_input<ppT> > primary_inputs(num_proofs, primary_input);
+    std::vector<r1cs_rom_se_ppzksnark_proof<ppT> > mauled = proofs;
+    mauled[1] = rerandomize_proof<ppT>(proofs[1]);
+    check_batch<scheme>(pvk, primary_inputs, mauled, { 1 }, profile);
+
+    mauled[num_proofs - 1].g_C = mauled[num_proofs - 1].g_C + libff::G1<ppT>::one();
+    check_batch<scheme>(pvk, primary_inputs, mauled, { 1, num_proofs - 1 }, profile);
+    printf("* re-randomized proof rejected\n");
+}
+
+int main()
+{
+    libff::alt_bn128_pp::init_public_params();
+
+    test_r1cs_rom_se_ppzksnark_batch_verifier<libff::alt_bn128_pp>(100, 4, 7);
+}
@@ -0,0 +1,161 @@
+/** @file
+ *****************************************************************************
+
+ Shared fixture for the tests of the strong-IC batch verifiers of the
+ GG-ppzkSNARK and the ROM-SE-ppzkSNARK.
+
+ A scheme is described by a struct with the types
+   processed_verification_key, primary_input, proof
+ and the static functions
+   batch_verify(pvk, primary_inputs, proofs, results, profile)
+   verify(pvk, primary_input, proof, profile)
+
+ *****************************************************************************
+ * @author     This file is part of libsnark, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BATCH_VERIFIER_FIXTURE_HPP_
+#define BATCH_VERIFIER_FIXTURE_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include <libff/common/profiling.hpp>
+
+#include <libsnark/relations/constraint_satisfaction_problems/r1cs/r1cs.hpp>
+
+namespace libsnark {
+
+/*
+  A chain of num_constraints constraints over num_inputs primary inputs x_1 .. x_k :
+  a_1 = x_1 * x_1 , and a_{i+1} = ( a_i + x_{i mod k + 1} ) * a_i .
+*/
+template<typename FieldT>
+void chain_example(const size_t num_constraints, const size_t num_inputs,
+                   r1cs_constraint_system<FieldT> &cs,
+                   r1cs_primary_input<FieldT> &primary_input,
+                   r1cs_auxiliary_input<FieldT> &auxiliary_input)
+{
+    cs = r1cs_constraint_system<FieldT>();
+    cs.primary_input_size = num_inputs;
+    cs.auxiliary_input_size = num_constraints;
+
+    primary_input.clear();
+    for (size_t i = 0; i < num_inputs; ++i)
+    {
+        primary_input.emplace_back(FieldT::random_element());
+    }
+
+    auxiliary_input.assign(1, primary_input[0] * primary_input[0]);
+    cs.add_constraint(r1cs_constraint<FieldT>(variable<FieldT>(1), variable<FieldT>(1), variable<FieldT>(num_inputs + 1)));
+
+    for (size_t i = 1; i < num_constraints; ++i)
+    {
+        const size_t x = i % num_inputs;
+        const variable<FieldT> a(num_inputs + i), a_next(num_inputs + i + 1), xi(x + 1);
+        auxiliary_input.emplace_back((auxiliary_input[i-1] + primary_input[x]) * auxiliary_input[i-1]);
+        cs.add_constraint(r1cs_constraint<FieldT>(a + xi, a, a_next));
+    }
+
+    assert(cs.is_satisfied(primary_input, auxiliary_input));
+}
+
+/* runs the batch verifier, and checks that results flags exactly the proofs in invalid */
+template<typename Scheme>
+void check_batch(const typename Scheme::processed_verification_key &pvk,
+                 const std::vector<typename Scheme::primary_input> &primary_inputs,
+                 const std::vector<typename Scheme::proof> &proofs,
+                 const std::vector<size_t> &invalid,
+                 libff::profiling &profile)
+{
+    std::vector<bool> results;
+    const bool all_valid = Scheme::batch_verify(pvk, primary_inputs, proofs, results, profile);
+
+    assert(all_valid == invalid.empty());
+    assert(results.size() == proofs.size());
+    for (size_t i = 0; i < proofs.size(); ++i)
+    {
+        const bool expected = (std::find(invalid.begin(), invalid.end(), i) == invalid.end());
+        assert(results[i] == expected);
+        assert(results[i] == Scheme::verify(pvk, primary_inputs[i], proofs[i], profile));
+    }
+}
+
+/*
+  The cases both schemes share, given num_proofs >= 2 valid proofs of primary_input :
+  tampered, malformed and mismatched items inside otherwise valid batches.
+*/
+template<typename ppT, typename Scheme>
+void test_batch_verifier_common(const typename Scheme::processed_verification_key &pvk,
+                                const typename Scheme::primary_input &primary_input,
+                                const std::vector<typename Scheme::proof> &proofs,
+                                libff::profiling &profile)
+{
+    typedef typename Scheme::proof proof_t;
+    typedef typename Scheme::primary_input primary_input_t;
+
+    const size_t num_proofs = proofs.size();
+    assert(num_proofs >= 2);
+    const std::vector<primary_input_t> primary_inputs(num_proofs, primary_input);
+
+    /* a valid batch */
+    check_batch<Scheme>(pvk, primary_inputs, proofs, {}, profile);
+    printf("* valid batch of %zu proofs accepted\n", num_proofs);
+
+    /* one tampered proof, at each position : bisection flags exactly that one */
+    for (size_t t = 0; t < num_proofs; ++t)
+    {
+        std::vector<proof_t> tampered = proofs;
+        tampered[t].g_C = tampered[t].g_C + libff::G1<ppT>::one();
+        check_batch<Scheme>(pvk, primary_inputs, tampered, { t }, profile);
+    }
+    printf("* one tampered proof found at each of %zu positions\n", num_proofs);
+
+    /* a point off the curve, as a malformed proof would decode to, is flagged without poisoning the batch */
+    std::vector<proof_t> malformed = proofs;
+    malformed[num_proofs / 2].g_A.X += libff::G1<ppT>::base_field::one();
+    assert(!malformed[num_proofs / 2].is_well_formed());
+    check_batch<Scheme>(pvk, primary_inputs, malformed, { num_proofs / 2 }, profile);
+    printf("* malformed proof found\n");
+
+    /* a proof against a wrong primary input, and two tampered proofs in different halves */
+    std::vector<primary_input_t> wrong_inputs = primary_inputs;
+    wrong_inputs[num_proofs / 2][0] += libff::Fr<ppT>::one();
+    check_batch<Scheme>(pvk, wrong_inputs, proofs, { num_proofs / 2 }, profile);
+
+    std::vector<proof_t> tampered = proofs;
+    tampered[0].g_A = tampered[0].g_A.dbl();
+    tampered[num_proofs - 1].g_B = tampered[num_proofs - 1].g_B + libff::G2<ppT>::one();
+    check_batch<Scheme>(pvk, primary_inputs, tampered, { 0, num_proofs - 1 }, profile);
+
+    /* a primary input of the wrong length is rejected without entering the pairing check */
+    wrong_inputs = primary_inputs;
+    wrong_inputs[1].pop_back();
+    check_batch<Scheme>(pvk, wrong_inputs, proofs, { 1 }, profile);
+    printf("* wrong input, two tampered proofs, and short input found\n");
+
+    /* an empty batch, and batches of one */
+    check_batch<Scheme>(pvk, {}, {}, {}, profile);
+    check_batch<Scheme>(pvk, { primary_inputs[0] }, { proofs[0] }, {}, profile);
+    check_batch<Scheme>(pvk, { primary_inputs[0] }, { tampered[0] }, { 0 }, profile);
+    printf("* empty batch and batches of one\n");
+}
+
+/* re-randomizes (A, B) into (k A, k^{-1} B) : the pairing e(A, B) , and so the GG equation, is unchanged */
+template<typename ppT, typename ProofT>
+ProofT rerandomize_proof(const ProofT &proof)
+{
+    const libff::Fr<ppT> k = libff::Fr<ppT>::random_element();
+    ProofT mauled = proof;
+    mauled.g_A = k * proof.g_A;
+    mauled.g_B = k.inverse() * proof.g_B;
+    return mauled;
+}
+
+} // libsnark
+
+#endif // BATCH_VERIFIER_FIXTURE_HPP_